@@ -283,6 +283,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/renderer/renderer_impl.cpp",
     "src/mbgl/renderer/renderer_impl.hpp",
     "src/mbgl/renderer/renderer_state.cpp",
+    "src/mbgl/renderer/shader_warm_up.cpp",
+    "src/mbgl/renderer/shader_warm_up.hpp",
     "src/mbgl/renderer/sources/render_custom_geometry_source.cpp",
     "src/mbgl/renderer/sources/render_custom_geometry_source.hpp",
     "src/mbgl/renderer/sources/render_geojson_source.cpp",
@@ -487,6 +489,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/text/local_glyph_rasterizer.hpp",
     "src/mbgl/text/placement.cpp",
     "src/mbgl/text/placement.hpp",
+    "src/mbgl/text/placement_state.cpp",
+    "src/mbgl/text/placement_state.hpp",
     "src/mbgl/text/quads.cpp",
     "src/mbgl/text/quads.hpp",
     "src/mbgl/text/shaping.cpp",
@@ -514,6 +518,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/tile/raster_tile.hpp",
     "src/mbgl/tile/raster_tile_worker.cpp",
     "src/mbgl/tile/raster_tile_worker.hpp",
+    "src/mbgl/tile/shared_geometry_tile_data.cpp",
+    "src/mbgl/tile/shared_geometry_tile_data.hpp",
     "src/mbgl/tile/tile.cpp",
     "src/mbgl/tile/tile.hpp",
     "src/mbgl/tile/tile_cache.cpp",
@@ -562,6 +568,7 @@ MLN_CORE_SOURCE = [
     "src/mbgl/util/i18n.cpp",
     "src/mbgl/util/i18n.hpp",
     "src/mbgl/util/identity.cpp",
+    "src/mbgl/util/indexed_priority_queue.hpp",
     "src/mbgl/util/instrumentation.cpp",
     "src/mbgl/util/interpolate.cpp",
     "src/mbgl/util/intersection_tests.cpp",
@@ -586,6 +593,7 @@ MLN_CORE_SOURCE = [
     "src/mbgl/util/quaternion.hpp",
     "src/mbgl/util/rapidjson.cpp",
     "src/mbgl/util/rapidjson.hpp",
+    "src/mbgl/util/shared_buffer.cpp",
     "src/mbgl/util/source_location.hpp",
     "src/mbgl/util/std.hpp",
     "src/mbgl/util/stopwatch.cpp",
@@ -596,6 +604,7 @@ MLN_CORE_SOURCE = [
     "src/mbgl/util/thread_local.hpp",
     "src/mbgl/util/thread_pool.cpp",
     "src/mbgl/util/thread_pool.hpp",
+    "src/mbgl/util/thread_pool_size.cpp",
     "src/mbgl/util/tile_coordinate.hpp",
     "src/mbgl/util/tile_cover.cpp",
     "src/mbgl/util/tile_cover.hpp",
@@ -613,6 +622,7 @@ MLN_CORE_SOURCE = [
     "src/mbgl/util/version.cpp",
     "src/mbgl/util/version.hpp",
     "src/mbgl/util/work_request.cpp",
+    "src/mbgl/util/work_stealing_deque.hpp",
 ] + select({
     "//:rust": [
         "src/mbgl/util/color.rs.cpp",
@@ -695,6 +705,7 @@ MLN_CORE_HEADERS = [
     "include/mbgl/renderer/renderer_frontend.hpp",
     "include/mbgl/renderer/renderer_observer.hpp",
     "include/mbgl/renderer/renderer_state.hpp",
+    "include/mbgl/renderer/tile_cache_stats.hpp",
     "include/mbgl/shaders/program_parameters.hpp",
     "include/mbgl/storage/database_file_source.hpp",
     "include/mbgl/storage/file_source.hpp",
@@ -841,9 +852,11 @@ MLN_CORE_HEADERS = [
     "include/mbgl/util/rect.hpp",
     "include/mbgl/util/run_loop.hpp",
     "include/mbgl/util/scoped.hpp",
+    "include/mbgl/util/shared_buffer.hpp",
     "include/mbgl/util/size.hpp",
     "include/mbgl/util/string.hpp",
     "include/mbgl/util/string_indexer.hpp",
+    "include/mbgl/util/thread_pool_size.hpp",
     "include/mbgl/util/tile_server_options.hpp",
     "include/mbgl/util/thread.hpp",
     "include/mbgl/util/tileset.hpp",
@@ -863,6 +876,7 @@ MLN_CORE_HEADERS = [
 MLN_OPENGL_SOURCE = [
     "src/mbgl/gl/attribute.cpp",
     "src/mbgl/gl/attribute.hpp",
+    "src/mbgl/gl/buffer_storage_extension.hpp",
     "src/mbgl/gl/command_encoder.cpp",
     "src/mbgl/gl/command_encoder.hpp",
     "src/mbgl/gl/context.cpp",
@@ -877,12 +891,16 @@ MLN_OPENGL_SOURCE = [
     "src/mbgl/gl/fence.cpp",
     "src/mbgl/gl/fence.hpp",
     "src/mbgl/gl/framebuffer.hpp",
+    "src/mbgl/gl/gpu_timer.cpp",
+    "src/mbgl/gl/gpu_timer.hpp",
     "src/mbgl/gl/index_buffer_resource.cpp",
     "src/mbgl/gl/index_buffer_resource.hpp",
     "src/mbgl/gl/object.cpp",
     "src/mbgl/gl/object.hpp",
     "src/mbgl/gl/offscreen_texture.cpp",
     "src/mbgl/gl/offscreen_texture.hpp",
+    "src/mbgl/gl/program_binary_cache.cpp",
+    "src/mbgl/gl/program_binary_cache.hpp",
     "src/mbgl/gl/render_pass.cpp",
     "src/mbgl/gl/render_pass.hpp",
     "src/mbgl/gl/renderbuffer_resource.cpp",
@@ -1031,6 +1049,8 @@ MLN_DRAWABLES_GL_SOURCE = [
     "src/mbgl/gl/layer_group_gl.cpp",
     "src/mbgl/gl/texture2d.cpp",
     "src/mbgl/gl/uniform_buffer_gl.cpp",
+    "src/mbgl/gl/uniform_buffer_ring.cpp",
+    "src/mbgl/gl/uniform_buffer_ring.hpp",
     "src/mbgl/gl/vertex_attribute_gl.cpp",
     "src/mbgl/shaders/gl/shader_info.cpp",
     "src/mbgl/shaders/gl/shader_program_gl.cpp",
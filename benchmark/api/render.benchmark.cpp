@@ -1,6 +1,10 @@
 #include <benchmark/benchmark.h>
 
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/gfx/headless_frontend.hpp>
+#if MLN_RENDER_BACKEND_OPENGL
+#include <mbgl/gl/renderer_backend.hpp>
+#endif
 #include <mbgl/map/map.hpp>
 #include <mbgl/map/map_observer.hpp>
 #include <mbgl/map/map_options.hpp>
@@ -14,7 +18,11 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/thread_pool_size.hpp>
 
+#include <thread>
+
+#include <filesystem>
 #include <sstream>
 #include <optional>
 
@@ -154,9 +162,127 @@ static void API_renderStill_multiple_sources(::benchmark::State& state) {
     }
 }
 
+// Renders dense icon labels from many sources without cross-source collisions,
+// placing the sources serially (0) or concurrently (1)
+static void API_renderStill_dense_labels(::benchmark::State& state) {
+    using namespace mbgl::style;
+    RenderBenchmark bench;
+    HeadlessFrontend frontend{size, pixelRatio};
+    Map map{frontend,
+            MapObserver::nullObserver(),
+            MapOptions()
+                .withMapMode(MapMode::Static)
+                .withSize(size)
+                .withPixelRatio(pixelRatio)
+                .withCrossSourceCollisions(false)
+                .withParallelPlacement(state.range(0) != 0),
+            ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+    prepare(map);
+    auto& style = map.getStyle();
+    const int kSourcesCount = 8;
+    const int kPointsCount = 2000;
+    for (int i = 0; i < kSourcesCount; ++i) {
+        mapbox::feature::feature_collection<double> features;
+        for (int j = 0; j < kPointsCount; ++j) {
+            // Deterministic scatter over the viewport around the camera center
+            const double lng = -74.0 + 0.02 * ((j * 7919 + i * 104729) % 1000) / 1000.0;
+            const double lat = 40.717 + 0.02 * ((j * 6271 + i * 7907) % 1000) / 1000.0;
+            features.emplace_back(Point<double>{lng, lat});
+        }
+
+        const std::string sourceId = "dense" + std::to_string(i);
+        auto source = std::make_unique<GeoJSONSource>(sourceId);
+        source->setGeoJSON(features);
+        style.addSource(std::move(source));
+        auto layer = std::make_unique<SymbolLayer>(sourceId, sourceId);
+        layer->setIconImage({"test-icon"});
+        style.addLayer(std::move(layer));
+    }
+
+    for (auto _ : state) {
+        frontend.render(map);
+    }
+}
+
+// Renders a fresh map with a worker pool of `state.range(0)` threads, to see how parsing scales with cores
+static void API_renderStill_worker_scaling(::benchmark::State& state) {
+    RenderBenchmark bench;
+    const auto workers = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        // Hold the pool so that the frontend and map pick it up instead of creating the default one
+        auto pool = Scheduler::GetBackground(ThreadPoolSize::fixed(workers));
+        HeadlessFrontend frontend{size, pixelRatio};
+        Map map{frontend,
+                MapObserver::nullObserver(),
+                MapOptions().withMapMode(MapMode::Static).withSize(size).withPixelRatio(pixelRatio),
+                ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+        prepare(map);
+        frontend.render(map);
+    }
+    state.counters["workers"] = static_cast<double>(workers);
+}
+
+#if MLN_RENDER_BACKEND_OPENGL
+// First frame of a fresh renderer without the program binary cache (0), with an empty cache (1) and with the
+// cache filled by an earlier renderer (2), which is what short-lived render processes see after the first one
+static void API_renderStill_first_frame_program_cache(::benchmark::State& state) {
+    RenderBenchmark bench;
+    const std::string programCachePath = "benchmark/fixtures/api/program_binary_cache";
+    const auto mode = state.range(0);
+
+    const auto renderFirstFrame = [&] {
+        HeadlessFrontend frontend{size, pixelRatio};
+        if (mode != 0) {
+            static_cast<gl::RendererBackend*>(frontend.getBackend())->setProgramBinaryCacheDirectory(programCachePath);
+        }
+        Map map{frontend,
+                MapObserver::nullObserver(),
+                MapOptions().withMapMode(MapMode::Static).withSize(size).withPixelRatio(pixelRatio),
+                ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+        prepare(map);
+        frontend.render(map);
+    };
+
+    std::filesystem::remove_all(programCachePath);
+    if (mode == 2) {
+        renderFirstFrame();
+    }
+
+    for (auto _ : state) {
+        if (mode == 1) {
+            state.PauseTiming();
+            std::filesystem::remove_all(programCachePath);
+            state.ResumeTiming();
+        }
+        renderFirstFrame();
+    }
+    state.SetLabel(mode == 0 ? "no cache" : mode == 1 ? "cold" : "warm");
+
+    std::filesystem::remove_all(programCachePath);
+}
+#endif
+
+static void workerScalingArguments(::benchmark::internal::Benchmark* benchmark) {
+    const auto maxWorkers = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned workers = 1; workers < maxWorkers; workers *= 2) {
+        benchmark->Arg(workers);
+    }
+    benchmark->Arg(maxWorkers);
+}
+
 BENCHMARK(API_renderStill_reuse_map)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_reuse_map_formatted_labels)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_reuse_map_switch_styles)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_recreate_map)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_recreate_map_2)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_multiple_sources)->Unit(benchmark::kMillisecond)->Iterations(50);
+BENCHMARK(API_renderStill_dense_labels)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->Iterations(50);
+#if MLN_RENDER_BACKEND_OPENGL
+BENCHMARK(API_renderStill_first_frame_program_cache)->DenseRange(0, 2)->Unit(benchmark::kMillisecond)->Iterations(20);
+#endif
+BENCHMARK(API_renderStill_worker_scaling)
+    ->Apply(workerScalingArguments)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(20)
+    ->UseRealTime();
@@ -4,10 +4,13 @@
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
 #include <mbgl/storage/sqlite3.hpp>
+#include <mbgl/util/io.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <atomic>
 #include <random>
+#include <thread>
 
 class OfflineDatabase : public benchmark::Fixture {
 public:
@@ -200,3 +203,94 @@ BENCHMARK_F(OfflineDatabase, ResizeDatabase)(benchmark::State& state) {
         }
     }
 }
+
+namespace {
+
+const std::string mixedDatabasePath = "benchmark/fixtures/offline_database_mixed.db";
+
+void deleteMixedDatabase() {
+    using namespace std::literals::string_literals;
+    mbgl::util::deleteFile(mixedDatabasePath);
+    mbgl::util::deleteFile(mixedDatabasePath + "-wal"s);
+    mbgl::util::deleteFile(mixedDatabasePath + "-shm"s);
+    mbgl::util::deleteFile(mixedDatabasePath + "-journal"s);
+}
+
+} // namespace
+
+// Browsing pattern on an on-disk cache: every iteration stores one new tile and
+// reads back four cached ones, while a second connection keeps reading on
+// another thread. Arg(0) uses the default rollback journal with a commit per
+// tile, Arg(1) uses a write-ahead log with batched commits.
+static void OfflineDatabase_MixedReadWrite(benchmark::State& state) {
+    using namespace mbgl;
+    using namespace std::chrono_literals;
+
+    const bool batching = state.range(0) != 0;
+    const unsigned tileCount = 100;
+
+    deleteMixedDatabase();
+
+    Response response;
+    response.data = std::make_shared<std::string>(50 * 1024, 0);
+    response.mustRevalidate = false;
+    response.expires = util::now() + 1h;
+
+    auto tile = [](const std::string& name, unsigned i) {
+        return Resource::tile("mapbox://" + name + util::toString(i), 1, 0, 0, 0, Tileset::Scheme::XYZ);
+    };
+
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> backgroundReads{0};
+    std::thread reader;
+
+    {
+        mbgl::OfflineDatabase db(mixedDatabasePath, TileServerOptions::DefaultConfiguration());
+        if (batching) {
+            db.setWriteBatching(mbgl::OfflineDatabase::WriteBatching{});
+        }
+        for (unsigned i = 0; i < tileCount; ++i) {
+            db.put(tile("tile_ambient", i), response);
+        }
+        db.flushPendingWrites();
+
+        reader = std::thread([&] {
+            auto readerDB = mapbox::sqlite::Database::open(mixedDatabasePath, mapbox::sqlite::ReadOnly);
+            readerDB.setBusyTimeout(Milliseconds::max());
+            mapbox::sqlite::Statement statement{readerDB, "SELECT data FROM tiles WHERE url_template = ?1"};
+            std::mt19937 gen(1);
+            std::uniform_int_distribution<unsigned> dis(0, tileCount - 1);
+            while (!done) {
+                mapbox::sqlite::Query query{statement};
+                query.bind(1, "mapbox://tile_ambient" + util::toString(dis(gen)));
+                if (query.run()) {
+                    ++backgroundReads;
+                }
+            }
+        });
+
+        std::mt19937 gen(2);
+        std::uniform_int_distribution<unsigned> dis(0, tileCount - 1);
+        unsigned written = 0;
+
+        for (auto _ : state) {
+            db.put(tile("tile_new", written++), response);
+            for (unsigned i = 0; i < 4; ++i) {
+                auto res = db.get(tile("tile_ambient", dis(gen)));
+                benchmark::DoNotOptimize(res);
+            }
+        }
+        db.flushPendingWrites();
+
+        done = true;
+        reader.join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * 5);
+    state.counters["background_reads"] = benchmark::Counter(static_cast<double>(backgroundReads),
+                                                            benchmark::Counter::kIsRate);
+
+    deleteMixedDatabase();
+}
+
+BENCHMARK(OfflineDatabase_MixedReadWrite)->Arg(0)->Arg(1)->UseRealTime();
@@ -0,0 +1,165 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/storage/file_source.hpp>
+#include <mbgl/storage/http_file_source.hpp>
+#include <mbgl/storage/offline_database.hpp>
+#include <mbgl/storage/offline_download.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/async_request.hpp>
+#include <mbgl/util/client_options.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <cstdlib>
+#include <list>
+#include <memory>
+#include <string>
+#include <tuple>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr const char* localTileURL = "http://127.0.0.1:3000/{z}-{x}-{y}.vector.pbf";
+
+std::string styleJSON(const std::string& tileURL) {
+    return R"JSON({
+    "version": 8,
+    "sources": {
+        "inline": {
+            "type": "vector",
+            "minzoom": 0,
+            "maxzoom": 15,
+            "tiles": [ ")JSON" +
+           tileURL + R"JSON(" ]
+        }
+    },
+    "layers": []
+})JSON";
+}
+
+// Answers the style in-process. Tiles are answered on the next run loop iteration,
+// so only the download pipeline and the database are measured, unless a network
+// file source is given to fetch them.
+class LocalFileSource : public FileSource {
+public:
+    explicit LocalFileSource(std::string tileURL_ = localTileURL, std::unique_ptr<FileSource> network_ = nullptr)
+        : tileURL(std::move(tileURL_)),
+          network(std::move(network_)) {
+        tile.data = std::make_shared<std::string>(16 * 1024, 'x');
+    }
+
+    std::unique_ptr<AsyncRequest> request(const Resource& resource, Callback callback) override {
+        Response response;
+        if (resource.kind == Resource::Kind::Style) {
+            response.data = std::make_shared<std::string>(styleJSON(tileURL));
+        } else if (network) {
+            return network->request(resource, std::move(callback));
+        } else {
+            response = tile;
+        }
+        return util::RunLoop::Get()->invokeCancellable([callback, response] { callback(response); });
+    }
+
+    bool canRequest(const Resource&) const override { return true; }
+
+    void setResourceOptions(ResourceOptions options) override { resourceOptions = std::move(options); }
+    ResourceOptions getResourceOptions() override { return resourceOptions.clone(); }
+
+    void setClientOptions(ClientOptions options) override { clientOptions = std::move(options); }
+    ClientOptions getClientOptions() override { return clientOptions.clone(); }
+
+private:
+    const std::string tileURL;
+    const std::unique_ptr<FileSource> network;
+    Response tile;
+    ResourceOptions resourceOptions;
+    ClientOptions clientOptions;
+};
+
+class CompletionObserver : public OfflineRegionObserver {
+public:
+    explicit CompletionObserver(util::RunLoop& loop_)
+        : loop(loop_) {}
+
+    void statusChanged(OfflineRegionStatus status) override {
+        if (status.complete()) {
+            tiles = status.completedTileCount;
+            loop.stop();
+        }
+    }
+
+    util::RunLoop& loop;
+    uint64_t tiles = 0;
+};
+
+// Download the world from zoom 0 to `maxZoom` into an empty database, or resume a
+// download that has every other tile already stored.
+void downloadRegion(benchmark::State& state,
+                    util::RunLoop& loop,
+                    LocalFileSource& fileSource,
+                    const std::string& tileURL,
+                    uint8_t maxZoom) {
+    const bool resume = state.range(0) != 0;
+    const OfflineTilePyramidRegionDefinition definition{
+        "http://127.0.0.1:3000/style.json", LatLngBounds::world(), 0, static_cast<double>(maxZoom), 1.0, false};
+    uint64_t tiles = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        OfflineDatabase db(":memory:", TileServerOptions::MapTilerConfiguration());
+        auto region = db.createRegion(definition, {});
+        if (resume) {
+            Response response;
+            response.data = std::make_shared<std::string>(16 * 1024, 'x');
+            std::list<std::tuple<Resource, Response>> stored;
+            for (uint8_t z = 0; z <= maxZoom; ++z) {
+                for (int32_t x = 0; x < (1 << z); ++x) {
+                    for (int32_t y = x % 2; y < (1 << z); y += 2) {
+                        stored.emplace_back(Resource::tile(tileURL, 1, x, y, z, Tileset::Scheme::XYZ), response);
+                    }
+                }
+            }
+            OfflineRegionStatus status;
+            db.putRegionResources(region->getID(), stored, status);
+        }
+        OfflineDownload download(region->getID(), definition, db, fileSource);
+        auto observer = std::make_unique<CompletionObserver>(loop);
+        auto& completion = *observer;
+        download.setObserver(std::move(observer));
+        state.ResumeTiming();
+
+        download.setState(OfflineRegionDownloadState::Active);
+        loop.run();
+        tiles += completion.tiles;
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(tiles));
+}
+
+// Zoom 0 to 6, 5461 tiles, answered in-process
+void OfflineDownload_Region(benchmark::State& state) {
+    util::RunLoop loop;
+    LocalFileSource fileSource;
+    downloadRegion(state, loop, fileSource, localTileURL, 6);
+}
+
+// Zoom 0 to 4, 341 tiles, fetched over HTTP from the tile URL template in
+// MLN_BENCHMARK_TILE_URL, e.g. http://127.0.0.1:8000/{z}/{x}/{y}.pbf. Any local
+// server that answers every tile path works.
+void OfflineDownload_RegionHTTP(benchmark::State& state) {
+    const char* tileURL = std::getenv("MLN_BENCHMARK_TILE_URL");
+    if (!tileURL) {
+        state.SkipWithError("MLN_BENCHMARK_TILE_URL is not set");
+        return;
+    }
+
+    util::RunLoop loop;
+    LocalFileSource fileSource(tileURL, std::make_unique<HTTPFileSource>(ResourceOptions(), ClientOptions()));
+    downloadRegion(state, loop, fileSource, tileURL, 4);
+}
+
+} // namespace
+
+BENCHMARK(OfflineDownload_Region)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(OfflineDownload_RegionHTTP)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/indexed_priority_queue.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <random>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Stand-in for the queued requests, only their addresses are used
+struct Request {
+    std::size_t priority;
+};
+
+// The list based queue OnlineFileSource used before, for comparison
+class ListQueue {
+public:
+    ListQueue()
+        : firstLowPriority(queue.begin()) {}
+
+    void push(Request* request) {
+        if (request->priority == 0) {
+            firstLowPriority = std::next(queue.insert(firstLowPriority, request));
+        } else if (firstLowPriority == queue.end()) {
+            firstLowPriority = queue.insert(queue.end(), request);
+        } else {
+            queue.push_back(request);
+        }
+    }
+
+    void remove(const Request* request) {
+        auto it = std::find(queue.begin(), queue.end(), request);
+        if (it != queue.end()) {
+            if (it == firstLowPriority) {
+                ++firstLowPriority;
+            }
+            queue.erase(it);
+        }
+    }
+
+private:
+    std::list<Request*> queue;
+    std::list<Request*>::iterator firstLowPriority;
+};
+
+// Queue a mix of regular and low priority requests, then cancel all of them in
+// random order, like a fast pan abandoning prefetched tiles.
+template <typename Queue, typename Push>
+void EnqueueAndCancel(benchmark::State& state, Push push) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+
+    std::vector<Request> requests(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        requests[i].priority = i % 4 == 0 ? 1 : 0;
+    }
+    std::vector<Request*> cancelOrder;
+    for (auto& request : requests) {
+        cancelOrder.push_back(&request);
+    }
+    std::shuffle(cancelOrder.begin(), cancelOrder.end(), std::mt19937(42));
+
+    for (auto _ : state) {
+        Queue queue;
+        for (auto& request : requests) {
+            push(queue, &request);
+        }
+        for (auto* request : cancelOrder) {
+            queue.remove(request);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+
+void PendingRequests_Indexed(benchmark::State& state) {
+    EnqueueAndCancel<util::IndexedPriorityQueue<Request*, 2>>(
+        state, [](auto& queue, Request* request) { queue.push(request, request->priority); });
+}
+
+void PendingRequests_List(benchmark::State& state) {
+    EnqueueAndCancel<ListQueue>(state, [](auto& queue, Request* request) { queue.push(request); });
+}
+
+} // namespace
+
+BENCHMARK(PendingRequests_Indexed)->RangeMultiplier(10)->Range(500, 50000)->Unit(benchmark::kMillisecond);
+BENCHMARK(PendingRequests_List)->RangeMultiplier(10)->Range(500, 50000)->Unit(benchmark::kMillisecond);
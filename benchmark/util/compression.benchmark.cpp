@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+const std::string& tileData() {
+    static const std::string data = util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf");
+    return data;
+}
+
+// Slices of another tile from the same tileset.
+const std::vector<std::string>& trainingSamples() {
+    static const std::vector<std::string> samples = [] {
+        const std::string other = util::read_file("test/fixtures/api/assets/streets/0-0-0.vector.pbf");
+        constexpr std::size_t sliceSize = 8 * 1024;
+        std::vector<std::string> result;
+        for (std::size_t offset = 0; offset < other.size(); offset += sliceSize) {
+            result.push_back(other.substr(offset, sliceSize));
+        }
+        return result;
+    }();
+    return samples;
+}
+
+// Args: codec, whether to use a trained dictionary.
+void Compression_DecodeTile(benchmark::State& state) {
+    const auto codec = static_cast<util::Codec>(state.range(0));
+    if (!util::isAvailable(codec)) {
+        state.SkipWithError("Codec is not available in this build");
+        return;
+    }
+
+    std::string dictionary;
+    if (state.range(1)) {
+        dictionary = util::trainDictionary(codec, trainingSamples(), 32 * 1024);
+    }
+    const auto* dictionaryPtr = dictionary.empty() ? nullptr : &dictionary;
+    const util::DictionaryLookup lookup = [&](util::Codec, uint32_t) {
+        return dictionaryPtr;
+    };
+
+    const std::string& raw = tileData();
+    const std::string compressed = util::compress(raw, codec, dictionaryPtr);
+
+    for (auto _ : state) {
+        auto decompressed = util::decompress(compressed, codec, lookup);
+        benchmark::DoNotOptimize(decompressed);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * raw.size()));
+    state.counters["ratio"] = static_cast<double>(raw.size()) / static_cast<double>(compressed.size());
+}
+
+} // namespace
+
+BENCHMARK(Compression_DecodeTile)
+    ->Args({static_cast<int64_t>(util::Codec::Zlib), 0})
+    ->Args({static_cast<int64_t>(util::Codec::Zlib), 1})
+    ->Args({static_cast<int64_t>(util::Codec::Zstd), 0})
+    ->Args({static_cast<int64_t>(util::Codec::Zstd), 1});
@@ -0,0 +1,168 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/map_options.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/style/image.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/text/collision_index.hpp>
+#include <mbgl/util/grid_index.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+using CollisionGrid = CollisionIndex::CollisionGrid;
+using Operation = CollisionTrace::Operation;
+
+// Records the collision grid operations of placing the labels of the query benchmark's
+// Manhattan view, flat and pitched, from the tiles in the benchmark cache.
+std::vector<CollisionTrace> recordPlacement() {
+    std::vector<CollisionTrace> traces;
+    CollisionIndex::setTraceSink([&](CollisionTrace&& trace) {
+        if (!trace.operations.empty()) {
+            traces.push_back(std::move(trace));
+        }
+    });
+
+    {
+        NetworkStatus::Set(NetworkStatus::Status::Offline);
+        util::RunLoop loop;
+        HeadlessFrontend frontend{{1000, 1000}, 1};
+        Map map{frontend,
+                MapObserver::nullObserver(),
+                MapOptions().withMapMode(MapMode::Static).withSize(frontend.getSize()),
+                ResourceOptions()
+                    .withCachePath("benchmark/fixtures/api/cache.db")
+                    .withAssetPath(".")
+                    .withApiKey("foobar")};
+        map.getStyle().loadJSON(util::read_file("benchmark/fixtures/api/style.json"));
+        map.getStyle().addImage(std::make_unique<style::Image>(
+            "test-icon", decodeImage(util::read_file("benchmark/fixtures/api/default_marker.png")), 1.0f));
+
+        for (const double pitch : {0.0, 60.0}) {
+            map.jumpTo(CameraOptions()
+                           .withCenter(LatLng{40.726989, -73.992857})
+                           .withZoom(15.0)
+                           .withBearing(30.0)
+                           .withPitch(pitch));
+            frontend.render(map);
+        }
+    }
+
+    // Placements still alive when recording stops are left out
+    CollisionIndex::setTraceSink({});
+    return traces;
+}
+
+const std::vector<CollisionTrace>& traces() {
+    static const auto recorded = recordPlacement();
+    return recorded;
+}
+
+CollisionGrid::BBox toBox(const Operation& operation) {
+    return {{operation.x1, operation.y1}, {operation.x2, operation.y2}};
+}
+
+CollisionGrid::BCircle toCircle(const Operation& operation) {
+    return {{operation.x1, operation.y1}, operation.x2};
+}
+
+// Replays the recorded operations of one placement into fresh grids. Grouped hit tests compare
+// collision groups like the placement predicate does; a placement split by collision group only
+// holds features of a single group, so the group last inserted stands in for the tested one.
+std::size_t replay(const CollisionTrace& trace, CollisionGrid& grid, CollisionGrid& ignoredGrid) {
+    const std::string layer = "poi";
+    uint16_t group = 0;
+    const std::function<bool(const RefIndexedSubfeature&)> predicate = [&](const RefIndexedSubfeature& feature) {
+        return feature.getCollisionGroupId() == group;
+    };
+
+    std::size_t hits = 0;
+    std::size_t index = 0;
+    for (const auto& operation : trace.operations) {
+        switch (operation.type) {
+            case Operation::Type::HitTest:
+                if (operation.circle) {
+                    hits += operation.grouped ? grid.hitTest(toCircle(operation), predicate)
+                                              : grid.hitTest(toCircle(operation));
+                } else {
+                    hits += operation.grouped ? grid.hitTest(toBox(operation), predicate)
+                                              : grid.hitTest(toBox(operation));
+                }
+                break;
+            case Operation::Type::Insert:
+            case Operation::Type::InsertIgnored: {
+                auto& target = operation.type == Operation::Type::Insert ? grid : ignoredGrid;
+                group = operation.collisionGroupId;
+                IndexedSubfeature feature(index, layer, layer, index, 0, group);
+                ++index;
+                if (operation.circle) {
+                    target.insert(std::move(feature), toCircle(operation));
+                } else {
+                    target.insert(std::move(feature), toBox(operation));
+                }
+                break;
+            }
+        }
+    }
+    return hits;
+}
+
+void GridIndex_Placement(benchmark::State& state) {
+    std::size_t hits = 0;
+    std::size_t operations = 0;
+    for (const auto& trace : traces()) {
+        operations += trace.operations.size();
+    }
+
+    for (auto _ : state) {
+        for (const auto& trace : traces()) {
+            CollisionGrid grid(trace.width, trace.height, 25);
+            CollisionGrid ignoredGrid(trace.width, trace.height, 25);
+            hits = replay(trace, grid, ignoredGrid);
+            benchmark::DoNotOptimize(grid);
+        }
+    }
+    state.counters["placements"] = static_cast<double>(traces().size());
+    state.counters["hits"] = static_cast<double>(hits);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * operations));
+}
+
+// Rendered symbol queries against the placed labels, as in CollisionIndex::queryRenderedSymbols
+void GridIndex_QueryWithBoxes(benchmark::State& state) {
+    if (traces().empty()) {
+        state.SkipWithError("No placement was recorded");
+        return;
+    }
+    const auto& trace = traces().back();
+    CollisionGrid grid(trace.width, trace.height, 25);
+    CollisionGrid ignoredGrid(trace.width, trace.height, 25);
+    replay(trace, grid, ignoredGrid);
+
+    std::size_t found = 0;
+    for (auto _ : state) {
+        for (float y = 0; y < trace.height; y += 50) {
+            for (float x = 0; x < trace.width; x += 50) {
+                found += grid.queryWithBoxes({{x, y}, {x + 60, y + 60}}).size();
+                found += ignoredGrid.queryWithBoxes({{x, y}, {x + 60, y + 60}}).size();
+            }
+        }
+    }
+    benchmark::DoNotOptimize(found);
+}
+
+} // namespace
+
+BENCHMARK(GridIndex_Placement);
+BENCHMARK(GridIndex_QueryWithBoxes);
@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/thread_pool.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Stand-in for decoding and laying out features, keeps a core busy for a few microseconds
+void burn(std::size_t iterations) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        hash = (hash ^ i) * 1099511628211ull;
+    }
+    benchmark::DoNotOptimize(hash);
+}
+
+// Synthetic tile parse: each tile is parsed by one task which then schedules
+// a task per layer, spread over a few map instances sharing the pool.
+void TileParseLoad(benchmark::State& state, ThreadedSchedulerBase::Mode mode) {
+    constexpr std::size_t tilesPerIteration = 256;
+    constexpr std::size_t layersPerTile = 8;
+    constexpr std::size_t maps = 4;
+
+    const auto threads = static_cast<std::size_t>(state.range(0));
+    std::shared_ptr<Scheduler> pool = std::make_shared<ParallelScheduler>(threads - 1, mode);
+    const std::vector<util::SimpleIdentity> tags(maps);
+
+    std::atomic<std::size_t> layers{0};
+    for (auto _ : state) {
+        for (std::size_t tile = 0; tile < tilesPerIteration; ++tile) {
+            const auto tag = tags[tile % maps];
+            pool->schedule(tag, [&, tag] {
+                burn(20000);
+                for (std::size_t layer = 0; layer < layersPerTile; ++layer) {
+                    pool->schedule(tag, [&] {
+                        burn(5000);
+                        layers++;
+                    });
+                }
+            });
+        }
+        for (const auto& tag : tags) {
+            pool->waitForEmpty(tag);
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * tilesPerIteration));
+    benchmark::DoNotOptimize(layers.load());
+}
+
+void ThreadPool_Shared(benchmark::State& state) {
+    TileParseLoad(state, ThreadedSchedulerBase::Mode::Shared);
+}
+
+void ThreadPool_WorkStealing(benchmark::State& state) {
+    TileParseLoad(state, ThreadedSchedulerBase::Mode::WorkStealing);
+}
+
+} // namespace
+
+BENCHMARK(ThreadPool_Shared)->RangeMultiplier(2)->Range(2, 32)->UseRealTime();
+BENCHMARK(ThreadPool_WorkStealing)->RangeMultiplier(2)->Range(2, 32)->UseRealTime();
@@ -56,6 +56,7 @@ list(APPEND
         SRC_FILES
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/attribute.cpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/attribute.hpp
+        ${PROJECT_SOURCE_DIR}/src/mbgl/gl/buffer_storage_extension.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/command_encoder.cpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/command_encoder.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/context.cpp
@@ -70,12 +71,16 @@ list(APPEND
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/enum.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/extension.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/framebuffer.hpp
+        ${PROJECT_SOURCE_DIR}/src/mbgl/gl/gpu_timer.cpp
+        ${PROJECT_SOURCE_DIR}/src/mbgl/gl/gpu_timer.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/index_buffer_resource.cpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/index_buffer_resource.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/object.cpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/object.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/offscreen_texture.cpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/offscreen_texture.hpp
+        ${PROJECT_SOURCE_DIR}/src/mbgl/gl/program_binary_cache.cpp
+        ${PROJECT_SOURCE_DIR}/src/mbgl/gl/program_binary_cache.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/render_pass.cpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/render_pass.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/renderbuffer_resource.cpp
@@ -148,5 +153,7 @@ list(APPEND SRC_FILES
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/layer_group_gl.cpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/texture2d.cpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/uniform_buffer_gl.cpp
+        ${PROJECT_SOURCE_DIR}/src/mbgl/gl/uniform_buffer_ring.cpp
+        ${PROJECT_SOURCE_DIR}/src/mbgl/gl/uniform_buffer_ring.hpp
         ${PROJECT_SOURCE_DIR}/src/mbgl/gl/vertex_attribute_gl.cpp
 )
@@ -77,6 +77,9 @@ public:
 
     ActorRef<std::decay_t<Object>> self() { return parent.self(); }
 
+    /// Set the priority of messages to this actor relative to other work on the same scheduler.
+    void setPriority(Scheduler::Priority priority) { parent.mailbox->setPriority(priority); }
+
 private:
     const std::shared_ptr<Scheduler> retainer;
     AspiringActor<Object> parent;
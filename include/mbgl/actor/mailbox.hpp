@@ -37,6 +37,10 @@ public:
 
     bool isOpen() const;
 
+    /// Set the priority used when scheduling this mailbox's messages. Only messages
+    /// scheduled after the change are affected.
+    void setPriority(Scheduler::Priority priority_) { priority = priority_; }
+
     void push(std::unique_ptr<Message>);
     void receive();
 
@@ -55,6 +59,7 @@ private:
     std::mutex pushingMutex;
 
     std::atomic<State> state{State::Idle};
+    std::atomic<Scheduler::Priority> priority{Scheduler::DefaultPriority};
     bool closed{false};
 
     std::mutex queueMutex;
@@ -47,6 +47,13 @@ public:
 
     const OptionalActorRef<Object>& self() { return selfRef; }
 
+    /// Set the priority of messages to the actor, synchronous objects have no queue to order.
+    void setPriority(Scheduler::Priority priority) {
+        if (actor) {
+            actor->setPriority(priority);
+        }
+    }
+
 private:
     class SyncObject {
     public:
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <mbgl/util/identity.hpp>
+#include <mbgl/util/thread_pool_size.hpp>
 
 #include <mapbox/std/weak.hpp>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <type_traits>
 
 namespace mbgl {
@@ -38,10 +41,28 @@ class Scheduler {
 public:
     virtual ~Scheduler() = default;
 
+    /// Relative urgency of a task, lower values run first.
+    using Priority = uint32_t;
+    static constexpr Priority DefaultPriority = 0;
+
     /// Enqueues a function for execution.
     virtual void schedule(std::function<void()>&&) = 0;
     virtual void schedule(const util::SimpleIdentity, std::function<void()>&&) = 0;
 
+    /// Enqueues a function for execution ahead of pending tasks with a higher `priority`
+    /// value. Tasks of equal priority run in the order they were scheduled. Schedulers
+    /// without priority support run it like any other task.
+    /// @param tag Owner of the task, or none for the scheduler itself
+    virtual void scheduleWithPriority(const std::optional<util::SimpleIdentity>& tag,
+                                      Priority,
+                                      std::function<void()>&& fn) {
+        if (tag) {
+            schedule(*tag, std::move(fn));
+        } else {
+            schedule(std::move(fn));
+        }
+    }
+
     /// Makes a weak pointer to this Scheduler.
     virtual mapbox::base::WeakPtr<Scheduler> makeWeakPtr() = 0;
     /// Enqueues a function for execution on the render thread owned by the given tag.
@@ -92,6 +113,18 @@ public:
     /// TODO : Rename to GetPool()
     [[nodiscard]] static std::shared_ptr<Scheduler> GetBackground();
 
+    /// Get the shared worker pool, making sure it runs at least as many
+    /// threads as `size` resolves to. If the pool does not exist yet it is
+    /// created with exactly that many threads; an existing pool is grown
+    /// but never shrunk, since other maps may depend on it.
+    [[nodiscard]] static std::shared_ptr<Scheduler> GetBackground(const ThreadPoolSize& size);
+
+    /// Get the shared pool for blocking I/O, such as file or database reads.
+    /// It is kept apart from the worker pool so that slow reads never occupy
+    /// threads needed for parsing and layout. Sizing follows the same rules
+    /// as `GetBackground(const ThreadPoolSize&)`.
+    [[nodiscard]] static std::shared_ptr<Scheduler> GetIO(const ThreadPoolSize& size = {});
+
     /// Get the *sequenced* scheduler for asynchronous tasks.
     /// Unlike the method above, the returned scheduler
     /// (once stored) represents a single thread, thus each
@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <mutex>
 #include <shared_mutex>
 
@@ -105,6 +106,20 @@ public:
         return stats;
     }
 
+    /// Enables measuring the GPU time of render passes and layer groups, reported in `RenderingStats`.
+    /// Has no effect if the backend or the device can't measure it.
+    virtual void setGPUTimingEnabled(bool) {}
+    virtual bool isGPUTimingEnabled() const { return false; }
+
+    /// Enables streaming the uniform buffers created from now on through a single, persistently mapped buffer.
+    /// Has no effect if the backend or the device doesn't support it.
+    virtual void setUniformBufferRingEnabled(bool) {}
+    virtual bool isUniformBufferRingEnabled() const { return false; }
+
+    /// Starts timing the GPU commands that follow, until the matching `endGPUTimer`. Timers may nest.
+    virtual void beginGPUTimer(GPUTimerType, [[maybe_unused]] std::string_view name) {}
+    virtual void endGPUTimer() {}
+
 #ifndef NDEBUG
     virtual void visualizeStencilBuffer() = 0;
     virtual void visualizeDepthBuffer(float depthRangeSize) = 0;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <map>
 #include <string>
 #include <memory>
 #include <mbgl/util/color.hpp>
@@ -14,6 +16,12 @@ class SymbolLayer;
 
 namespace gfx {
 
+/// What a GPU timer measures
+enum class GPUTimerType : uint8_t {
+    RenderPass,
+    LayerGroup,
+};
+
 struct RenderingStats {
     bool isZero() const;
 
@@ -89,6 +97,22 @@ struct RenderingStats {
     /// Number of stencil buffer updates
     int stencilUpdates = 0;
 
+    /// Total number of tile parse and layout passes abandoned because the tile was no longer needed
+    std::size_t abortedTileWork = 0;
+
+    /// Total number of symbols whose placement was carried over from the previous placement
+    std::size_t reusedSymbolPlacements = 0;
+    /// Total number of symbols that were collision tested during placement
+    std::size_t testedSymbolPlacements = 0;
+
+    /// GPU time of the most recent frame whose timings are available (seconds), when GPU timing is enabled.
+    /// GPU timings lag a few frames behind the other statistics.
+    double gpuFrameTime = 0.0;
+    /// GPU time of the same frame, by render pass (seconds)
+    std::map<std::string, double> gpuRenderPassTimes;
+    /// GPU time of the same frame, by layer group over all render passes (seconds)
+    std::map<std::string, double> gpuLayerGroupTimes;
+
     RenderingStats& operator+=(const RenderingStats&);
 
 #ifndef NDEBUG
@@ -403,6 +403,30 @@ public:
          ...);
     }
 
+    /// Predicts the properties `readDataDrivenPaintProperties` will turn into uniforms, without any tile data
+    /// @param evaluated Evaluated properties
+    /// @param propertiesAsUniforms [out] A set of string identities for the properties which will be constant, not
+    /// attributes.
+    /// @details Assumes that every property which is not constant has per-vertex values.
+    template <typename... DataDrivenPaintProperty, typename Evaluated>
+    static void getDataDrivenPropertiesAsUniforms(const Evaluated& evaluated,
+                                                  StringIDSetsPair& propertiesAsUniforms,
+                                                  const size_t firstDataDrivenAttrId) {
+        size_t dataDrivenAttrId = firstDataDrivenAttrId;
+        (
+            [&] {
+                const bool constant = isConstant<DataDrivenPaintProperty>(evaluated);
+                for (const auto& attributeName : DataDrivenPaintProperty::AttributeNames) {
+                    if (constant) {
+                        propertiesAsUniforms.first.emplace(attributeName);
+                        propertiesAsUniforms.second.emplace(dataDrivenAttrId);
+                    }
+                    dataDrivenAttrId++;
+                }
+            }(),
+            ...);
+    }
+
 protected:
     template <typename DataDrivenPaintProperty, typename Evaluated>
     static bool isConstant(const Evaluated& evaluated) noexcept {
@@ -5,6 +5,8 @@
 #include <mbgl/util/size.hpp>
 #include <mbgl/util/util.hpp>
 
+#include <string>
+
 namespace mbgl {
 
 class ProgramParameters;
@@ -26,6 +28,12 @@ public:
     /// One-time shader initialization
     void initShaders(gfx::ShaderRegistry&, const ProgramParameters& programParameters) override;
 
+    /// Stores linked shader programs in `directory` and loads them from there instead of
+    /// compiling them again, e.g. in later processes. Disabled by default or with an empty path.
+    /// Only affects programs created after the call, so it is best set before the first render.
+    void setProgramBinaryCacheDirectory(std::string directory);
+    const std::string& getProgramBinaryCacheDirectory() const { return programBinaryCacheDirectory; }
+
 protected:
     std::unique_ptr<gfx::Context> createContext() override;
 
@@ -56,6 +64,9 @@ public:
     void setFramebufferBinding(FramebufferID fbo);
     void setViewport(int32_t x, int32_t y, const Size&);
     void setScissorTest(int32_t, int32_t, uint32_t, uint32_t);
+
+private:
+    std::string programBinaryCacheDirectory;
 };
 
 } // namespace gl
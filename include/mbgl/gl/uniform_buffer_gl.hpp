@@ -4,14 +4,27 @@
 #include <mbgl/gl/types.hpp>
 #include <mbgl/gl/buffer_allocator.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
 namespace mbgl {
 namespace gl {
 
+class UniformBufferRing;
+
 class UniformBufferGL final : public gfx::UniformBuffer {
     UniformBufferGL(const UniformBufferGL&);
 
 public:
-    UniformBufferGL(Context& context, const void* data, std::size_t size_, IBufferAllocator& allocator);
+    /// @param ring If set, the contents are kept on the CPU and copied into the ring each frame they are bound,
+    /// instead of updating a buffer of their own
+    UniformBufferGL(Context& context,
+                    const void* data,
+                    std::size_t size_,
+                    IBufferAllocator& allocator,
+                    UniformBufferRing* ring = nullptr);
     ~UniformBufferGL() override;
 
     UniformBufferGL(UniformBufferGL&& rhs) noexcept;
@@ -26,7 +39,13 @@ public:
     // gfx::UniformBuffer
     void update(const void* data, std::size_t dataSize) override;
 
+    /// Binds the contents to the uniform block binding point `index`
+    void bind(std::size_t index) const;
+
 private:
+    /// Updates the buffer of its own of a buffer streamed through the ring, for when the ring is full
+    void uploadLocal() const;
+
     Context& context;
 
     // unique id used for debugging and profiling purposes
@@ -38,9 +57,18 @@ private:
 
     // If the requested UBO size is too large for the allocator, the UBO will manage its own allocation
     bool isManagedAllocation = false;
-    BufferID localID;
+    mutable BufferID localID = 0;
     gl::RelocatableBuffer<UniformBufferGL> managedBuffer;
 
+    UniformBufferRing* ring = nullptr;
+    // CPU-side contents of a buffer streamed through the ring
+    std::vector<std::byte> streamedContents;
+    // The frame and offset of the last copy into the ring
+    mutable std::optional<std::uint64_t> ringFrame;
+    mutable std::size_t ringOffset = 0;
+    // Whether `localID` holds the current contents
+    mutable bool localCurrent = false;
+
     friend class UniformBufferArrayGL;
 };
 
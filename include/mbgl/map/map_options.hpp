@@ -3,8 +3,10 @@
 #include <mbgl/map/mode.hpp>
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/size.hpp>
+#include <mbgl/util/thread_pool_size.hpp>
 
 #include <memory>
+#include <optional>
 
 namespace mbgl {
 
@@ -149,6 +151,62 @@ public:
      */
     bool fastPFOREnabled() const;
 
+    /**
+     * @brief Sets whether symbol placement may run on the worker threads.
+     * Only takes effect when cross-source collisions are disabled: each
+     * source is then an independent collision group and the groups are placed
+     * concurrently, with the same result as serial placement. By default, it
+     * is set to false.
+     *
+     * @param enable true to enable, false to disable
+     * @return MapOptions for chaining options together.
+     */
+    MapOptions& withParallelPlacement(bool enable);
+
+    /**
+     * @brief Gets the previously set (or default) parallel placement value.
+     *
+     * @return true if enabled, false otherwise.
+     */
+    bool parallelPlacement() const;
+
+    /**
+     * @brief Sets whether symbol placement may start from the previous
+     * placement. When the camera only panned, without zooming, rotating or
+     * tilting, symbols whose surroundings did not change keep their previous
+     * result and only the others are collision tested again. Has no effect in
+     * static map modes. By default, it is set to false.
+     *
+     * @param enable true to enable, false to disable
+     * @return MapOptions for chaining options together.
+     */
+    MapOptions& withIncrementalPlacement(bool enable);
+
+    /**
+     * @brief Gets the previously set (or default) incremental placement value.
+     *
+     * @return true if enabled, false otherwise.
+     */
+    bool incrementalPlacement() const;
+
+    /**
+     * @brief Sets the number of worker threads used for tile parsing and
+     * layout. Workers are shared by all maps in the process, so this grows the
+     * shared pool if it is smaller but never shrinks it. By default the pool
+     * is left as it is.
+     *
+     * @param size Sizing policy for the worker pool.
+     * @return MapOptions for chaining options together.
+     */
+    MapOptions& withWorkerThreadPoolSize(ThreadPoolSize size);
+
+    /**
+     * @brief Gets the previously set worker pool size, if any.
+     *
+     * @return Worker pool sizing policy.
+     */
+    std::optional<ThreadPoolSize> workerThreadPoolSize() const;
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl_;
@@ -15,6 +15,15 @@ DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_THREAD_PRIORITY_FILE, thread_priority_file
 DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_THREAD_PRIORITY_NETWORK, thread_priority_network);
 DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_THREAD_PRIORITY_DATABASE, thread_priority_database);
 
+// The value for EXPERIMENTAL_WORKER_WORK_STEALING must be a bool. When true, the
+// background worker pool uses per-thread work-stealing deques instead of shared queues.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_WORKER_WORK_STEALING, worker_work_stealing);
+
+// The value for EXPERIMENTAL_SHARED_TILE_DATA_CACHE_SIZE must be an unsigned integer. When
+// non-zero, decoded vector tile data is shared between all maps in the process that load
+// the same tile from the same source, and up to this many tiles are kept.
+DECLARE_MAPLIBRE_SETTING(EXPERIMENTAL_SHARED_TILE_DATA_CACHE_SIZE, shared_tile_data_cache_size);
+
 /// Settings class provides non-persistent, in-process key-value storage.
 class Settings final {
 public:
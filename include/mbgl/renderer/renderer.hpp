@@ -1,7 +1,9 @@
 #pragma once
 
 #include <mbgl/renderer/query.hpp>
+#include <mbgl/renderer/tile_cache_stats.hpp>
 #include <mbgl/annotation/annotation.hpp>
+#include <mbgl/util/chrono.hpp>
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/geojson.hpp>
 
@@ -90,6 +92,39 @@ public:
                             const std::optional<std::string>& featureID,
                             const std::optional<std::string>& stateKey);
 
+    /**
+     * @brief Creates the shaders the style's layers are expected to need ahead of the frames
+     * that draw them, spending up to `budget` after each frame. Frames keep being requested
+     * until every expected shader exists.
+     *
+     * Zero (the default) creates shaders only when a frame first needs them.
+     */
+    void setShaderWarmUpBudget(Duration budget);
+    Duration getShaderWarmUpBudget() const;
+
+    /// Number of shaders waiting to be created ahead of time
+    std::size_t getPendingShaderWarmUpCount() const;
+
+    /**
+     * @brief Measures the GPU time of each render pass and layer group, reported in the
+     * `gfx::RenderingStats` passed to `RendererObserver::onDidFinishRenderingFrame`.
+     *
+     * The timings arrive a few frames late, so that reading them never waits for the GPU.
+     * Has no effect if the device can't measure GPU time. Disabled by default.
+     */
+    void setGPUTimingEnabled(bool);
+    bool isGPUTimingEnabled() const;
+
+    /**
+     * @brief Streams uniform data through one persistently mapped buffer split per frame in flight,
+     * instead of updating a buffer for each drawable.
+     *
+     * Applies to the uniform buffers created from the next frame on. Has no effect if the device
+     * doesn't support buffer storage. Disabled by default.
+     */
+    void setUniformBufferRingEnabled(bool);
+    bool isUniformBufferRingEnabled() const;
+
     // Debug
     void dumpDebugLogs();
 
@@ -114,6 +149,17 @@ public:
     // Memory
     void setTileCacheEnabled(bool);
     bool getTileCacheEnabled() const;
+
+    /**
+     * @brief Limits the CPU memory held by each source's tile cache, as estimated from the
+     * tiles' buckets, feature indexes and images. GPU buffers and textures are not counted.
+     * Zero (the default) limits caches by tile count only.
+     */
+    void setTileCacheMaxCPUBytes(std::size_t);
+    std::size_t getTileCacheMaxCPUBytes() const;
+
+    /// Hit, miss and eviction counters summed over all sources' tile caches
+    TileCacheStats getTileCacheStats() const;
     void reduceMemoryUse();
     void clearData();
 
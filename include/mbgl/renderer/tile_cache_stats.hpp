@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mbgl {
+
+/// Counters for the caches that keep recently used tiles around after they leave the viewport.
+struct TileCacheStats {
+    /// Number of times a tile was taken from the cache instead of being loaded again
+    uint64_t hits = 0;
+    /// Number of times a tile was looked up but had to be created
+    uint64_t misses = 0;
+    /// Number of tiles dropped to stay within the count or byte budget
+    uint64_t evictions = 0;
+    /// Number of tiles currently held
+    std::size_t tiles = 0;
+    /// Approximate CPU memory held by the cached tiles, in bytes
+    std::size_t cpuBytes = 0;
+
+    TileCacheStats& operator+=(const TileCacheStats& other) {
+        hits += other.hits;
+        misses += other.misses;
+        evictions += other.evictions;
+        tiles += other.tiles;
+        cpuBytes += other.cpuBytes;
+        return *this;
+    }
+};
+
+} // namespace mbgl
@@ -2,6 +2,7 @@
 
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/offline.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/expected.hpp>
 
 namespace mbgl {
@@ -62,6 +63,23 @@ public:
      */
     virtual void runPackDatabaseAutomatically(bool);
 
+    /**
+     * Sets the codec used to store new resources, optionally with a shared
+     * dictionary built by util::trainDictionary() from resources of the same
+     * kind, e.g. tiles of one tileset.
+     *
+     * Each stored resource records its codec, so existing data remains
+     * readable. Dictionaries are stored in the database, so resources
+     * compressed with one stay readable after a restart.
+     *
+     * When the operation is complete or encounters an error, the given callback
+     * will be executed on the database thread; it is the responsibility of the
+     * SDK bindings to re-execute a user-provided callback on the main thread.
+     */
+    virtual void setCompression(util::Codec,
+                                std::shared_ptr<const std::string> dictionary,
+                                std::function<void(std::exception_ptr)> callback);
+
     // Ambient cache
 
     /**
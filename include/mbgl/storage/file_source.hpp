@@ -112,10 +112,25 @@ constexpr const char* API_BASE_URL_KEY = "api-base-url";
 /// type: unsigned
 constexpr const char* MAX_CONCURRENT_REQUESTS_KEY = "max-concurrent-requests";
 
+/// Property name to get the number of network transfers started.
+/// type: unsigned, read-only
+constexpr const char* TRANSFER_COUNT_KEY = "transfer-count";
+
+/// Property name to get the number of requests that shared an identical
+/// transfer already in flight instead of starting their own.
+/// type: unsigned, read-only
+constexpr const char* COALESCED_REQUEST_COUNT_KEY = "coalesced-request-count";
+
 // Properties that may be supported by database file sources:
 
 /// Property to set database mode. When set, database opens in read-only mode;
 /// database opens in read-write-create mode otherwise. type: bool
 constexpr const char* READ_ONLY_MODE_KEY = "read-only-mode";
 
+/// Property to set the database journal mode. When set, the database uses a
+/// write-ahead log and commits ambient cache writes in batches, so that reads
+/// are not held up by a sync per tile; the default rollback journal is used
+/// otherwise. type: bool
+constexpr const char* WRITE_AHEAD_LOG_MODE_KEY = "write-ahead-log-mode";
+
 } // namespace mbgl
@@ -23,7 +23,8 @@ public:
         Image
     };
 
-    enum class Priority : bool {
+    // Lower values are served first
+    enum class Priority : uint8_t {
         Regular,
         Low
     };
@@ -100,7 +101,7 @@ public:
     std::optional<Timestamp> priorModified = std::nullopt;
     std::optional<Timestamp> priorExpires = std::nullopt;
     std::optional<std::string> priorEtag = std::nullopt;
-    std::shared_ptr<const std::string> priorData;
+    SharedBuffer priorData;
     Duration minimumUpdateInterval{Duration::zero()};
     StoragePolicy storagePolicy{StoragePolicy::Permanent};
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/util/chrono.hpp>
+#include <mbgl/util/shared_buffer.hpp>
 
 #include <optional>
 #include <string>
@@ -31,7 +32,7 @@ public:
     bool mustRevalidate = false;
 
     // The actual data of the response. Present only for non-error, non-notModified responses.
-    std::shared_ptr<const std::string> data;
+    SharedBuffer data;
 
     std::optional<Timestamp> modified;
     std::optional<Timestamp> expires;
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/thread_pool_size.hpp>
+
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -52,6 +56,118 @@ public:
      */
     const std::string& version() const;
 
+    /**
+     * @brief Sets the size of the shared pool that file sources use for
+     * blocking reads. The pool is separate from the worker pool used for
+     * parsing, so slow storage never delays layout. An existing pool is grown
+     * but never shrunk.
+     *
+     * @param size Sizing policy for the I/O pool.
+     * @return ClientOptions for chaining options together.
+     */
+    ClientOptions& withIOThreadPoolSize(ThreadPoolSize size);
+
+    /**
+     * @brief Gets the previously set (or default) I/O pool size.
+     *
+     * @return I/O pool sizing policy.
+     */
+    const ThreadPoolSize& ioThreadPoolSize() const;
+
+    /**
+     * @brief Sets whether HTTP requests to the same host may be multiplexed
+     * over a single HTTP/2 connection. When enabled, new requests wait for an
+     * existing connection to the host instead of opening another one.
+     * Enabled by default.
+     *
+     * @param enabled True to negotiate HTTP/2 and multiplex requests.
+     * @return ClientOptions for chaining options together.
+     */
+    ClientOptions& withHTTPMultiplexing(bool enabled);
+
+    /**
+     * @brief Gets the previously set (or default) HTTP multiplexing setting.
+     *
+     * @return true if requests may be multiplexed.
+     */
+    bool httpMultiplexing() const;
+
+    /**
+     * @brief Sets whether plain `http://` requests speak HTTP/2 from the start
+     * ("prior knowledge"), so that they can be multiplexed too. HTTP/2 is
+     * otherwise only negotiated over TLS, and cleartext requests use HTTP/1.1
+     * because servers that don't speak HTTP/2 would reject the connection.
+     * Only enable this for servers known to support cleartext HTTP/2 (h2c).
+     * Has no effect unless multiplexing is enabled. Disabled by default.
+     *
+     * @param enabled True to use HTTP/2 for cleartext requests.
+     * @return ClientOptions for chaining options together.
+     */
+    ClientOptions& withHTTP2PriorKnowledge(bool enabled);
+
+    /**
+     * @brief Gets the previously set (or default) cleartext HTTP/2 setting.
+     *
+     * @return true if cleartext requests use HTTP/2.
+     */
+    bool http2PriorKnowledge() const;
+
+    /**
+     * @brief Sets the maximum number of connections opened to a single host.
+     * Requests above the limit are queued until a connection becomes
+     * available, or are multiplexed over an open one.
+     *
+     * @param connections Connection limit, zero for no limit (the default).
+     * @return ClientOptions for chaining options together.
+     */
+    ClientOptions& withMaxHostConnections(std::size_t connections);
+
+    /**
+     * @brief Gets the previously set (or default) per-host connection limit.
+     *
+     * @return connection limit, zero if unlimited.
+     */
+    std::size_t maxHostConnections() const;
+
+    /**
+     * @brief Sets the maximum number of connections opened across all hosts.
+     *
+     * @param connections Connection limit, zero for no limit (the default).
+     * @return ClientOptions for chaining options together.
+     */
+    ClientOptions& withMaxTotalConnections(std::size_t connections);
+
+    /**
+     * @brief Gets the previously set (or default) total connection limit.
+     *
+     * @return connection limit, zero if unlimited.
+     */
+    std::size_t maxTotalConnections() const;
+
+    /**
+     * @brief Enables TCP keep-alive probes on HTTP connections, so idle
+     * connections kept for reuse are not silently dropped by middleboxes.
+     *
+     * @param idle Idle time before the first probe, zero disables keep-alive (the default).
+     * @param interval Time between probes.
+     * @return ClientOptions for chaining options together.
+     */
+    ClientOptions& withTCPKeepAlive(Seconds idle, Seconds interval);
+
+    /**
+     * @brief Gets the previously set (or default) keep-alive idle time.
+     *
+     * @return idle time, zero if keep-alive is disabled.
+     */
+    Seconds tcpKeepAliveIdle() const;
+
+    /**
+     * @brief Gets the previously set (or default) keep-alive probe interval.
+     *
+     * @return probe interval.
+     */
+    Seconds tcpKeepAliveInterval() const;
+
 private:
     ClientOptions(const ClientOptions&);
 
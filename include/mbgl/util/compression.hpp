@@ -1,7 +1,10 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace mbgl {
 namespace util {
@@ -13,11 +16,37 @@ enum CompressionFormat {
     DETECT = 15 + 32
 };
 
-bool is_compressed(const std::string&);
-std::string compress(const std::string& raw, int windowBits = CompressionFormat::ZLIB);
-std::string decompress(const std::string& raw, int windowBits = CompressionFormat::DETECT);
+bool is_compressed(std::string_view);
+std::string compress(std::string_view raw, int windowBits = CompressionFormat::ZLIB);
+std::string decompress(std::string_view raw, int windowBits = CompressionFormat::DETECT);
 
 std::uint32_t crc32(const void* raw, size_t size) noexcept;
 
+/// Codecs for stored data. The values are persisted, e.g. by the offline
+/// database, and must not be changed.
+enum class Codec : std::uint8_t {
+    None = 0,
+    Zlib = 1,
+    /// Only available when built with MLN_WITH_ZSTD.
+    Zstd = 2,
+};
+
+/// Returns the dictionary with the given ID, or nullptr if it is not known.
+using DictionaryLookup = std::function<const std::string*(Codec, std::uint32_t id)>;
+
+bool isAvailable(Codec);
+
+/// Compresses `raw`, optionally primed with a shared dictionary. The
+/// compressed data records the ID of the dictionary it needs.
+std::string compress(std::string_view raw, Codec, const std::string* dictionary = nullptr);
+std::string decompress(const std::string& raw, Codec, const DictionaryLookup& = {});
+
+/// ID under which `decompress` asks for the dictionary.
+std::uint32_t dictionaryID(Codec, const std::string& dictionary);
+
+/// Builds a dictionary of at most `maxSize` bytes from content shared by the
+/// samples, e.g. tiles of the same tileset.
+std::string trainDictionary(Codec, const std::vector<std::string>& samples, std::size_t maxSize);
+
 } // namespace util
 } // namespace mbgl
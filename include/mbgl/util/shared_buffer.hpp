@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace mbgl {
+
+// An immutable, refcounted range of bytes. The bytes belong to an owner handle,
+// such as a heap allocated string, a memory-mapped file or a buffer filled by
+// a network library, and stay valid as long as any buffer referring to them
+// exists. Copies and slices share the owner instead of copying the bytes.
+//
+// Pointer-like access (`if (buffer)`, `*buffer`, `buffer->size()`) mirrors the
+// std::shared_ptr<const std::string> this replaces in Response.
+class SharedBuffer {
+public:
+    SharedBuffer() = default;
+    SharedBuffer(std::nullptr_t) {}
+
+    // Adopts the string without copying it.
+    SharedBuffer(std::shared_ptr<const std::string>);
+    // Same for std::make_shared<std::string>() or std::make_unique<std::string>().
+    template <typename String,
+              typename = std::enable_if_t<std::is_convertible_v<String, std::shared_ptr<const std::string>>>>
+    SharedBuffer(String&& string)
+        : SharedBuffer(std::shared_ptr<const std::string>(std::forward<String>(string))) {}
+
+    // Refers to `size` bytes at `data`, which `owner` keeps alive.
+    SharedBuffer(const char* data, std::size_t size, std::shared_ptr<const void> owner);
+
+    // Returns `length` bytes starting at `offset`, sharing the owner. The range
+    // is clamped to the end of the buffer.
+    SharedBuffer slice(std::size_t offset, std::size_t length = std::string_view::npos) const;
+
+    // Returns the bytes as a string. This is free when the buffer spans a whole
+    // adopted string, and copies the bytes otherwise.
+    std::shared_ptr<const std::string> string() const;
+
+    const char* data() const { return bytes.data(); }
+    std::size_t size() const { return bytes.size(); }
+    bool empty() const { return bytes.empty(); }
+    std::string_view view() const { return bytes; }
+
+    explicit operator bool() const { return owner != nullptr; }
+    const std::string_view& operator*() const { return bytes; }
+    const std::string_view* operator->() const { return &bytes; }
+
+    // Buffers compare equal when they refer to the same bytes.
+    friend bool operator==(const SharedBuffer& lhs, const SharedBuffer& rhs) {
+        return lhs.owner == rhs.owner && lhs.bytes.data() == rhs.bytes.data() && lhs.bytes.size() == rhs.bytes.size();
+    }
+    friend bool operator==(const SharedBuffer& buffer, std::nullptr_t) { return !buffer; }
+
+private:
+    std::string_view bytes;
+    std::shared_ptr<const void> owner;
+    // Set when `owner` is a std::string that `bytes` spans completely.
+    bool wholeString = false;
+};
+
+} // namespace mbgl
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mbgl {
+
+/**
+ * @brief Describes how many threads a worker pool should run.
+ *
+ * The policy is resolved into a concrete count when a pool is created or
+ * grown, so a `ThreadPoolSize` can be configured before the environment
+ * (cores, container limits) is known.
+ */
+class ThreadPoolSize final {
+public:
+    enum class Policy : uint8_t {
+        /// A fixed number of threads, regardless of the hardware
+        Fixed,
+        /// One thread per hardware thread reported by the OS
+        HardwareConcurrency,
+        /// One thread per CPU granted to the process by its CPU affinity mask and,
+        /// on Linux, the cgroup CPU quota. Falls back to `HardwareConcurrency`.
+        CPUQuota,
+    };
+
+    /**
+     * @brief Constructs the default size, four threads.
+     */
+    ThreadPoolSize();
+
+    /**
+     * @brief A pool with exactly `threads` threads.
+     *
+     * @param threads Number of threads, at least one is always used.
+     */
+    static ThreadPoolSize fixed(std::size_t threads);
+
+    /**
+     * @brief A pool sized to the hardware concurrency.
+     *
+     * @param reserved Number of hardware threads to leave for other work, e.g. the render thread.
+     * @param maxThreads Upper bound, zero for no limit.
+     */
+    static ThreadPoolSize hardwareConcurrency(std::size_t reserved = 0, std::size_t maxThreads = 0);
+
+    /**
+     * @brief A pool sized to the CPUs this process may actually use.
+     *
+     * @param reserved Number of CPUs to leave for other work, e.g. the render thread.
+     * @param maxThreads Upper bound, zero for no limit.
+     */
+    static ThreadPoolSize cpuQuota(std::size_t reserved = 0, std::size_t maxThreads = 0);
+
+    Policy policy() const { return policy_; }
+
+    /**
+     * @brief Resolves the policy against the current environment.
+     *
+     * @return Number of threads, always at least one.
+     */
+    std::size_t threadCount() const;
+
+    bool operator==(const ThreadPoolSize&) const = default;
+
+private:
+    ThreadPoolSize(Policy, std::size_t threads, std::size_t reserved, std::size_t maxThreads);
+
+    Policy policy_;
+    std::size_t threads_;
+    std::size_t reserved_;
+    std::size_t maxThreads_;
+};
+
+} // namespace mbgl
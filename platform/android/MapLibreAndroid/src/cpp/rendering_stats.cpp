@@ -53,6 +53,9 @@ void RenderingStats::Update(jni::JNIEnv& env,
     SetField(memUniformBuffers, jni::jint);
     SetField(stencilClears, jni::jint);
     SetField(stencilUpdates, jni::jint);
+    SetField(abortedTileWork, jni::jlong);
+    SetField(reusedSymbolPlacements, jni::jlong);
+    SetField(testedSymbolPlacements, jni::jlong);
 
 #undef SetField
 }
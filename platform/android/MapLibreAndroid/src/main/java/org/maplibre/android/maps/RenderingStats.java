@@ -72,4 +72,10 @@ public class RenderingStats {
   public int stencilClears = 0;
   /// Number of stencil buffer updates
   public int stencilUpdates = 0;
+  /// Total number of tile parse and layout passes abandoned because the tile was no longer needed
+  public long abortedTileWork = 0;
+  /// Total number of symbols whose placement was carried over from the previous placement
+  public long reusedSymbolPlacements = 0;
+  /// Total number of symbols that were collision tested during placement
+  public long testedSymbolPlacements = 0;
 }
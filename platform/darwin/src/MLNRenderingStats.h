@@ -78,6 +78,12 @@ MLN_EXPORT
 @property (readonly) int stencilClears;
 /// Number of stencil buffer updates
 @property (readonly) int stencilUpdates;
+/// Total number of tile parse and layout passes abandoned because the tile was no longer needed
+@property (readonly) unsigned long abortedTileWork;
+/// Total number of symbols whose placement was carried over from the previous placement
+@property (readonly) unsigned long reusedSymbolPlacements;
+/// Total number of symbols that were collision tested during placement
+@property (readonly) unsigned long testedSymbolPlacements;
 @end
 
 NS_ASSUME_NONNULL_END
@@ -32,6 +32,9 @@
   _memUniformBuffers = stats.memUniformBuffers;
   _stencilClears = stats.stencilClears;
   _stencilUpdates = stats.stencilUpdates;
+  _abortedTileWork = stats.abortedTileWork;
+  _reusedSymbolPlacements = stats.reusedSymbolPlacements;
+  _testedSymbolPlacements = stats.testedSymbolPlacements;
 }
 
 @end
@@ -670,7 +670,7 @@
   req = fs->request(resource, [&](mbgl::Response res) {
     req.reset();
     XCTAssertFalse(res.error.get(), @"Request should not return an error");
-    XCTAssertTrue(res.data.get(), @"Request should return data");
+    XCTAssertTrue(res.data, @"Request should return data");
     XCTAssertEqual("{\"api\":\"mapbox\"}", *res.data, @"Request did not return expected data");
     CFRunLoopStop(CFRunLoopGetCurrent());
   });
@@ -836,7 +836,7 @@
         const mbgl::Resource resource{mbgl::Resource::Unknown, "https://api.mapbox.com/some/thing"};
         req = fs->request(resource, [&](mbgl::Response res) {
           XCTAssertFalse(res.error.get(), @"Request should not return an error");
-          XCTAssertTrue(res.data.get(), @"Request should return data");
+          XCTAssertTrue(res.data, @"Request should return data");
           XCTAssertFalse(res.modified, @"Request should not have a modification timestamp");
           XCTAssertFalse(res.expires, @"Request should not have an expiration timestamp");
           XCTAssertFalse(res.etag, @"Request should not have an entity tag");
@@ -874,7 +874,7 @@
         req = fs->request(resource, [&, tNow = now.timeIntervalSince1970,
                                      tFuture = future.timeIntervalSince1970](mbgl::Response res) {
           XCTAssertFalse(res.error.get(), @"Request should not return an error");
-          XCTAssertTrue(res.data.get(), @"Request should return data");
+          XCTAssertTrue(res.data, @"Request should return data");
           XCTAssertTrue(res.modified, @"Request should have a modification timestamp");
           XCTAssertEqual(MLNTimeIntervalFromDuration(res.modified->time_since_epoch()), floor(tNow),
                          @"Modification timestamp should roundtrip");
@@ -3,6 +3,8 @@
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/offline.hpp>
 #include <mbgl/util/tile_server_options.hpp>
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/exception.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/mapbox.hpp>
@@ -12,13 +14,16 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <optional>
+#include <vector>
 
 namespace mapbox {
 namespace sqlite {
 class Database;
 class Statement;
 class Query;
+class Transaction;
 class Exception;
 } // namespace sqlite
 } // namespace mapbox
@@ -37,6 +42,17 @@ struct MapboxTileLimitExceededException : util::Exception {
         : util::Exception("Mapbox tile limit exceeded") {}
 };
 
+// Download progress of a tileset: every tile of the region up to and including the
+// cursor tile, in tile cover order, is stored and linked to the region.
+struct OfflineRegionTileCursor {
+    std::string urlTemplate;
+    uint8_t pixelRatio;
+    uint8_t z;
+    // Index of the cursor tile in the tile cover of zoom level `z`. Tile coordinates
+    // don't follow cover order, e.g. where the cover wraps around the antimeridian.
+    uint64_t position;
+};
+
 class OfflineDatabase {
 public:
     OfflineDatabase(std::string path, const TileServerOptions& options);
@@ -79,6 +95,13 @@ public:
     // Return value is (response, stored size)
     std::optional<std::pair<Response, uint64_t>> getRegionResource(const Resource&);
     std::optional<int64_t> hasRegionResource(const Resource&);
+    // Batched `hasRegionResource`; tiles are looked up with one range query per tileset and zoom level.
+    std::vector<std::optional<int64_t>> hasRegionResources(const std::vector<Resource>&);
+
+    std::optional<OfflineRegionTileCursor> getRegionTileCursor(int64_t regionID, const std::string& urlTemplate);
+    void setRegionTileCursor(int64_t regionID, const OfflineRegionTileCursor&);
+    // Return value is (count, size) of the region tiles of the cursor's tileset below the cursor's zoom level
+    std::pair<int64_t, int64_t> getRegionTileCountAndSize(int64_t regionID, const OfflineRegionTileCursor&);
     uint64_t putRegionResource(int64_t regionID, const Resource&, const Response&);
     void putRegionResources(int64_t regionID, const std::list<std::tuple<Resource, Response>>&, OfflineRegionStatus&);
 
@@ -95,6 +118,37 @@ public:
     std::exception_ptr pack();
     void runPackDatabaseAutomatically(bool autopack_) { autopack = autopack_; }
 
+    struct WriteBatching {
+        // Commit once this many ambient cache writes are pending.
+        std::size_t maxPendingWrites = 64;
+        // Commit once the oldest pending write is older than this.
+        Duration maxDelay = std::chrono::milliseconds(500);
+    };
+
+    // Switches the database to `journal_mode = WAL` and `synchronous = NORMAL`
+    // and groups ambient cache put() calls into a single transaction, which is
+    // committed when either limit is reached or flushPendingWrites() is called.
+    // Other connections keep reading the last committed state in the meantime,
+    // while get() on this object already sees the pending writes. Region writes
+    // and maintenance operations commit pending writes first. A failing put()
+    // doesn't lose the other writes of its batch. Passing
+    // std::nullopt commits pending writes and restores the rollback journal.
+    void setWriteBatching(std::optional<WriteBatching>);
+    const std::optional<WriteBatching>& getWriteBatching() const { return writeBatching; }
+
+    void flushPendingWrites();
+    bool hasPendingWrites() const { return pendingWrites != nullptr; }
+
+    // Sets the codec, and optionally a dictionary from util::trainDictionary(),
+    // used for new entries. The default is zlib without a dictionary. Each row
+    // records its codec, so existing entries stay readable. Dictionaries are
+    // stored in the database and registered again when it is opened.
+    std::exception_ptr setCompression(util::Codec, std::shared_ptr<const std::string> dictionary = nullptr);
+
+    // Registers and stores a dictionary for reading entries, e.g. ones that
+    // were written elsewhere, without using it for new ones.
+    void addCompressionDictionary(util::Codec, std::shared_ptr<const std::string> dictionary);
+
     void reopenDatabaseReadOnly(bool readOnly);
 
     // Builds the offline-cache key for a resource. Exposed for testing.
@@ -115,20 +169,27 @@ private:
     void migrateToVersion5();
     void migrateToVersion3();
     void migrateToVersion6();
+    void migrateToVersion7();
+    void migrateToVersion8();
     void cleanup();
     bool disabled();
     void vacuum();
     void checkFlags();
+    void applyJournalMode();
+    void commitPendingWrites();
+    void discardPendingWrites();
+    void replayPendingWrites();
 
     mapbox::sqlite::Statement& getStatement(const char*);
 
     std::optional<std::pair<Response, uint64_t>> getTile(const Resource::TileData&);
     std::optional<int64_t> hasTile(const Resource::TileData&);
-    bool putTile(const Resource::TileData&, const Response&, const std::string&, bool compressed);
+    void hasTiles(const std::vector<Resource>&, std::vector<std::optional<int64_t>>&);
+    bool putTile(const Resource::TileData&, const Response&, std::string_view, util::Codec);
 
     std::optional<std::pair<Response, uint64_t>> getResource(const Resource&);
     std::optional<int64_t> hasResource(const Resource&);
-    bool putResource(const Resource&, const Response&, const std::string&, bool compressed);
+    bool putResource(const Resource&, const Response&, std::string_view, util::Codec);
 
     uint64_t putRegionResourceInternal(int64_t regionID, const Resource&, const Response&);
 
@@ -189,6 +250,23 @@ private:
 
     bool autopack = true;
     bool readOnly = false;
+
+    struct Compression {
+        util::Codec codec = util::Codec::Zlib;
+        std::shared_ptr<const std::string> dictionary;
+    };
+    Compression compression;
+    std::map<std::pair<util::Codec, uint32_t>, std::shared_ptr<const std::string>> compressionDictionaries;
+    util::DictionaryLookup dictionaryLookup() const;
+    void registerCompressionDictionary(util::Codec, std::shared_ptr<const std::string> dictionary);
+    void storeCompressionDictionary(util::Codec, uint32_t id, const std::string& dictionary);
+    void loadCompressionDictionaries();
+
+    std::optional<WriteBatching> writeBatching;
+    std::unique_ptr<mapbox::sqlite::Transaction> pendingWrites;
+    // The puts of the open batch, replayed if a later put in the batch fails.
+    std::vector<std::pair<Resource, Response>> pendingPuts;
+    TimePoint pendingWritesStarted;
 };
 
 } // namespace mbgl
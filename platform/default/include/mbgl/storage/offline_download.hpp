@@ -2,16 +2,20 @@
 
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/offline.hpp>
+#include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/resource.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/tileset.hpp>
 
 #include <list>
 #include <unordered_set>
 #include <memory>
 #include <deque>
+#include <optional>
+#include <vector>
 
 namespace mbgl {
 
-class OfflineDatabase;
 class FileSource;
 class AsyncRequest;
 class Response;
@@ -21,6 +25,10 @@ namespace style {
 class Parser;
 } // namespace style
 
+namespace util {
+class TileCover;
+} // namespace util
+
 /**
  * Coordinates the request and storage of all resources for an offline region.
 
@@ -49,6 +57,30 @@ private:
      */
     void ensureResource(Resource&&, std::function<void(Response)> = {});
 
+    /*
+     * Request a resource that is known to be missing from the database and queue
+     * the response for batched insertion. Tiles pass the chunk they were enumerated
+     * in, so that the download cursor can advance once the whole chunk is stored.
+     */
+    void requestResource(Resource&&, std::function<void(Response)> = {}, std::optional<uint64_t> tileChunk = {});
+
+    /*
+     * Enumerate the next chunk of tiles and look all of them up in the database
+     * with a single batched query. Tiles already stored are marked as used, the
+     * rest are queued in `tilesToFetch`.
+     */
+    void checkTiles();
+    // Returns up to `count` tiles of a single tileset, and the cursor of the last one in `last`
+    std::vector<Resource> nextTiles(std::size_t count, OfflineRegionTileCursor& last);
+    bool hasQueuedResources() const;
+
+    /*
+     * Persist the last tile of every completed chunk as the download cursor of its
+     * tileset, so that a later download can skip everything up to that tile.
+     * Must only be called when the response buffer has been flushed.
+     */
+    void saveTileCursors();
+
     void onMapboxTileCountLimitExceeded();
 
     int64_t id;
@@ -64,6 +96,38 @@ private:
     std::list<Resource> resourcesToBeMarkedAsUsed;
     std::list<std::tuple<Resource, Response>> buffer;
 
+    // Tilesets whose tiles have not all been enumerated yet. Tiles are pulled
+    // from the cover in chunks, only when `tilesToFetch` runs low, so memory
+    // use does not grow with the size of the region.
+    struct TileSource {
+        std::string urlTemplate;
+        Tileset::Scheme scheme;
+        uint8_t z;
+        uint8_t maxZ;
+        // Position in `cover` of the next tile
+        uint64_t position;
+        // Tiles of the first cover up to and including this position were stored by an earlier download
+        std::optional<uint64_t> resumeAfter;
+        std::unique_ptr<util::TileCover> cover;
+    };
+    std::deque<TileSource> tileSources;
+
+    // Enumerated chunks, in tile cover order, with the number of their tiles
+    // that are not stored yet. Chunks are identified by their sequence number.
+    struct TileChunk {
+        OfflineRegionTileCursor last;
+        std::size_t remaining;
+    };
+    std::deque<TileChunk> tileChunks;
+    uint64_t firstTileChunk = 0;
+
+    std::deque<std::pair<Resource, uint64_t>> tilesToFetch;
+    std::unique_ptr<AsyncRequest> tileCheck;
+
+    // Tiles skipped by resuming from a cursor, reported with the first chunk
+    uint64_t resumedTileCount = 0;
+    uint64_t resumedTileSize = 0;
+
     void queueResource(Resource&&);
     void queueTiles(style::SourceType, uint16_t tileSize, const Tileset&);
     void markPendingUsedResources();
@@ -50,6 +50,20 @@ static constexpr const char* offlineDatabaseSchema =
     "  tile_id INTEGER NOT NULL REFERENCES tiles(id),\n"
     "  UNIQUE (region_id, tile_id)\n"
     ");\n"
+    "CREATE TABLE region_tile_cursors (\n"
+    "  region_id INTEGER NOT NULL REFERENCES regions(id) ON DELETE CASCADE,\n"
+    "  url_template TEXT NOT NULL,\n"
+    "  pixel_ratio INTEGER NOT NULL,\n"
+    "  z INTEGER NOT NULL,\n"
+    "  position INTEGER NOT NULL,\n"
+    "  UNIQUE (region_id, url_template)\n"
+    ");\n"
+    "CREATE TABLE compression_dictionaries (\n"
+    "  codec INTEGER NOT NULL,\n"
+    "  id INTEGER NOT NULL,\n"
+    "  dictionary BLOB NOT NULL,\n"
+    "  UNIQUE (codec, id)\n"
+    ");\n"
     "CREATE INDEX resources_accessed\n"
     "ON resources (accessed);\n"
     "CREATE INDEX tiles_accessed\n"
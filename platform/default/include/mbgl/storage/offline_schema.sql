@@ -29,7 +29,9 @@ CREATE TABLE resources (
 
   data BLOB,                                       -- Contents of the resource.
 
-  compressed INTEGER NOT NULL DEFAULT 0,           -- If the resource is compressed with Deflate or not. Compression is
+  compressed INTEGER NOT NULL DEFAULT 0,           -- Codec the resource is compressed with: 0 for none, 1 for Deflate,
+                                                   -- 2 for Zstandard. The compressed data carries the ID of the
+                                                   -- dictionary it needs, if any. Compression is
                                                    -- optional and should be used when the compression ratio is
                                                    -- significant. Using compression will make decoding time slower
                                                    -- because it will add an extra decompression step.
@@ -74,7 +76,9 @@ CREATE TABLE tiles (
 
   data BLOB,                                       -- Contents of the tile.
 
-  compressed INTEGER NOT NULL DEFAULT 0,           -- If the tile is compressed with Deflate or not. Compression is
+  compressed INTEGER NOT NULL DEFAULT 0,           -- Codec the tile is compressed with: 0 for none, 1 for Deflate,
+                                                   -- 2 for Zstandard. The compressed data carries the ID of the
+                                                   -- dictionary it needs, if any. Compression is
                                                    -- optional and should be used when the compression ratio is
                                                    -- significant. Using compression will make decoding time slower
                                                    -- because it will add an extra decompression step.
@@ -148,6 +152,32 @@ CREATE TABLE region_tiles (
   UNIQUE (region_id, tile_id)
 );
 
+--
+-- Progress of interrupted region downloads, so that a download
+-- can resume without enumerating and checking every tile again.
+-- Every tile of the region up to and including the cursor tile,
+-- in tile cover order, is stored and linked to the region.
+--
+CREATE TABLE region_tile_cursors (
+  region_id INTEGER NOT NULL REFERENCES regions(id) ON DELETE CASCADE,
+  url_template TEXT NOT NULL,                       -- The tileset the cursor belongs to.
+  pixel_ratio INTEGER NOT NULL,                     -- The tile pixel ratio of the tileset.
+  z INTEGER NOT NULL,                               -- The zoom level of the cursor tile.
+  position INTEGER NOT NULL,                        -- The index of the cursor tile in the tile cover of its zoom level.
+  UNIQUE (region_id, url_template)
+);
+
+--
+-- Dictionaries that entries were compressed with, so that the
+-- entries stay readable after the database is reopened.
+--
+CREATE TABLE compression_dictionaries (
+  codec INTEGER NOT NULL,                           -- Codec the dictionary is for, as in the compressed columns.
+  id INTEGER NOT NULL,                              -- ID the compressed data refers to the dictionary by.
+  dictionary BLOB NOT NULL,
+  UNIQUE (codec, id)
+);
+
 --
 -- Indexes for efficient eviction queries.
 --
@@ -13,6 +13,10 @@ namespace sqlite {
 enum OpenFlag : int {
     ReadOnly = 0b001,
     ReadWriteCreate = 0b110,
+    // The connection is only ever used by one thread at a time
+    NoMutex = 0x8000,
+    // Connections to the same file share one page cache
+    SharedCache = 0x20000,
 };
 
 enum class ResultCode : uint8_t {
@@ -11,6 +11,7 @@
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/thread.hpp>
+#include <mbgl/util/timer.hpp>
 
 #include <map>
 #include <utility>
@@ -47,6 +48,7 @@ public:
 
     void forward(const Resource& resource, const Response& response, const std::function<void()>& callback) {
         db->put(resource, response);
+        schedulePendingWritesFlush();
         if (callback) {
             callback();
         }
@@ -58,7 +60,16 @@ public:
 
     void runPackDatabaseAutomatically(bool autopack) { db->runPackDatabaseAutomatically(autopack); }
 
-    void put(const Resource& resource, const Response& response) { db->put(resource, response); }
+    void setCompression(util::Codec codec,
+                        const std::shared_ptr<const std::string>& dictionary,
+                        const std::function<void(std::exception_ptr)>& callback) {
+        callback(db->setCompression(codec, dictionary));
+    }
+
+    void put(const Resource& resource, const Response& response) {
+        db->put(resource, response);
+        schedulePendingWritesFlush();
+    }
 
     void invalidateAmbientCache(const std::function<void(std::exception_ptr)>& callback) {
         callback(db->invalidateAmbientCache());
@@ -132,7 +143,23 @@ public:
 
     void reopenDatabaseReadOnly(bool readOnly) { db->reopenDatabaseReadOnly(readOnly); }
 
+    void setWriteBatching(bool enabled) {
+        db->setWriteBatching(enabled ? std::optional<OfflineDatabase::WriteBatching>{OfflineDatabase::WriteBatching{}}
+                                     : std::nullopt);
+        flushTimer.stop();
+    }
+
 private:
+    // OfflineDatabase only checks the batch age on put(), so commit the last
+    // partial batch once writes stop arriving.
+    void schedulePendingWritesFlush() {
+        const auto& batching = db->getWriteBatching();
+        if (!batching || !db->hasPendingWrites()) {
+            return;
+        }
+        flushTimer.start(batching->maxDelay, Duration::zero(), [this] { db->flushPendingWrites(); });
+    }
+
     expected<OfflineDownload*, std::exception_ptr> getDownload(int64_t regionID) {
         if (!onlineFileSource) {
             return unexpected<std::exception_ptr>(
@@ -155,6 +182,7 @@ private:
     std::unique_ptr<OfflineDatabase> db;
     std::map<int64_t, std::unique_ptr<OfflineDownload>> downloads;
     std::shared_ptr<FileSource> onlineFileSource;
+    util::Timer flushTimer;
 };
 
 class DatabaseFileSource::Impl {
@@ -249,6 +277,12 @@ void DatabaseFileSource::runPackDatabaseAutomatically(bool autopack) {
     impl->actor().invoke(&DatabaseFileSourceThread::runPackDatabaseAutomatically, autopack);
 }
 
+void DatabaseFileSource::setCompression(util::Codec codec,
+                                        std::shared_ptr<const std::string> dictionary,
+                                        std::function<void(std::exception_ptr)> callback) {
+    impl->actor().invoke(&DatabaseFileSourceThread::setCompression, codec, std::move(dictionary), std::move(callback));
+}
+
 void DatabaseFileSource::put(const Resource& resource, const Response& response) {
     impl->actor().invoke(&DatabaseFileSourceThread::put, resource, response);
 }
@@ -326,6 +360,8 @@ void DatabaseFileSource::setOfflineMapboxTileCountLimit(uint64_t limit) const {
 void DatabaseFileSource::setProperty(const std::string& key, const mapbox::base::Value& value) {
     if (key == READ_ONLY_MODE_KEY && value.getBool()) {
         impl->actor().invoke(&DatabaseFileSourceThread::reopenDatabaseReadOnly, *value.getBool());
+    } else if (key == WRITE_AHEAD_LOG_MODE_KEY && value.getBool()) {
+        impl->actor().invoke(&DatabaseFileSourceThread::setWriteBatching, *value.getBool());
     } else {
         std::string message = "Resource provider does not support property " + key;
         Log::Error(Event::General, message.c_str());
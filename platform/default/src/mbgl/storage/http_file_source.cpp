@@ -33,12 +33,36 @@ void handleError(CURLcode code) {
         throw std::runtime_error(std::string("CURL easy error: ") + curl_easy_strerror(code));
     }
 }
+
+void handleError(CURLSHcode code) {
+    if (code != CURLSHE_OK) {
+        throw std::runtime_error(std::string("CURL share error: ") + curl_share_strerror(code));
+    }
+}
+
+// Whether the linked libcurl was built with HTTP/2 support, e.g. against nghttp2.
+bool supportsHTTP2() {
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (33) << 8 | 0) // Added in 7.33.0
+    static const bool supported = (curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_HTTP2) != 0;
+    return supported;
+#else
+    return false;
+#endif
+}
 } // namespace
 
 namespace mbgl {
 
 class HTTPFileSource::Impl {
 public:
+    // Snapshot of the client options that affect how connections are made.
+    struct ConnectionOptions {
+        bool multiplexing;
+        bool priorKnowledge;
+        long keepAliveIdle;
+        long keepAliveInterval;
+    };
+
     Impl(const ResourceOptions &resourceOptions_, const ClientOptions &clientOptions_);
     ~Impl();
 
@@ -51,6 +75,10 @@ public:
     void returnHandle(CURL *handle);
     void checkMultiInfo();
 
+    // Returns the current connection options, applying any changed limits to
+    // the multi handle first. Must be called on the thread owning `multi`.
+    ConnectionOptions connectionOptions();
+
     // Used as the CURL timer function to periodically check for socket updates.
     util::Timer timeout;
 
@@ -58,7 +86,8 @@ public:
     // without having to block and spawn threads.
     CURLM *multi = nullptr;
 
-    // CURL share handles are used for sharing session state (e.g.)
+    // CURL share handle for the DNS cache and TLS sessions, so resumed
+    // handshakes are cheap even when a new connection has to be opened.
     CURLSH *share = nullptr;
 
     // A queue that we use for storing reusable CURL easy handles to avoid
@@ -76,6 +105,7 @@ private:
     mutable std::mutex clientOptionsMutex;
     ResourceOptions resourceOptions;
     ClientOptions clientOptions;
+    bool clientOptionsChanged = true;
 };
 
 class HTTPRequest : public AsyncRequest {
@@ -113,7 +143,10 @@ HTTPFileSource::Impl::Impl(const ResourceOptions &resourceOptions_, const Client
         throw std::runtime_error("Could not init cURL");
     }
 
+    // All handles are used on a single thread, so the share needs no lock callbacks.
     share = curl_share_init();
+    handleError(curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS));
+    handleError(curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION));
 
     multi = curl_multi_init();
     handleError(curl_multi_setopt(multi, CURLMOPT_SOCKETFUNCTION, handleSocket));
@@ -172,6 +205,32 @@ void HTTPFileSource::Impl::checkMultiInfo() {
     }
 }
 
+HTTPFileSource::Impl::ConnectionOptions HTTPFileSource::Impl::connectionOptions() {
+    std::scoped_lock lock(clientOptionsMutex);
+    if (clientOptionsChanged) {
+        clientOptionsChanged = false;
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (43) << 8 | 0) // Added in 7.43.0
+        const long pipelining = clientOptions.httpMultiplexing() && supportsHTTP2() ? CURLPIPE_MULTIPLEX
+                                                                                     : CURLPIPE_NOTHING;
+        handleError(curl_multi_setopt(multi, CURLMOPT_PIPELINING, pipelining));
+#endif
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (30) << 8 | 0) // Added in 7.30.0
+        handleError(curl_multi_setopt(
+            multi, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(clientOptions.maxHostConnections())));
+        handleError(curl_multi_setopt(
+            multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, static_cast<long>(clientOptions.maxTotalConnections())));
+#endif
+    }
+
+    return {
+        // Without HTTP/2 there is nothing to multiplex over, stay on HTTP/1.1.
+        .multiplexing = clientOptions.httpMultiplexing() && supportsHTTP2(),
+        .priorKnowledge = clientOptions.http2PriorKnowledge(),
+        .keepAliveIdle = static_cast<long>(clientOptions.tcpKeepAliveIdle().count()),
+        .keepAliveInterval = static_cast<long>(clientOptions.tcpKeepAliveInterval().count()),
+    };
+}
+
 void HTTPFileSource::Impl::perform(curl_socket_t s, util::RunLoop::Event events) {
     int flags = 0;
 
@@ -256,6 +315,7 @@ ResourceOptions HTTPFileSource::Impl::getResourceOptions() {
 void HTTPFileSource::Impl::setClientOptions(ClientOptions options) {
     std::scoped_lock lock(clientOptionsMutex);
     clientOptions = options;
+    clientOptionsChanged = true;
 }
 
 ClientOptions HTTPFileSource::Impl::getClientOptions() {
@@ -305,6 +365,34 @@ HTTPRequest::HTTPRequest(HTTPFileSource::Impl *context_, Resource resource_, Fil
     handleError(curl_easy_setopt(handle, CURLOPT_USERAGENT, "MapLibreNative/1.0"));
     handleError(curl_easy_setopt(handle, CURLOPT_SHARE, context->share));
 
+    const auto options = context->connectionOptions();
+    if (options.multiplexing) {
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (47) << 8 | 0) // Added in 7.47.0
+        // Plain http stays on HTTP/1.1 on purpose: upgrading to h2c costs a round trip per
+        // connection, and servers without HTTP/2 would reject it when assumed up front.
+        auto version = static_cast<long>(CURL_HTTP_VERSION_2TLS);
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (49) << 8 | 0) // Added in 7.49.0
+        if (options.priorKnowledge && resource.url.starts_with("http://")) {
+            version = static_cast<long>(CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE);
+        }
+#endif
+        handleError(curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, version));
+#endif
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (43) << 8 | 0) // Added in 7.43.0
+        // Prefer waiting for a connection that can multiplex over opening a new one.
+        handleError(curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L));
+#endif
+    } else {
+        handleError(curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_1_1)));
+    }
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (25) << 8 | 0) // Added in 7.25.0
+    if (options.keepAliveIdle > 0) {
+        handleError(curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L));
+        handleError(curl_easy_setopt(handle, CURLOPT_TCP_KEEPIDLE, options.keepAliveIdle));
+        handleError(curl_easy_setopt(handle, CURLOPT_TCP_KEEPINTVL, options.keepAliveInterval));
+    }
+#endif
+
     // Start requesting the information.
     handleError(curl_multi_add_handle(context->multi, handle));
 }
@@ -331,6 +419,16 @@ size_t HTTPRequest::writeCallback(void *const contents, const size_t size, const
 
     if (!impl->data) {
         impl->data = std::make_shared<std::string>();
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (55) << 8 | 0) // Added in 7.55.0
+        // Size the body from Content-Length up front, so large tiles are not
+        // copied on every reallocation while they stream in. The header is
+        // untrusted, so the preallocation is capped.
+        constexpr curl_off_t maxReservedBodySize = 64 * 1024 * 1024;
+        curl_off_t length = -1;
+        if (curl_easy_getinfo(impl->handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length) == CURLE_OK && length > 0) {
+            impl->data->reserve(static_cast<size_t>(std::min<curl_off_t>(length, maxReservedBodySize)));
+        }
+#endif
     }
 
     impl->data->append(static_cast<char *>(contents), size * nmemb);
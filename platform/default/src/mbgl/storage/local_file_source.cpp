@@ -1,3 +1,4 @@
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/platform/settings.hpp>
 #include <mbgl/storage/file_source_request.hpp>
 #include <mbgl/storage/local_file_request.hpp>
@@ -23,7 +24,8 @@ class LocalFileSource::Impl {
 public:
     explicit Impl(const ActorRef<Impl>&, const ResourceOptions& resourceOptions_, const ClientOptions& clientOptions_)
         : resourceOptions(resourceOptions_.clone()),
-          clientOptions(clientOptions_.clone()) {}
+          clientOptions(clientOptions_.clone()),
+          ioPool(Scheduler::GetIO(clientOptions.ioThreadPoolSize())) {}
 
     void request(const Resource& resource, const ActorRef<FileSourceRequest>& req) {
         if (!acceptsURL(resource.url)) {
@@ -36,7 +38,8 @@ public:
         // Cut off the protocol and prefix with path.
         const auto path = mbgl::util::percentDecode(
             resource.url.substr(std::char_traits<char>::length(util::FILE_PROTOCOL)));
-        requestLocalFile(path, req, resource.dataRange);
+        // Reads block, run them on the I/O pool so that several files can be read at once
+        ioPool->schedule([path, req, dataRange = resource.dataRange] { requestLocalFile(path, req, dataRange); });
     }
 
     void setResourceOptions(ResourceOptions options) {
@@ -64,6 +67,7 @@ private:
     mutable std::mutex clientOptionsMutex;
     ResourceOptions resourceOptions;
     ClientOptions clientOptions;
+    std::shared_ptr<Scheduler> ioPool;
 };
 
 LocalFileSource::LocalFileSource(const ResourceOptions& resourceOptions, const ClientOptions& clientOptions)
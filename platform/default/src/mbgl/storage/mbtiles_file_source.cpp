@@ -1,6 +1,9 @@
 #include <sstream>
 #include <map>
+#include <memory>
+#include <mutex>
 
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/platform/settings.hpp>
 #include <mbgl/storage/mbtiles_file_source.hpp>
 #include <mbgl/storage/file_source_request.hpp>
@@ -40,11 +43,71 @@ std::string url_to_path(const std::string &url) {
 namespace mbgl {
 using namespace rapidjson;
 
+namespace {
+
+// Read-only connections to one .mbtiles file, each with the tile query already prepared.
+// Every I/O thread reads through a connection of its own, so several tiles can be read at
+// once. Connections never move between threads, which not all SQLite backends allow
+// (e.g. QSqlDatabase).
+class ReaderPool : public std::enable_shared_from_this<ReaderPool> {
+public:
+    class Reader {
+    public:
+        explicit Reader(const std::string &path)
+            : db(mapbox::sqlite::Database::open(
+                  path, mapbox::sqlite::ReadOnly | mapbox::sqlite::NoMutex | mapbox::sqlite::SharedCache)),
+              tileQuery(db, "SELECT tile_data FROM tiles WHERE zoom_level = ?1 AND tile_column = ?2 AND tile_row = ?3") {}
+
+        std::optional<std::string> getTile(int32_t x, int32_t y, int8_t z) {
+            mapbox::sqlite::Query query(tileQuery);
+            query.bind(1, static_cast<int64_t>(z));
+            query.bind(2, static_cast<int64_t>(x));
+            // MBTiles uses the TMS scheme
+            query.bind(3, (int64_t{1} << z) - 1 - y);
+            if (query.run()) {
+                return query.get<std::optional<std::string>>(0);
+            }
+            return std::nullopt;
+        }
+
+    private:
+        mapbox::sqlite::Database db;
+        mapbox::sqlite::Statement tileQuery;
+    };
+
+    explicit ReaderPool(std::string path_)
+        : path(std::move(path_)) {}
+
+    // Returns the connection of the calling thread, opening it on first use
+    Reader &reader() {
+        struct Entry {
+            std::weak_ptr<ReaderPool> pool;
+            std::unique_ptr<Reader> reader;
+        };
+        thread_local std::map<const ReaderPool *, Entry> readers;
+
+        // Connections to closed files are closed here, on the thread that opened them
+        std::erase_if(readers, [](const auto &item) { return item.second.pool.expired(); });
+
+        auto &entry = readers[this];
+        if (!entry.reader) {
+            entry = {.pool = weak_from_this(), .reader = std::make_unique<Reader>(path)};
+        }
+        return *entry.reader;
+    }
+
+private:
+    const std::string path;
+};
+
+} // namespace
+
 class MBTilesFileSource::Impl {
 public:
     explicit Impl(const ActorRef<Impl> &, const ResourceOptions &resourceOptions_, const ClientOptions &clientOptions_)
         : resourceOptions(resourceOptions_.clone()),
-          clientOptions(clientOptions_.clone()) {}
+          clientOptions(clientOptions_.clone()),
+          ioPool(Scheduler::GetIO(clientOptions.ioThreadPoolSize())) {}
 
     std::vector<double> &split(const std::string &s, char delim, std::vector<double> &elems) {
         std::stringstream ss(s);
@@ -190,36 +253,29 @@ public:
     void request_tile(const Resource &resource, ActorRef<FileSourceRequest> req) {
         std::string base_path = url_to_path(resource.url);
         std::string path = db_path(base_path);
-        auto &db = get_db(path);
-
-        int iy = resource.tileData->y;
-        int iz = resource.tileData->z;
 
-        auto x = std::to_string(resource.tileData->x);
-        auto y = std::to_string((int)(pow(2, iz) - 1) - iy);
-        auto z = std::to_string(iz);
-
-        std::string sql = "SELECT tile_data FROM tiles where zoom_level = " + z + " AND tile_column = " + x +
-                          " AND tile_row = " + y;
-        mapbox::sqlite::Statement stmt(db, sql.c_str());
-
-        Response response;
-        response.noContent = true;
+        // Reads block, run them on the I/O pool so that several tiles can be read at once
+        ioPool->schedule([pool = get_pool(path), url = resource.url, tileData = *resource.tileData, req] {
+            Response response;
+            response.noContent = true;
 
-        for (mapbox::sqlite::Query q(stmt); q.run();) {
-            std::optional<std::string> data = q.get<std::optional<std::string>>(0);
-            if (data) {
-                response.data = std::make_shared<std::string>(*data);
-                response.noContent = false;
-                response.expires = Timestamp::max();
-                response.etag = resource.url;
+            try {
+                std::optional<std::string> data = pool->reader().getTile(tileData.x, tileData.y, tileData.z);
 
-                if (util::is_compressed(*response.data)) {
-                    response.data = std::make_shared<std::string>(util::decompress(*response.data));
+                if (data) {
+                    response.data = std::make_shared<std::string>(
+                        util::is_compressed(*data) ? util::decompress(*data) : std::move(*data));
+                    response.noContent = false;
+                    response.expires = Timestamp::max();
+                    response.etag = url;
                 }
+            } catch (const std::exception &e) {
+                response.error = std::make_unique<Response::Error>(Response::Error::Reason::Other,
+                                                                   std::string("Error reading MBTiles tile: ") + e.what());
             }
-        }
-        req.invoke(&FileSourceRequest::setResponse, response);
+
+            req.invoke(&FileSourceRequest::setResponse, response);
+        });
     }
 
     void setResourceOptions(ResourceOptions options) {
@@ -243,33 +299,26 @@ public:
     }
 
 private:
-    std::map<std::string, mapbox::sqlite::Database> db_cache;
+    std::map<std::string, std::shared_ptr<ReaderPool>> pool_cache;
 
-    void close_db(const std::string &path) {
-        auto ptr = db_cache.find(path);
-        if (ptr != db_cache.end()) {
-            db_cache.erase(path);
-        }
-    }
+    void close_db(const std::string &path) { pool_cache.erase(path); }
 
-    void close_all() { db_cache.clear(); }
+    void close_all() { pool_cache.clear(); }
 
     // Multiple databases open simultaneously, to effectively support multiple .mbtiles maps
-    mapbox::sqlite::Database &get_db(const std::string &path) {
-        auto ptr = db_cache.find(path);
-        if (ptr != db_cache.end()) {
-            return ptr->second;
-        };
-
-        auto ptr2 = db_cache.insert(std::pair<std::string, mapbox::sqlite::Database>(
-            path, mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly)));
-        return ptr2.first->second;
+    std::shared_ptr<ReaderPool> get_pool(const std::string &path) {
+        auto &pool = pool_cache[path];
+        if (!pool) {
+            pool = std::make_shared<ReaderPool>(path);
+        }
+        return pool;
     }
 
     mutable std::mutex resourceOptionsMutex;
     mutable std::mutex clientOptionsMutex;
     ResourceOptions resourceOptions;
     ClientOptions clientOptions;
+    std::shared_ptr<Scheduler> ioPool;
 };
 
 MBTilesFileSource::MBTilesFileSource(const ResourceOptions &resourceOptions, const ClientOptions &clientOptions)
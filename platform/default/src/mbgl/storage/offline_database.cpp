@@ -11,6 +11,12 @@
 #include <mbgl/storage/offline_schema.hpp>
 #include <mbgl/storage/merge_sideloaded.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+
 namespace mbgl {
 
 // Single-point transformer for offline storage keys. For sources where the URL is
@@ -48,6 +54,7 @@ void OfflineDatabase::initialize() {
 
         db->setBusyTimeout(Milliseconds::max());
         db->exec("PRAGMA foreign_keys = ON");
+        loadCompressionDictionaries();
 
         return;
     }
@@ -64,7 +71,7 @@ void OfflineDatabase::initialize() {
             // Newly created database, or old cache-only database; remove old table if it exists.
             removeOldCacheTable();
             createSchema();
-            return;
+            break;
         case 2:
             migrateToVersion3();
             // fall through
@@ -78,13 +85,23 @@ void OfflineDatabase::initialize() {
             migrateToVersion6();
             // fall through
         case 6:
+            migrateToVersion7();
+            // fall through
+        case 7:
+            migrateToVersion8();
+            // fall through
+        case 8:
             // Happy path; we're done
-            return;
+            break;
         default:
             // Downgrade: delete the database and try to reinitialize.
             removeExisting();
             initialize();
+            return;
     }
+
+    applyJournalMode();
+    loadCompressionDictionaries();
 }
 
 void OfflineDatabase::changePath(const std::string& path_) {
@@ -95,6 +112,8 @@ void OfflineDatabase::changePath(const std::string& path_) {
 }
 
 void OfflineDatabase::cleanup() {
+    flushPendingWrites();
+
     // Deleting these SQLite objects may result in exceptions
     try {
         statements.clear();
@@ -161,6 +180,7 @@ void OfflineDatabase::handleError(const char* action) {
 void OfflineDatabase::removeExisting() {
     Log::Warning(Event::Database, "Removing existing incompatible offline database");
 
+    discardPendingWrites();
     statements.clear();
     db.reset();
 
@@ -184,7 +204,7 @@ void OfflineDatabase::createSchema() {
     db->exec("PRAGMA synchronous = FULL");
     mapbox::sqlite::Transaction transaction(*db);
     db->exec(offlineDatabaseSchema);
-    db->exec("PRAGMA user_version = 6");
+    db->exec("PRAGMA user_version = 8");
     transaction.commit();
 }
 
@@ -226,9 +246,47 @@ void OfflineDatabase::migrateToVersion6() {
     transaction.commit();
 }
 
+void OfflineDatabase::migrateToVersion7() {
+    assert(db);
+    checkFlags();
+
+    mapbox::sqlite::Transaction transaction(*db);
+    db->exec(
+        "CREATE TABLE region_tile_cursors ("
+        "  region_id INTEGER NOT NULL REFERENCES regions(id) ON DELETE CASCADE,"
+        "  url_template TEXT NOT NULL,"
+        "  pixel_ratio INTEGER NOT NULL,"
+        "  z INTEGER NOT NULL,"
+        "  position INTEGER NOT NULL,"
+        "  UNIQUE (region_id, url_template)"
+        ")");
+    db->exec("PRAGMA user_version = 7");
+    transaction.commit();
+}
+
+// Version 8 stores compression dictionaries. It also turned the compressed
+// column from a zlib flag into a codec; older builds see a newer version and
+// recreate the database, instead of inflating Zstandard entries as zlib.
+void OfflineDatabase::migrateToVersion8() {
+    assert(db);
+    checkFlags();
+
+    mapbox::sqlite::Transaction transaction(*db);
+    db->exec(
+        "CREATE TABLE compression_dictionaries ("
+        "  codec INTEGER NOT NULL,"
+        "  id INTEGER NOT NULL,"
+        "  dictionary BLOB NOT NULL,"
+        "  UNIQUE (codec, id)"
+        ")");
+    db->exec("PRAGMA user_version = 8");
+    transaction.commit();
+}
+
 void OfflineDatabase::vacuum() {
     assert(db);
     checkFlags();
+    commitPendingWrites();
 
     if (getPragma<int64_t>("PRAGMA auto_vacuum") != 2 /*INCREMENTAL*/) {
         db->exec("PRAGMA auto_vacuum = INCREMENTAL");
@@ -244,6 +302,171 @@ void OfflineDatabase::checkFlags() {
     }
 }
 
+// The journal mode is persistent, so it is applied after every (re)open in case
+// the schema creation or a migration reset it.
+void OfflineDatabase::applyJournalMode() {
+    assert(db);
+    assert(!pendingWrites);
+    checkFlags();
+
+    if (writeBatching) {
+        db->exec("PRAGMA journal_mode = WAL");
+        db->exec("PRAGMA synchronous = NORMAL");
+    } else if (getPragma<std::string>("PRAGMA journal_mode") == "wal") {
+        db->exec("PRAGMA journal_mode = DELETE");
+        db->exec("PRAGMA synchronous = FULL");
+    }
+}
+
+void OfflineDatabase::commitPendingWrites() {
+    if (!pendingWrites) {
+        return;
+    }
+
+    try {
+        pendingWrites->commit();
+        pendingWrites.reset();
+        pendingPuts.clear();
+    } catch (...) {
+        discardPendingWrites();
+        throw;
+    }
+}
+
+void OfflineDatabase::discardPendingWrites() {
+    if (!pendingWrites) {
+        return;
+    }
+
+    try {
+        pendingWrites->rollback();
+    } catch (...) {
+        // SQLite may have rolled back the transaction already.
+        [[maybe_unused]] auto eptr = std::current_exception();
+    }
+    pendingWrites.reset();
+    pendingPuts.clear();
+
+    // The discarded writes were already accounted for, so recompute the size lazily.
+    currentAmbientCacheSize = std::nullopt;
+}
+
+void OfflineDatabase::replayPendingWrites() {
+    auto puts = std::move(pendingPuts);
+    discardPendingWrites();
+    if (puts.empty()) {
+        return;
+    }
+
+    try {
+        pendingWrites = std::make_unique<mapbox::sqlite::Transaction>(*db, mapbox::sqlite::Transaction::Immediate);
+        for (const auto& [resource, response] : puts) {
+            putInternal(resource, response, true);
+        }
+        pendingPuts = std::move(puts);
+    } catch (...) {
+        // The earlier puts already reported success, so a failed replay is only
+        // logged; the error of the failing put is handled by the caller. They
+        // are ambient cache entries and will be fetched again.
+        discardPendingWrites();
+        Log::Warning(Event::Database,
+                     "Dropped " + std::to_string(puts.size()) + " pending writes after a failed write");
+    }
+}
+
+void OfflineDatabase::setWriteBatching(std::optional<WriteBatching> writeBatching_) try {
+    flushPendingWrites();
+    writeBatching = std::move(writeBatching_);
+
+    if (db && !readOnly) {
+        applyJournalMode();
+    }
+} catch (...) {
+    handleError("change journal mode");
+}
+
+void OfflineDatabase::flushPendingWrites() try {
+    commitPendingWrites();
+} catch (...) {
+    handleError("commit pending writes");
+}
+
+std::exception_ptr OfflineDatabase::setCompression(util::Codec codec,
+                                                   std::shared_ptr<const std::string> dictionary) try {
+    if (!util::isAvailable(codec)) {
+        throw std::runtime_error("Compression codec is not available in this build");
+    }
+    if (dictionary) {
+        if (codec == util::Codec::None || util::dictionaryID(codec, *dictionary) == 0) {
+            throw std::runtime_error("Compression dictionary is not valid for this codec");
+        }
+        registerCompressionDictionary(codec, dictionary);
+    }
+
+    compression = {codec, std::move(dictionary)};
+    return nullptr;
+} catch (...) {
+    handleError("set compression");
+    return std::current_exception();
+}
+
+void OfflineDatabase::addCompressionDictionary(util::Codec codec, std::shared_ptr<const std::string> dictionary) try {
+    registerCompressionDictionary(codec, std::move(dictionary));
+} catch (...) {
+    handleError("add compression dictionary");
+}
+
+void OfflineDatabase::registerCompressionDictionary(util::Codec codec, std::shared_ptr<const std::string> dictionary) {
+    assert(dictionary);
+    const auto id = util::dictionaryID(codec, *dictionary);
+    compressionDictionaries[{codec, id}] = dictionary;
+    if (!readOnly) {
+        storeCompressionDictionary(codec, id, *dictionary);
+    }
+}
+
+void OfflineDatabase::storeCompressionDictionary(util::Codec codec, uint32_t id, const std::string& dictionary) {
+    // Keep the dictionary out of the write batch, so that a failed put can't roll it back.
+    commitPendingWrites();
+
+    mapbox::sqlite::Query query{getStatement(
+        "INSERT OR IGNORE INTO compression_dictionaries (codec, id, dictionary) VALUES (?1, ?2, ?3)")};
+    query.bind(1, static_cast<int64_t>(codec));
+    query.bind(2, static_cast<int64_t>(id));
+    query.bindBlob(3, dictionary.data(), dictionary.size(), false);
+    query.run();
+}
+
+void OfflineDatabase::loadCompressionDictionaries() {
+    assert(db);
+
+    // Read-only databases are not migrated, and may predate the table.
+    if (getPragma<int64_t>("PRAGMA user_version") < 8) {
+        return;
+    }
+
+    mapbox::sqlite::Query query{getStatement("SELECT codec, id, dictionary FROM compression_dictionaries")};
+    while (query.run()) {
+        const auto codec = static_cast<util::Codec>(query.get<int64_t>(0));
+        const auto id = static_cast<uint32_t>(query.get<int64_t>(1));
+        compressionDictionaries[{codec, id}] = std::make_shared<const std::string>(query.get<std::string>(2));
+    }
+    query.reset();
+
+    // The dictionary for new entries may have been set before this database was opened.
+    if (compression.dictionary && !readOnly) {
+        storeCompressionDictionary(
+            compression.codec, util::dictionaryID(compression.codec, *compression.dictionary), *compression.dictionary);
+    }
+}
+
+util::DictionaryLookup OfflineDatabase::dictionaryLookup() const {
+    return [this](util::Codec codec, uint32_t id) -> const std::string* {
+        auto it = compressionDictionaries.find({codec, id});
+        return it != compressionDictionaries.end() ? it->second.get() : nullptr;
+    };
+}
+
 mapbox::sqlite::Statement& OfflineDatabase::getStatement(const char* sql) {
     if (!db) {
         initialize();
@@ -296,9 +519,35 @@ std::pair<bool, uint64_t> OfflineDatabase::put(const Resource& resource, const R
         return {false, 0};
     }
 
-    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
-    auto result = putInternal(resource, response, true);
-    transaction.commit();
+    if (!writeBatching) {
+        mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+        auto result = putInternal(resource, response, true);
+        transaction.commit();
+        return result;
+    }
+
+    if (!pendingWrites) {
+        pendingWrites = std::make_unique<mapbox::sqlite::Transaction>(*db, mapbox::sqlite::Transaction::Immediate);
+        pendingWritesStarted = Clock::now();
+    }
+
+    std::pair<bool, uint64_t> result;
+    try {
+        result = putInternal(resource, response, true);
+    } catch (...) {
+        // A failed statement may leave the transaction unusable, so roll it
+        // back and replay the writes that already succeeded in a new one.
+        // Only the failing put reports an error.
+        auto eptr = std::current_exception();
+        replayPendingWrites();
+        std::rethrow_exception(eptr);
+    }
+    pendingPuts.emplace_back(resource, response);
+
+    if (pendingPuts.size() >= writeBatching->maxPendingWrites ||
+        Clock::now() - pendingWritesStarted >= writeBatching->maxDelay) {
+        commitPendingWrites();
+    }
     return result;
 } catch (...) {
     handleError("write resource");
@@ -315,13 +564,17 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
     }
 
     std::string compressedData;
-    bool compressed = false;
+    util::Codec codec = util::Codec::None;
     uint64_t size = 0;
 
     if (response.data) {
-        compressedData = util::compress(*response.data);
-        compressed = compressedData.size() < response.data->size();
-        size = compressed ? compressedData.size() : response.data->size();
+        if (compression.codec != util::Codec::None) {
+            compressedData = util::compress(*response.data, compression.codec, compression.dictionary.get());
+            if (compressedData.size() < response.data->size()) {
+                codec = compression.codec;
+            }
+        }
+        size = codec != util::Codec::None ? compressedData.size() : response.data->size();
     }
 
     std::optional<DatabaseSizeChangeStats> stats;
@@ -333,23 +586,17 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
         }
     }
 
+    // Bound without copying, the response keeps the uncompressed data alive.
+    const std::string_view data = codec != util::Codec::None ? std::string_view(compressedData)
+                                  : response.data            ? response.data.view()
+                                                             : std::string_view("");
     bool inserted;
 
     if (resource.kind == Resource::Kind::Tile) {
         assert(resource.tileData);
-        inserted = putTile(*resource.tileData,
-                           response,
-                           compressed      ? compressedData
-                           : response.data ? *response.data
-                                           : "",
-                           compressed);
+        inserted = putTile(*resource.tileData, response, data, codec);
     } else {
-        inserted = putResource(resource,
-                               response,
-                               compressed      ? compressedData
-                               : response.data ? *response.data
-                                               : "",
-                               compressed);
+        inserted = putResource(resource, response, data, codec);
     }
 
     if (stats) {
@@ -403,12 +650,12 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const
     auto data = query.get<std::optional<std::string>>(4);
     if (!data) {
         response.noContent = true;
-    } else if (query.get<bool>(5)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
+    } else if (const auto codec = static_cast<util::Codec>(query.get<int64_t>(5)); codec != util::Codec::None) {
+        response.data = std::make_shared<std::string>(util::decompress(*data, codec, dictionaryLookup()));
         size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
         size = data->length();
+        response.data = std::make_shared<std::string>(std::move(*data));
     }
 
     return std::make_pair(response, size);
@@ -426,8 +673,8 @@ std::optional<int64_t> OfflineDatabase::hasResource(const Resource& resource) {
 
 bool OfflineDatabase::putResource(const Resource& resource,
                                   const Response& response,
-                                  const std::string& data,
-                                  bool compressed) {
+                                  std::string_view data,
+                                  util::Codec codec) {
     checkFlags();
 
     if (response.notModified) {
@@ -476,7 +723,7 @@ bool OfflineDatabase::putResource(const Resource& resource,
         updateQuery.bind(8, false);
     } else {
         updateQuery.bindBlob(7, data.data(), data.size(), false);
-        updateQuery.bind(8, compressed);
+        updateQuery.bind(8, static_cast<uint8_t>(codec));
     }
 
     updateQuery.run();
@@ -503,7 +750,7 @@ bool OfflineDatabase::putResource(const Resource& resource,
         insertQuery.bind(9, false);
     } else {
         insertQuery.bindBlob(8, data.data(), data.size(), false);
-        insertQuery.bind(9, compressed);
+        insertQuery.bind(9, static_cast<uint8_t>(codec));
     }
 
     insertQuery.run();
@@ -577,12 +824,12 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Reso
     std::optional<std::string> data = query.get<std::optional<std::string>>(4);
     if (!data) {
         response.noContent = true;
-    } else if (query.get<bool>(5)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
+    } else if (const auto codec = static_cast<util::Codec>(query.get<int64_t>(5)); codec != util::Codec::None) {
+        response.data = std::make_shared<std::string>(util::decompress(*data, codec, dictionaryLookup()));
         size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
         size = data->length();
+        response.data = std::make_shared<std::string>(std::move(*data));
     }
 
     return std::make_pair(response, size);
@@ -613,10 +860,76 @@ std::optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile)
     return size.get<std::optional<int64_t>>(0);
 }
 
+void OfflineDatabase::hasTiles(const std::vector<Resource>& resources, std::vector<std::optional<int64_t>>& result) {
+    // Group by everything but the tile position, which is then looked up by key.
+    std::map<std::tuple<std::string, uint8_t, int8_t>, std::vector<std::size_t>> groups;
+    for (std::size_t i = 0; i < resources.size(); ++i) {
+        if (resources[i].kind == Resource::Kind::Tile) {
+            const auto& tile = *resources[i].tileData;
+            groups[{tile.urlTemplate, tile.pixelRatio, tile.z}].push_back(i);
+        }
+    }
+
+    // Each statement looks up a chunk of tile positions, each one an exact search of the
+    // (url_template, pixel_ratio, z, x, y) index. Shorter chunks are padded with a position no tile has.
+    constexpr std::size_t chunkSize = 64;
+    static const std::string sql = [] {
+        std::string keys;
+        for (std::size_t i = 0; i < chunkSize; ++i) {
+            keys += (i ? ", (?" : "(?") + std::to_string(4 + 2 * i) + ", ?" + std::to_string(5 + 2 * i) + ")";
+        }
+        // clang-format off
+        return "WITH keys(x, y) AS (VALUES " + keys + ") "
+               "SELECT keys.x, keys.y, length(tiles.data) "
+               "FROM keys CROSS JOIN tiles "
+               "ON tiles.url_template = ?1 "
+               "  AND tiles.pixel_ratio = ?2 "
+               "  AND tiles.z = ?3 "
+               "  AND tiles.x = keys.x "
+               "  AND tiles.y = keys.y ";
+        // clang-format on
+    }();
+    mapbox::sqlite::Query query{getStatement(sql.c_str())};
+
+    const auto position = [](int64_t x, int64_t y) {
+        return (static_cast<uint64_t>(x) << 32) | static_cast<uint32_t>(y);
+    };
+
+    std::unordered_map<uint64_t, std::optional<int64_t>> sizes;
+    for (const auto& [key, indices] : groups) {
+        for (std::size_t begin = 0; begin < indices.size(); begin += chunkSize) {
+            const std::size_t end = std::min(begin + chunkSize, indices.size());
+
+            query.bind(1, std::get<0>(key));
+            query.bind(2, std::get<1>(key));
+            query.bind(3, std::get<2>(key));
+            for (std::size_t i = 0; i < chunkSize; ++i) {
+                const auto* tile = begin + i < end ? &*resources[indices[begin + i]].tileData : nullptr;
+                query.bind(static_cast<int>(4 + 2 * i), tile ? tile->x : -1);
+                query.bind(static_cast<int>(5 + 2 * i), tile ? tile->y : -1);
+            }
+
+            sizes.clear();
+            while (query.run()) {
+                sizes.emplace(position(query.get<int64_t>(0), query.get<int64_t>(1)),
+                              query.get<std::optional<int64_t>>(2));
+            }
+            query.reset();
+
+            for (std::size_t i = begin; i < end; ++i) {
+                const auto& tile = *resources[indices[i]].tileData;
+                if (auto it = sizes.find(position(tile.x, tile.y)); it != sizes.end()) {
+                    result[indices[i]] = it->second;
+                }
+            }
+        }
+    }
+}
+
 bool OfflineDatabase::putTile(const Resource::TileData& tile,
                               const Response& response,
-                              const std::string& data,
-                              bool compressed) {
+                              std::string_view data,
+                              util::Codec codec) {
     checkFlags();
 
     if (response.notModified) {
@@ -680,7 +993,7 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         updateQuery.bind(7, false);
     } else {
         updateQuery.bindBlob(6, data.data(), data.size(), false);
-        updateQuery.bind(7, compressed);
+        updateQuery.bind(7, static_cast<uint8_t>(codec));
     }
 
     updateQuery.run();
@@ -710,7 +1023,7 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         insertQuery.bind(12, false);
     } else {
         insertQuery.bindBlob(11, data.data(), data.size(), false);
-        insertQuery.bind(12, compressed);
+        insertQuery.bind(12, static_cast<uint8_t>(codec));
     }
 
     insertQuery.run();
@@ -720,6 +1033,7 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
 
 std::exception_ptr OfflineDatabase::invalidateAmbientCache() try {
     checkFlags();
+    commitPendingWrites();
 
     // clang-format off
     mapbox::sqlite::Query tileQuery{ getStatement(
@@ -753,6 +1067,7 @@ std::exception_ptr OfflineDatabase::invalidateAmbientCache() try {
 
 std::exception_ptr OfflineDatabase::clearAmbientCache() try {
     checkFlags();
+    commitPendingWrites();
 
     // clang-format off
     mapbox::sqlite::Query tileQuery{ getStatement(
@@ -786,6 +1101,7 @@ std::exception_ptr OfflineDatabase::clearAmbientCache() try {
 
 std::exception_ptr OfflineDatabase::invalidateRegion(int64_t regionID) try {
     checkFlags();
+    commitPendingWrites();
 
     {
         // clang-format off
@@ -869,6 +1185,7 @@ expected<std::optional<OfflineRegion>, std::exception_ptr> OfflineDatabase::getR
 expected<OfflineRegion, std::exception_ptr> OfflineDatabase::createRegion(const OfflineRegionDefinition& definition,
                                                                           const OfflineRegionMetadata& metadata) try {
     checkFlags();
+    commitPendingWrites();
 
     // clang-format off
     mapbox::sqlite::Query query{ getStatement(
@@ -889,6 +1206,8 @@ expected<OfflineRegions, std::exception_ptr> OfflineDatabase::mergeDatabase(cons
     checkFlags();
 
     try {
+        commitPendingWrites();
+
         // clang-format off
         mapbox::sqlite::Query query{ getStatement("ATTACH DATABASE ?1 AS side") };
         // clang-format on
@@ -903,12 +1222,14 @@ expected<OfflineRegions, std::exception_ptr> OfflineDatabase::mergeDatabase(cons
         return unexpected<std::exception_ptr>(std::current_exception());
     }
     try {
-        // Support sideloaded databases at user_version = 6. Future schema
+        // Support sideloaded databases at user_version = 6 and up. Version 7 only
+        // added download cursors, which are not merged, and version 8 added
+        // compression dictionaries, which are merged when present. Future schema
         // version changes will need to implement migration paths for sideloaded
         // databases at version 6.
         auto sideUserVersion = static_cast<int>(getPragma<int64_t>("PRAGMA side.user_version"));
         const auto mainUserVersion = getPragma<int64_t>("PRAGMA user_version");
-        if (sideUserVersion < 6 || sideUserVersion != mainUserVersion) {
+        if (sideUserVersion < 6 || sideUserVersion > mainUserVersion) {
             throw std::runtime_error("Merge database has incorrect user_version");
         }
 
@@ -937,7 +1258,13 @@ expected<OfflineRegions, std::exception_ptr> OfflineDatabase::mergeDatabase(cons
 
         mapbox::sqlite::Transaction transaction(*db);
         db->exec(mergeSideloadedDatabaseSQL);
+        if (sideUserVersion >= 8) {
+            db->exec(
+                "INSERT OR IGNORE INTO compression_dictionaries (codec, id, dictionary) "
+                "SELECT codec, id, dictionary FROM side.compression_dictionaries");
+        }
         transaction.commit();
+        loadCompressionDictionaries();
 
         // clang-format off
         mapbox::sqlite::Query queryRegions{ getStatement(
@@ -969,6 +1296,7 @@ expected<OfflineRegions, std::exception_ptr> OfflineDatabase::mergeDatabase(cons
 expected<OfflineRegionMetadata, std::exception_ptr> OfflineDatabase::updateMetadata(
     const int64_t regionID, const OfflineRegionMetadata& metadata) try {
     checkFlags();
+    commitPendingWrites();
 
     // clang-format off
     mapbox::sqlite::Query query{ getStatement(
@@ -987,6 +1315,7 @@ expected<OfflineRegionMetadata, std::exception_ptr> OfflineDatabase::updateMetad
 
 std::exception_ptr OfflineDatabase::deleteRegion(OfflineRegion&& region) try {
     checkFlags();
+    commitPendingWrites();
 
     {
         mapbox::sqlite::Query query{getStatement("DELETE FROM regions WHERE id = ?")};
@@ -1022,12 +1351,98 @@ std::optional<int64_t> OfflineDatabase::hasRegionResource(const Resource& resour
     return std::nullopt;
 }
 
+std::vector<std::optional<int64_t>> OfflineDatabase::hasRegionResources(const std::vector<Resource>& resources) try {
+    std::vector<std::optional<int64_t>> result(resources.size());
+    hasTiles(resources, result);
+    for (std::size_t i = 0; i < resources.size(); ++i) {
+        if (resources[i].kind != Resource::Kind::Tile) {
+            result[i] = hasResource(resources[i]);
+        }
+    }
+    return result;
+} catch (...) {
+    handleError("query region resources");
+    return std::vector<std::optional<int64_t>>(resources.size());
+}
+
+std::optional<OfflineRegionTileCursor> OfflineDatabase::getRegionTileCursor(int64_t regionID,
+                                                                           const std::string& urlTemplate) try {
+    // clang-format off
+    mapbox::sqlite::Query query{ getStatement(
+        "SELECT pixel_ratio, z, position "
+        "FROM region_tile_cursors "
+        "WHERE region_id    = ?1 "
+        "  AND url_template = ?2 ") };
+    // clang-format on
+
+    query.bind(1, regionID);
+    query.bind(2, urlTemplate);
+    if (!query.run()) {
+        return std::nullopt;
+    }
+
+    return OfflineRegionTileCursor{.urlTemplate = urlTemplate,
+                                   .pixelRatio = static_cast<uint8_t>(query.get<int64_t>(0)),
+                                   .z = static_cast<uint8_t>(query.get<int64_t>(1)),
+                                   .position = static_cast<uint64_t>(query.get<int64_t>(2))};
+} catch (...) {
+    handleError("read region tile cursor");
+    return std::nullopt;
+}
+
+void OfflineDatabase::setRegionTileCursor(int64_t regionID, const OfflineRegionTileCursor& cursor) try {
+    commitPendingWrites();
+
+    // clang-format off
+    mapbox::sqlite::Query query{ getStatement(
+        "REPLACE INTO region_tile_cursors (region_id, url_template, pixel_ratio, z, position) "
+        "VALUES (?1, ?2, ?3, ?4, ?5) ") };
+    // clang-format on
+
+    query.bind(1, regionID);
+    query.bind(2, cursor.urlTemplate);
+    query.bind(3, cursor.pixelRatio);
+    query.bind(4, cursor.z);
+    query.bind(5, static_cast<int64_t>(cursor.position));
+    query.run();
+} catch (...) {
+    handleError("write region tile cursor");
+}
+
+std::pair<int64_t, int64_t> OfflineDatabase::getRegionTileCountAndSize(int64_t regionID,
+                                                                       const OfflineRegionTileCursor& cursor) try {
+    // Lower zoom levels are enumerated completely before the cursor's. Tiles of the
+    // cursor's zoom level have no stored order, they are looked up by the caller.
+    // clang-format off
+    mapbox::sqlite::Query query{ getStatement(
+        "SELECT COUNT(*), SUM(LENGTH(t.data)) "
+        "FROM region_tiles rt, tiles t "
+        "WHERE rt.region_id   = ?1 "
+        "  AND rt.tile_id     = t.id "
+        "  AND t.url_template = ?2 "
+        "  AND t.pixel_ratio  = ?3 "
+        "  AND t.z            < ?4 ") };
+    // clang-format on
+
+    query.bind(1, regionID);
+    query.bind(2, cursor.urlTemplate);
+    query.bind(3, cursor.pixelRatio);
+    query.bind(4, cursor.z);
+    query.run();
+
+    return {query.get<int64_t>(0), query.get<std::optional<int64_t>>(1).value_or(0)};
+} catch (...) {
+    handleError("get region tile count and size");
+    return {0, 0};
+}
+
 uint64_t OfflineDatabase::putRegionResource(int64_t regionID, const Resource& resource, const Response& response) try {
     checkFlags();
 
     if (!db) {
         initialize();
     }
+    commitPendingWrites();
     mapbox::sqlite::Transaction transaction(*db);
     auto size = putRegionResourceInternal(regionID, resource, response);
     transaction.commit();
@@ -1045,6 +1460,7 @@ void OfflineDatabase::putRegionResources(int64_t regionID,
     if (!db) {
         initialize();
     }
+    commitPendingWrites();
     mapbox::sqlite::Transaction transaction(*db);
 
     // Accumulate all statistics locally first before adding them to the
@@ -1395,6 +1811,7 @@ std::exception_ptr OfflineDatabase::setMaximumAmbientCacheSize(uint64_t size) {
     }
 
     try {
+        commitPendingWrites();
         maximumAmbientCacheSize = size;
 
         if (*currentAmbientCacheSize > maximumAmbientCacheSize) {
@@ -1460,6 +1877,7 @@ void OfflineDatabase::markUsedResources(int64_t regionID, const std::list<Resour
     if (!db) {
         initialize();
     }
+    commitPendingWrites();
     mapbox::sqlite::Transaction transaction(*db);
     for (const auto& resource : resources) {
         markUsed(regionID, resource);
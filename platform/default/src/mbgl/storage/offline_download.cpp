@@ -19,12 +19,16 @@
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/tileset.hpp>
 
+#include <algorithm>
+#include <map>
 #include <set>
+#include <tuple>
 
 namespace {
 
 const size_t kResourcesBatchSize = 64;
 const size_t kMarkBatchSize = 200;
+const size_t kTileChunkSize = 256;
 
 } // namespace
 
@@ -57,6 +61,16 @@ void tileCover(const Geometry& geometry, uint8_t z, Fn&& fn) {
     }
 }
 
+std::unique_ptr<util::TileCover> tileCover(const OfflineRegionDefinition& definition, uint8_t z) {
+    return std::visit(overloaded{[&](const OfflineTilePyramidRegionDefinition& reg) {
+                                     return std::make_unique<util::TileCover>(reg.bounds, z);
+                                 },
+                                 [&](const OfflineGeometryRegionDefinition& reg) {
+                                     return std::make_unique<util::TileCover>(reg.geometry, z);
+                                 }},
+                      definition);
+}
+
 template <class Fn>
 void tileCover(const OfflineRegionDefinition& definition,
                style::SourceType type,
@@ -150,7 +164,7 @@ OfflineRegionStatus OfflineDownload::getStatus() const {
     }
 
     style::Parser parser;
-    parser.parse(*styleResponse->data);
+    parser.parse(*styleResponse->data.string());
 
     result->requiredResourceCountIsPrecise = true;
 
@@ -168,8 +182,8 @@ OfflineRegionStatus OfflineDownload::getStatus() const {
                 std::optional<Response> sourceResponse = offlineDatabase.get(Resource::source(url));
                 if (sourceResponse) {
                     style::conversion::Error error;
-                    std::optional<Tileset> tileset = style::conversion::convertJSON<Tileset>(*sourceResponse->data,
-                                                                                             error);
+                    std::optional<Tileset> tileset = style::conversion::convertJSON<Tileset>(
+                        *sourceResponse->data.string(), error);
                     if (tileset) {
                         uint64_t tileSourceCount = tileCount(definition, type, tileSize, (*tileset).zoomRange);
                         result->requiredTileCount += tileSourceCount;
@@ -252,7 +266,7 @@ void OfflineDownload::activateDownload() {
         status.requiredResourceCountIsPrecise = true;
 
         style::Parser parser;
-        parser.parse(*styleResponse.data);
+        parser.parse(*styleResponse.data.string());
 
         auto tileServerOptions = onlineFileSource.getResourceOptions().tileServerOptions();
         parser.glyphURL = util::mapbox::canonicalizeGlyphURL(tileServerOptions, parser.glyphURL);
@@ -277,8 +291,8 @@ void OfflineDownload::activateDownload() {
 
                     ensureResource(std::move(sourceResource), [=, this](const Response& sourceResponse) {
                         style::conversion::Error error;
-                        std::optional<Tileset> tileset = style::conversion::convertJSON<Tileset>(*sourceResponse.data,
-                                                                                                 error);
+                        std::optional<Tileset> tileset = style::conversion::convertJSON<Tileset>(
+                            *sourceResponse.data.string(), error);
                         if (tileset) {
                             auto resourceOptions = onlineFileSource.getResourceOptions();
                             util::mapbox::canonicalizeTileset(
@@ -394,7 +408,7 @@ void OfflineDownload::activateDownload() {
    fruitless anyway.
 */
 void OfflineDownload::continueDownload() {
-    if (resourcesRemaining.empty()) {
+    if (!hasQueuedResources()) {
         // Flush pending buffers.
         if (!flushResourcesBuffer()) return;
         if (status.complete()) {
@@ -412,29 +426,73 @@ void OfflineDownload::continueDownload() {
         maxConcurrentRequests = static_cast<uint32_t>(*maxRequests);
     }
 
-    while (!resourcesRemaining.empty() && requests.size() < maxConcurrentRequests) {
-        ensureResource(std::move(resourcesRemaining.front()));
-        resourcesRemaining.pop_front();
+    while (requests.size() < maxConcurrentRequests) {
+        if (!resourcesRemaining.empty()) {
+            ensureResource(std::move(resourcesRemaining.front()));
+            resourcesRemaining.pop_front();
+        } else if (!tilesToFetch.empty()) {
+            // Pop first: hitting the tile count limit deactivates the download, which clears the queue.
+            auto [tile, chunk] = std::move(tilesToFetch.front());
+            tilesToFetch.pop_front();
+            requestResource(std::move(tile), {}, chunk);
+        } else {
+            break;
+        }
+    }
+
+    // Stay one chunk ahead of the requests, so the fetch queue does not run dry
+    // while tiles remain, without enumerating the whole region up front.
+    if (!tileCheck && !tileSources.empty() && tilesToFetch.size() < kTileChunkSize) {
+        checkTiles();
     }
 }
 
 void OfflineDownload::deactivateDownload() {
     requiredSourceURLs.clear();
     resourcesRemaining.clear();
+    tileSources.clear();
+    tileChunks.clear();
+    tilesToFetch.clear();
+    tileCheck.reset();
+    resumedTileCount = 0;
+    resumedTileSize = 0;
     requests.clear();
     buffer.clear();
 }
 
 bool OfflineDownload::flushResourcesBuffer() {
-    if (buffer.empty()) return true;
-    try {
-        offlineDatabase.putRegionResources(id, buffer, status);
-        buffer.clear();
-        observer->statusChanged(status);
-        return true;
-    } catch (const MapboxTileLimitExceededException&) {
-        onMapboxTileCountLimitExceeded();
-        return false;
+    if (!buffer.empty()) {
+        try {
+            offlineDatabase.putRegionResources(id, buffer, status);
+            buffer.clear();
+            observer->statusChanged(status);
+        } catch (const MapboxTileLimitExceededException&) {
+            onMapboxTileCountLimitExceeded();
+            return false;
+        }
+    }
+    saveTileCursors();
+    return true;
+}
+
+void OfflineDownload::saveTileCursors() {
+    assert(buffer.empty());
+
+    std::map<std::string, OfflineRegionTileCursor> cursors;
+    while (!tileChunks.empty() && tileChunks.front().remaining == 0) {
+        auto& last = tileChunks.front().last;
+        cursors.insert_or_assign(last.urlTemplate, std::move(last));
+        tileChunks.pop_front();
+        firstTileChunk++;
+    }
+    if (cursors.empty()) {
+        return;
+    }
+
+    // The cursor vouches for the tiles being linked to the region
+    markPendingUsedResources();
+    for (const auto& [urlTemplate, cursor] : cursors) {
+        offlineDatabase.setRegionTileCursor(id, cursor);
     }
 }
 
@@ -449,25 +507,174 @@ void OfflineDownload::queueResource(Resource&& resource) {
 }
 
 void OfflineDownload::queueTiles(SourceType type, uint16_t tileSize, const Tileset& tileset) {
-    tileCover(definition, type, tileSize, tileset.zoomRange, [&](const auto& tile) {
+    const Range<uint8_t> zoomRange = std::visit(
+        [&](auto& reg) { return coveringZoomRange(reg, type, tileSize, tileset.zoomRange); }, definition);
+    TileSource source{.urlTemplate = tileset.tiles[0],
+                      .scheme = tileset.scheme,
+                      .z = zoomRange.min,
+                      .maxZ = zoomRange.max,
+                      .position = 0,
+                      .resumeAfter = std::nullopt,
+                      .cover = nullptr};
+
+    // Continue after the last tile stored by an earlier download of this region.
+    const auto cursor = offlineDatabase.getRegionTileCursor(id, source.urlTemplate);
+    if (cursor && cursor->z >= zoomRange.min && cursor->z <= zoomRange.max) {
+        source.resumeAfter = cursor->position;
+        source.z = cursor->z;
+    }
+
+    // The tiles themselves are enumerated lazily by `nextTiles`; only count them here
+    // so that the required resource count stays precise. Skipped tiles of the cursor's
+    // zoom level are looked up in chunks, those of lower levels with a single query.
+    const auto pixelRatio = std::visit([](auto& def) { return def.pixelRatio; }, definition);
+    uint64_t skipped = 0;
+    uint64_t position = 0;
+    std::pair<int64_t, int64_t> stored{0, 0};
+    std::vector<Resource> skippedTiles;
+    const auto lookUpSkippedTiles = [&] {
+        if (skippedTiles.empty()) {
+            return;
+        }
+        for (const auto& size : offlineDatabase.hasRegionResources(skippedTiles)) {
+            if (size) {
+                stored.first++;
+                stored.second += *size;
+            }
+        }
+        skippedTiles.clear();
+    };
+    tileCover(definition, type, tileSize, tileset.zoomRange, [&](const CanonicalTileID& tile) {
         status.requiredResourceCount++;
         status.requiredTileCount++;
+        if (!source.resumeAfter || tile.z > source.z) {
+            return;
+        }
+        if (tile.z < source.z) {
+            skipped++;
+            return;
+        }
+        if (position++ > *source.resumeAfter) {
+            return;
+        }
+        skipped++;
+        skippedTiles.push_back(Resource::tile(source.urlTemplate, pixelRatio, tile.x, tile.y, tile.z, source.scheme));
+        if (skippedTiles.size() == kTileChunkSize) {
+            lookUpSkippedTiles();
+        }
+    });
+    lookUpSkippedTiles();
+
+    if (skipped > 0) {
+        const auto [count, size] = offlineDatabase.getRegionTileCountAndSize(id, *cursor);
+        stored.first += count;
+        stored.second += size;
+        // Skipped tiles that are not stored were not found on the server; those
+        // were dropped from the required count by the download that skipped them.
+        status.requiredResourceCount -= skipped - std::min<uint64_t>(skipped, stored.first);
+        resumedTileCount += stored.first;
+        resumedTileSize += stored.second;
+    }
 
-        auto tileResource = Resource::tile(tileset.tiles[0],
-                                           std::visit([](auto& def) { return def.pixelRatio; }, definition),
-                                           tile.x,
-                                           tile.y,
-                                           tile.z,
-                                           tileset.scheme);
+    tileSources.push_back(std::move(source));
+}
 
-        tileResource.setPriority(Resource::Priority::Low);
-        tileResource.setUsage(Resource::Usage::Offline);
+std::vector<Resource> OfflineDownload::nextTiles(std::size_t count, OfflineRegionTileCursor& last) {
+    const auto pixelRatio = std::visit([](auto& def) { return def.pixelRatio; }, definition);
 
-        resourcesRemaining.push_back(std::move(tileResource));
+    std::vector<Resource> tiles;
+    tiles.reserve(count);
+
+    // Exhausted sources are dropped eagerly, so `tileSources` is empty as soon
+    // as the last tile has been handed out. A chunk never spans two tilesets,
+    // so that its last tile can serve as the cursor of its tileset.
+    while (!tileSources.empty()) {
+        auto& source = tileSources.front();
+        if (source.cover && source.cover->hasNext()) {
+            if (tiles.size() == count) {
+                break;
+            }
+            const auto tile = source.cover->next()->canonical;
+            const uint64_t position = source.position++;
+            if (source.resumeAfter) {
+                if (position <= *source.resumeAfter) {
+                    continue;
+                }
+                source.resumeAfter.reset();
+            }
+            auto tileResource = Resource::tile(source.urlTemplate, pixelRatio, tile.x, tile.y, tile.z, source.scheme);
+            tileResource.setPriority(Resource::Priority::Low);
+            tileResource.setUsage(Resource::Usage::Offline);
+            last = {.urlTemplate = source.urlTemplate,
+                    .pixelRatio = tileResource.tileData->pixelRatio,
+                    .z = tile.z,
+                    .position = position};
+            tiles.push_back(std::move(tileResource));
+        } else if (source.z <= source.maxZ) {
+            source.cover = tileCover(definition, source.z++);
+            source.position = 0;
+        } else {
+            tileSources.pop_front();
+            if (!tiles.empty()) {
+                break;
+            }
+        }
+    }
+
+    return tiles;
+}
+
+bool OfflineDownload::hasQueuedResources() const {
+    return !resourcesRemaining.empty() || !tilesToFetch.empty() || !tileSources.empty();
+}
+
+void OfflineDownload::checkTiles() {
+    assert(!tileCheck);
+    tileCheck = util::RunLoop::Get()->invokeCancellable([this]() {
+        tileCheck.reset();
+
+        OfflineRegionTileCursor last{};
+        std::vector<Resource> tiles = nextTiles(kTileChunkSize, last);
+        const std::vector<std::optional<int64_t>> sizes = offlineDatabase.hasRegionResources(tiles);
+
+        bool stored = false;
+        if (resumedTileCount > 0) {
+            status.completedResourceCount += resumedTileCount;
+            status.completedResourceSize += resumedTileSize;
+            status.completedTileCount += resumedTileCount;
+            status.completedTileSize += resumedTileSize;
+            resumedTileCount = 0;
+            resumedTileSize = 0;
+            stored = true;
+        }
+
+        if (!tiles.empty()) {
+            const uint64_t chunk = firstTileChunk + tileChunks.size();
+            tileChunks.push_back({.last = std::move(last), .remaining = 0});
+            for (std::size_t i = 0; i < tiles.size(); ++i) {
+                if (sizes[i]) {
+                    status.completedResourceCount++;
+                    status.completedResourceSize += *sizes[i];
+                    status.completedTileCount++;
+                    status.completedTileSize += *sizes[i];
+                    resourcesToBeMarkedAsUsed.push_back(std::move(tiles[i]));
+                    stored = true;
+                } else {
+                    tilesToFetch.emplace_back(std::move(tiles[i]), chunk);
+                    tileChunks.back().remaining++;
+                }
+            }
+        }
+
+        if (stored) {
+            observer->statusChanged(status);
+        }
+        continueDownload();
     });
 }
 
 void OfflineDownload::markPendingUsedResources() {
+    if (resourcesToBeMarkedAsUsed.empty()) return;
     offlineDatabase.markUsedResources(id, resourcesToBeMarkedAsUsed);
     resourcesToBeMarkedAsUsed.clear();
 }
@@ -511,47 +718,59 @@ void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Res
             return;
         }
 
-        if (offlineDatabase.exceedsOfflineMapboxTileCountLimit(resource)) {
-            onMapboxTileCountLimitExceeded();
-            return;
-        }
+        requestResource(Resource(resource), callback);
+    });
+}
+
+void OfflineDownload::requestResource(Resource&& resource,
+                                      std::function<void(Response)> callback,
+                                      std::optional<uint64_t> tileChunk) {
+    if (offlineDatabase.exceedsOfflineMapboxTileCountLimit(resource)) {
+        onMapboxTileCountLimitExceeded();
+        return;
+    }
 
-        auto fileRequestsIt = requests.insert(requests.begin(), nullptr);
-        *fileRequestsIt = onlineFileSource.request(resource, [=, this](const Response& onlineResponse) {
-            if (onlineResponse.error) {
-                observer->responseError(*onlineResponse.error);
-                if (onlineResponse.error->reason == Response::Error::Reason::NotFound) {
-                    // On error 404, we skip this request and go further.
-                    requests.erase(fileRequestsIt);
-                    assert(status.requiredResourceCount > 0);
-                    status.requiredResourceCount--;
-                    continueDownload();
+    auto fileRequestsIt = requests.insert(requests.begin(), nullptr);
+    *fileRequestsIt = onlineFileSource.request(resource, [=, this](const Response& onlineResponse) {
+        if (onlineResponse.error) {
+            observer->responseError(*onlineResponse.error);
+            if (onlineResponse.error->reason == Response::Error::Reason::NotFound) {
+                // On error 404, we skip this request and go further.
+                requests.erase(fileRequestsIt);
+                assert(status.requiredResourceCount > 0);
+                status.requiredResourceCount--;
+                if (tileChunk) {
+                    tileChunks[*tileChunk - firstTileChunk].remaining--;
                 }
-                return;
+                continueDownload();
             }
+            return;
+        }
 
-            requests.erase(fileRequestsIt);
+        requests.erase(fileRequestsIt);
 
-            if (callback) {
-                callback(onlineResponse);
-            }
+        if (callback) {
+            callback(onlineResponse);
+        }
 
-            // Queue up for batched insertion
-            buffer.emplace_back(resource, onlineResponse);
+        // Queue up for batched insertion
+        buffer.emplace_back(resource, onlineResponse);
+        if (tileChunk) {
+            tileChunks[*tileChunk - firstTileChunk].remaining--;
+        }
 
-            // Flush buffer periodically.
-            // Have to keep `resourcesRemaining.empty()` as the following
-            // condition would fail otherwise.
-            // TODO: Simplify the tile count limit check code path!
-            if ((buffer.size() == kResourcesBatchSize || resourcesRemaining.empty()) && !flushResourcesBuffer()) return;
+        // Flush buffer periodically.
+        // Have to flush once nothing is queued, as the following
+        // condition would fail otherwise.
+        // TODO: Simplify the tile count limit check code path!
+        if ((buffer.size() == kResourcesBatchSize || !hasQueuedResources()) && !flushResourcesBuffer()) return;
 
-            if (offlineDatabase.exceedsOfflineMapboxTileCountLimit(resource)) {
-                onMapboxTileCountLimitExceeded();
-                return;
-            }
+        if (offlineDatabase.exceedsOfflineMapboxTileCountLimit(resource)) {
+            onMapboxTileCountLimitExceeded();
+            return;
+        }
 
-            continueDownload();
-        });
+        continueDownload();
     });
 }
 
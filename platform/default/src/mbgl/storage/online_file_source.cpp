@@ -16,6 +16,7 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/exception.hpp>
 #include <mbgl/util/http_timeout.hpp>
+#include <mbgl/util/indexed_priority_queue.hpp>
 #include <mbgl/util/mapbox.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/platform.hpp>
@@ -24,10 +25,13 @@
 #include <mbgl/util/timer.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <list>
 #include <map>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace mbgl {
 
@@ -54,7 +58,6 @@ struct OnlineFileRequest {
     Duration getUpdateInterval(std::optional<Timestamp> expires) const;
     OnlineFileSourceThread& impl;
     Resource resource;
-    std::unique_ptr<AsyncRequest> request;
     util::Timer timer;
     Callback callback;
 
@@ -73,11 +76,20 @@ struct OnlineFileRequest {
     std::optional<Timestamp> retryAfter;
 };
 
+// Updated on the file source thread, read from any thread
+struct TransferStats {
+    std::atomic<uint64_t> transfers{0};
+    std::atomic<uint64_t> coalesced{0};
+};
+
 class OnlineFileSourceThread {
 public:
-    OnlineFileSourceThread(const ResourceOptions& resourceOptions_, const ClientOptions& clientOptions_)
+    OnlineFileSourceThread(const ResourceOptions& resourceOptions_,
+                           const ClientOptions& clientOptions_,
+                           std::shared_ptr<TransferStats> stats_)
         : resourceOptions(resourceOptions_.clone()),
           clientOptions(clientOptions_.clone()),
+          stats(std::move(stats_)),
           httpFileSource(resourceOptions_, clientOptions_) {
         NetworkStatus::Subscribe(&reachability);
         setMaximumConcurrentRequests(util::DEFAULT_MAXIMUM_CONCURRENT_REQUESTS);
@@ -116,7 +128,22 @@ public:
 
     void remove(OnlineFileRequest* req) {
         allRequests.erase(req);
-        if (activeRequests.erase(req)) {
+        if (joinedRequests.erase(req)) {
+            auto& requests = transfers.at(TransferKey(req->resource)).requests;
+            requests.erase(std::find(requests.begin(), requests.end(), req));
+        } else if (activeRequests.erase(req)) {
+            auto it = transfers.find(TransferKey(req->resource));
+            assert(it != transfers.end() && it->second.requests.front() == req);
+            auto& requests = it->second.requests;
+            requests.erase(requests.begin());
+            if (!requests.empty()) {
+                // Others still wait for the response, hand the transfer and its slot over
+                joinedRequests.erase(requests.front());
+                activeRequests.insert(requests.front());
+                return;
+            }
+            // Cancels the transfer
+            transfers.erase(it);
             activatePendingRequest();
         } else {
             pendingRequests.remove(req);
@@ -125,8 +152,11 @@ public:
 
     void activateOrQueueRequest(OnlineFileRequest* req) {
         assert(allRequests.contains(req));
-        assert(!activeRequests.contains(req));
-        assert(!req->request);
+        assert(!isActive(req));
+
+        if (joinTransfer(req)) {
+            return;
+        }
 
         if (activeRequests.size() >= getMaximumConcurrentRequests()) {
             queueRequest(req);
@@ -135,20 +165,38 @@ public:
         }
     }
 
-    void queueRequest(OnlineFileRequest* req) { pendingRequests.insert(req); }
+    void queueRequest(OnlineFileRequest* req) {
+        pendingRequests.push(req, static_cast<std::size_t>(req->resource.priority));
+    }
+
+    // Identical requests in flight at the same time share one transfer, which
+    // occupies a single slot on behalf of all of them.
+    bool joinTransfer(OnlineFileRequest* req) {
+        auto it = transfers.find(TransferKey(req->resource));
+        if (it == transfers.end()) {
+            return false;
+        }
+        it->second.requests.push_back(req);
+        joinedRequests.insert(req);
+        stats->coalesced++;
+        return true;
+    }
 
     void activateRequest(OnlineFileRequest* req) {
-        auto callback = [=, this](const Response& response) {
-            activeRequests.erase(req);
-            req->request.reset();
-            req->completed(response);
-            activatePendingRequest();
+        TransferKey key(req->resource);
+        auto callback = [this, key](const Response& response) {
+            completeTransfer(key, response);
         };
 
         activeRequests.insert(req);
+        transfers[key].requests.push_back(req);
 
         if (online) {
-            req->request = httpFileSource.request(req->resource, callback);
+            stats->transfers++;
+            auto request = httpFileSource.request(req->resource, callback);
+            if (auto it = transfers.find(key); it != transfers.end()) {
+                it->second.request = std::move(request);
+            }
         } else {
             Response response;
             response.error = std::make_unique<Response::Error>(Response::Error::Reason::Connection,
@@ -157,17 +205,38 @@ public:
         }
     }
 
-    void activatePendingRequest() {
-        auto req = pendingRequests.pop();
+    void completeTransfer(const TransferKey& key, const Response& response) {
+        auto transfer = transfers.extract(key);
+        if (transfer.empty()) {
+            return;
+        }
 
-        if (req) {
-            activateRequest(*req);
+        const std::vector<OnlineFileRequest*> requests = std::move(transfer.mapped().requests);
+        activeRequests.erase(requests.front());
+        for (auto* req : requests) {
+            joinedRequests.erase(req);
+        }
+        for (auto* req : requests) {
+            // Completing a request may end up removing others
+            if (allRequests.contains(req)) {
+                req->completed(response);
+            }
+        }
+        activatePendingRequest();
+    }
+
+    void activatePendingRequest() {
+        while (auto req = pendingRequests.pop()) {
+            if (!joinTransfer(*req)) {
+                activateRequest(*req);
+                return;
+            }
         }
     }
 
     bool isPending(OnlineFileRequest* req) { return pendingRequests.contains(req); }
 
-    bool isActive(OnlineFileRequest* req) { return activeRequests.contains(req); }
+    bool isActive(OnlineFileRequest* req) { return activeRequests.contains(req) || joinedRequests.contains(req); }
 
     void setResourceTransform(ResourceTransform transform) { resourceTransform = std::move(transform); }
 
@@ -220,70 +289,38 @@ private:
         }
     }
 
-    // Using Pending Requests as an priority queue which processes
-    // file requests in a FIFO manner but prefers regular requests
-    // over offline requests with a low priority such that low priority
-    // requests do not throttle regular requests.
-    //
-    // The order of a queue is therefore:
-    //
-    // hi0 -- hi1 -- hi2 -- hi3 -- lo0 -- lo1 --lo2
-    //                              ^
-    //                              firstLowPriorityRequest
-
-    struct PendingRequests {
-        PendingRequests()
-            : firstLowPriorityRequest(queue.begin()) {}
-
-        std::list<OnlineFileRequest*> queue;
-        std::list<OnlineFileRequest*>::iterator firstLowPriorityRequest;
-
-        void remove(const OnlineFileRequest* request) {
-            auto it = std::find(queue.begin(), queue.end(), request);
-            if (it != queue.end()) {
-                if (it == firstLowPriorityRequest) {
-                    firstLowPriorityRequest++;
-                }
-                queue.erase(it);
-            }
-        }
+    // Requests are merged if they would send the same HTTP request
+    struct TransferKey {
+        explicit TransferKey(const Resource& resource)
+            : url(resource.url),
+              dataRange(resource.dataRange),
+              priority(resource.priority),
+              priorModified(resource.priorModified),
+              priorEtag(resource.priorEtag) {}
 
-        void insert(OnlineFileRequest* request) {
-            if (request->resource.priority == Resource::Priority::Regular) {
-                firstLowPriorityRequest = queue.insert(firstLowPriorityRequest, request);
-                firstLowPriorityRequest++;
-            } else {
-                if (firstLowPriorityRequest == queue.end()) {
-                    firstLowPriorityRequest = queue.insert(queue.end(), request);
-                } else {
-                    queue.insert(queue.end(), request);
-                }
-            }
+        bool operator<(const TransferKey& other) const {
+            return std::tie(url, dataRange, priority, priorModified, priorEtag) <
+                   std::tie(other.url, other.dataRange, other.priority, other.priorModified, other.priorEtag);
         }
 
-        std::optional<OnlineFileRequest*> pop() {
-            if (queue.empty()) {
-                return {};
-            }
-
-            if (queue.begin() == firstLowPriorityRequest) {
-                firstLowPriorityRequest++;
-            }
-
-            OnlineFileRequest* next = queue.front();
-            queue.pop_front();
-            return {next};
-        }
+        std::string url;
+        std::optional<std::pair<uint64_t, uint64_t>> dataRange;
+        Resource::Priority priority;
+        std::optional<Timestamp> priorModified;
+        std::optional<std::string> priorEtag;
+    };
 
-        bool contains(OnlineFileRequest* request) const {
-            return (std::find(queue.begin(), queue.end(), request) != queue.end());
-        }
+    struct Transfer {
+        std::unique_ptr<AsyncRequest> request;
+        // The first request holds the slot in `activeRequests`, the others joined later
+        std::vector<OnlineFileRequest*> requests;
     };
 
     ResourceTransform resourceTransform;
 
     ResourceOptions resourceOptions;
     ClientOptions clientOptions;
+    std::shared_ptr<TransferStats> stats;
 
     /**
      * The lifetime of a request is:
@@ -294,13 +331,19 @@ private:
      * 4. Back to #1
      *
      * Requests in any state are in `allRequests`. Requests in the pending state are in
-     * `pendingRequests`. Requests in the active state are in `activeRequests`.
+     * `pendingRequests`. Requests in the active state are in `activeRequests`, or in
+     * `joinedRequests` if they share the transfer of an identical active request.
      */
     std::set<OnlineFileRequest*> allRequests;
 
-    PendingRequests pendingRequests;
+    // Regular priority requests go first, so that low priority requests like
+    // offline downloads do not throttle them. FIFO within a priority.
+    util::IndexedPriorityQueue<OnlineFileRequest*, static_cast<std::size_t>(Resource::Priority::Low) + 1>
+        pendingRequests;
 
     std::set<OnlineFileRequest*> activeRequests;
+    std::set<OnlineFileRequest*> joinedRequests;
+    std::map<TransferKey, Transfer> transfers;
 
     bool online = true;
     uint32_t maximumConcurrentRequests;
@@ -318,7 +361,8 @@ public:
               util::makeThreadPrioritySetter(platform::EXPERIMENTAL_THREAD_PRIORITY_NETWORK),
               "OnlineFileSource",
               resourceOptions.clone(),
-              clientOptions.clone())) {}
+              clientOptions.clone(),
+              stats)) {}
 
     std::unique_ptr<AsyncRequest> request(Callback callback, Resource res) {
         auto req = std::make_unique<FileSourceRequest>(std::move(callback));
@@ -418,7 +462,11 @@ public:
         return cachedResourceOptions.tileServerOptions().baseURL();
     }
 
+    uint64_t getTransferCount() const { return stats->transfers; }
+    uint64_t getCoalescedRequestCount() const { return stats->coalesced; }
+
 private:
+    const std::shared_ptr<TransferStats> stats = std::make_shared<TransferStats>();
     mutable std::mutex resourceOptionsMutex;
     mutable std::mutex clientOptionsMutex;
     ResourceOptions cachedResourceOptions;
@@ -692,6 +740,10 @@ mapbox::base::Value OnlineFileSource::getProperty(const std::string& key) const
         return impl->getAPIBaseURL();
     } else if (key == MAX_CONCURRENT_REQUESTS_KEY) {
         return impl->getMaximumConcurrentRequests();
+    } else if (key == TRANSFER_COUNT_KEY) {
+        return impl->getTransferCount();
+    } else if (key == COALESCED_REQUEST_COUNT_KEY) {
+        return impl->getCoalescedRequestCount();
     }
     std::string message = "Resource provider does not support property " + key;
     Log::Error(Event::General, message.c_str());
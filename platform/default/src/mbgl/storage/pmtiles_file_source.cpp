@@ -1,6 +1,12 @@
+#include <atomic>
+#include <list>
 #include <sstream>
 #include <map>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
 
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/platform/settings.hpp>
 #include <mbgl/storage/file_source_manager.hpp>
 #include <mbgl/storage/file_source_request.hpp>
@@ -12,6 +18,7 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <mbgl/util/hash.hpp>
 #include <mbgl/util/thread.hpp>
 #include <mbgl/util/url.hpp>
 #include <mbgl/util/chrono.hpp>
@@ -23,6 +30,20 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #if defined(__QT__) && (defined(_WIN32) || defined(__EMSCRIPTEN__))
 #include <QtZlib/zlib.h>
 #else
@@ -36,7 +57,7 @@ constexpr int pmtilesHeaderLength = 127;
 
 // To avoid allocating lots of memory with PMTiles directory caching,
 // set a limit so it doesn't grow unlimited
-constexpr int MAX_DIRECTORY_CACHE_ENTRIES = 100;
+constexpr std::size_t MAX_DIRECTORY_CACHE_BYTES = 32 * 1024 * 1024;
 
 bool acceptsURL(const std::string& url) {
     return url.starts_with(mbgl::util::PMTILES_PROTOCOL);
@@ -55,14 +76,260 @@ const uint8_t TILETYPE_MLT = 0x6;
 namespace mbgl {
 using namespace rapidjson;
 
+namespace {
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(
+            path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        LARGE_INTEGER fileSize;
+        HANDLE mapping = nullptr;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        }
+        if (mapping) {
+            data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            size = static_cast<std::size_t>(fileSize.QuadPart);
+            // The view keeps the file mapped
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* mapped = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                data = static_cast<const char*>(mapped);
+                size = static_cast<std::size_t>(info.st_size);
+            }
+        }
+        // The mapping keeps the file open
+        ::close(fd);
+#endif
+        if (!data) {
+            throw std::runtime_error("Cannot map " + path);
+        }
+    }
+
+    ~MappedFile() {
+#if defined(_WIN32)
+        UnmapViewOfFile(data);
+#else
+        munmap(const_cast<char*>(data), size);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view view(uint64_t offset, uint64_t length) const {
+        if (offset > size || length > size - offset) {
+            throw std::out_of_range("Range is outside of the archive");
+        }
+        return {data + offset, static_cast<std::size_t>(length)};
+    }
+
+private:
+    const char* data = nullptr;
+    std::size_t size = 0;
+};
+
+using Directory = std::vector<pmtiles::entryv3>;
+
+struct DirectoryKey {
+    // Archive URL, or a unique name for a local archive
+    std::string archive;
+    uint64_t offset;
+    uint64_t length;
+
+    bool operator==(const DirectoryKey&) const = default;
+};
+
+struct DirectoryKeyHash {
+    std::size_t operator()(const DirectoryKey& key) const { return util::hash(key.archive, key.offset, key.length); }
+};
+
+// Decoded directories of all archives of a file source. The least recently used
+// directories are evicted once the byte budget is exceeded. Used from both the file
+// source thread and the I/O pool.
+class DirectoryCache {
+public:
+    explicit DirectoryCache(std::size_t maxBytes_)
+        : maxBytes(maxBytes_) {}
+
+    std::shared_ptr<const Directory> get(const DirectoryKey& key) {
+        std::scoped_lock lock(mutex);
+        auto it = index.find(key);
+        if (it == index.end()) {
+            ++stats.misses;
+            return nullptr;
+        }
+        ++stats.hits;
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second->directory;
+    }
+
+    void put(const DirectoryKey& key, std::shared_ptr<const Directory> directory) {
+        const std::size_t bytes = sizeof(Entry) + key.archive.size() + directory->size() * sizeof(pmtiles::entryv3);
+
+        std::scoped_lock lock(mutex);
+        if (auto it = index.find(key); it != index.end()) {
+            stats.bytes -= it->second->bytes;
+            entries.erase(it->second);
+            index.erase(it);
+        }
+        entries.push_front({.key = key, .directory = std::move(directory), .bytes = bytes});
+        index.emplace(key, entries.begin());
+        stats.bytes += bytes;
+
+        // Always keep the newest directory, it is about to be used
+        while (stats.bytes > maxBytes && entries.size() > 1) {
+            const Entry& last = entries.back();
+            stats.bytes -= last.bytes;
+            index.erase(last.key);
+            entries.pop_back();
+            ++stats.evictions;
+        }
+    }
+
+    // A fetch was joined with an identical one already in flight
+    void addCoalesced() {
+        std::scoped_lock lock(mutex);
+        ++stats.coalesced;
+    }
+
+    PMTilesFileSource::DirectoryCacheStats getStats() const {
+        std::scoped_lock lock(mutex);
+        auto result = stats;
+        result.entries = entries.size();
+        return result;
+    }
+
+private:
+    struct Entry {
+        DirectoryKey key;
+        std::shared_ptr<const Directory> directory;
+        std::size_t bytes;
+    };
+
+    const std::size_t maxBytes;
+    mutable std::mutex mutex;
+    std::list<Entry> entries;
+    std::unordered_map<DirectoryKey, std::list<Entry>::iterator, DirectoryKeyHash> index;
+    PMTilesFileSource::DirectoryCacheStats stats;
+};
+
+// A PMTiles archive on the local file system. Reads go straight to the mapped
+// file, so tiles can be looked up from any thread without going through the
+// file source.
+class LocalArchive {
+public:
+    explicit LocalArchive(const std::string& path)
+        : file(path),
+          header(pmtiles::deserialize_header(std::string(file.view(pmtilesHeaderOffset, pmtilesHeaderLength)))),
+          // Unique per opened file, so that a replaced archive never sees directories of the old one
+          cacheName(path + "#" + std::to_string(nextID++)) {
+        if ((header.internal_compression != pmtiles::COMPRESSION_NONE &&
+             header.internal_compression != pmtiles::COMPRESSION_GZIP) ||
+            (header.tile_compression != pmtiles::COMPRESSION_NONE &&
+             header.tile_compression != pmtiles::COMPRESSION_GZIP)) {
+            throw std::runtime_error("Compression method not supported");
+        }
+    }
+
+    // Archives are shared by all sources using the same file, and reopened when the file changes
+    static std::shared_ptr<LocalArchive> open(const std::string& path) {
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) {
+            return nullptr;
+        }
+
+        struct Registered {
+            std::weak_ptr<LocalArchive> archive;
+            decltype(info.st_size) size;
+            decltype(info.st_mtime) modified;
+        };
+        static std::mutex registryMutex;
+        static std::map<std::string, Registered> registry;
+
+        std::scoped_lock lock(registryMutex);
+        auto& registered = registry[path];
+        auto archive = registered.archive.lock();
+        if (!archive || registered.size != info.st_size || registered.modified != info.st_mtime) {
+            archive = std::make_shared<LocalArchive>(path);
+            registered = {.archive = archive, .size = info.st_size, .modified = info.st_mtime};
+        }
+        return archive;
+    }
+
+    const pmtiles::headerv3& getHeader() const { return header; }
+
+    // Returns the offset and length of the tile, or zeros if the archive doesn't contain it
+    std::pair<uint64_t, uint32_t> findTile(uint64_t tileID, DirectoryCache& cache) const {
+        auto directory = getDirectory(header.root_dir_offset, header.root_dir_bytes, cache);
+        for (uint32_t depth = 0;; ++depth) {
+            const pmtiles::entryv3 entry = pmtiles::find_tile(*directory, tileID);
+            if (entry.length == 0) {
+                return {0, 0};
+            }
+            if (entry.run_length > 0) {
+                return {header.tile_data_offset + entry.offset, entry.length};
+            }
+            if (depth == 3) {
+                throw std::runtime_error("Maximum directory depth exceeded");
+            }
+            directory = getDirectory(header.leaf_dirs_offset + entry.offset, entry.length, cache);
+        }
+    }
+
+    // Points into the mapping, valid as long as the archive is alive
+    std::string_view viewTile(std::pair<uint64_t, uint32_t> address) const {
+        return file.view(address.first, address.second);
+    }
+
+private:
+    std::shared_ptr<const Directory> getDirectory(uint64_t offset, uint64_t length, DirectoryCache& cache) const {
+        DirectoryKey key{.archive = cacheName, .offset = offset, .length = length};
+        if (auto directory = cache.get(key)) {
+            return directory;
+        }
+
+        const std::string_view data = file.view(offset, length);
+        auto directory = std::make_shared<const Directory>(pmtiles::deserialize_directory(
+            header.internal_compression == pmtiles::COMPRESSION_GZIP ? util::decompress(data) : std::string(data)));
+        cache.put(key, directory);
+        return directory;
+    }
+
+    static inline std::atomic<uint64_t> nextID{0};
+
+    const MappedFile file;
+    const pmtiles::headerv3 header;
+    const std::string cacheName;
+};
+
+} // namespace
+
 using AsyncCallback = std::function<void(std::unique_ptr<Response::Error>)>;
+using AsyncDirectoryCallback = std::function<void(std::shared_ptr<const Directory>, std::unique_ptr<Response::Error>)>;
 using AsyncTileCallback = std::function<void(std::pair<uint64_t, uint32_t>, std::unique_ptr<Response::Error>)>;
 
 class PMTilesFileSource::Impl {
 public:
     explicit Impl(const ActorRef<Impl>&, const ResourceOptions& resourceOptions_, const ClientOptions& clientOptions_)
         : resourceOptions(resourceOptions_.clone()),
-          clientOptions(clientOptions_.clone()) {}
+          clientOptions(clientOptions_.clone()),
+          ioPool(Scheduler::GetIO(clientOptions.ioThreadPoolSize())) {}
 
     // Generate a tilejson resource from .pmtiles file
     void request_tilejson(AsyncRequest* req, const Resource& resource, const ActorRef<FileSourceRequest>& ref) {
@@ -86,6 +353,11 @@ public:
     void request_tile(AsyncRequest* req, const Resource& resource, ActorRef<FileSourceRequest> ref) {
         auto url = extract_url(resource.url);
 
+        if (url.starts_with(util::FILE_PROTOCOL)) {
+            request_local_tile(url, *resource.tileData, ref);
+            return;
+        }
+
         getHeader(url, req, [=, this](std::unique_ptr<Response::Error> error) {
             if (error) {
                 Response response;
@@ -198,6 +470,61 @@ public:
         });
     }
 
+    // Local archives are read directly from a memory mapping on the I/O pool
+    void request_local_tile(const std::string& url,
+                            const Resource::TileData& tileData,
+                            const ActorRef<FileSourceRequest>& ref) {
+        const auto path = util::percentDecode(url.substr(std::char_traits<char>::length(util::FILE_PROTOCOL)));
+
+        ioPool->schedule([path, tileData, ref, cache = directory_cache] {
+            Response response;
+            response.noContent = true;
+
+            try {
+                auto archive = LocalArchive::open(path);
+                if (!archive) {
+                    response.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound,
+                                                                       "path not found: " + path);
+                    ref.invoke(&FileSourceRequest::setResponse, response);
+                    return;
+                }
+
+                const auto& header = archive->getHeader();
+                if (tileData.z >= header.min_zoom && tileData.z <= header.max_zoom) {
+                    const auto address = archive->findTile(pmtiles::zxy_to_tileid(static_cast<uint8_t>(tileData.z),
+                                                                                  static_cast<uint32_t>(tileData.x),
+                                                                                  static_cast<uint32_t>(tileData.y)),
+                                                           *cache);
+                    if (address.second > 0) {
+                        const std::string_view data = archive->viewTile(address);
+                        response.noContent = false;
+
+                        // Support uncompressed tiles. Compressed ones are inflated straight out of
+                        // the mapping, uncompressed ones are handed out as a slice of it.
+                        if (header.tile_compression == pmtiles::COMPRESSION_GZIP && util::is_compressed(data)) {
+                            try {
+                                response.data = std::make_shared<std::string>(util::decompress(data));
+                            } catch (const std::exception& e) {
+                                response.error = std::make_unique<Response::Error>(
+                                    Response::Error::Reason::Other,
+                                    std::string("Error decompressing PMTiles tile: ") + e.what());
+                            }
+                        } else {
+                            response.data = SharedBuffer(data.data(), data.size(), archive);
+                        }
+                    }
+                }
+            } catch (const std::exception& e) {
+                response.error = std::make_unique<Response::Error>(Response::Error::Reason::Other,
+                                                                   std::string("Error reading PMTiles tile: ") + e.what());
+            }
+
+            ref.invoke(&FileSourceRequest::setResponse, response);
+        });
+    }
+
+    PMTilesFileSource::DirectoryCacheStats getDirectoryCacheStats() { return directory_cache->getStats(); }
+
     void setResourceOptions(ResourceOptions options) {
         std::scoped_lock lock(resourceOptionsMutex);
         resourceOptions = options;
@@ -223,14 +550,21 @@ private:
     mutable std::mutex clientOptionsMutex;
     ResourceOptions resourceOptions;
     ClientOptions clientOptions;
+    std::shared_ptr<Scheduler> ioPool;
 
     std::shared_ptr<FileSource> fileSource;
     std::map<std::string, pmtiles::headerv3> header_cache;
     std::map<std::string, std::string> metadata_cache;
-    std::map<std::string, std::map<std::string, std::vector<pmtiles::entryv3>>> directory_cache;
-    std::map<std::string, std::vector<std::string>> directory_cache_control;
+    std::shared_ptr<DirectoryCache> directory_cache = std::make_shared<DirectoryCache>(MAX_DIRECTORY_CACHE_BYTES);
     std::map<AsyncRequest*, std::unique_ptr<AsyncRequest>> tasks;
 
+    // Directory fetches in flight, requests for the same directory wait for the first one
+    struct PendingDirectory {
+        std::unique_ptr<AsyncRequest> request;
+        std::vector<AsyncDirectoryCallback> callbacks;
+    };
+    std::unordered_map<DirectoryKey, PendingDirectory, DirectoryKeyHash> pending_directories;
+
     std::shared_ptr<FileSource> getFileSource() {
         if (!fileSource) {
             fileSource = FileSourceManager::get()->getFileSource(
@@ -283,7 +617,7 @@ private:
                 }
 
                 try {
-                    pmtiles::headerv3 header = pmtiles::deserialize_header(response.data->substr(0, 127));
+                    pmtiles::headerv3 header = pmtiles::deserialize_header(std::string(response.data->substr(0, 127)));
 
                     if ((header.internal_compression != pmtiles::COMPRESSION_NONE &&
                          header.internal_compression != pmtiles::COMPRESSION_GZIP) ||
@@ -447,7 +781,7 @@ private:
                             return;
                         }
 
-                        std::string data = *responseMetadata.data;
+                        std::string data(*responseMetadata.data);
 
                         if (header.internal_compression == pmtiles::COMPRESSION_GZIP) {
                             try {
@@ -470,23 +804,16 @@ private:
             });
     }
 
-    void storeDirectory(const std::string& url,
-                        uint64_t directoryOffset,
-                        uint64_t directoryLength,
-                        const std::string& directoryData) {
-        if (!directory_cache.contains(url)) {
-            directory_cache.emplace(url, std::map<std::string, std::vector<pmtiles::entryv3>>());
-            directory_cache_control.emplace(url, std::vector<std::string>());
+    void finishDirectory(const DirectoryKey& key,
+                         const std::shared_ptr<const Directory>& directory,
+                         std::unique_ptr<Response::Error> error) {
+        auto pending = pending_directories.extract(key);
+        if (pending.empty()) {
+            return;
         }
 
-        std::string directory_cache_key = url + "|" + std::to_string(directoryOffset) + "|" +
-                                          std::to_string(directoryLength);
-        directory_cache.at(url).emplace(directory_cache_key, pmtiles::deserialize_directory(directoryData));
-        directory_cache_control.at(url).emplace_back(directory_cache_key);
-
-        if (directory_cache_control.at(url).size() > MAX_DIRECTORY_CACHE_ENTRIES) {
-            directory_cache.at(url).erase(directory_cache_control.at(url).front());
-            directory_cache_control.at(url).erase(directory_cache_control.at(url).begin());
+        for (auto& callback : pending.mapped().callbacks) {
+            callback(directory, error ? std::make_unique<Response::Error>(*error) : nullptr);
         }
     }
 
@@ -494,30 +821,25 @@ private:
                       AsyncRequest* req,
                       uint64_t directoryOffset,
                       uint32_t directoryLength,
-                      AsyncCallback callback) {
-        std::string directory_cache_key = url + "|" + std::to_string(directoryOffset) + "|" +
-                                          std::to_string(directoryLength);
-
-        if (directory_cache.contains(url) && directory_cache.at(url).contains(directory_cache_key)) {
-            if (directory_cache_control.at(url).back() != directory_cache_key) {
-                directory_cache_control.at(url).emplace_back(directory_cache_key);
-
-                for (auto it = directory_cache_control.at(url).begin(); it != directory_cache_control.at(url).end();
-                     ++it) {
-                    if (*it == directory_cache_key) {
-                        directory_cache_control.at(url).erase(it);
-                        break;
-                    }
-                }
-            }
+                      AsyncDirectoryCallback callback) {
+        DirectoryKey key{.archive = url, .offset = directoryOffset, .length = directoryLength};
 
-            callback(std::unique_ptr<Response::Error>());
+        if (auto directory = directory_cache->get(key)) {
+            callback(std::move(directory), {});
+            return;
+        }
+
+        if (auto it = pending_directories.find(key); it != pending_directories.end()) {
+            directory_cache->addCoalesced();
+            it->second.callbacks.push_back(std::move(callback));
             return;
         }
 
+        pending_directories[key].callbacks.push_back(std::move(callback));
+
         getHeader(url, req, [=, this](std::unique_ptr<Response::Error> error) {
             if (error) {
-                callback(std::move(error));
+                finishDirectory(key, nullptr, std::move(error));
                 return;
             }
 
@@ -527,11 +849,13 @@ private:
             resource.loadingMethod = Resource::LoadingMethod::All;
             resource.dataRange = std::make_pair(directoryOffset, directoryOffset + directoryLength - 1);
 
-            tasks[req] = getFileSource()->request(resource, [=, this](const Response& response) {
+            auto request = getFileSource()->request(resource, [=, this](const Response& response) {
                 if (response.error) {
-                    callback(std::make_unique<Response::Error>(
-                        response.error->reason,
-                        std::string("Error fetching PMTiles directory: ") + response.error->message));
+                    finishDirectory(key,
+                                    nullptr,
+                                    std::make_unique<Response::Error>(
+                                        response.error->reason,
+                                        std::string("Error fetching PMTiles directory: ") + response.error->message));
 
                     return;
                 }
@@ -541,27 +865,39 @@ private:
                 }
 
                 if (!response.data) {
-                    callback(std::make_unique<Response::Error>(Response::Error::Reason::Other,
-                                                               "PMTiles directory response has no data"));
+                    finishDirectory(key,
+                                    nullptr,
+                                    std::make_unique<Response::Error>(Response::Error::Reason::Other,
+                                                                      "PMTiles directory response has no data"));
                     return;
                 }
 
+                std::shared_ptr<const Directory> directory;
                 try {
-                    std::string directoryData = *response.data;
-
                     if (header.internal_compression == pmtiles::COMPRESSION_GZIP) {
-                        directoryData = util::decompress(directoryData);
+                        directory = std::make_shared<const Directory>(
+                            pmtiles::deserialize_directory(util::decompress(*response.data)));
+                    } else {
+                        directory = std::make_shared<const Directory>(
+                            pmtiles::deserialize_directory(*response.data.string()));
                     }
-
-                    storeDirectory(url, directoryOffset, directoryLength, directoryData);
-
-                    callback(std::unique_ptr<Response::Error>());
                 } catch (const std::exception& e) {
-                    callback(std::make_unique<Response::Error>(
-                        Response::Error::Reason::Other,
-                        std::string(std::string("Error parsing PMTiles directory: ") + e.what())));
+                    finishDirectory(key,
+                                    nullptr,
+                                    std::make_unique<Response::Error>(
+                                        Response::Error::Reason::Other,
+                                        std::string(std::string("Error parsing PMTiles directory: ") + e.what())));
+                    return;
                 }
+
+                directory_cache->put(key, directory);
+                finishDirectory(key, directory, {});
             });
+
+            // The fetch may already have finished if the response was cached
+            if (auto it = pending_directories.find(key); it != pending_directories.end()) {
+                it->second.request = std::move(request);
+            }
         });
     }
 
@@ -586,17 +922,15 @@ private:
             req,
             directoryOffset,
             directoryLength,
-            [=, this](std::unique_ptr<Response::Error> error) { // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
+            [=, this](std::shared_ptr<const Directory> directory,
+                      std::unique_ptr<Response::Error> error) { // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
                 if (error) {
                     callback(std::make_pair(0, 0), std::move(error));
                     return;
                 }
 
                 pmtiles::headerv3 header = header_cache.at(url);
-                std::vector<pmtiles::entryv3> directory = directory_cache.at(url).at(
-                    url + "|" + std::to_string(directoryOffset) + "|" + std::to_string(directoryLength));
-
-                pmtiles::entryv3 entry = pmtiles::find_tile(directory, tileID);
+                pmtiles::entryv3 entry = pmtiles::find_tile(*directory, tileID);
 
                 if (entry.length > 0) {
                     if (entry.run_length > 0) {
@@ -670,4 +1004,8 @@ ClientOptions PMTilesFileSource::getClientOptions() {
     return thread->actor().ask(&Impl::getClientOptions).get();
 }
 
+PMTilesFileSource::DirectoryCacheStats PMTilesFileSource::getDirectoryCacheStats() {
+    return thread->actor().ask(&Impl::getDirectoryCacheStats).get();
+}
+
 } // namespace mbgl
@@ -50,6 +50,11 @@ static_assert(mbgl::underlying_type(ResultCode::Auth) == SQLITE_AUTH, "error");
 static_assert(mbgl::underlying_type(ResultCode::Range) == SQLITE_RANGE, "error");
 static_assert(mbgl::underlying_type(ResultCode::NotADB) == SQLITE_NOTADB, "error");
 
+static_assert(OpenFlag::ReadOnly == SQLITE_OPEN_READONLY, "error");
+static_assert(OpenFlag::ReadWriteCreate == (SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE), "error");
+static_assert(OpenFlag::NoMutex == SQLITE_OPEN_NOMUTEX, "error");
+static_assert(OpenFlag::SharedCache == SQLITE_OPEN_SHAREDCACHE, "error");
+
 void setTempPath(const std::string& path) {
     sqlite3_temp_directory = sqlite3_mprintf("%s", path.c_str());
 }
@@ -6,9 +6,20 @@
 #include <zlib.h>
 #endif
 
+#if defined(MLN_WITH_ZSTD)
+#include <zdict.h>
+#include <zstd.h>
+#endif
+
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
 // Check zlib library version.
 [[maybe_unused]] const static bool zlibVersionCheck = []() {
@@ -31,7 +42,7 @@ namespace util {
 // cause a link error.
 #undef compress
 
-bool is_compressed(const std::string &v) {
+bool is_compressed(std::string_view v) {
     if (v.size() > 2) {
         const auto byte0 = static_cast<uint8_t>(v[0]);
         const auto byte1 = static_cast<uint8_t>(v[1]);
@@ -54,7 +65,9 @@ bool is_compressed(const std::string &v) {
     return false;
 }
 
-std::string compress(const std::string &raw, int windowBits) {
+namespace {
+
+std::string deflateData(std::string_view raw, int windowBits, const std::string *dictionary) {
     z_stream deflate_stream;
     memset(&deflate_stream, 0, sizeof(deflate_stream));
 
@@ -63,6 +76,13 @@ std::string compress(const std::string &raw, int windowBits) {
         throw std::runtime_error("failed to initialize deflate");
     }
 
+    if (dictionary &&
+        deflateSetDictionary(
+            &deflate_stream, reinterpret_cast<const Bytef *>(dictionary->data()), uInt(dictionary->size())) != Z_OK) {
+        deflateEnd(&deflate_stream);
+        throw std::runtime_error("failed to set deflate dictionary");
+    }
+
     deflate_stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(raw.data()));
     deflate_stream.avail_in = uInt(raw.size());
 
@@ -89,7 +109,7 @@ std::string compress(const std::string &raw, int windowBits) {
     return result;
 }
 
-std::string decompress(const std::string &raw, int windowBits) {
+std::string inflateData(std::string_view raw, int windowBits, const DictionaryLookup &lookup) {
     z_stream inflate_stream;
     memset(&inflate_stream, 0, sizeof(inflate_stream));
 
@@ -109,6 +129,17 @@ std::string decompress(const std::string &raw, int windowBits) {
         inflate_stream.next_out = reinterpret_cast<Bytef *>(out);
         inflate_stream.avail_out = sizeof(out);
         code = inflate(&inflate_stream, 0);
+        if (code == Z_NEED_DICT) {
+            const std::string *dictionary = lookup ? lookup(Codec::Zlib, static_cast<std::uint32_t>(inflate_stream.adler))
+                                                   : nullptr;
+            if (!dictionary) {
+                inflateEnd(&inflate_stream);
+                throw std::runtime_error("missing zlib compression dictionary " +
+                                         std::to_string(inflate_stream.adler));
+            }
+            code = inflateSetDictionary(
+                &inflate_stream, reinterpret_cast<const Bytef *>(dictionary->data()), uInt(dictionary->size()));
+        }
         if (result.size() < inflate_stream.total_out) {
             result.append(out, inflate_stream.total_out - result.size());
         }
@@ -123,6 +154,272 @@ std::string decompress(const std::string &raw, int windowBits) {
     return result;
 }
 
+#if defined(MLN_WITH_ZSTD)
+constexpr int zstdLevel = 3;
+
+struct ZstdDeleter {
+    void operator()(ZSTD_CCtx *context) const { ZSTD_freeCCtx(context); }
+    void operator()(ZSTD_DCtx *context) const { ZSTD_freeDCtx(context); }
+    void operator()(ZSTD_CDict *dictionary) const { ZSTD_freeCDict(dictionary); }
+    void operator()(ZSTD_DDict *dictionary) const { ZSTD_freeDDict(dictionary); }
+};
+
+template <typename T>
+using ZstdPtr = std::unique_ptr<T, ZstdDeleter>;
+
+// Digested dictionaries are cached per thread by ID, since preparing one costs
+// more than compressing a typical tile.
+template <typename T, typename Create>
+T *cachedDictionary(std::unordered_map<unsigned, ZstdPtr<T>> &cache, unsigned id, Create &&create) {
+    auto it = cache.find(id);
+    if (it == cache.end()) {
+        if (cache.size() >= 8) {
+            cache.clear();
+        }
+        ZstdPtr<T> digested(create());
+        if (!digested) {
+            throw std::runtime_error("failed to load zstd dictionary");
+        }
+        it = cache.emplace(id, std::move(digested)).first;
+    }
+    return it->second.get();
+}
+
+std::string compressZstd(std::string_view raw, const std::string *dictionary) {
+    thread_local ZstdPtr<ZSTD_CCtx> context(ZSTD_createCCtx());
+    thread_local std::unordered_map<unsigned, ZstdPtr<ZSTD_CDict>> dictionaries;
+
+    std::string result(ZSTD_compressBound(raw.size()), '\0');
+    size_t size = 0;
+    if (dictionary) {
+        const unsigned id = ZSTD_getDictID_fromDict(dictionary->data(), dictionary->size());
+        if (id == 0) {
+            throw std::invalid_argument("zstd dictionaries must be created with trainDictionary()");
+        }
+        auto *digested = cachedDictionary(dictionaries, id, [&] {
+            return ZSTD_createCDict(dictionary->data(), dictionary->size(), zstdLevel);
+        });
+        size = ZSTD_compress_usingCDict(context.get(), result.data(), result.size(), raw.data(), raw.size(), digested);
+    } else {
+        size = ZSTD_compressCCtx(context.get(), result.data(), result.size(), raw.data(), raw.size(), zstdLevel);
+    }
+
+    if (ZSTD_isError(size)) {
+        throw std::runtime_error(ZSTD_getErrorName(size));
+    }
+    result.resize(size);
+    return result;
+}
+
+std::string decompressZstd(const std::string &raw, const DictionaryLookup &lookup) {
+    thread_local ZstdPtr<ZSTD_DCtx> context(ZSTD_createDCtx());
+    thread_local std::unordered_map<unsigned, ZstdPtr<ZSTD_DDict>> dictionaries;
+
+    const auto contentSize = ZSTD_getFrameContentSize(raw.data(), raw.size());
+    if (contentSize == ZSTD_CONTENTSIZE_ERROR || contentSize == ZSTD_CONTENTSIZE_UNKNOWN) {
+        throw std::runtime_error("invalid zstd frame");
+    }
+
+    std::string result(contentSize, '\0');
+    size_t size = 0;
+    if (const unsigned id = ZSTD_getDictID_fromFrame(raw.data(), raw.size())) {
+        const std::string *dictionary = lookup ? lookup(Codec::Zstd, id) : nullptr;
+        if (!dictionary) {
+            throw std::runtime_error("missing zstd compression dictionary " + std::to_string(id));
+        }
+        auto *digested = cachedDictionary(
+            dictionaries, id, [&] { return ZSTD_createDDict(dictionary->data(), dictionary->size()); });
+        size = ZSTD_decompress_usingDDict(
+            context.get(), result.data(), result.size(), raw.data(), raw.size(), digested);
+    } else {
+        size = ZSTD_decompressDCtx(context.get(), result.data(), result.size(), raw.data(), raw.size());
+    }
+
+    if (ZSTD_isError(size)) {
+        throw std::runtime_error(ZSTD_getErrorName(size));
+    }
+    result.resize(size);
+    return result;
+}
+#endif
+
+[[noreturn]] void unavailable(Codec codec) {
+    throw std::runtime_error("compression codec " + std::to_string(static_cast<int>(codec)) + " is not available");
+}
+
+// zlib has no trainer, so keep runs of bytes that recur across samples. deflate
+// only looks back 32 KiB and matches closer to the data are cheaper to encode,
+// so the most valuable strings go last.
+std::string trainZlibDictionary(const std::vector<std::string> &samples, std::size_t maxSize) {
+    constexpr std::size_t gramSize = 8;
+    maxSize = std::min<std::size_t>(maxSize, 32 * 1024);
+
+    // Number of samples each gram occurs in.
+    std::unordered_map<std::string_view, std::size_t> frequency;
+    for (const auto &sample : samples) {
+        std::unordered_set<std::string_view> seen;
+        for (std::size_t i = 0; i + gramSize <= sample.size(); ++i) {
+            const std::string_view gram(sample.data() + i, gramSize);
+            if (seen.insert(gram).second) {
+                ++frequency[gram];
+            }
+        }
+    }
+
+    // Maximal runs of shared grams, scored by length times how widely they are shared.
+    std::unordered_map<std::string_view, std::size_t> candidates;
+    for (const auto &sample : samples) {
+        std::size_t i = 0;
+        while (i + gramSize <= sample.size()) {
+            std::size_t shared = frequency[std::string_view(sample.data() + i, gramSize)];
+            if (shared < 2) {
+                ++i;
+                continue;
+            }
+            std::size_t end = i + 1;
+            while (end + gramSize <= sample.size()) {
+                const auto next = frequency[std::string_view(sample.data() + end, gramSize)];
+                if (next < 2) {
+                    break;
+                }
+                shared = std::min(shared, next);
+                ++end;
+            }
+            const std::string_view run(sample.data() + i, end - i + gramSize - 1);
+            auto &score = candidates[run];
+            score = std::max(score, shared * run.size());
+            i = end + gramSize - 1;
+        }
+    }
+
+    std::vector<std::pair<std::string_view, std::size_t>> ranked(candidates.begin(), candidates.end());
+    std::sort(ranked.begin(), ranked.end(), [](const auto &a, const auto &b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+
+    std::vector<std::string_view> selected;
+    std::size_t size = 0;
+    for (const auto &[run, score] : ranked) {
+        if (size + run.size() > maxSize) {
+            continue;
+        }
+        selected.push_back(run);
+        size += run.size();
+    }
+
+    std::string dictionary;
+    dictionary.reserve(size);
+    for (auto it = selected.rbegin(); it != selected.rend(); ++it) {
+        dictionary.append(*it);
+    }
+    return dictionary;
+}
+
+} // namespace
+
+std::string compress(std::string_view raw, int windowBits) {
+    return deflateData(raw, windowBits, nullptr);
+}
+
+std::string decompress(std::string_view raw, int windowBits) {
+    return inflateData(raw, windowBits, {});
+}
+
+bool isAvailable(Codec codec) {
+    switch (codec) {
+        case Codec::None:
+        case Codec::Zlib:
+            return true;
+        case Codec::Zstd:
+#if defined(MLN_WITH_ZSTD)
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+std::string compress(std::string_view raw, Codec codec, const std::string *dictionary) {
+    switch (codec) {
+        case Codec::None:
+            return std::string(raw);
+        case Codec::Zlib:
+            return deflateData(raw, CompressionFormat::ZLIB, dictionary);
+        case Codec::Zstd:
+#if defined(MLN_WITH_ZSTD)
+            return compressZstd(raw, dictionary);
+#else
+            break;
+#endif
+    }
+    unavailable(codec);
+}
+
+std::string decompress(const std::string &raw, Codec codec, const DictionaryLookup &lookup) {
+    switch (codec) {
+        case Codec::None:
+            return raw;
+        case Codec::Zlib:
+            return inflateData(raw, CompressionFormat::DETECT, lookup);
+        case Codec::Zstd:
+#if defined(MLN_WITH_ZSTD)
+            return decompressZstd(raw, lookup);
+#else
+            break;
+#endif
+    }
+    unavailable(codec);
+}
+
+std::uint32_t dictionaryID(Codec codec, const std::string &dictionary) {
+    switch (codec) {
+        case Codec::None:
+            return 0;
+        case Codec::Zlib:
+            return static_cast<std::uint32_t>(adler32(
+                adler32(0L, Z_NULL, 0), reinterpret_cast<const Bytef *>(dictionary.data()), uInt(dictionary.size())));
+        case Codec::Zstd:
+#if defined(MLN_WITH_ZSTD)
+            return ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size());
+#else
+            break;
+#endif
+    }
+    unavailable(codec);
+}
+
+std::string trainDictionary(Codec codec, const std::vector<std::string> &samples, std::size_t maxSize) {
+    switch (codec) {
+        case Codec::None:
+            throw std::invalid_argument("codec does not use dictionaries");
+        case Codec::Zlib:
+            return trainZlibDictionary(samples, maxSize);
+        case Codec::Zstd: {
+#if defined(MLN_WITH_ZSTD)
+            std::string buffer;
+            std::vector<size_t> sizes;
+            sizes.reserve(samples.size());
+            for (const auto &sample : samples) {
+                buffer.append(sample);
+                sizes.push_back(sample.size());
+            }
+            std::string dictionary(maxSize, '\0');
+            const size_t size = ZDICT_trainFromBuffer(
+                dictionary.data(), dictionary.size(), buffer.data(), sizes.data(), static_cast<unsigned>(sizes.size()));
+            if (ZDICT_isError(size)) {
+                throw std::runtime_error(ZDICT_getErrorName(size));
+            }
+            dictionary.resize(size);
+            return dictionary;
+#else
+            break;
+#endif
+        }
+    }
+    unavailable(codec);
+}
+
 std::uint32_t crc32(const void *raw, size_t size) noexcept {
     auto hash = ::crc32(0L, Z_NULL, 0);
     if (raw) {
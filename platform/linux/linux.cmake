@@ -181,6 +181,13 @@ target_link_libraries(
         mbgl-vendor-sqlite
 )
 
+if(MLN_WITH_ZSTD)
+    pkg_search_module(ZSTD libzstd REQUIRED)
+    target_include_directories(mbgl-core PRIVATE ${ZSTD_INCLUDE_DIRS})
+    target_link_libraries(mbgl-core PRIVATE ${ZSTD_LIBRARIES})
+    target_compile_definitions(mbgl-core PRIVATE MLN_WITH_ZSTD=1)
+endif()
+
 if(MLN_CREATE_AMALGAMATION)
     if ("${ARMERGE}" STREQUAL "MLN_CREATE_AMALGAMATION")
         message(FATAL_ERROR "armerge required when MLN_CREATE_AMALGAMATION=ON")
@@ -94,6 +94,11 @@ std::variant<Database, Exception> Database::tryOpen(const std::string& filename,
         connectOptions.append("QSQLITE_OPEN_READONLY");
     }
 
+    if (flags & OpenFlag::SharedCache) {
+        if (!connectOptions.isEmpty()) connectOptions.append(';');
+        connectOptions.append("QSQLITE_ENABLE_SHARED_CACHE");
+    }
+
     if (filename.compare(0, 5, "file:") == 0) {
         if (!connectOptions.isEmpty()) connectOptions.append(';');
         connectOptions.append("QSQLITE_OPEN_URI");
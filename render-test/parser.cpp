@@ -735,7 +735,7 @@ TestOperations parseTestOperations(TestMetadata& metadata) {
                 auto req = ctx.getFileSource().request(mbgl::Resource::image("mapbox://render-tests/" + imagePath),
                                                        [&](mbgl::Response response) {
                                                            if (response.data) {
-                                                               maybeImage = *response.data;
+                                                               maybeImage = *response.data.string();
                                                            }
 
                                                            requestCompleted = true;
@@ -159,11 +159,7 @@ void Mailbox::scheduleToRecieve(const std::optional<util::SimpleIdentity>& tag)
                 locked->receive();
             }
         };
-        if (tag) {
-            weakScheduler->schedule(*tag, std::move(setToRecieve));
-        } else {
-            weakScheduler->schedule(std::move(setToRecieve));
-        }
+        weakScheduler->scheduleWithPriority(tag, priority, std::move(setToRecieve));
     }
 }
 
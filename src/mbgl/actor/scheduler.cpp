@@ -3,6 +3,8 @@
 #include <mbgl/util/thread_pool.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <optional>
+
 namespace mbgl {
 
 std::function<void()> Scheduler::bindOnce(std::function<void()> fn) {
@@ -32,19 +34,47 @@ Scheduler* Scheduler::GetCurrent(bool init) {
     return localScheduler;
 }
 
-// static
-std::shared_ptr<Scheduler> Scheduler::GetBackground() {
-    static std::weak_ptr<Scheduler> weak;
-    static std::mutex mtx;
+namespace {
 
-    std::scoped_lock lock(mtx);
-    std::shared_ptr<Scheduler> scheduler = weak.lock();
+struct SharedPool {
+    std::weak_ptr<ThreadPool> weak;
+    std::mutex mutex;
 
-    if (!scheduler) {
-        weak = scheduler = std::make_shared<ThreadPool>();
+    std::shared_ptr<ThreadPool> get(std::optional<std::size_t> threadCount) {
+        std::scoped_lock lock(mutex);
+        std::shared_ptr<ThreadPool> pool = weak.lock();
+
+        if (!pool) {
+            weak = pool = threadCount ? std::make_shared<ThreadPool>(*threadCount) : std::make_shared<ThreadPool>();
+        } else if (threadCount) {
+            pool->reserve(*threadCount);
+        }
+
+        return pool;
     }
+};
+
+SharedPool& backgroundPool() {
+    static SharedPool pool;
+    return pool;
+}
 
-    return scheduler;
+} // namespace
+
+// static
+std::shared_ptr<Scheduler> Scheduler::GetBackground() {
+    return backgroundPool().get(std::nullopt);
+}
+
+// static
+std::shared_ptr<Scheduler> Scheduler::GetBackground(const ThreadPoolSize& size) {
+    return backgroundPool().get(size.threadCount());
+}
+
+// static
+std::shared_ptr<Scheduler> Scheduler::GetIO(const ThreadPoolSize& size) {
+    static SharedPool pool;
+    return pool.get(size.threadCount());
 }
 
 // static
@@ -8,6 +8,7 @@
 #include <mbgl/util/grid_index.hpp>
 #include <mbgl/util/mat4.hpp>
 
+#include <functional>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -138,6 +139,9 @@ public:
 
     void setBucketLayerIDs(const std::string& bucketLeaderID, const std::vector<std::string>& layerIDs);
 
+    /// Approximate memory held by the spatial index, in bytes. The tile data is not included.
+    std::size_t getCPUMemoryUsage() const { return sizeof(*this) + grid.bytes(); }
+
     std::unordered_map<std::string, std::vector<Feature>> lookupSymbolFeatures(
         const std::vector<IndexedSubfeature>& symbolFeatures,
         const RenderedQueryOptions& options,
@@ -60,6 +60,16 @@ RenderingStats& RenderingStats::operator+=(const RenderingStats& r) {
     memUniformBuffers += r.memUniformBuffers;
     stencilClears += r.stencilClears;
     stencilUpdates += r.stencilUpdates;
+    abortedTileWork += r.abortedTileWork;
+    reusedSymbolPlacements += r.reusedSymbolPlacements;
+    testedSymbolPlacements += r.testedSymbolPlacements;
+    gpuFrameTime += r.gpuFrameTime;
+    for (const auto& [name, time] : r.gpuRenderPassTimes) {
+        gpuRenderPassTimes[name] += time;
+    }
+    for (const auto& [name, time] : r.gpuLayerGroupTimes) {
+        gpuLayerGroupTimes[name] += time;
+    }
     return *this;
 }
 
@@ -106,6 +116,16 @@ std::string RenderingStats::toString(std::string_view sep) const {
     optionalStatLine(ss, memUniformBuffers, "memUniformBuffers", sep);
     optionalStatLine(ss, stencilClears, "stencilClears", sep);
     optionalStatLine(ss, stencilUpdates, "stencilUpdates", sep);
+    optionalStatLine(ss, abortedTileWork, "abortedTileWork", sep);
+    optionalStatLine(ss, reusedSymbolPlacements, "reusedSymbolPlacements", sep);
+    optionalStatLine(ss, testedSymbolPlacements, "testedSymbolPlacements", sep);
+    optionalStatLine(ss, gpuFrameTime, "gpuFrameTime", sep);
+    for (const auto& [name, time] : gpuRenderPassTimes) {
+        optionalStatLine(ss, time, "gpuRenderPassTime[" + name + "]", sep);
+    }
+    for (const auto& [name, time] : gpuLayerGroupTimes) {
+        optionalStatLine(ss, time, "gpuLayerGroupTime[" + name + "]", sep);
+    }
     return ss.str();
 }
 #endif
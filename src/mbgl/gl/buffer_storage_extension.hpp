@@ -0,0 +1,28 @@
+#pragma once
+
+#include <mbgl/gl/extension.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+
+namespace mbgl {
+namespace gl {
+namespace extension {
+
+using namespace platform;
+
+/// Immutable buffer storage, which can stay mapped while the GPU reads from it
+class BufferStorage {
+public:
+    template <typename Fn>
+    BufferStorage(const Fn& loadExtension)
+        : bufferStorage(loadExtension(
+              {{"GL_ARB_buffer_storage", "glBufferStorage"}, {"GL_EXT_buffer_storage", "glBufferStorageEXT"}})) {}
+
+    const ExtensionFunction<void(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags)> bufferStorage;
+};
+
+} // namespace extension
+} // namespace gl
+} // namespace mbgl
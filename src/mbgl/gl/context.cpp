@@ -8,6 +8,7 @@
 #include <mbgl/gl/renderer_backend.hpp>
 #include <mbgl/gl/renderbuffer_resource.hpp>
 #include <mbgl/gl/offscreen_texture.hpp>
+#include <mbgl/gl/buffer_storage_extension.hpp>
 #include <mbgl/gl/debugging_extension.hpp>
 #include <mbgl/gl/timestamp_query_extension.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
@@ -22,6 +23,7 @@
 #include <mbgl/gl/dynamic_texture.hpp>
 #include <mbgl/gl/layer_group_gl.hpp>
 #include <mbgl/gl/uniform_buffer_gl.hpp>
+#include <mbgl/gl/uniform_buffer_ring.hpp>
 #include <mbgl/gl/texture2d.hpp>
 #include <mbgl/renderer/render_target.hpp>
 #include <mbgl/shaders/gl/shader_program_gl.hpp>
@@ -107,11 +109,13 @@ Context::~Context() noexcept {
             globalUniformBuffers.set(i, nullptr);
         }
 
+        gpuTimer.reset();
         reset();
 
         // Delete all pooled resources while the context is still valid
         texturePool.reset();
         uboAllocator.reset();
+        uniformBufferRing.reset();
 
 #if !defined(NDEBUG)
         Log::Debug(Event::General, "Rendering Stats:\n" + stats.toString("\n"));
@@ -127,6 +131,10 @@ void Context::beginFrame() {
 
     frameInFlightFence = std::make_shared<gl::Fence>();
 
+    if (uniformBufferRing) {
+        uniformBufferRing->beginFrame();
+    }
+
     // Run allocator defragmentation on this frame interval.
     constexpr auto defragFreq = 4;
 
@@ -141,6 +149,13 @@ void Context::beginFrame() {
 void Context::endFrame() {
     MLN_TRACE_FUNC();
 
+    if (gpuTimer) {
+        gpuTimer->endFrame(stats);
+    }
+    if (uniformBufferRing) {
+        uniformBufferRing->endFrame();
+    }
+
     if (!frameInFlightFence) {
         return;
     }
@@ -174,10 +189,14 @@ void Context::initializeExtensions(const std::function<gl::ProcAddress(const cha
             debugging = std::make_unique<extension::Debugging>(fn);
         }
 
-// Currently GL timestamp queries are only used when Tracy profiling is enabled
-#ifdef MLN_TRACY_ENABLE
         extension::loadTimeStampQueryExtension(fn);
-#endif
+        disjointTimerQuery = strstr(extensions, "GL_EXT_disjoint_timer_query") != nullptr;
+
+        // Uniform buffers may already refer to the ring
+        if (!uniformBufferRing) {
+            bufferStorage = std::make_unique<extension::BufferStorage>(fn);
+            setUniformBufferRingEnabled(uniformBufferRingEnabled);
+        }
     }
     MLN_TRACE_GL_CONTEXT();
 }
@@ -237,11 +256,120 @@ UniqueProgram Context::createProgram(ShaderID vertexShader, ShaderID fragmentSha
     // AttributeLocations::getFirstAttribName.
     MBGL_CHECK_ERROR(glBindAttribLocation(result, 0, location0AttribName));
 
+    if (programBinaryCache) {
+        MBGL_CHECK_ERROR(glProgramParameteri(result, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+
     linkProgram(result);
 
     return result;
 }
 
+std::optional<UniqueProgram> Context::createProgram(const ProgramBinary& binary) {
+    MLN_TRACE_FUNC();
+
+    UniqueProgram result{MBGL_CHECK_ERROR(glCreateProgram()), {this}};
+    // Rejected binaries raise GL_INVALID_ENUM or leave the program unlinked, neither is an error here
+    glProgramBinary(result, binary.format, binary.data.data(), static_cast<GLsizei>(binary.data.size()));
+    while (glGetError() != GL_NO_ERROR) {
+        // Clear the error flags so that the next checked call doesn't report them
+    }
+
+    GLint status = GL_FALSE;
+    MBGL_CHECK_ERROR(glGetProgramiv(result, GL_LINK_STATUS, &status));
+    if (status != GL_TRUE) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+std::optional<ProgramBinary> Context::getProgramBinary(ProgramID program_) {
+    MLN_TRACE_FUNC();
+
+    GLint length = 0;
+    MBGL_CHECK_ERROR(glGetProgramiv(program_, GL_PROGRAM_BINARY_LENGTH, &length));
+    if (length <= 0) {
+        return std::nullopt;
+    }
+
+    ProgramBinary binary;
+    binary.data.resize(static_cast<std::size_t>(length));
+    GLsizei written = 0;
+    GLenum format = 0;
+    MBGL_CHECK_ERROR(glGetProgramBinary(program_, length, &written, &format, binary.data.data()));
+    if (written <= 0) {
+        return std::nullopt;
+    }
+    binary.data.resize(static_cast<std::size_t>(written));
+    binary.format = format;
+    return binary;
+}
+
+void Context::setProgramBinaryCacheDirectory(const std::string& directory) {
+    MLN_TRACE_FUNC();
+
+    programBinaryCache.reset();
+    if (directory.empty()) {
+        return;
+    }
+
+    GLint formats = 0;
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats));
+    if (formats <= 0) {
+        Log::Info(Event::Shader, "Program binaries are not supported, the program binary cache is disabled");
+        return;
+    }
+
+    // Binaries are only valid for the exact driver build that produced them
+    std::string driver;
+    for (const GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION}) {
+        if (const auto* value = reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(name)))) {
+            driver += value;
+        }
+        driver += '\n';
+    }
+    programBinaryCache = std::make_unique<ProgramBinaryCache>(directory, std::move(driver));
+}
+
+void Context::setGPUTimingEnabled(bool enable) {
+    if (!enable) {
+        if (gpuTimer) {
+            gpuTimer.reset();
+            stats.gpuFrameTime = 0.0;
+            stats.gpuRenderPassTimes.clear();
+            stats.gpuLayerGroupTimes.clear();
+        }
+    } else if (!gpuTimer && extension::timeStampQueriesSupported()) {
+        gpuTimer = std::make_unique<GPUTimer>(disjointTimerQuery);
+    }
+}
+
+void Context::setUniformBufferRingEnabled(bool enable) {
+    uniformBufferRingEnabled = enable;
+
+    // Allocated on first use and kept afterwards, since uniform buffers may still refer to it
+    if (enable && !uniformBufferRing && bufferStorage && bufferStorage->bufferStorage) {
+        uniformBufferRing = std::make_unique<UniformBufferRing>(*this, *bufferStorage);
+        if (!uniformBufferRing->isValid()) {
+            // Don't try again on every frame
+            uniformBufferRing.reset();
+            bufferStorage.reset();
+        }
+    }
+}
+
+void Context::beginGPUTimer(gfx::GPUTimerType type, std::string_view name) {
+    if (gpuTimer) {
+        gpuTimer->begin(type, name);
+    }
+}
+
+void Context::endGPUTimer() {
+    if (gpuTimer) {
+        gpuTimer->end();
+    }
+}
+
 void Context::linkProgram(ProgramID program_) {
     MLN_TRACE_FUNC();
 
@@ -546,7 +674,11 @@ gfx::UniformBufferPtr Context::createUniformBuffer(const void* data,
                                                    bool /*ssbo*/) {
     MLN_TRACE_FUNC();
 
-    return std::make_shared<gl::UniformBufferGL>(*this, data, size, *uboAllocator);
+    UniformBufferRing* ring = nullptr;
+    if (isUniformBufferRingEnabled() && size <= uniformBufferRing->getRegionSize()) {
+        ring = uniformBufferRing.get();
+    }
+    return std::make_shared<gl::UniformBufferGL>(*this, data, size, *uboAllocator, ring);
 }
 
 gfx::UniqueUniformBufferArray Context::createLayerUniformBufferArray() {
@@ -10,6 +10,8 @@
 #include <mbgl/gl/state.hpp>
 #include <mbgl/gl/value.hpp>
 #include <mbgl/gl/framebuffer.hpp>
+#include <mbgl/gl/gpu_timer.hpp>
+#include <mbgl/gl/program_binary_cache.hpp>
 #include <mbgl/gl/resource_pool.hpp>
 #include <mbgl/gl/vertex_array.hpp>
 #include <mbgl/gl/types.hpp>
@@ -34,8 +36,11 @@ class RendererBackend;
 namespace extension {
 class VertexArray;
 class Debugging;
+class BufferStorage;
 } // namespace extension
 
+class UniformBufferRing;
+
 class Context final : public gfx::Context {
 public:
     Context(RendererBackend&);
@@ -58,6 +63,27 @@ public:
     UniqueProgram createProgram(ShaderID vertexShader, ShaderID fragmentShader, const char* location0AttribName);
     void verifyProgramLinkage(ProgramID);
     void linkProgram(ProgramID);
+
+    /// Enables the on-disk program binary cache in `directory`, or disables it if empty.
+    /// Nothing is cached if the driver doesn't support any binary format.
+    void setProgramBinaryCacheDirectory(const std::string& directory);
+    const ProgramBinaryCache* getProgramBinaryCache() const { return programBinaryCache.get(); }
+    /// Creates a program from a binary, returns nothing if the driver rejects it.
+    std::optional<UniqueProgram> createProgram(const ProgramBinary&);
+    std::optional<ProgramBinary> getProgramBinary(ProgramID);
+
+    void setGPUTimingEnabled(bool) override;
+    bool isGPUTimingEnabled() const override { return gpuTimer != nullptr; }
+    void beginGPUTimer(gfx::GPUTimerType, std::string_view name) override;
+    void endGPUTimer() override;
+
+    /// Streams the uniform buffers created from now on through a persistently mapped ring buffer, which
+    /// replaces their individual updates. Requires buffer storage, disabled by default.
+    void setUniformBufferRingEnabled(bool) override;
+    bool isUniformBufferRingEnabled() const override { return uniformBufferRingEnabled && uniformBufferRing; }
+    UniformBufferRing* getUniformBufferRing() { return uniformBufferRing.get(); }
+    const UniformBufferRing* getUniformBufferRing() const { return uniformBufferRing.get(); }
+
     UniqueTexture createUniqueTexture(const Size& size, gfx::TexturePixelType format, gfx::TextureChannelDataType type);
 
     Framebuffer createFramebuffer(const gfx::Renderbuffer<gfx::RenderbufferPixelType::RGBA>&,
@@ -165,8 +191,14 @@ private:
     bool cleanupOnDestruction = true;
 
     std::unique_ptr<extension::Debugging> debugging;
+    std::unique_ptr<ProgramBinaryCache> programBinaryCache;
+    std::unique_ptr<GPUTimer> gpuTimer;
+    bool disjointTimerQuery = false;
     std::shared_ptr<gl::Fence> frameInFlightFence;
     std::unique_ptr<gl::UniformBufferAllocator> uboAllocator;
+    std::unique_ptr<extension::BufferStorage> bufferStorage;
+    std::unique_ptr<UniformBufferRing> uniformBufferRing;
+    bool uniformBufferRingEnabled = false;
     size_t frameNum = 0;
     UniformBufferArrayGL globalUniformBuffers;
 
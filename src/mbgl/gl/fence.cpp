@@ -65,5 +65,30 @@ bool Fence::isSignaled() const {
     }
 }
 
+void Fence::wait() const {
+    MLN_TRACE_FUNC();
+
+    if (!fence) {
+        return;
+    }
+
+    constexpr GLuint64 timeout = 100'000'000; // 100ms, in nanoseconds
+    while (true) {
+        switch (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout)) {
+            case GL_ALREADY_SIGNALED:
+                [[fallthrough]];
+            case GL_CONDITION_SATISFIED:
+                return;
+            case GL_TIMEOUT_EXPIRED:
+                break;
+            case GL_WAIT_FAILED:
+                throw std::runtime_error("glClientWaitSync failed. " + glErrors());
+            default:
+                assert(false); // unreachable
+                return;
+        }
+    }
+}
+
 } // namespace gl
 } // namespace mbgl
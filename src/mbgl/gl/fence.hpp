@@ -13,6 +13,8 @@ public:
 
     void insert() noexcept;
     bool isSignaled() const;
+    /// Blocks until the fence is signaled, returns immediately if it was never inserted
+    void wait() const;
 
 private:
     platform::GLsync fence{nullptr};
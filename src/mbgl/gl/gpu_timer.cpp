@@ -0,0 +1,159 @@
+#include <mbgl/gl/gpu_timer.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/gl/timestamp_query_extension.hpp>
+#include <mbgl/util/instrumentation.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <optional>
+
+namespace mbgl {
+namespace gl {
+
+using namespace platform;
+
+namespace {
+
+constexpr double secondsPerNanosecond = 1e-9;
+
+GLuint64 queryResult(GLuint query) {
+    GLuint64 value = 0;
+    MBGL_CHECK_ERROR(extension::glGetQueryObjectui64v(query, GL_QUERY_RESULT, &value));
+    return value;
+}
+
+} // namespace
+
+GPUTimer::GPUTimer(bool checkDisjoint_)
+    : checkDisjoint(checkDisjoint_) {
+    assert(extension::timeStampQueriesSupported());
+
+    if (checkDisjoint) {
+        // Reading the flag clears it, only what happens from now on matters
+        GLint disjoint = 0;
+        MBGL_CHECK_ERROR(glGetIntegerv(GL_GPU_DISJOINT, &disjoint));
+    }
+}
+
+GPUTimer::~GPUTimer() {
+    if (!queries.empty()) {
+        MBGL_CHECK_ERROR(extension::glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data()));
+    }
+}
+
+GLuint GPUTimer::timestamp() {
+    if (freeQueries.empty()) {
+        constexpr std::size_t batchSize = 32;
+        const auto first = queries.size();
+        queries.resize(first + batchSize);
+        MBGL_CHECK_ERROR(extension::glGenQueries(static_cast<GLsizei>(batchSize), queries.data() + first));
+        freeQueries.assign(queries.begin() + first, queries.end());
+    }
+
+    const GLuint query = freeQueries.back();
+    freeQueries.pop_back();
+    MBGL_CHECK_ERROR(extension::glQueryCounter(query, GL_TIMESTAMP));
+    current.lastQuery = query;
+    return query;
+}
+
+void GPUTimer::begin(gfx::GPUTimerType type, std::string_view name) {
+    openTimers.push_back(current.timers.size());
+    current.timers.push_back({.type = type, .name = std::string(name), .beginQuery = timestamp()});
+}
+
+void GPUTimer::end() {
+    assert(!openTimers.empty());
+    if (openTimers.empty()) {
+        return;
+    }
+    current.timers[openTimers.back()].endQuery = timestamp();
+    openTimers.pop_back();
+}
+
+bool GPUTimer::isAvailable(const Frame& frame) const {
+    GLuint available = GL_FALSE;
+    MBGL_CHECK_ERROR(extension::glGetQueryObjectuiv(frame.lastQuery, GL_QUERY_RESULT_AVAILABLE, &available));
+    return available == GL_TRUE;
+}
+
+void GPUTimer::read(const Frame& frame, gfx::RenderingStats& stats) const {
+    MLN_TRACE_FUNC();
+
+    stats.gpuRenderPassTimes.clear();
+    stats.gpuLayerGroupTimes.clear();
+
+    GLuint64 frameBegin = std::numeric_limits<GLuint64>::max();
+    GLuint64 frameEnd = 0;
+    for (const auto& timer : frame.timers) {
+        const GLuint64 begin = queryResult(timer.beginQuery);
+        const GLuint64 end = queryResult(timer.endQuery);
+        frameBegin = std::min(frameBegin, begin);
+        frameEnd = std::max(frameEnd, end);
+
+        auto& times = timer.type == gfx::GPUTimerType::RenderPass ? stats.gpuRenderPassTimes
+                                                                   : stats.gpuLayerGroupTimes;
+        times[timer.name] += static_cast<double>(end > begin ? end - begin : 0) * secondsPerNanosecond;
+    }
+    stats.gpuFrameTime = frameEnd > frameBegin ? static_cast<double>(frameEnd - frameBegin) * secondsPerNanosecond
+                                               : 0.0;
+}
+
+void GPUTimer::recycle(Frame& frame) {
+    for (const auto& timer : frame.timers) {
+        freeQueries.push_back(timer.beginQuery);
+        if (timer.endQuery) {
+            freeQueries.push_back(timer.endQuery);
+        }
+    }
+    frame.timers.clear();
+}
+
+void GPUTimer::endFrame(gfx::RenderingStats& stats) {
+    MLN_TRACE_FUNC();
+
+    // Close what was left open, an exception may have skipped the end of a scope
+    while (!openTimers.empty()) {
+        end();
+    }
+    if (!current.timers.empty()) {
+        pending.push_back(std::move(current));
+        current = {};
+    }
+
+    // Frames finish in order, skip to the newest finished one without waiting for any other
+    std::optional<Frame> finished;
+    while (!pending.empty() && isAvailable(pending.front())) {
+        if (finished) {
+            recycle(*finished);
+        }
+        finished = std::move(pending.front());
+        pending.pop_front();
+    }
+
+    GLint disjoint = 0;
+    if (checkDisjoint) {
+        MBGL_CHECK_ERROR(glGetIntegerv(GL_GPU_DISJOINT, &disjoint));
+    }
+    if (disjoint) {
+        // Any of the timestamps taken since the last check may be meaningless
+        for (auto& frame : pending) {
+            recycle(frame);
+        }
+        pending.clear();
+    } else if (finished) {
+        read(*finished, stats);
+    }
+    if (finished) {
+        recycle(*finished);
+    }
+
+    while (pending.size() > maxPendingFrames) {
+        recycle(pending.front());
+        pending.pop_front();
+    }
+}
+
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <mbgl/gfx/rendering_stats.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mbgl {
+namespace gl {
+
+/**
+ * @brief Measures the GPU time of nested scopes of GL commands with timestamp queries.
+ *
+ * A frame's results are read once the GPU has finished it, a few frames later, so reading
+ * them never waits for the GPU. Query objects are recycled from frame to frame; if the GPU
+ * falls more than a few frames behind, the oldest frame's results are dropped.
+ *
+ * Requires the timestamp query extension to be loaded, see `extension::timeStampQueriesSupported`.
+ */
+class GPUTimer {
+public:
+    /// @param checkDisjoint Whether the driver reports disjoint operations, such as frequency
+    /// changes, which invalidate the timestamps taken while they happen
+    explicit GPUTimer(bool checkDisjoint);
+    GPUTimer(const GPUTimer&) = delete;
+    GPUTimer& operator=(const GPUTimer&) = delete;
+    /// Deletes the query objects, the context must be current
+    ~GPUTimer();
+
+    void begin(gfx::GPUTimerType, std::string_view name);
+    void end();
+
+    /// Ends the current frame and reports the timings of the newest frame the GPU has finished
+    void endFrame(gfx::RenderingStats&);
+
+    /// Number of frames whose results have not been read yet
+    std::size_t getPendingFrameCount() const { return pending.size(); }
+
+private:
+    struct Timer {
+        gfx::GPUTimerType type;
+        std::string name;
+        platform::GLuint beginQuery;
+        platform::GLuint endQuery = 0;
+    };
+
+    struct Frame {
+        std::vector<Timer> timers;
+        /// The query issued last, its result is available after all the others
+        platform::GLuint lastQuery = 0;
+    };
+
+    platform::GLuint timestamp();
+    bool isAvailable(const Frame&) const;
+    void read(const Frame&, gfx::RenderingStats&) const;
+    void recycle(Frame&);
+
+    /// Frames the GPU may run behind before results are dropped
+    static constexpr std::size_t maxPendingFrames = 4;
+
+    const bool checkDisjoint;
+    Frame current;
+    /// Indices into `current.timers` of the timers begun but not ended
+    std::vector<std::size_t> openTimers;
+    std::deque<Frame> pending;
+    std::vector<platform::GLuint> freeQueries;
+    std::vector<platform::GLuint> queries;
+};
+
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,172 @@
+#include <mbgl/gl/program_binary_cache.hpp>
+#include <mbgl/util/instrumentation.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <system_error>
+
+namespace mbgl {
+namespace gl {
+
+namespace {
+
+constexpr uint64_t fnvPrime = 1099511628211ull;
+constexpr uint64_t fnvOffsetBasis = 14695981039346656037ull;
+// Any other basis gives an independent hash
+constexpr uint64_t digestOffsetBasis = 0x6c62272e07bb0142ull;
+
+constexpr char fileMagic[4] = {'M', 'L', 'P', 'B'};
+// Bump when the layout of the header or the key changes
+constexpr uint32_t fileVersion = 1;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t format;
+    uint32_t reserved;
+    uint64_t digest;
+    uint64_t checksum;
+    uint64_t size;
+};
+static_assert(sizeof(FileHeader) == 40, "the header layout is part of the file format");
+
+class Hasher {
+public:
+    explicit Hasher(uint64_t basis)
+        : value(basis) {}
+
+    void add(std::string_view bytes) {
+        for (const char byte : bytes) {
+            value = (value ^ static_cast<uint8_t>(byte)) * fnvPrime;
+        }
+        // Terminate every part, so that moving bytes between parts changes the hash
+        value = (value ^ 0xffu) * fnvPrime;
+    }
+
+    uint64_t value;
+};
+
+uint64_t checksum(std::string_view data) {
+    Hasher hasher(fnvOffsetBasis);
+    hasher.add(data);
+    return hasher.value;
+}
+
+} // namespace
+
+ProgramBinaryCache::ProgramBinaryCache(std::string directory_, std::string driver_)
+    : directory(std::move(directory_)),
+      driver(std::move(driver_)) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        Log::Warning(Event::Shader,
+                     "Cannot create program binary cache directory " + directory + ": " + error.message());
+    }
+}
+
+std::string ProgramBinaryCache::Key::fileName() const {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(name));
+    return std::string(buffer) + ".bin";
+}
+
+ProgramBinaryCache::Key ProgramBinaryCache::makeKey(std::initializer_list<const char*> vertexSources,
+                                                    std::initializer_list<const char*> fragmentSources,
+                                                    std::string_view location0AttribName) const {
+    MLN_TRACE_FUNC();
+
+    Hasher nameHasher(fnvOffsetBasis);
+    Hasher digestHasher(digestOffsetBasis);
+    const auto add = [&](std::string_view part) {
+        nameHasher.add(part);
+        digestHasher.add(part);
+    };
+
+    add(driver);
+    for (const char* source : vertexSources) {
+        add(source);
+    }
+    add("fragment");
+    for (const char* source : fragmentSources) {
+        add(source);
+    }
+    add(location0AttribName);
+
+    Key key;
+    key.name = nameHasher.value;
+    key.digest = digestHasher.value;
+    return key;
+}
+
+std::string ProgramBinaryCache::path(const Key& key) const {
+    return (std::filesystem::path(directory) / key.fileName()).string();
+}
+
+std::optional<ProgramBinary> ProgramBinaryCache::load(const Key& key) const {
+    MLN_TRACE_FUNC();
+
+    auto file = util::readFile(path(key));
+    if (!file || file->size() < sizeof(FileHeader)) {
+        return std::nullopt;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    const std::string_view data = std::string_view(*file).substr(sizeof(header));
+    if (std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0 || header.version != fileVersion ||
+        header.digest != key.digest || header.size != data.size() || header.checksum != checksum(data)) {
+        return std::nullopt;
+    }
+
+    file->erase(0, sizeof(header));
+    return ProgramBinary{header.format, std::move(*file)};
+}
+
+void ProgramBinaryCache::store(const Key& key, const ProgramBinary& binary) const {
+    MLN_TRACE_FUNC();
+
+    FileHeader header{};
+    std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+    header.version = fileVersion;
+    header.format = binary.format;
+    header.digest = key.digest;
+    header.checksum = checksum(binary.data);
+    header.size = binary.data.size();
+
+    // A unique temporary name keeps concurrent writers from interleaving
+    const std::string target = path(key);
+    const std::string temporary = target + "." + std::to_string(std::random_device()()) + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data.data(), static_cast<std::streamsize>(binary.data.size()));
+        if (!file.good()) {
+            Log::Warning(Event::Shader, "Cannot write program binary " + temporary);
+            file.close();
+            std::error_code ignored;
+            std::filesystem::remove(temporary, ignored);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, target, error);
+    if (error) {
+        Log::Warning(Event::Shader, "Cannot store program binary " + target + ": " + error.message());
+        std::filesystem::remove(temporary, error);
+    }
+}
+
+void ProgramBinaryCache::remove(const Key& key) const {
+    std::error_code ignored;
+    std::filesystem::remove(path(key), ignored);
+}
+
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace mbgl {
+namespace gl {
+
+/// A linked program as returned by `glGetProgramBinary`.
+struct ProgramBinary {
+    uint32_t format = 0;
+    std::string data;
+};
+
+/**
+ * @brief Stores linked program binaries in a directory, one file per program.
+ *
+ * Programs are keyed by their complete shader sources, which include the
+ * defines selecting the permutation, and by the driver that linked them.
+ * Files are checked against the key and a checksum of the binary before
+ * they are handed out; anything that doesn't match reads as a miss. The
+ * driver may still reject a binary, e.g. after an update that kept the
+ * version string, so callers have to verify the link status and fall back
+ * to compiling.
+ *
+ * Files are written to a temporary name and renamed into place, so any
+ * number of processes can share a directory.
+ */
+class ProgramBinaryCache {
+public:
+    /// `driver` identifies the GL implementation, binaries linked by others are never loaded.
+    ProgramBinaryCache(std::string directory, std::string driver);
+
+    class Key {
+    public:
+        /// The name of the file in the cache directory
+        std::string fileName() const;
+
+    private:
+        friend class ProgramBinaryCache;
+        uint64_t name = 0;
+        // Computed with a different seed, guards against collisions of `name`
+        uint64_t digest = 0;
+    };
+
+    Key makeKey(std::initializer_list<const char*> vertexSources,
+                std::initializer_list<const char*> fragmentSources,
+                std::string_view location0AttribName) const;
+
+    std::optional<ProgramBinary> load(const Key&) const;
+    /// Best effort, failures are logged and otherwise ignored.
+    void store(const Key&, const ProgramBinary&) const;
+    /// Removes a binary that the driver rejected.
+    void remove(const Key&) const;
+
+    const std::string& getDirectory() const { return directory; }
+
+private:
+    std::string path(const Key&) const;
+
+    const std::string directory;
+    const std::string driver;
+};
+
+} // namespace gl
+} // namespace mbgl
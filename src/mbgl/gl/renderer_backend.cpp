@@ -28,9 +28,20 @@ std::unique_ptr<gfx::Context> RendererBackend::createContext() {
         *this); // Tagged background thread pool will be owned by the RendererBackend
     result->enableDebugging();
     result->initializeExtensions(std::bind(&RendererBackend::getExtensionFunctionPointer, this, std::placeholders::_1));
+    result->setProgramBinaryCacheDirectory(programBinaryCacheDirectory);
     return result;
 }
 
+void RendererBackend::setProgramBinaryCacheDirectory(std::string directory) {
+    MLN_TRACE_FUNC();
+
+    programBinaryCacheDirectory = std::move(directory);
+    if (context) {
+        gfx::BackendScope guard{*this};
+        getContext<gl::Context>().setProgramBinaryCacheDirectory(programBinaryCacheDirectory);
+    }
+}
+
 PremultipliedImage RendererBackend::readFramebuffer(const Size& size) {
     MLN_TRACE_FUNC();
 
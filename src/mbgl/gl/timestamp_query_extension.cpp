@@ -13,23 +13,27 @@ using namespace platform;
 namespace {
 
 constexpr const char *const extName = "GL_EXT_disjoint_timer_query";
+// Desktop OpenGL has the same functions, without the suffix
+constexpr const char *const arbExtName = "GL_ARB_timer_query";
+
+ProcAddress load(const GlContexsLoader &loadExtension, const char *name, const char *nameEXT) {
+    return loadExtension({{extName, name}, {extName, nameEXT}, {arbExtName, name}});
+}
 
 struct TimestampQueryLoader {
     TimestampQueryLoader(const GlContexsLoader &loadExtension)
-        : glGenQueries(loadExtension({{extName, "glGenQueries"}, {extName, "glGenQueriesEXT"}})),
-          glDeleteQueries(loadExtension({{extName, "glDeleteQueries"}, {extName, "glDeleteQueriesEXT"}})),
-          glIsQuery(loadExtension({{extName, "glIsQuery"}, {extName, "glIsQueryEXT"}})),
-          glBeginQuery(loadExtension({{extName, "glBeginQuery"}, {extName, "glBeginQueryEXT"}})),
-          glEndQuery(loadExtension({{extName, "glEndQuery"}, {extName, "glEndQueryEXT"}})),
-          glQueryCounter(loadExtension({{extName, "glQueryCounter"}, {extName, "glQueryCounterEXT"}})),
-          glGetQueryiv(loadExtension({{extName, "glGetQueryiv"}, {extName, "glGetQueryivEXT"}})),
-          glGetQueryObjectiv(loadExtension({{extName, "glGetQueryObjectiv"}, {extName, "glGetQueryObjectivEXT"}})),
-          glGetQueryObjectuiv(loadExtension({{extName, "glGetQueryObjectuiv"}, {extName, "glGetQueryObjectuivEXT"}})),
-          glGetQueryObjecti64v(
-              loadExtension({{extName, "glGetQueryObjecti64v"}, {extName, "glGetQueryObjecti64vEXT"}})),
-          glGetQueryObjectui64v(
-              loadExtension({{extName, "glGetQueryObjectui64v"}, {extName, "glGetQueryObjectui64vEXT"}})),
-          glGetInteger64v(loadExtension({{extName, "glGetInteger64v"}, {extName, "glGetInteger64vEXT"}})) {}
+        : glGenQueries(load(loadExtension, "glGenQueries", "glGenQueriesEXT")),
+          glDeleteQueries(load(loadExtension, "glDeleteQueries", "glDeleteQueriesEXT")),
+          glIsQuery(load(loadExtension, "glIsQuery", "glIsQueryEXT")),
+          glBeginQuery(load(loadExtension, "glBeginQuery", "glBeginQueryEXT")),
+          glEndQuery(load(loadExtension, "glEndQuery", "glEndQueryEXT")),
+          glQueryCounter(load(loadExtension, "glQueryCounter", "glQueryCounterEXT")),
+          glGetQueryiv(load(loadExtension, "glGetQueryiv", "glGetQueryivEXT")),
+          glGetQueryObjectiv(load(loadExtension, "glGetQueryObjectiv", "glGetQueryObjectivEXT")),
+          glGetQueryObjectuiv(load(loadExtension, "glGetQueryObjectuiv", "glGetQueryObjectuivEXT")),
+          glGetQueryObjecti64v(load(loadExtension, "glGetQueryObjecti64v", "glGetQueryObjecti64vEXT")),
+          glGetQueryObjectui64v(load(loadExtension, "glGetQueryObjectui64v", "glGetQueryObjectui64vEXT")),
+          glGetInteger64v(load(loadExtension, "glGetInteger64v", "glGetInteger64vEXT")) {}
 
     ExtensionFunction<void(GLsizei n, GLuint *ids)> glGenQueries;
     ExtensionFunction<void(GLsizei n, const GLuint *ids)> glDeleteQueries;
@@ -117,6 +121,12 @@ void loadTimeStampQueryExtension(const GlContexsLoader &loadExtension) {
     loader = std::make_unique<TimestampQueryLoader>(loadExtension);
 }
 
+bool timeStampQueriesSupported() {
+    const auto &loader = singleton();
+    return loader && loader->glGenQueries && loader->glDeleteQueries && loader->glQueryCounter &&
+           loader->glGetQueryObjectuiv && loader->glGetQueryObjectui64v;
+}
+
 } // namespace extension
 } // namespace gl
 } // namespace mbgl
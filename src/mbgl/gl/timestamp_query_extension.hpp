@@ -36,6 +36,9 @@ using GlContexsLoader = std::function<ProcAddress(std::initializer_list<std::pai
 
 void loadTimeStampQueryExtension(const GlContexsLoader &loadExtension);
 
+/// Whether the functions needed to read timestamps were loaded
+bool timeStampQueriesSupported();
+
 } // namespace extension
 } // namespace gl
 } // namespace mbgl
@@ -1,5 +1,6 @@
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/uniform_buffer_gl.hpp>
+#include <mbgl/gl/uniform_buffer_ring.hpp>
 #include <mbgl/gl/defines.hpp>
 #include <mbgl/util/compression.hpp>
 #include <mbgl/util/instrumentation.hpp>
@@ -26,13 +27,18 @@ int64_t generateDebugId() noexcept {
 
 } // namespace
 
-UniformBufferGL::UniformBufferGL(Context& context_, const void* data_, std::size_t size_, IBufferAllocator& allocator_)
+UniformBufferGL::UniformBufferGL(Context& context_,
+                                 const void* data_,
+                                 std::size_t size_,
+                                 IBufferAllocator& allocator_,
+                                 UniformBufferRing* ring_)
     : UniformBuffer(size_),
       context(context_),
 #ifdef MLN_TRACY_ENABLE
       uniqueDebugId(generateDebugId()),
 #endif
-      managedBuffer(allocator_, this) {
+      managedBuffer(allocator_, this),
+      ring(ring_) {
 
     context.renderingStats().numUniformBuffers++;
     context.renderingStats().memUniformBuffers += size;
@@ -48,6 +54,14 @@ UniformBufferGL::UniformBufferGL(Context& context_, const void* data_, std::size
 #endif
 
     MLN_TRACE_ALLOC_CONST_BUFFER(uniqueDebugId, size_);
+    if (ring) {
+        // Written to the ring when bound
+        streamedContents.resize(size_);
+        if (data_) {
+            std::memcpy(streamedContents.data(), data_, size_);
+        }
+        return;
+    }
     if (forceDisableManagedAllocation || size_ > managedBuffer.allocator.pageSize()) {
         // Buffer is very large, won't fit in the provided allocator
         MBGL_CHECK_ERROR(glGenBuffers(1, &localID));
@@ -69,8 +83,14 @@ UniformBufferGL::UniformBufferGL(UniformBufferGL&& rhs) noexcept
 #endif
       isManagedAllocation(rhs.isManagedAllocation),
       localID(rhs.localID),
-      managedBuffer(std::move(rhs.managedBuffer)) {
+      managedBuffer(std::move(rhs.managedBuffer)),
+      ring(rhs.ring),
+      streamedContents(std::move(rhs.streamedContents)),
+      ringFrame(rhs.ringFrame),
+      ringOffset(rhs.ringOffset),
+      localCurrent(rhs.localCurrent) {
     managedBuffer.setOwner(this);
+    rhs.localID = 0;
 #ifdef MLN_TRACY_ENABLE
     rhs.uniqueDebugId = -1;
 #endif
@@ -82,9 +102,14 @@ UniformBufferGL::UniformBufferGL(const UniformBufferGL& other)
 #ifdef MLN_TRACY_ENABLE
       uniqueDebugId(generateDebugId()),
 #endif
-      managedBuffer(other.managedBuffer.allocator, this) {
+      managedBuffer(other.managedBuffer.allocator, this),
+      ring(other.ring),
+      streamedContents(other.streamedContents) {
     MLN_TRACE_ALLOC_CONST_BUFFER(uniqueDebugId, other.size);
     managedBuffer.setOwner(this);
+    if (ring) {
+        return;
+    }
     if (other.isManagedAllocation) {
         managedBuffer.allocate(other.managedBuffer.getContents().data(), other.size);
     } else {
@@ -121,12 +146,36 @@ UniformBufferGL::~UniformBufferGL() {
 BufferID UniformBufferGL::getID() const {
     if (isManagedAllocation) {
         return managedBuffer.getBufferID();
+    } else if (ring && ringFrame == ring->getFrame()) {
+        return ring->getBufferID();
     } else {
         return localID;
     }
 }
 
 void UniformBufferGL::update(const void* data, std::size_t dataSize) {
+    if (ring) {
+        assert(dataSize <= size);
+        if (dataSize > size) {
+            Log::Error(Event::General,
+                       "Mismatched size given to UBO update, expected max " + std::to_string(size) + ", got " +
+                           std::to_string(dataSize));
+            return;
+        }
+        if (std::memcmp(data, streamedContents.data(), dataSize) == 0) {
+            return;
+        }
+
+        // No GL call, the new contents are written to the ring when next bound
+        std::memcpy(streamedContents.data(), data, dataSize);
+        ringFrame.reset();
+        localCurrent = false;
+
+        context.renderingStats().numUniformUpdates++;
+        context.renderingStats().uniformUpdateBytes += dataSize;
+        return;
+    }
+
     assert(isManagedAllocation ? dataSize <= managedBuffer.getContents().size() : dataSize <= size);
 
     if (dataSize > size || (isManagedAllocation && dataSize > managedBuffer.getContents().size())) {
@@ -155,19 +204,55 @@ void UniformBufferGL::update(const void* data, std::size_t dataSize) {
     context.renderingStats().bufferUpdateBytes += dataSize;
 }
 
+void UniformBufferGL::bind(std::size_t index) const {
+    const auto binding = static_cast<GLuint>(index);
+    if (!ring) {
+        MBGL_CHECK_ERROR(
+            glBindBufferRange(GL_UNIFORM_BUFFER, binding, getID(), managedBuffer.getBindingOffset(), size));
+        return;
+    }
+
+    // Copied once per frame, however many drawables bind it
+    if (ringFrame != ring->getFrame()) {
+        if (const auto offset = ring->write(streamedContents.data(), size)) {
+            ringFrame = ring->getFrame();
+            ringOffset = *offset;
+        }
+    }
+    if (ringFrame == ring->getFrame()) {
+        MBGL_CHECK_ERROR(glBindBufferRange(
+            GL_UNIFORM_BUFFER, binding, ring->getBufferID(), static_cast<GLintptr>(ringOffset), size));
+    } else {
+        // The ring is full until the next frame
+        uploadLocal();
+        MBGL_CHECK_ERROR(glBindBufferRange(GL_UNIFORM_BUFFER, binding, localID, 0, size));
+    }
+}
+
+void UniformBufferGL::uploadLocal() const {
+    if (localCurrent) {
+        return;
+    }
+    if (!localID) {
+        MBGL_CHECK_ERROR(glGenBuffers(1, &localID));
+    }
+    MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, localID));
+    MBGL_CHECK_ERROR(glBufferData(GL_UNIFORM_BUFFER, size, streamedContents.data(), GL_DYNAMIC_DRAW));
+    MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+    localCurrent = true;
+
+    context.renderingStats().bufferUpdates++;
+    context.renderingStats().bufferObjUpdates++;
+    context.renderingStats().bufferUpdateBytes += size;
+}
+
 void UniformBufferArrayGL::bind() const {
     MLN_TRACE_FUNC();
 
     for (size_t id = 0; id < allocatedSize(); id++) {
         const auto& uniformBuffer = get(id);
         if (!uniformBuffer) continue;
-        GLint binding = static_cast<GLint>(id);
-        const auto& uniformBufferGL = static_cast<const UniformBufferGL&>(*uniformBuffer);
-        MBGL_CHECK_ERROR(glBindBufferRange(GL_UNIFORM_BUFFER,
-                                           binding,
-                                           uniformBufferGL.getID(),
-                                           uniformBufferGL.getManagedBuffer().getBindingOffset(),
-                                           uniformBufferGL.getSize()));
+        static_cast<const UniformBufferGL&>(*uniformBuffer).bind(id);
     }
 }
 
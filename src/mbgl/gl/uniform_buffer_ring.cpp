@@ -0,0 +1,138 @@
+#include <mbgl/gl/uniform_buffer_ring.hpp>
+#include <mbgl/gl/buffer_storage_extension.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/util/instrumentation.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace mbgl {
+namespace gl {
+
+using namespace platform;
+
+namespace {
+
+constexpr GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+} // namespace
+
+UniformBufferRing::UniformBufferRing(Context& context_, const extension::BufferStorage& storage_)
+    : context(context_),
+      storage(storage_) {
+    assert(storage.bufferStorage);
+
+    GLint offsetAlignment = 0;
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment));
+    alignment = std::max<std::size_t>(1, static_cast<std::size_t>(offsetAlignment));
+
+    allocate(initialRegionSize);
+}
+
+UniformBufferRing::~UniformBufferRing() {
+    release();
+}
+
+void UniformBufferRing::allocate(std::size_t size) {
+    MLN_TRACE_FUNC();
+    assert(!buffer);
+
+    const auto totalSize = static_cast<GLsizeiptr>(size * regionCount);
+    MBGL_CHECK_ERROR(glGenBuffers(1, &buffer));
+    MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, buffer));
+    MBGL_CHECK_ERROR(storage.bufferStorage(GL_UNIFORM_BUFFER, totalSize, nullptr, mapFlags));
+    mapped = static_cast<std::byte*>(MBGL_CHECK_ERROR(glMapBufferRange(GL_UNIFORM_BUFFER, 0, totalSize, mapFlags)));
+    MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+    regionSize = size;
+
+    auto& stats = context.renderingStats();
+    stats.totalBuffers++;
+    stats.numBuffers++;
+    stats.memBuffers += size * regionCount;
+
+    if (!mapped) {
+        Log::Warning(Event::OpenGL, "Failed to map the uniform buffer ring");
+    }
+}
+
+void UniformBufferRing::release() {
+    if (!buffer) {
+        return;
+    }
+
+    if (mapped) {
+        MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, buffer));
+        MBGL_CHECK_ERROR(glUnmapBuffer(GL_UNIFORM_BUFFER));
+        MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+        mapped = nullptr;
+    }
+    // The driver keeps the storage alive until the GPU is done with it
+    MBGL_CHECK_ERROR(glDeleteBuffers(1, &buffer));
+    buffer = 0;
+
+    auto& stats = context.renderingStats();
+    stats.numBuffers--;
+    stats.memBuffers -= regionSize * regionCount;
+
+    for (auto& fence : fences) {
+        fence.reset();
+    }
+}
+
+void UniformBufferRing::beginFrame() {
+    MLN_TRACE_FUNC();
+
+    if (overflowed && regionSize < maxRegionSize) {
+        // A fresh buffer doesn't have to wait for any frame in flight
+        const auto size = std::min(regionSize * 2, maxRegionSize);
+        release();
+        allocate(size);
+        region = 0;
+    } else {
+        region = (region + 1) % regionCount;
+    }
+
+    if (auto& fence = fences[region]) {
+        fence->wait();
+        fence.reset();
+        ++fenceWaits;
+    }
+
+    pointer = 0;
+    overflowed = false;
+    ++frame;
+}
+
+void UniformBufferRing::endFrame() {
+    if (buffer && !fences[region]) {
+        fences[region] = std::make_unique<Fence>();
+        fences[region]->insert();
+    }
+}
+
+std::optional<std::size_t> UniformBufferRing::write(const void* data, std::size_t size) {
+    if (!mapped) {
+        return std::nullopt;
+    }
+
+    const auto offset = (pointer + alignment - 1) / alignment * alignment;
+    if (offset + size > regionSize) {
+        overflowed = true;
+        return std::nullopt;
+    }
+
+    const auto bufferOffset = region * regionSize + offset;
+    std::memcpy(mapped + bufferOffset, data, size);
+    pointer = offset + size;
+
+    auto& stats = context.renderingStats();
+    stats.bufferUpdates++;
+    stats.bufferUpdateBytes += size;
+    return bufferOffset;
+}
+
+} // namespace gl
+} // namespace mbgl
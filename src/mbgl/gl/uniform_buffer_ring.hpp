@@ -0,0 +1,85 @@
+#pragma once
+
+#include <mbgl/gl/fence.hpp>
+#include <mbgl/gl/types.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace mbgl {
+namespace gl {
+
+class Context;
+
+namespace extension {
+class BufferStorage;
+} // namespace extension
+
+/**
+ * @brief A uniform buffer split into one region per frame in flight, mapped once for its whole lifetime.
+ *
+ * Uniform data is copied linearly into the current frame's region and bound by offset, in place of
+ * updating a buffer of its own. A region is written again once the GPU has finished the frame which
+ * last used it. When a frame runs out of space, the regions are reallocated twice as large at the
+ * start of the next one.
+ *
+ * Requires buffer storage, see `extension::BufferStorage`.
+ */
+class UniformBufferRing {
+public:
+    UniformBufferRing(Context&, const extension::BufferStorage&);
+    UniformBufferRing(const UniformBufferRing&) = delete;
+    UniformBufferRing& operator=(const UniformBufferRing&) = delete;
+    /// Deletes the buffer, the context must be current
+    ~UniformBufferRing();
+
+    /// Moves on to the next region, waiting for the GPU to finish reading it if needed
+    void beginFrame();
+    /// Marks the end of the commands reading the current region
+    void endFrame();
+
+    /// Copies `size` bytes into the current region
+    /// @return The offset of the copy in the buffer, or nothing if the region is full
+    std::optional<std::size_t> write(const void* data, std::size_t size);
+
+    bool isValid() const { return mapped != nullptr; }
+    BufferID getBufferID() const { return buffer; }
+    std::size_t getRegionSize() const { return regionSize; }
+
+    /// Identifies the current frame, the offsets returned by `write` are only valid until it changes
+    std::uint64_t getFrame() const { return frame; }
+    /// Number of times a frame had to wait for the GPU to release its region
+    std::size_t getFenceWaits() const { return fenceWaits; }
+
+    static constexpr std::size_t regionCount = 3;
+    static constexpr std::size_t initialRegionSize = 1024 * 1024;
+    static constexpr std::size_t maxRegionSize = 32 * 1024 * 1024;
+
+private:
+    void allocate(std::size_t size);
+    void release();
+
+    Context& context;
+    const extension::BufferStorage& storage;
+
+    BufferID buffer = 0;
+    std::byte* mapped = nullptr;
+    std::size_t regionSize = 0;
+    std::size_t alignment = 1;
+
+    std::size_t region = 0;
+    /// The next free byte in the current region
+    std::size_t pointer = 0;
+    std::uint64_t frame = 0;
+    /// Whether a write didn't fit in the current region
+    bool overflowed = false;
+    std::size_t fenceWaits = 0;
+    /// Signaled once the GPU has finished with each region
+    std::array<std::unique_ptr<Fence>, regionCount> fences;
+};
+
+} // namespace gl
+} // namespace mbgl
@@ -8,6 +8,7 @@
 #include <mbgl/style/layer_properties.hpp>
 #include <mbgl/util/containers.hpp>
 
+#include <atomic>
 #include <list>
 
 namespace mbgl {
@@ -98,6 +99,7 @@ public:
         : sourceLayer(std::move(sourceLayer_)),
           zoom(parameters.tileID.overscaledZ),
           overscaling(parameters.tileID.overscaleFactor()),
+          obsolete(parameters.obsolete),
           hasPattern(false) {
         assert(!group.empty());
         auto leaderLayerProperties = staticImmutableCast<LayerPropertiesType>(group.front());
@@ -124,7 +126,7 @@ public:
         }
 
         const size_t featureCount = sourceLayer->featureCount();
-        for (size_t i = 0; i < featureCount; ++i) {
+        for (size_t i = 0; i < featureCount && !parameters.isObsolete(); ++i) {
             auto feature = sourceLayer->getFeature(i);
             if (!leaderLayerProperties->layerImpl().filter(
                     style::expression::EvaluationContext(this->zoom, feature.get())
@@ -189,6 +191,9 @@ public:
                       const CanonicalTileID& canonical) override {
         auto bucket = std::make_shared<BucketType>(layout, layerPropertiesMap, zoom, overscaling);
         for (auto& patternFeature : features) {
+            if (obsolete && obsolete->load(std::memory_order_relaxed)) {
+                return;
+            }
             const auto i = patternFeature.i;
             std::unique_ptr<GeometryTileFeature> feature = std::move(patternFeature.feature);
             const PatternLayerMap& patterns = patternFeature.getPatterns();
@@ -214,6 +219,7 @@ protected:
 
     const float zoom;
     const uint32_t overscaling;
+    const std::atomic<bool>* const obsolete;
     std::string sourceLayerID;
     bool hasPattern;
 };
@@ -125,6 +125,7 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
       canonicalID(parameters.tileID.canonical),
       mode(parameters.mode),
       pixelRatio(parameters.pixelRatio),
+      obsolete(parameters.obsolete),
       tileSize(static_cast<uint32_t>(util::tileSize_D * overscaling)),
       tilePixelRatio(static_cast<float>(util::EXTENT) / tileSize),
       layout(createLayout(toSymbolLayerProperties(layers.at(0)).layerImpl().layout, zoom)) {
@@ -169,6 +170,11 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
     // Determine glyph dependencies
     const size_t featureCount = sourceLayer->featureCount();
     for (size_t i = 0; i < featureCount; ++i) {
+        if (isObsolete()) {
+            features.clear();
+            return;
+        }
+
         auto feature = sourceLayer->getFeature(i);
         if (!leader.filter(expression::EvaluationContext(this->zoom, feature.get())
                                .withCanonicalTileID(&parameters.tileID.canonical)))
@@ -590,6 +596,10 @@ void SymbolLayout::prepareSymbols(const GlyphMap& glyphMap,
     const bool textAlongLine = layout->get<TextRotationAlignment>() == AlignmentType::Map && !isPointPlacement;
 
     for (auto it = features.begin(); it != features.end(); ++it) {
+        if (isObsolete()) {
+            break;
+        }
+
         auto& feature = *it;
         if (feature.geometry.empty()) continue;
 
@@ -1032,6 +1042,9 @@ void SymbolLayout::createBucket(const ImagePositions&,
                                                  iconsInText);
 
     for (SymbolInstance& symbolInstance : bucket->symbolInstances) {
+        if (isObsolete()) {
+            return;
+        }
         if (!symbolInstance.check(SYM_GUARD_LOC)) {
             continue;
         }
@@ -10,6 +10,7 @@
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/util/containers.hpp>
 
+#include <atomic>
 #include <memory>
 #include <map>
 #include <vector>
@@ -129,6 +130,10 @@ private:
     const CanonicalTileID canonicalID;
     const MapMode mode;
     const float pixelRatio;
+    // Owned by the tile, set when the work can be abandoned
+    const std::atomic<bool>* const obsolete;
+
+    bool isObsolete() const { return obsolete && obsolete->load(std::memory_order_relaxed); }
 
     const uint32_t tileSize;
     const float tilePixelRatio;
@@ -1,3 +1,4 @@
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/layermanager/layer_manager.hpp>
 #include <mbgl/map/map_impl.hpp>
 #include <mbgl/renderer/update_parameters.hpp>
@@ -10,6 +11,8 @@
 #include <mbgl/util/action_journal_impl.hpp>
 #include <mbgl/gfx/rendering_stats.hpp>
 
+#include <tuple>
+
 namespace mbgl {
 
 #if !defined(NDEBUG)
@@ -55,9 +58,16 @@ Map::Impl::Impl(RendererFrontend& frontend_,
       pixelRatio(mapOptions.pixelRatio()),
       crossSourceCollisions(mapOptions.crossSourceCollisions()),
       fastPFOREnabled(mapOptions.fastPFOREnabled()),
+      parallelPlacement(mapOptions.parallelPlacement()),
+      incrementalPlacement(mapOptions.incrementalPlacement()),
       fileSource(std::move(fileSource_)),
       style(std::make_unique<style::Style>(fileSource, pixelRatio, frontend_.getThreadPool())),
       annotationManager(*style) {
+    if (const auto workerThreads = mapOptions.workerThreadPoolSize()) {
+        // Grow the shared worker pool if this map asks for more parsing threads than it currently runs
+        std::ignore = Scheduler::GetBackground(*workerThreads);
+    }
+
     transform.setNorthOrientation(mapOptions.northOrientation());
     style->impl->setObserver(this);
     rendererFrontend.setObserver(*this);
@@ -134,6 +144,8 @@ void Map::Impl::onUpdate() {
                                .stillImageRequest = bool(stillImageRequest),
                                .crossSourceCollisions = crossSourceCollisions,
                                .fastPFOREnabled = fastPFOREnabled,
+                               .parallelPlacement = parallelPlacement,
+                               .incrementalPlacement = incrementalPlacement,
                                .tileLodMinRadius = tileLodMinRadius,
                                .tileLodScale = tileLodScale,
                                .tileLodPitchThreshold = tileLodPitchThreshold,
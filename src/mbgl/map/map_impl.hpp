@@ -92,6 +92,8 @@ public:
     const float pixelRatio;
     const bool crossSourceCollisions;
     const bool fastPFOREnabled;
+    const bool parallelPlacement;
+    const bool incrementalPlacement;
 
     MapDebugOptions debugOptions{MapDebugOptions::NoDebug};
     std::unique_ptr<gfx::RenderingStatsView> renderingStatsView;
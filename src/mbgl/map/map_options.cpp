@@ -12,6 +12,9 @@ public:
     Size size = {64, 64};
     float pixelRatio = 1.0;
     bool fastPFOREnabled = false;
+    bool parallelPlacement = false;
+    bool incrementalPlacement = false;
+    std::optional<ThreadPoolSize> workerThreadPoolSize;
 };
 
 // These requires the complete type of Impl.
@@ -92,4 +95,31 @@ bool MapOptions::fastPFOREnabled() const {
     return impl_->fastPFOREnabled;
 }
 
+MapOptions& MapOptions::withParallelPlacement(bool enable) {
+    impl_->parallelPlacement = enable;
+    return *this;
+}
+
+bool MapOptions::parallelPlacement() const {
+    return impl_->parallelPlacement;
+}
+
+MapOptions& MapOptions::withIncrementalPlacement(bool enable) {
+    impl_->incrementalPlacement = enable;
+    return *this;
+}
+
+bool MapOptions::incrementalPlacement() const {
+    return impl_->incrementalPlacement;
+}
+
+MapOptions& MapOptions::withWorkerThreadPoolSize(ThreadPoolSize size) {
+    impl_->workerThreadPoolSize = size;
+    return *this;
+}
+
+std::optional<ThreadPoolSize> MapOptions::workerThreadPoolSize() const {
+    return impl_->workerThreadPoolSize;
+}
+
 } // namespace mbgl
@@ -51,6 +51,10 @@ public:
 
     virtual bool hasData() const = 0;
 
+    /// Approximate CPU memory held by the bucket in bytes. GPU buffers and textures
+    /// made from its data are not included.
+    virtual std::size_t getCPUMemoryUsage() const { return 0; }
+
     virtual float getQueryRadius(const RenderLayer&) const { return 0; };
 
     bool needsUpload() const { return hasData() && !uploaded; }
@@ -81,6 +85,7 @@ public:
 
 protected:
     Bucket() = default;
+
     std::atomic<bool> uploaded{false};
 
     util::SimpleIdentity bucketID;
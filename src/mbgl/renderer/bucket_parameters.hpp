@@ -3,6 +3,8 @@
 #include <mbgl/map/mode.hpp>
 #include <mbgl/tile/tile_id.hpp>
 
+#include <atomic>
+
 namespace mbgl {
 namespace style {
 struct LayerTypeInfo;
@@ -14,6 +16,11 @@ public:
     const MapMode mode;
     const float pixelRatio;
     const style::LayerTypeInfo* layerType;
+    /// Set once the tile no longer needs this work, checked by layouts and buckets
+    /// at cooperative cancellation points.
+    const std::atomic<bool>* obsolete = nullptr;
+
+    bool isObsolete() const { return obsolete && obsolete->load(std::memory_order_relaxed); }
 };
 
 } // namespace mbgl
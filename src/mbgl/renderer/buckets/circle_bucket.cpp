@@ -32,6 +32,10 @@ bool CircleBucket::hasData() const {
     return !segments.empty();
 }
 
+std::size_t CircleBucket::getCPUMemoryUsage() const {
+    return vertices.bytes() + triangles.bytes();
+}
+
 namespace {
 template <class Property>
 float get(const CirclePaintProperties::PossiblyEvaluated& evaluated,
@@ -82,6 +82,10 @@ bool FillBucket::hasData() const {
     return !triangleSegments.empty() || !basicLineSegments.empty();
 }
 
+std::size_t FillBucket::getCPUMemoryUsage() const {
+    return vertices.bytes() + triangles.bytes() + lineVertices.bytes() + lineIndexes.bytes() + basicLines.bytes();
+}
+
 float FillBucket::getQueryRadius(const RenderLayer& layer) const {
     using namespace style;
     const auto& evaluated = getEvaluated<FillLayerProperties>(layer.evaluatedProperties);
@@ -43,6 +43,8 @@ public:
 
     bool hasData() const override;
 
+    std::size_t getCPUMemoryUsage() const override;
+
     void upload(gfx::UploadPass&) override;
 
     float getQueryRadius(const RenderLayer&) const override;
@@ -137,6 +137,10 @@ bool LineBucket::hasData() const {
     return !segments.empty();
 }
 
+std::size_t LineBucket::getCPUMemoryUsage() const {
+    return vertices.bytes() + triangles.bytes();
+}
+
 namespace {
 template <class Property>
 float get(const LinePaintProperties::PossiblyEvaluated& evaluated,
@@ -105,4 +105,8 @@ bool RasterBucket::hasData() const {
     return !!image;
 }
 
+std::size_t RasterBucket::getCPUMemoryUsage() const {
+    return (image ? image->bytes() : 0) + vertices.bytes() + indices.bytes();
+}
+
 } // namespace mbgl
@@ -96,6 +96,30 @@ bool SymbolBucket::hasData() const {
            hasTextCollisionBoxData() || hasIconCollisionCircleData() || hasTextCollisionCircleData();
 }
 
+std::size_t SymbolBucket::getCPUMemoryUsage() const {
+    const auto bufferUsage = [](const Buffer& buffer) {
+        return buffer.vertices().bytes() + buffer.dynamicVertices().bytes() + buffer.opacityVertices().bytes() +
+               buffer.triangles.bytes() + buffer.placedSymbols.size() * sizeof(PlacedSymbol);
+    };
+    const auto collisionUsage = [](const CollisionBuffer& buffer) {
+        return buffer.vertices().bytes() + buffer.dynamicVertices().bytes();
+    };
+
+    std::size_t bytes = bufferUsage(text) + bufferUsage(icon) + bufferUsage(sdfIcon) +
+                        symbolInstances.size() * sizeof(SymbolInstance);
+    for (const auto* box : {iconCollisionBox.get(), textCollisionBox.get()}) {
+        if (box) {
+            bytes += collisionUsage(*box) + box->lines.bytes();
+        }
+    }
+    for (const auto* circle : {iconCollisionCircle.get(), textCollisionCircle.get()}) {
+        if (circle) {
+            bytes += collisionUsage(*circle) + circle->triangles.bytes();
+        }
+    }
+    return bytes;
+}
+
 bool SymbolBucket::hasTextData() const {
     return !text.segments.empty();
 }
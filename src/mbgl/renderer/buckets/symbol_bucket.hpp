@@ -228,6 +228,8 @@ public:
 
     void upload(gfx::UploadPass&) override;
     bool hasData() const override;
+
+    std::size_t getCPUMemoryUsage() const override;
     std::pair<uint32_t, bool> registerAtCrossTileIndex(CrossTileSymbolLayerIndex&, const RenderTile&) override;
     void place(Placement&, const BucketPlacementData&, std::set<uint32_t>&) override;
     void updateVertices(
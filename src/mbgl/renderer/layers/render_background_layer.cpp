@@ -1,12 +1,14 @@
 #include <mbgl/renderer/layers/render_background_layer.hpp>
 #include <mbgl/gfx/context.hpp>
 #include <mbgl/gfx/cull_face_mode.hpp>
+#include <mbgl/gfx/shader_registry.hpp>
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/pattern_atlas.hpp>
 #include <mbgl/renderer/render_pass.hpp>
 #include <mbgl/renderer/render_static_data.hpp>
+#include <mbgl/renderer/shader_warm_up.hpp>
 #include <mbgl/renderer/upload_parameters.hpp>
 #include <mbgl/style/layers/background_layer_impl.hpp>
 #include <mbgl/style/layer_properties.hpp>
@@ -232,4 +234,17 @@ void RenderBackgroundLayer::update(gfx::ShaderRegistry& shaders,
     }
 }
 
+void RenderBackgroundLayer::collectShaderPermutations(gfx::ShaderRegistry& shaders,
+                                                      std::vector<ShaderPermutation>& permutations) const {
+    // A transparent background isn't drawn at all
+    const auto& evaluated = getEvaluated<BackgroundLayerProperties>(evaluatedProperties);
+    if (evaluated.get<style::BackgroundOpacity>() == 0.0f) {
+        return;
+    }
+
+    const bool hasPattern = !evaluated.get<BackgroundPattern>().to.empty();
+    const auto name = hasPattern ? BackgroundPatternShaderName : BackgroundPlainShaderName;
+    permutations.push_back({shaders.getShaderGroup(std::string(name)), {}});
+}
+
 } // namespace mbgl
@@ -7,6 +7,7 @@
 #include <mbgl/renderer/buckets/circle_bucket.hpp>
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
+#include <mbgl/renderer/shader_warm_up.hpp>
 #include <mbgl/style/layers/circle_layer_impl.hpp>
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/util/math.hpp>
@@ -292,4 +293,23 @@ void RenderCircleLayer::update(gfx::ShaderRegistry& shaders,
     }
 }
 
+void RenderCircleLayer::collectShaderPermutations(gfx::ShaderRegistry& shaders,
+                                                  std::vector<ShaderPermutation>& permutations) const {
+    if (!(mbgl::underlying_type(RenderPass::Translucent) & evaluatedProperties->renderPasses)) {
+        return;
+    }
+
+    const auto& evaluated = static_cast<const CircleLayerProperties&>(*evaluatedProperties).evaluated;
+    ShaderPermutation permutation{shaders.getShaderGroup(CircleShaderGroupName), {}};
+    gfx::VertexAttributeArray::getDataDrivenPropertiesAsUniforms<CircleColor,
+                                                                 CircleRadius,
+                                                                 CircleBlur,
+                                                                 CircleOpacity,
+                                                                 CircleStrokeColor,
+                                                                 CircleStrokeWidth,
+                                                                 CircleStrokeOpacity>(
+        evaluated, permutation.propertiesAsUniforms, idCircleColorVertexAttribute);
+    permutations.push_back(std::move(permutation));
+}
+
 } // namespace mbgl
@@ -22,6 +22,8 @@ public:
                 const RenderTree&,
                 UniqueChangeRequestVec&) override;
 
+    void collectShaderPermutations(gfx::ShaderRegistry&, std::vector<ShaderPermutation>&) const override;
+
 private:
     void transition(const TransitionParameters&) override;
     void evaluate(const PropertyEvaluationParameters&) override;
@@ -10,6 +10,7 @@
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/render_static_data.hpp>
 #include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/renderer/shader_warm_up.hpp>
 #include <mbgl/renderer/tile_render_data.hpp>
 #include <mbgl/style/expression/image.hpp>
 #include <mbgl/style/layers/fill_extrusion_layer_impl.hpp>
@@ -494,4 +495,29 @@ void RenderFillExtrusionLayer::update(gfx::ShaderRegistry& shaders,
     }
 }
 
+void RenderFillExtrusionLayer::collectShaderPermutations(gfx::ShaderRegistry& shaders,
+                                                         std::vector<ShaderPermutation>& permutations) const {
+    if (passes == RenderPass::None) {
+        return;
+    }
+
+    const auto& evaluated = static_cast<const FillExtrusionLayerProperties&>(*evaluatedProperties).evaluated;
+    const auto hasPattern = !unevaluated.get<FillExtrusionPattern>().isUndefined();
+    StringIDSetsPair propertiesAsUniforms;
+    gfx::VertexAttributeArray::getDataDrivenPropertiesAsUniforms<FillExtrusionBase,
+                                                                 FillExtrusionColor,
+                                                                 FillExtrusionHeight,
+                                                                 FillExtrusionPattern>(
+        evaluated, propertiesAsUniforms, idFillExtrusionBaseVertexAttribute);
+
+#if MLN_USE_FILL_EXTRUSION_INSTANCING
+    permutations.push_back(
+        {shaders.getShaderGroup(hasPattern ? "FillExtrusionPatternInstancedShader" : "FillExtrusionInstancedShader"),
+         propertiesAsUniforms});
+#endif
+    permutations.push_back(
+        {shaders.getShaderGroup(hasPattern ? "FillExtrusionPatternShader" : "FillExtrusionShader"),
+         std::move(propertiesAsUniforms)});
+}
+
 } // namespace mbgl
@@ -27,6 +27,8 @@ private:
                 const RenderTree&,
                 UniqueChangeRequestVec&) override;
 
+    void collectShaderPermutations(gfx::ShaderRegistry&, std::vector<ShaderPermutation>&) const override;
+
     bool queryIntersectsFeature(const GeometryCoordinates&,
                                 const GeometryTileFeature&,
                                 float,
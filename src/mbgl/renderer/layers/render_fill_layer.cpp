@@ -10,6 +10,7 @@
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/renderer/shader_warm_up.hpp>
 #include <mbgl/renderer/tile_render_data.hpp>
 #include <mbgl/style/expression/image.hpp>
 #include <mbgl/style/layers/fill_layer_impl.hpp>
@@ -539,4 +540,36 @@ void RenderFillLayer::update(gfx::ShaderRegistry& shaders,
     }
 }
 
+void RenderFillLayer::collectShaderPermutations(gfx::ShaderRegistry& shaders,
+                                                std::vector<ShaderPermutation>& permutations) const {
+    const auto& evaluated = getEvaluated<FillLayerProperties>(evaluatedProperties);
+    StringIDSetsPair propertiesAsUniforms;
+    gfx::VertexAttributeArray::getDataDrivenPropertiesAsUniforms<FillColor, FillOpacity, FillOutlineColor, FillPattern>(
+        evaluated, propertiesAsUniforms, idFillColorVertexAttribute);
+
+    const bool pattern = !unevaluated.get<FillPattern>().isUndefined();
+    const auto doOutline = evaluated.get<FillAntialias>() &&
+                           (!pattern || unevaluated.get<FillOutlineColor>().isUndefined());
+
+    permutations.push_back(
+        {shaders.getShaderGroup(std::string(pattern ? FillPatternShaderName : FillShaderName)), propertiesAsUniforms});
+    if (!doOutline) {
+        return;
+    }
+#if MLN_TRIANGULATE_FILL_OUTLINES
+    const bool dataDrivenOutline = !evaluated.get<FillOutlineColor>().isConstant() ||
+                                   !evaluated.get<FillOpacity>().isConstant();
+    if (!pattern && !dataDrivenOutline) {
+        // `update` still creates the plain outline shader below to set up the outline builder
+        permutations.push_back(
+            {shaders.getShaderGroup(std::string(FillOutlineTriangulatedShaderName)),
+             {{"a_color", "a_opacity", "a_width"},
+              {idLineColorVertexAttribute, idLineOpacityVertexAttribute, idLineWidthVertexAttribute}}});
+    }
+#endif
+    permutations.push_back(
+        {shaders.getShaderGroup(std::string(pattern ? FillOutlinePatternShaderName : FillOutlineShaderName)),
+         std::move(propertiesAsUniforms)});
+}
+
 } // namespace mbgl
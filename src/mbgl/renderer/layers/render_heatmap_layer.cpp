@@ -3,6 +3,7 @@
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/render_static_data.hpp>
+#include <mbgl/renderer/shader_warm_up.hpp>
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/style/layers/heatmap_layer_impl.hpp>
 #include <mbgl/geometry/feature_index.hpp>
@@ -393,4 +394,18 @@ void RenderHeatmapLayer::update(gfx::ShaderRegistry& shaders,
     }
 }
 
+void RenderHeatmapLayer::collectShaderPermutations(gfx::ShaderRegistry& shaders,
+                                                   std::vector<ShaderPermutation>& permutations) const {
+    if (!(mbgl::underlying_type(RenderPass::Translucent) & evaluatedProperties->renderPasses)) {
+        return;
+    }
+
+    const auto& evaluated = static_cast<const HeatmapLayerProperties&>(*evaluatedProperties).evaluated;
+    ShaderPermutation permutation{shaders.getShaderGroup(HeatmapShaderGroupName), {}};
+    gfx::VertexAttributeArray::getDataDrivenPropertiesAsUniforms<HeatmapWeight, HeatmapRadius>(
+        evaluated, permutation.propertiesAsUniforms, idHeatmapWeightVertexAttribute);
+    permutations.push_back(std::move(permutation));
+    permutations.push_back({shaders.getShaderGroup(HeatmapTextureShaderGroupName), {}});
+}
+
 } // namespace mbgl
@@ -30,6 +30,8 @@ public:
                 const RenderTree&,
                 UniqueChangeRequestVec&) override;
 
+    void collectShaderPermutations(gfx::ShaderRegistry&, std::vector<ShaderPermutation>&) const override;
+
 private:
     void transition(const TransitionParameters&) override;
     void evaluate(const PropertyEvaluationParameters&) override;
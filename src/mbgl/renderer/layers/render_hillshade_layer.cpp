@@ -4,6 +4,7 @@
 #include <mbgl/renderer/sources/render_raster_dem_source.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/render_static_data.hpp>
+#include <mbgl/renderer/shader_warm_up.hpp>
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/style/layers/hillshade_layer_impl.hpp>
 #include <mbgl/gfx/cull_face_mode.hpp>
@@ -388,4 +389,10 @@ void RenderHillshadeLayer::update(gfx::ShaderRegistry& shaders,
     }
 }
 
+void RenderHillshadeLayer::collectShaderPermutations(gfx::ShaderRegistry& shaders,
+                                                     std::vector<ShaderPermutation>& permutations) const {
+    permutations.push_back({shaders.getShaderGroup(HillshadePrepareShaderGroupName), {}});
+    permutations.push_back({shaders.getShaderGroup(HillshadeShaderGroupName), {}});
+}
+
 } // namespace mbgl
@@ -9,6 +9,7 @@
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/renderer/shader_warm_up.hpp>
 #include <mbgl/renderer/tile_render_data.hpp>
 #include <mbgl/renderer/upload_parameters.hpp>
 #include <mbgl/style/expression/image.hpp>
@@ -504,4 +505,30 @@ void RenderLineLayer::update(gfx::ShaderRegistry& shaders,
     }
 }
 
+void RenderLineLayer::collectShaderPermutations(gfx::ShaderRegistry& shaders,
+                                                std::vector<ShaderPermutation>& permutations) const {
+    const auto& evaluated = getEvaluated<LineLayerProperties>(evaluatedProperties);
+    ShaderPermutation permutation{nullptr, {}, posNormalAttribName};
+    gfx::VertexAttributeArray::getDataDrivenPropertiesAsUniforms<LineColor,
+                                                                 LineBlur,
+                                                                 LineOpacity,
+                                                                 LineGapWidth,
+                                                                 LineOffset,
+                                                                 LineWidth,
+                                                                 LineFloorWidth,
+                                                                 LinePattern>(
+        evaluated, permutation.propertiesAsUniforms, idLineColorVertexAttribute);
+
+    if (!evaluated.get<LineDasharray>().from.empty()) {
+        permutation.group = shaders.getShaderGroup("LineSDFShader");
+    } else if (!unevaluated.get<LinePattern>().isUndefined()) {
+        permutation.group = shaders.getShaderGroup("LinePatternShader");
+    } else if (!unevaluated.get<LineGradient>().getValue().isUndefined()) {
+        permutation.group = shaders.getShaderGroup("LineGradientShader");
+    } else {
+        permutation.group = shaders.getShaderGroup("LineShader");
+    }
+    permutations.push_back(std::move(permutation));
+}
+
 } // namespace mbgl
@@ -3,10 +3,12 @@
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/render_static_data.hpp>
+#include <mbgl/renderer/shader_warm_up.hpp>
 #include <mbgl/renderer/sources/render_image_source.hpp>
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/gfx/context.hpp>
 #include <mbgl/gfx/cull_face_mode.hpp>
+#include <mbgl/gfx/shader_registry.hpp>
 #include <mbgl/math/angles.hpp>
 #include <mbgl/style/layers/raster_layer_impl.hpp>
 #include <mbgl/util/logging.hpp>
@@ -366,4 +368,9 @@ void RenderRasterLayer::update(gfx::ShaderRegistry& shaders,
     }
 }
 
+void RenderRasterLayer::collectShaderPermutations(gfx::ShaderRegistry& shaders,
+                                                  std::vector<ShaderPermutation>& permutations) const {
+    permutations.push_back({shaders.getShaderGroup("RasterShader"), {}});
+}
+
 } // namespace mbgl
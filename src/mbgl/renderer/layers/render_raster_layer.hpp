@@ -23,6 +23,8 @@ public:
                 const RenderTree&,
                 UniqueChangeRequestVec&) override;
 
+    void collectShaderPermutations(gfx::ShaderRegistry&, std::vector<ShaderPermutation>&) const override;
+
 protected:
     /// @brief Called by the RenderOrchestrator during RenderTree construction.
     /// This event is run to indicate if the layer should render or not for the current frame.
@@ -9,6 +9,7 @@
 #include <mbgl/renderer/property_evaluation_parameters.hpp>
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/renderer/shader_warm_up.hpp>
 #include <mbgl/renderer/tile_render_data.hpp>
 #include <mbgl/renderer/upload_parameters.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
@@ -866,4 +867,31 @@ void RenderSymbolLayer::update(gfx::ShaderRegistry& shaders,
     }
 }
 
+void RenderSymbolLayer::collectShaderPermutations(gfx::ShaderRegistry& shaders,
+                                                  std::vector<ShaderPermutation>& permutations) const {
+    if (passes == RenderPass::None) {
+        return;
+    }
+
+    // Only the common cases, SDF text and plain icons; which one a tile uses depends on its images
+    const auto& evaluated = getEvaluated<SymbolLayerProperties>(evaluatedProperties);
+    const auto& layout = impl_cast(baseImpl).layout;
+    if (!layout.get<TextField>().isUndefined()) {
+        ShaderPermutation permutation{
+            shaders.getShaderGroup(std::string(SymbolSDFShaderName)), {}, posOffsetAttribName};
+        gfx::VertexAttributeArray::
+            getDataDrivenPropertiesAsUniforms<TextOpacity, TextColor, TextHaloColor, TextHaloWidth, TextHaloBlur>(
+                evaluated, permutation.propertiesAsUniforms, idSymbolOpacityVertexAttribute);
+        permutations.push_back(std::move(permutation));
+    }
+    if (!layout.get<IconImage>().isUndefined()) {
+        ShaderPermutation permutation{
+            shaders.getShaderGroup(std::string(SymbolIconShaderName)), {}, posOffsetAttribName};
+        gfx::VertexAttributeArray::
+            getDataDrivenPropertiesAsUniforms<IconOpacity, IconColor, IconHaloColor, IconHaloWidth, IconHaloBlur>(
+                evaluated, permutation.propertiesAsUniforms, idSymbolOpacityVertexAttribute);
+        permutations.push_back(std::move(permutation));
+    }
+}
+
 } // namespace mbgl
@@ -77,6 +77,8 @@ public:
                 const RenderTree&,
                 UniqueChangeRequestVec&) override;
 
+    void collectShaderPermutations(gfx::ShaderRegistry&, std::vector<ShaderPermutation>&) const override;
+
     /// Remove all the drawables for tiles
     std::size_t removeAllDrawables() override;
 
@@ -24,6 +24,7 @@ class PaintParameters;
 class PatternAtlas;
 class RenderTile;
 class RenderTree;
+struct ShaderPermutation;
 class SymbolBucket;
 class TransformState;
 class TransitionParameters;
@@ -163,6 +164,10 @@ public:
                         const RenderTree&,
                         UniqueChangeRequestVec&) {}
 
+    /// Adds the shaders that `update` is expected to request for the current evaluated properties,
+    /// so that they can be created before the layer first shows up.
+    virtual void collectShaderPermutations(gfx::ShaderRegistry&, std::vector<ShaderPermutation>&) const {}
+
     /// Called when the style layer is replaced (same ID and type), and the render layer is reused.
     virtual void layerChanged(const TransitionParameters&,
                               const Immutable<style::Layer::Impl>& newLayer,
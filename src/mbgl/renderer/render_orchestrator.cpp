@@ -201,7 +201,8 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
                                   .tileLodPitchThreshold = updateParameters->tileLodPitchThreshold,
                                   .tileLodZoomShift = updateParameters->tileLodZoomShift,
                                   .tileLodMode = updateParameters->tileLodMode,
-                                  .dynamicTextureAtlas = dynamicTextureAtlas};
+                                  .dynamicTextureAtlas = dynamicTextureAtlas,
+                                  .abortedTileWork = abortedTileWork};
 
     glyphManager->setURL(updateParameters->glyphURL);
     glyphManager->setFontFaces(updateParameters->fontFaces);
@@ -339,6 +340,7 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         std::unique_ptr<RenderSource> renderSource = RenderSource::create(entry.second, threadPool);
         renderSource->setObserver(this);
         renderSource->setCacheEnabled(tileCacheEnabled);
+        renderSource->setCacheMaxCPUBytes(tileCacheMaxCPUBytes);
         renderSource->setFastPFOREnabled(updateParameters->fastPFOREnabled);
         renderSources.emplace(entry.first, std::move(renderSource));
     }
@@ -507,6 +509,8 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         if (renderTreeParameters->placementChanged) {
             Mutable<Placement> placement = Placement::create(updateParameters, placementController.getPlacement());
             placement->placeLayers(layersNeedPlacement);
+            reusedSymbolPlacements += placement->getReusedSymbolCount();
+            testedSymbolPlacements += placement->getTestedSymbolCount();
             placementController.setPlacement(std::move(placement));
             crossTileSymbolIndex.pruneUnusedLayers(usedSymbolLayers);
             for (const auto& entry : renderSources) {
@@ -768,6 +772,26 @@ bool RenderOrchestrator::getTileCacheEnabled() const {
     return tileCacheEnabled;
 }
 
+void RenderOrchestrator::setTileCacheMaxCPUBytes(std::size_t maxCPUBytes) {
+    tileCacheMaxCPUBytes = maxCPUBytes;
+
+    for (const auto& entry : renderSources) {
+        entry.second->setCacheMaxCPUBytes(maxCPUBytes);
+    }
+}
+
+std::size_t RenderOrchestrator::getTileCacheMaxCPUBytes() const {
+    return tileCacheMaxCPUBytes;
+}
+
+TileCacheStats RenderOrchestrator::getTileCacheStats() const {
+    TileCacheStats stats;
+    for (const auto& entry : renderSources) {
+        stats += entry.second->getCacheStats();
+    }
+    return stats;
+}
+
 void RenderOrchestrator::reduceMemoryUse() {
     MLN_TRACE_FUNC();
 
@@ -987,6 +1011,17 @@ void RenderOrchestrator::updateLayers(gfx::ShaderRegistry& shaders,
     addChanges(changes);
 }
 
+void RenderOrchestrator::collectShaderPermutations(gfx::ShaderRegistry& shaders,
+                                                   std::vector<ShaderPermutation>& permutations) const {
+    MLN_TRACE_FUNC();
+
+    for (const RenderLayer& layer : orderedLayers) {
+        if (layer.needsRendering()) {
+            layer.collectShaderPermutations(shaders, permutations);
+        }
+    }
+}
+
 void RenderOrchestrator::processChanges() {
     auto localChanges = std::move(pendingChanges);
     for (auto& change : localChanges) {
@@ -16,6 +16,8 @@
 #include <mbgl/text/placement.hpp>
 #include <mbgl/renderer/render_tree.hpp>
 
+#include <atomic>
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <string>
@@ -36,6 +38,7 @@ class LineAtlas;
 class PatternAtlas;
 class CrossTileSymbolIndex;
 class RenderTree;
+struct ShaderPermutation;
 
 namespace gfx {
 class ShaderRegistry;
@@ -95,6 +98,9 @@ public:
 
     void setTileCacheEnabled(bool);
     bool getTileCacheEnabled() const;
+    void setTileCacheMaxCPUBytes(std::size_t);
+    std::size_t getTileCacheMaxCPUBytes() const;
+    TileCacheStats getTileCacheStats() const;
     void reduceMemoryUse();
     void dumpDebugLogs();
     void collectPlacedSymbolData(bool);
@@ -140,6 +146,9 @@ public:
                       const std::shared_ptr<UpdateParameters>&,
                       const RenderTree&);
 
+    /// Collects the shader permutations the visible layers are expected to use, at any zoom level
+    void collectShaderPermutations(gfx::ShaderRegistry&, std::vector<ShaderPermutation>&) const;
+
     void processChanges();
 
     bool addRenderTarget(RenderTargetPtr);
@@ -165,6 +174,14 @@ public:
 
     const ZoomHistory& getZoomHistory() const { return zoomHistory; }
 
+    /// Number of parse and layout passes abandoned because their tile was no longer needed
+    std::size_t getAbortedTileWorkCount() const { return abortedTileWork->load(std::memory_order_relaxed); }
+
+    /// Number of symbols whose placement was carried over from the previous placement
+    std::size_t getReusedSymbolPlacementCount() const { return reusedSymbolPlacements; }
+    /// Number of symbols that were collision tested during placement
+    std::size_t getTestedSymbolPlacementCount() const { return testedSymbolPlacements; }
+
 private:
     bool isLoaded() const;
     bool hasTransitions(TimePoint) const;
@@ -224,6 +241,7 @@ private:
     bool contextLost = false;
     bool placedSymbolDataCollected = false;
     bool tileCacheEnabled = true;
+    std::size_t tileCacheMaxCPUBytes = 0;
 
 #if MLN_RENDER_BACKEND_OPENGL
     bool androidGoldfishMitigationEnabled{false};
@@ -237,6 +255,12 @@ private:
 
     TaggedScheduler threadPool;
 
+    // Shared with the tile workers, which may outlive a frame
+    std::shared_ptr<std::atomic<std::size_t>> abortedTileWork = std::make_shared<std::atomic<std::size_t>>(0);
+
+    std::size_t reusedSymbolPlacements = 0;
+    std::size_t testedSymbolPlacements = 0;
+
     std::vector<std::unique_ptr<ChangeRequest>> pendingChanges;
 
     using LayerGroupMap = std::multimap<int32_t, LayerGroupBasePtr>;
@@ -2,6 +2,7 @@
 
 #include <mbgl/actor/scheduler.hpp>
 #include <mbgl/map/mode.hpp>
+#include <mbgl/renderer/tile_cache_stats.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/tile/tile_observer.hpp>
 #include <mbgl/util/mat4.hpp>
@@ -106,6 +107,10 @@ public:
 
     virtual void setCacheEnabled(bool) {}
 
+    virtual void setCacheMaxCPUBytes(std::size_t) {}
+
+    virtual TileCacheStats getCacheStats() const { return {}; }
+
     virtual void setFastPFOREnabled(bool) {}
 
     virtual void reduceMemoryUse() = 0;
@@ -139,6 +139,38 @@ void Renderer::removeFeatureState(const std::string& sourceID,
     impl->orchestrator.removeFeatureState(sourceID, sourceLayerID, featureID, stateKey);
 }
 
+void Renderer::setShaderWarmUpBudget(Duration budget) {
+    impl->shaderWarmUpBudget = budget;
+    if (budget == Duration::zero()) {
+        impl->shaderWarmUp.clear();
+        impl->shaderWarmUpLayers.reset();
+    }
+}
+
+Duration Renderer::getShaderWarmUpBudget() const {
+    return impl->shaderWarmUpBudget;
+}
+
+std::size_t Renderer::getPendingShaderWarmUpCount() const {
+    return impl->shaderWarmUp.size();
+}
+
+void Renderer::setGPUTimingEnabled(bool enable) {
+    impl->gpuTimingEnabled = enable;
+}
+
+bool Renderer::isGPUTimingEnabled() const {
+    return impl->gpuTimingEnabled;
+}
+
+void Renderer::setUniformBufferRingEnabled(bool enable) {
+    impl->uniformBufferRingEnabled = enable;
+}
+
+bool Renderer::isUniformBufferRingEnabled() const {
+    return impl->uniformBufferRingEnabled;
+}
+
 void Renderer::dumpDebugLogs() {
     impl->orchestrator.dumpDebugLogs();
 }
@@ -159,6 +191,18 @@ bool Renderer::getTileCacheEnabled() const {
     return impl->orchestrator.getTileCacheEnabled();
 }
 
+void Renderer::setTileCacheMaxCPUBytes(std::size_t maxCPUBytes) {
+    impl->orchestrator.setTileCacheMaxCPUBytes(maxCPUBytes);
+}
+
+std::size_t Renderer::getTileCacheMaxCPUBytes() const {
+    return impl->orchestrator.getTileCacheMaxCPUBytes();
+}
+
+TileCacheStats Renderer::getTileCacheStats() const {
+    return impl->orchestrator.getTileCacheStats();
+}
+
 void Renderer::reduceMemoryUse() {
     gfx::BackendScope guard{impl->backend};
     impl->reduceMemoryUse();
@@ -49,6 +49,27 @@ RendererObserver& nullObserver() {
     return observer;
 }
 
+/// Times the GPU commands encoded during its lifetime, if GPU timing is enabled
+class GPUTimerScope {
+public:
+    GPUTimerScope(gfx::Context& context_, gfx::GPUTimerType type, std::string_view name)
+        : context(context_.isGPUTimingEnabled() ? &context_ : nullptr) {
+        if (context) {
+            context->beginGPUTimer(type, name);
+        }
+    }
+    GPUTimerScope(const GPUTimerScope&) = delete;
+    GPUTimerScope& operator=(const GPUTimerScope&) = delete;
+    ~GPUTimerScope() {
+        if (context) {
+            context->endGPUTimer();
+        }
+    }
+
+private:
+    gfx::Context* const context;
+};
+
 } // namespace
 
 Renderer::Impl::Impl(gfx::RendererBackend& backend_,
@@ -93,6 +114,8 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
     MLN_TRACE_FUNC();
     auto& context = backend.getContext();
     context.setObserver(this);
+    context.setGPUTimingEnabled(gpuTimingEnabled);
+    context.setUniformBufferRingEnabled(uniformBufferRingEnabled);
 
     assert(updateParameters);
 
@@ -255,6 +278,15 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
     if (staticData && staticData->shaders) {
         orchestrator.updateLayers(
             *staticData->shaders, context, renderTreeParameters.transformParams.state, updateParameters, renderTree);
+
+        // Queue the shaders the style will need once it's been evaluated, whenever its layers change
+        if (shaderWarmUpBudget > Duration::zero() && shaderWarmUpLayers != updateParameters->layers) {
+            std::vector<ShaderPermutation> permutations;
+            orchestrator.collectShaderPermutations(*staticData->shaders, permutations);
+            shaderWarmUp.clear();
+            shaderWarmUp.enqueue(std::move(permutations));
+            shaderWarmUpLayers = updateParameters->layers;
+        }
     }
 
     orchestrator.processChanges();
@@ -333,14 +365,24 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
         }
     };
 
+    // Layer groups with nothing to draw aren't worth a GPU timer
+    const auto renderLayerGroup = [&](LayerGroupBase& layerGroup) {
+        std::optional<GPUTimerScope> timer;
+        if (!layerGroup.empty()) {
+            timer.emplace(context, gfx::GPUTimerType::LayerGroup, layerGroup.getName());
+        }
+        layerGroup.render(orchestrator, parameters);
+    };
+
     const auto drawable3DPass = [&] {
         const auto debugGroup(parameters.encoder->createDebugGroup("drawables-3d"));
+        const GPUTimerScope timer(context, gfx::GPUTimerType::RenderPass, "3d");
         assert(parameters.pass == RenderPass::Pass3D);
 
         // draw layer groups, 3D pass
         parameters.currentLayer = static_cast<uint32_t>(orchestrator.numLayerGroups()) - 1;
         orchestrator.visitLayerGroups([&](LayerGroupBase& layerGroup) {
-            layerGroup.render(orchestrator, parameters);
+            renderLayerGroup(layerGroup);
             if (parameters.currentLayer > 0) {
                 parameters.currentLayer--;
             }
@@ -348,6 +390,7 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
     };
 
     const auto drawableTargetsPass = [&] {
+        const GPUTimerScope timer(context, gfx::GPUTimerType::RenderPass, "render-targets");
         // draw render targets
         orchestrator.visitRenderTargets(
             [&](RenderTarget& renderTarget) { renderTarget.render(orchestrator, renderTree, parameters); });
@@ -381,6 +424,7 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
     // Drawables
     const auto drawableOpaquePass = [&] {
         const auto debugGroup(parameters.renderPass->createDebugGroup("drawables-opaque"));
+        const GPUTimerScope timer(context, gfx::GPUTimerType::RenderPass, "opaque");
         parameters.pass = RenderPass::Opaque;
         parameters.depthRangeSize = 1 - (orchestrator.numLayerGroups() + 2) * PaintParameters::numSublayers *
                                             PaintParameters::depthEpsilon;
@@ -388,13 +432,14 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
         // draw layer groups, opaque pass
         parameters.currentLayer = 0;
         orchestrator.visitLayerGroupsReversed([&](LayerGroupBase& layerGroup) {
-            layerGroup.render(orchestrator, parameters);
+            renderLayerGroup(layerGroup);
             parameters.currentLayer++;
         });
     };
 
     const auto drawableTranslucentPass = [&] {
         const auto debugGroup(parameters.renderPass->createDebugGroup("drawables-translucent"));
+        const GPUTimerScope timer(context, gfx::GPUTimerType::RenderPass, "translucent");
         parameters.pass = RenderPass::Translucent;
         parameters.depthRangeSize = 1 - (orchestrator.numLayerGroups() + 2) * PaintParameters::numSublayers *
                                             PaintParameters::depthEpsilon;
@@ -402,7 +447,7 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
         // draw layer groups, translucent pass
         parameters.currentLayer = static_cast<uint32_t>(orchestrator.numLayerGroups()) - 1;
         orchestrator.visitLayerGroups([&](LayerGroupBase& layerGroup) {
-            layerGroup.render(orchestrator, parameters);
+            renderLayerGroup(layerGroup);
             if (parameters.currentLayer > 0) {
                 parameters.currentLayer--;
             }
@@ -426,6 +471,7 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
         // Renders debug overlays.
         {
             const auto debugGroup(parameters.renderPass->createDebugGroup("debug"));
+            const GPUTimerScope timer(context, gfx::GPUTimerType::RenderPass, "debug");
             parameters.currentLayer = 0;
             orchestrator.visitDebugLayerGroups([&](LayerGroupBase& layerGroup) {
                 layerGroup.render(orchestrator, parameters);
@@ -460,6 +506,11 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
     parameters.encoder.reset();
     context.endFrame();
 
+    // Create some of the shaders upcoming frames are likely to need
+    if (!shaderWarmUp.empty()) {
+        shaderWarmUp.run(context, shaderWarmUpBudget);
+    }
+
 #if MLN_RENDER_BACKEND_METAL
     if constexpr (EnableMetalCapture) {
         if (commandCaptureScope) {
@@ -474,10 +525,13 @@ void Renderer::Impl::render(const RenderTree& renderTree, const std::shared_ptr<
 #endif // MLN_RENDER_BACKEND_METAL
 
     context.renderingStats().encodingTime = renderTree.getElapsedTime() - context.renderingStats().renderingTime;
+    context.renderingStats().abortedTileWork = orchestrator.getAbortedTileWorkCount();
+    context.renderingStats().reusedSymbolPlacements = orchestrator.getReusedSymbolPlacementCount();
+    context.renderingStats().testedSymbolPlacements = orchestrator.getTestedSymbolPlacementCount();
 
     observer->onDidFinishRenderingFrame(
         renderTreeParameters.loaded ? RendererObserver::RenderMode::Full : RendererObserver::RenderMode::Partial,
-        renderTreeParameters.needsRepaint,
+        renderTreeParameters.needsRepaint || !shaderWarmUp.empty(),
         renderTreeParameters.placementChanged,
         context.threadSafeCopyRenderingStats());
 
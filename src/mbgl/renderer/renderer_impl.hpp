@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/renderer/render_orchestrator.hpp>
+#include <mbgl/renderer/shader_warm_up.hpp>
 #include <mbgl/gfx/context_observer.hpp>
 
 #if MLN_RENDER_BACKEND_METAL
@@ -9,7 +10,9 @@
 #endif // MLN_RENDER_BACKEND_METAL
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace mbgl {
 
@@ -66,6 +69,14 @@ private:
 
     uint64_t frameCount = 0;
 
+    ShaderWarmUp shaderWarmUp;
+    Duration shaderWarmUpBudget = Duration::zero();
+    /// The layers `shaderWarmUp` was last filled for
+    std::optional<Immutable<std::vector<Immutable<style::Layer::Impl>>>> shaderWarmUpLayers;
+
+    bool gpuTimingEnabled = false;
+    bool uniformBufferRingEnabled = false;
+
 #if MLN_RENDER_BACKEND_METAL
     mtl::MTLCaptureScopePtr commandCaptureScope;
 #endif // MLN_RENDER_BACKEND_METAL
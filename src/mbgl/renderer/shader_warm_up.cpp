@@ -0,0 +1,58 @@
+#include <mbgl/renderer/shader_warm_up.hpp>
+
+#include <mbgl/util/instrumentation.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <algorithm>
+#include <exception>
+
+namespace mbgl {
+
+namespace {
+
+bool samePermutation(const ShaderPermutation& a, const ShaderPermutation& b) {
+    // Shader groups key their permutations by the attribute IDs alone
+    return a.group == b.group && a.firstAttribName == b.firstAttribName &&
+           a.propertiesAsUniforms.second == b.propertiesAsUniforms.second;
+}
+
+} // namespace
+
+void ShaderWarmUp::enqueue(std::vector<ShaderPermutation> permutations) {
+    for (auto& permutation : permutations) {
+        if (!permutation.group) {
+            continue;
+        }
+        const auto queued = std::ranges::any_of(
+            queue, [&](const ShaderPermutation& other) { return samePermutation(permutation, other); });
+        if (!queued) {
+            queue.push_back(std::move(permutation));
+        }
+    }
+}
+
+std::size_t ShaderWarmUp::run(gfx::Context& context, Duration budget) {
+    MLN_TRACE_FUNC();
+
+    const auto deadline = Clock::now() + budget;
+    std::size_t count = 0;
+    do {
+        if (queue.empty()) {
+            break;
+        }
+        const ShaderPermutation permutation = std::move(queue.front());
+        queue.pop_front();
+        ++count;
+
+        const auto& [group, propertiesAsUniforms, firstAttribName] = permutation;
+        try {
+            group->getOrCreateShader(context, propertiesAsUniforms, firstAttribName);
+        } catch (const std::exception& e) {
+            // The frame that needs it will try again and report the error
+            Log::Warning(Event::Shader, std::string("Shader warm-up failed: ") + e.what());
+        }
+    } while (Clock::now() < deadline);
+    return count;
+}
+
+} // namespace mbgl
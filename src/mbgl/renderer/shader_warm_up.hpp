@@ -0,0 +1,48 @@
+#pragma once
+
+#include <mbgl/gfx/shader_group.hpp>
+#include <mbgl/util/chrono.hpp>
+
+#include <deque>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace mbgl {
+
+namespace gfx {
+class Context;
+} // namespace gfx
+
+/// A shader as a layer requests it from `gfx::ShaderGroup::getOrCreateShader`
+struct ShaderPermutation {
+    std::shared_ptr<gfx::ShaderGroup> group;
+    StringIDSetsPair propertiesAsUniforms;
+    std::string_view firstAttribName = "a_pos";
+};
+
+/**
+ * @brief Creates shader permutations ahead of the frames that need them.
+ *
+ * Compiling a permutation can take several milliseconds, so the queue is
+ * worked off a few permutations at a time, between frames, within a time
+ * budget. Permutations that already exist only cost a lookup.
+ */
+class ShaderWarmUp {
+public:
+    /// Queues the permutations that aren't queued yet.
+    void enqueue(std::vector<ShaderPermutation>);
+
+    /// Creates queued permutations until `budget` is spent, at least one.
+    /// @return The number of permutations taken off the queue
+    std::size_t run(gfx::Context&, Duration budget);
+
+    bool empty() const { return queue.empty(); }
+    std::size_t size() const { return queue.size(); }
+    void clear() { queue.clear(); }
+
+private:
+    std::deque<ShaderPermutation> queue;
+};
+
+} // namespace mbgl
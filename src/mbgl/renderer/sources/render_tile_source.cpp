@@ -562,6 +562,14 @@ void RenderTileSource::setCacheEnabled(bool enable) {
     tilePyramid.setCacheEnabled(enable);
 }
 
+void RenderTileSource::setCacheMaxCPUBytes(std::size_t maxCPUBytes) {
+    tilePyramid.setCacheMaxCPUBytes(maxCPUBytes);
+}
+
+TileCacheStats RenderTileSource::getCacheStats() const {
+    return tilePyramid.getCacheStats();
+}
+
 void RenderTileSource::reduceMemoryUse() {
     tilePyramid.reduceMemoryUse();
 }
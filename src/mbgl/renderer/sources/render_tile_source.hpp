@@ -47,6 +47,8 @@ public:
                             const std::optional<std::string>&) override;
 
     void setCacheEnabled(bool) override;
+    void setCacheMaxCPUBytes(std::size_t) override;
+    TileCacheStats getCacheStats() const override;
     void reduceMemoryUse() override;
     void dumpDebugLogs() const override;
 
@@ -3,6 +3,8 @@
 #include <mbgl/map/mode.hpp>
 #include <mbgl/actor/scheduler.hpp>
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
 #include <numbers>
 
@@ -40,6 +42,8 @@ public:
     TileLodMode tileLodMode = TileLodMode::Default;
     gfx::DynamicTextureAtlasPtr dynamicTextureAtlas;
     bool isUpdateSynchronous = false;
+    /// Incremented by tile workers whenever they abandon work for an obsolete tile
+    std::shared_ptr<std::atomic<std::size_t>> abortedTileWork;
 };
 
 } // namespace mbgl
@@ -6,6 +6,7 @@
 #include <mbgl/map/transform.hpp>
 #include <mbgl/math/clamp.hpp>
 #include <mbgl/actor/scheduler.hpp>
+#include <mbgl/util/tile_coordinate.hpp>
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/tile_range.hpp>
 #include <mbgl/util/enum.hpp>
@@ -17,6 +18,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <set>
 
 namespace mbgl {
 
@@ -25,6 +27,26 @@ using namespace style;
 namespace {
 TileObserver nullObserver;
 const std::map<OverscaledTileID, std::unique_ptr<Tile>> emptyPrefetchedTiles;
+
+// Worker priority for a tile, lower values run first. Tiles on screen come
+// before prefetched ones, then tiles closer to the viewport center, with
+// parent/child fallbacks just after ideal tiles at the same distance.
+Scheduler::Priority tilePriority(const OverscaledTileID& id,
+                                 const TileCoordinate& center,
+                                 const int32_t tileZoom,
+                                 const bool visible,
+                                 const bool ideal) {
+    constexpr uint32_t maxDistance = (1u << 30) - 1;
+
+    const TileCoordinate zoomed = center.zoomTo(id.canonical.z);
+    const double dx = (id.canonical.x + id.wrap * std::pow(2.0, id.canonical.z) + 0.5) - zoomed.p.x;
+    const double dy = (id.canonical.y + 0.5) - zoomed.p.y;
+    // Measure in tiles of the ideal zoom level so that parents and children compare fairly
+    const double distance = std::sqrt(dx * dx + dy * dy) * std::pow(2.0, tileZoom - id.canonical.z);
+    const auto quantized = static_cast<uint32_t>(std::min<double>(distance * 4.0, maxDistance));
+
+    return (static_cast<uint32_t>(!visible) << 31) | (quantized << 1) | static_cast<uint32_t>(!ideal);
+}
 } // namespace
 
 TilePyramid::TilePyramid(const TaggedScheduler& threadPool_)
@@ -182,15 +204,27 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
                               : std::min(tileZoom, static_cast<int32_t>(zoomRange.max));
         tileRange = util::TileRange::fromLatLngBounds(*bounds, zoomRange.min, maxZoom);
     }
+
+    const std::set<OverscaledTileID> idealTileSet(idealTiles.begin(), idealTiles.end());
+    const auto center = TileCoordinate::fromLatLng(tileZoom, parameters.transformState.getLatLng());
+    // Whether tiles are being created for the prefetched pan tiles, rather than to be shown
+    bool prefetching = false;
+
     auto createTileFn = [&](const OverscaledTileID& tileID) -> Tile* {
         if (tileRange && !tileRange->contains(tileID.canonical)) {
             return nullptr;
         }
+        // Refined below, once it's known which tiles are rendered
+        const auto priority = tilePriority(tileID, center, tileZoom, !prefetching, idealTileSet.contains(tileID));
         std::unique_ptr<Tile> tile = cache.pop(tileID);
         if (!tile) {
             tile = createTile(tileID, observer);
             if (!tile) return nullptr;
+            // Before `setLayers`, which sends the first message to the worker
+            tile->setPriority(priority);
             tile->setLayers(layers);
+        } else {
+            tile->setPriority(priority);
         }
 
         return tiles.emplace(tileID, std::move(tile)).first->second.get();
@@ -207,6 +241,7 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
     renderedTiles.clear();
 
     if (!panTiles.empty()) {
+        prefetching = true;
         algorithm::updateRenderables(
             getTileFn,
             createTileFn,
@@ -216,6 +251,7 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
             emptyPrefetchedTiles,
             zoomRange,
             maxParentTileOverscaleFactor);
+        prefetching = false;
     }
 
     algorithm::updateRenderables(getTileFn,
@@ -278,6 +314,10 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
 
     for (auto& pair : tiles) {
         pair.second->setShowCollisionBoxes(parameters.debugOptions & MapDebugOptions::Collision);
+
+        const bool ideal = idealTileSet.contains(pair.first);
+        const bool visible = ideal || renderedTiles.contains(pair.first.toUnwrapped());
+        pair.second->setPriority(tilePriority(pair.first, center, tileZoom, visible, ideal));
     }
 
     // Initialize renderable tiles and update the contained layer render data.
@@ -419,6 +459,10 @@ void TilePyramid::setCacheEnabled(bool enable) {
     cacheEnabled = enable;
 }
 
+void TilePyramid::setCacheMaxCPUBytes(std::size_t maxCPUBytes) {
+    cache.setMaxCPUBytes(maxCPUBytes);
+}
+
 void TilePyramid::reduceMemoryUse() {
     cache.clear();
 }
@@ -50,6 +50,12 @@ public:
 
     const bool fastPFOREnabled = false;
 
+    // Place independent collision groups concurrently
+    const bool parallelPlacement = false;
+
+    // Start symbol placement from the previous placement when the camera only panned
+    const bool incrementalPlacement = false;
+
     double tileLodMinRadius = 3;
     double tileLodScale = 1;
     double tileLodPitchThreshold = (60.0 / 180.0) * std::numbers::pi;
@@ -8,6 +8,7 @@
 #include <mbgl/shaders/shader_manifest.hpp>
 
 #include <cstring>
+#include <optional>
 #include <utility>
 
 namespace mbgl {
@@ -81,6 +82,37 @@ void addAttr(VertexAttributeArrayGL& attrs, const size_t id, GLint index, GLsize
     }
 }
 
+// Loads the program from the binary cache if possible, otherwise compiles it and adds it to the cache
+UniqueProgram loadOrCompileProgram(Context& context,
+                                   std::initializer_list<const char*> vertexSources,
+                                   std::initializer_list<const char*> fragmentSources,
+                                   const char* location0AttribName) {
+    const ProgramBinaryCache* cache = context.getProgramBinaryCache();
+    std::optional<ProgramBinaryCache::Key> key;
+    if (cache) {
+        key = cache->makeKey(vertexSources, fragmentSources, location0AttribName);
+        if (auto binary = cache->load(*key)) {
+            if (auto program = context.createProgram(*binary)) {
+                return std::move(*program);
+            }
+            // Rejected by the driver, e.g. after an update that kept the version string
+            cache->remove(*key);
+        }
+    }
+
+    // throws on compile error
+    auto vertProg = context.createShader(ShaderType::Vertex, vertexSources);
+    auto fragProg = context.createShader(ShaderType::Fragment, fragmentSources);
+    auto program = context.createProgram(vertProg, fragProg, location0AttribName);
+
+    if (cache) {
+        if (const auto binary = context.getProgramBinary(program)) {
+            cache->store(*key, *binary);
+        }
+    }
+    return program;
+}
+
 } // namespace
 
 ShaderProgramGL::ShaderProgramGL(UniqueProgram&& glProgram_)
@@ -119,23 +151,19 @@ std::shared_ptr<ShaderProgramGL> ShaderProgramGL::create(
         context.getObserver().onPreCompileShader(
             programParameters.getProgramType(), gfx::Backend::Type::OpenGL, additionalDefines);
 
-        // throws on compile error
-        auto vertProg = context.createShader(
-            ShaderType::Vertex,
-            std::initializer_list<const char*>{
-                "#version 300 es\n",
-                programParameters.getDefinesString().c_str(),
-                additionalDefines.c_str(),
-                shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>::vertex,
-                vertexSource.c_str()});
-        auto fragProg = context.createShader(
-            ShaderType::Fragment,
+        auto program = loadOrCompileProgram(
+            context,
+            {"#version 300 es\n",
+             programParameters.getDefinesString().c_str(),
+             additionalDefines.c_str(),
+             shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>::vertex,
+             vertexSource.c_str()},
             {"#version 300 es\n",
              programParameters.getDefinesString().c_str(),
              additionalDefines.c_str(),
              shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>::fragment,
-             fragmentSource.c_str()});
-        auto program = context.createProgram(vertProg, fragProg, firstAttribName.data());
+             fragmentSource.c_str()},
+            firstAttribName.data());
 
         context.getObserver().onPostCompileShader(
             programParameters.getProgramType(), gfx::Backend::Type::OpenGL, additionalDefines);
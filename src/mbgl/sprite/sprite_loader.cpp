@@ -60,8 +60,8 @@ void SpriteLoader::load(const std::optional<style::Sprite> sprite, FileSource& f
             emitSpriteLoadedIfComplete(*sprite);
         } else {
             // Only trigger a sprite loaded event we got new data.
-            assert(data->json != res.data);
-            data->json = std::move(res.data);
+            assert(data->json != res.data.string());
+            data->json = res.data.string();
             emitSpriteLoadedIfComplete(*sprite);
         }
     });
@@ -78,8 +78,8 @@ void SpriteLoader::load(const std::optional<style::Sprite> sprite, FileSource& f
                 data->image = std::make_shared<std::string>();
                 emitSpriteLoadedIfComplete(*sprite);
             } else {
-                assert(dataMap[sprite->id]->image != res.data);
-                data->image = std::move(res.data);
+                assert(dataMap[sprite->id]->image != res.data.string());
+                data->image = res.data.string();
                 emitSpriteLoadedIfComplete(*sprite);
             }
         });
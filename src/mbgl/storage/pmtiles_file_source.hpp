@@ -21,6 +21,19 @@ public:
     void setClientOptions(ClientOptions) override;
     ClientOptions getClientOptions() override;
 
+    // Counters of the cache holding decoded archive directories
+    struct DirectoryCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        // Fetches that joined an identical fetch already in flight
+        uint64_t coalesced = 0;
+        uint64_t evictions = 0;
+        std::size_t entries = 0;
+        std::size_t bytes = 0;
+    };
+
+    DirectoryCacheStats getDirectoryCacheStats();
+
 private:
     class Impl;
     std::unique_ptr<util::Thread<Impl>> thread; // impl
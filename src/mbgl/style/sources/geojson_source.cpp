@@ -88,7 +88,7 @@ void GeoJSONSource::loadDescription(FileSource& fileSource) {
                 util::SimpleIdentity::Empty,
                 /* makeImplInBackground */
                 [currentImpl = baseImpl,
-                 data = res.data,
+                 data = res.data.string(),
                  seqScheduler{sequencedScheduler}]() -> Immutable<Source::Impl> {
                     assert(data);
                     auto& current = static_cast<const Impl&>(*currentImpl);
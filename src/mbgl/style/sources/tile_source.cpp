@@ -66,7 +66,7 @@ void TileSource::loadDescription(FileSource& fileSource) {
             observer->onSourceError(*this, std::make_exception_ptr(std::runtime_error("unexpectedly empty TileJSON")));
         } else {
             conversion::Error error;
-            std::optional<Tileset> tileset = conversion::convertJSON<Tileset>(*res.data, error);
+            std::optional<Tileset> tileset = conversion::convertJSON<Tileset>(*res.data.string(), error);
             if (!tileset) {
                 observer->onSourceError(*this, std::make_exception_ptr(util::StyleParseException(error.message)));
                 return;
@@ -38,6 +38,24 @@ public:
     bool isCircle() const { return type == Type::Circle; }
     bool isBox() const { return type == Type::Box; }
 
+    /// The same geometry moved by `offset`
+    ProjectedCollisionBox translate(Point<float> offset) const {
+        switch (type) {
+            case Type::Box:
+                return {geometry.box.min.x + offset.x,
+                        geometry.box.min.y + offset.y,
+                        geometry.box.max.x + offset.x,
+                        geometry.box.max.y + offset.y};
+            case Type::Circle:
+                return {geometry.circle.center.x + offset.x,
+                        geometry.circle.center.y + offset.y,
+                        geometry.circle.radius};
+            case Type::Unknown:
+                break;
+        }
+        return {};
+    }
+
 private:
     union Geometry {
         // NOLINTNEXTLINE(modernize-use-equals-default)
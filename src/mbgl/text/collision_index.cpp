@@ -13,6 +13,7 @@
 #include <mbgl/renderer/buckets/symbol_bucket.hpp> // For PlacedSymbol: pull out to another location
 
 #include <cmath>
+#include <mutex>
 
 namespace mbgl {
 
@@ -32,6 +33,51 @@ inline float findViewportPadding(const TransformState& transformState, MapMode m
     return (transformState.getPitch() != 0.0f) ? viewportPaddingDefault * 2 : viewportPaddingDefault;
 }
 
+std::mutex traceSinkMutex;
+CollisionIndex::TraceSink traceSink;
+
+void record(CollisionTrace* trace,
+            CollisionTrace::Operation::Type type,
+            const CollisionIndex::CollisionGrid::BBox& box,
+            bool grouped,
+            uint16_t collisionGroupId) {
+    if (trace) {
+        trace->operations.push_back(
+            {type, false, grouped, collisionGroupId, box.min.x, box.min.y, box.max.x, box.max.y});
+    }
+}
+
+void record(CollisionTrace* trace,
+            CollisionTrace::Operation::Type type,
+            const CollisionIndex::CollisionGrid::BCircle& circle,
+            bool grouped,
+            uint16_t collisionGroupId) {
+    if (trace) {
+        trace->operations.push_back(
+            {type, true, grouped, collisionGroupId, circle.center.x, circle.center.y, circle.radius, 0});
+    }
+}
+
+template <typename Geometry>
+bool hitTest(const CollisionIndex::CollisionGrid& grid,
+             const Geometry& geometry,
+             const std::optional<std::function<bool(const RefIndexedSubfeature&)>>& predicate,
+             CollisionTrace* trace) {
+    record(trace, CollisionTrace::Operation::Type::HitTest, geometry, predicate.has_value(), 0);
+    return predicate ? grid.hitTest(geometry, *predicate) : grid.hitTest(geometry);
+}
+
+template <typename Geometry>
+void insert(CollisionIndex::CollisionGrid& grid,
+            IndexedSubfeature&& feature,
+            const Geometry& geometry,
+            bool ignored,
+            CollisionTrace* trace) {
+    using Type = CollisionTrace::Operation::Type;
+    record(trace, ignored ? Type::InsertIgnored : Type::Insert, geometry, false, feature.getCollisionGroupId());
+    grid.insert(std::move(feature), geometry);
+}
+
 } // namespace
 
 CollisionIndex::CollisionIndex(const TransformState& transformState_, MapMode mapMode)
@@ -48,7 +94,28 @@ CollisionIndex::CollisionIndex(const TransformState& transformState_, MapMode ma
       gridRightBoundary(transformState.getSize().width + 2 * viewportPadding),
       gridBottomBoundary(transformState.getSize().height + 2 * viewportPadding),
       pitchFactor(
-          static_cast<float>(std::cos(transformState.getPitch()) * transformState.getCameraToCenterDistance())) {}
+          static_cast<float>(std::cos(transformState.getPitch()) * transformState.getCameraToCenterDistance())) {
+    std::lock_guard lock(traceSinkMutex);
+    if (traceSink) {
+        trace = std::make_unique<CollisionTrace>();
+        trace->width = gridRightBoundary;
+        trace->height = gridBottomBoundary;
+    }
+}
+
+CollisionIndex::~CollisionIndex() {
+    if (trace) {
+        std::lock_guard lock(traceSinkMutex);
+        if (traceSink) {
+            traceSink(std::move(*trace));
+        }
+    }
+}
+
+void CollisionIndex::setTraceSink(TraceSink sink) {
+    std::lock_guard lock(traceSinkMutex);
+    traceSink = std::move(sink);
+}
 
 float CollisionIndex::approximateTileDistance(const TileDistance& tileDistance,
                                               const float lastSegmentAngle,
@@ -86,6 +153,42 @@ bool CollisionIndex::isInsideGrid(const CollisionBoundaries& boundaries) const {
            boundaries[1] < gridBottomBoundary;
 }
 
+namespace {
+
+CollisionBoundaries getBoundaries(const ProjectedCollisionBox& projected, Point<float> offset = {}) {
+    if (projected.isCircle()) {
+        const auto& circle = projected.circle();
+        return {{circle.center.x - circle.radius + offset.x,
+                 circle.center.y - circle.radius + offset.y,
+                 circle.center.x + circle.radius + offset.x,
+                 circle.center.y + circle.radius + offset.y}};
+    }
+    const auto& box = projected.box();
+    return {{box.min.x + offset.x, box.min.y + offset.y, box.max.x + offset.x, box.max.y + offset.y}};
+}
+
+} // namespace
+
+bool CollisionIndex::isOffscreen(const std::vector<ProjectedCollisionBox>& projectedBoxes) const {
+    for (const auto& projected : projectedBoxes) {
+        if ((projected.isBox() || projected.isCircle()) && !isOffscreen(getBoundaries(projected))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CollisionIndex::crossesGridEdge(const std::vector<ProjectedCollisionBox>& projectedBoxes,
+                                     Point<float> offset) const {
+    for (const auto& projected : projectedBoxes) {
+        if ((projected.isBox() || projected.isCircle()) &&
+            isInsideGrid(getBoundaries(projected)) != isInsideGrid(getBoundaries(projected, offset))) {
+            return true;
+        }
+    }
+    return false;
+}
+
 CollisionBoundaries CollisionIndex::projectTileBoundaries(const mat4& posMatrix) const {
     Point<float> topLeft = projectPoint(posMatrix, {0, 0});
     Point<float> bottomRight = projectPoint(posMatrix, {util::EXTENT, util::EXTENT});
@@ -168,7 +271,8 @@ std::pair<bool, bool> CollisionIndex::placeFeature(
         projectedBoxes.emplace_back(
             collisionBoundaries[0], collisionBoundaries[1], collisionBoundaries[2], collisionBoundaries[3]);
         if ((avoidEdges && !isInsideTile(collisionBoundaries, *avoidEdges)) || !isInsideGrid(collisionBoundaries) ||
-            (!allowOverlap && collisionGrid.hitTest(projectedBoxes.back().box(), collisionGroupPredicate))) {
+            (!allowOverlap &&
+             hitTest(collisionGrid, projectedBoxes.back().box(), collisionGroupPredicate, trace.get()))) {
             return {false, false};
         }
 
@@ -314,7 +418,8 @@ std::pair<bool, bool> CollisionIndex::placeLineFeature(
         inGrid |= isInsideGrid(collisionBoundaries);
 
         if ((avoidEdges && !isInsideTile(collisionBoundaries, *avoidEdges)) ||
-            (!allowOverlap && collisionGrid.hitTest(projectedBoxes[i].circle(), collisionGroupPredicate))) {
+            (!allowOverlap &&
+             hitTest(collisionGrid, projectedBoxes[i].circle(), collisionGroupPredicate, trace.get()))) {
             if (!collisionDebug) {
                 return {false, false};
             } else {
@@ -339,28 +444,30 @@ void CollisionIndex::insertFeature(const CollisionFeature& feature,
                 continue;
             }
 
-            if (ignorePlacement) {
-                ignoredGrid.insert(IndexedSubfeature{feature.indexedFeature, bucketInstanceId, collisionGroupId},
-                                   circle.circle());
-            } else {
-                collisionGrid.insert(IndexedSubfeature{feature.indexedFeature, bucketInstanceId, collisionGroupId},
-                                     circle.circle());
-            }
+            insert(ignorePlacement ? ignoredGrid : collisionGrid,
+                   IndexedSubfeature{feature.indexedFeature, bucketInstanceId, collisionGroupId},
+                   circle.circle(),
+                   ignorePlacement,
+                   trace.get());
         }
     } else if (!projectedBoxes.empty()) {
         assert(projectedBoxes.size() == 1);
         auto& box = projectedBoxes[0];
         assert(box.isBox());
-        if (ignorePlacement) {
-            ignoredGrid.insert(IndexedSubfeature{feature.indexedFeature, bucketInstanceId, collisionGroupId},
-                               box.box());
-        } else {
-            collisionGrid.insert(IndexedSubfeature{feature.indexedFeature, bucketInstanceId, collisionGroupId},
-                                 box.box());
-        }
+        insert(ignorePlacement ? ignoredGrid : collisionGrid,
+               IndexedSubfeature{feature.indexedFeature, bucketInstanceId, collisionGroupId},
+               box.box(),
+               ignorePlacement,
+               trace.get());
     }
 }
 
+void CollisionIndex::merge(CollisionIndex&& other) {
+    assert(viewportPadding == other.viewportPadding);
+    collisionGrid.merge(std::move(other.collisionGrid));
+    ignoredGrid.merge(std::move(other.ignoredGrid));
+}
+
 bool polygonIntersectsBox(const LineString<float>& polygon, const GridIndex<IndexedSubfeature>::BBox& bbox) {
     // This is just a wrapper that allows us to use the integer-based
     // util::polygonIntersectsPolygon Conversion limits our query accuracy to
@@ -7,6 +7,10 @@
 #include <mbgl/map/transform_state.hpp>
 
 #include <array>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
 
 namespace mbgl {
 
@@ -25,11 +29,45 @@ struct IntersectStatus {
     // Assuming tile border divides box in two sections
     int minSectionLength = 0;
 };
+/// The grid operations of one collision index in the order placement made them,
+/// recorded to replay real placements in benchmarks.
+struct CollisionTrace {
+    struct Operation {
+        enum class Type : uint8_t {
+            HitTest,
+            Insert,
+            InsertIgnored
+        };
+        Type type;
+        bool circle;
+        /// Whether a hit test only collided with its own collision group
+        bool grouped;
+        /// Collision group of an inserted feature
+        uint16_t collisionGroupId;
+        /// Box corners, or the circle center and radius in `x1`, `y1` and `x2`
+        float x1;
+        float y1;
+        float x2;
+        float y2;
+    };
+
+    float width = 0;
+    float height = 0;
+    std::vector<Operation> operations;
+};
+
 class CollisionIndex {
 public:
     using CollisionGrid = GridIndex<IndexedSubfeature>;
+    using TraceSink = std::function<void(CollisionTrace&&)>;
 
     explicit CollisionIndex(const TransformState&, MapMode);
+    ~CollisionIndex();
+
+    /// Records the grid operations of the indexes created from now on, each handed to `sink`
+    /// when its index is destroyed. An empty sink stops recording. Meant for benchmarks.
+    static void setTraceSink(TraceSink sink);
+
     IntersectStatus intersectsTileEdges(const CollisionBox&,
                                         Point<float> shift,
                                         const mat4& posMatrix,
@@ -58,6 +96,14 @@ public:
                        uint32_t bucketInstanceId,
                        uint16_t collisionGroupId);
 
+    /// Take over the features placed into another index for the same transform.
+    void merge(CollisionIndex&&);
+
+    /// Whether all boxes are outside the viewport, ignoring boxes of unused line label circles.
+    bool isOffscreen(const std::vector<ProjectedCollisionBox>&) const;
+    /// Whether moving the boxes by `offset` would move any of them into or out of the collision grid.
+    bool crossesGridEdge(const std::vector<ProjectedCollisionBox>&, Point<float> offset) const;
+
     std::unordered_map<uint32_t, std::vector<IndexedSubfeature>> queryRenderedSymbols(const ScreenLineString&) const;
 
     CollisionBoundaries projectTileBoundaries(const mat4& posMatrix) const;
@@ -115,6 +161,9 @@ private:
     const float gridBottomBoundary;
 
     const float pitchFactor;
+
+    /// Set while a trace sink is installed
+    std::unique_ptr<CollisionTrace> trace;
 };
 
 } // namespace mbgl
@@ -126,9 +126,9 @@ void GlyphManager::processResponse(const Response& res, const FontStack& fontSta
 
             try {
                 if (range.type == GlyphIDType::FontPBF) {
-                    glyphs = parseGlyphPBF(range, *res.data);
+                    glyphs = parseGlyphPBF(range, *res.data.string());
                 } else {
-                    if (loadHBShaper(fontStack, range.type, *res.data)) {
+                    if (loadHBShaper(fontStack, range.type, *res.data.string())) {
                         Glyph temp;
                         temp.id = GlyphID(0, range.type);
                         glyphs.emplace_back(std::move(temp));
@@ -1,5 +1,6 @@
 #include <mbgl/text/placement.hpp>
 
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/layout/symbol_layout.hpp>
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
@@ -10,38 +11,18 @@
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/math.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
 #include <list>
+#include <map>
+#include <mutex>
 #include <utility>
 
 namespace mbgl {
 
-OpacityState::OpacityState(bool placed_, bool skipFade)
-    : opacity((skipFade && placed_) ? 1.0f : 0.0f),
-      placed(placed_) {}
-
-OpacityState::OpacityState(const OpacityState& prevState, float increment, bool placed_)
-    : opacity(std::fmax(0.0f, std::fmin(1.0f, prevState.opacity + (prevState.placed ? increment : -increment)))),
-      placed(placed_) {}
-
-bool OpacityState::isHidden() const {
-    return opacity == 0 && !placed;
-}
-
-JointOpacityState::JointOpacityState(bool placedText, bool placedIcon, bool skipFade)
-    : icon(OpacityState(placedIcon, skipFade)),
-      text(OpacityState(placedText, skipFade)) {}
-
-JointOpacityState::JointOpacityState(const JointOpacityState& prevOpacityState,
-                                     float increment,
-                                     bool placedText,
-                                     bool placedIcon)
-    : icon(OpacityState(prevOpacityState.icon, increment, placedIcon)),
-      text(OpacityState(prevOpacityState.text, increment, placedText)) {}
-
-bool JointOpacityState::isHidden() const {
-    return icon.isHidden() && text.isHidden();
-}
-
 const CollisionGroups::CollisionGroup& CollisionGroups::get(const std::string& sourceID) {
     // The predicate/groupID mechanism allows for arbitrary grouping,
     // but the current interface defines one source == one group when
@@ -199,13 +180,322 @@ Placement::Placement()
 Placement::~Placement() = default;
 
 void Placement::placeLayers(const RenderLayerReferences& layers) {
-    for (auto it = layers.crbegin(); it != layers.crend(); ++it) {
-        std::set<uint32_t> seenCrossTileIDs;
-        placeLayer(*it, seenCrossTileIDs);
+    const bool placedByGroup = updateParameters && updateParameters->parallelPlacement &&
+                               !updateParameters->crossSourceCollisions && placeLayersByCollisionGroup(layers);
+    if (!placedByGroup) {
+        recordSymbols = updateParameters && updateParameters->incrementalPlacement &&
+                        updateParameters->mode == MapMode::Continuous && !showCollisionBoxes;
+        incremental = recordSymbols && prepareIncrementalPlacement(layers);
+        for (auto it = layers.crbegin(); it != layers.crend(); ++it) {
+            std::set<uint32_t> seenCrossTileIDs;
+            placeLayer(*it, seenCrossTileIDs);
+        }
     }
     commit();
 }
 
+namespace {
+
+// Runs `job(0)` ... `job(count - 1)` on the background pool and the calling thread
+// and returns once all of them finished. Jobs are claimed in order, so the calling
+// thread never waits for a job that no worker has picked up yet.
+void runOnBackground(std::size_t count, const std::function<void(std::size_t)>& job) {
+    struct State {
+        std::atomic<std::size_t> next{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::size_t finishedCount = 0;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+
+    // Workers starting after all jobs were claimed return without touching `job`
+    const auto work = [state, count, &job] {
+        for (auto i = state->next++; i < count; i = state->next++) {
+            std::exception_ptr error;
+            try {
+                job(i);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            std::scoped_lock lock(state->mutex);
+            if (error && !state->error) {
+                state->error = error;
+            }
+            if (++state->finishedCount == count) {
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    auto scheduler = Scheduler::GetBackground();
+    for (std::size_t i = 1; i < count; ++i) {
+        scheduler->schedule(work);
+    }
+    work();
+
+    std::unique_lock lock(state->mutex);
+    state->finished.wait(lock, [&] { return state->finishedCount == count; });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+} // namespace
+
+bool Placement::placeLayersByCollisionGroup(const RenderLayerReferences& layers) {
+    MLN_TRACE_FUNC();
+    // Without cross-source collisions, symbols only collide with symbols of
+    // their own group, so every group is placed into a collision index of its
+    // own. The results are merged in group order, which makes the outcome
+    // independent of how the groups were scheduled.
+    std::map<uint16_t, RenderLayerReferences> groups;
+    for (auto it = layers.crbegin(); it != layers.crend(); ++it) {
+        const auto& placementData = it->get().getPlacementData();
+        if (!placementData.empty()) {
+            groups[collisionGroups.get(placementData.front().sourceId).first].push_back(*it);
+        }
+    }
+    if (groups.size() < 2) {
+        return false;
+    }
+
+    std::vector<std::unique_ptr<Placement>> parts;
+    std::vector<std::reference_wrapper<const RenderLayerReferences>> partLayers;
+    for (const auto& group : groups) {
+        auto part = std::make_unique<Placement>(updateParameters, prevPlacement);
+        // Group IDs were assigned above; the parts only read them.
+        part->collisionGroups = collisionGroups;
+        parts.push_back(std::move(part));
+        partLayers.emplace_back(group.second);
+    }
+
+    runOnBackground(parts.size(), [&](std::size_t i) {
+        for (const RenderLayer& layer : partLayers[i].get()) {
+            std::set<uint32_t> seenCrossTileIDs;
+            parts[i]->placeLayer(layer, seenCrossTileIDs);
+        }
+    });
+
+    for (auto& part : parts) {
+        collisionIndex.merge(std::move(part->collisionIndex));
+        symbolStates.merge(part->symbolStates);
+        retainedQueryData.merge(part->retainedQueryData);
+        collisionCircles.merge(part->collisionCircles);
+    }
+    return true;
+}
+
+bool Placement::prepareIncrementalPlacement(const RenderLayerReferences& layers) {
+    MLN_TRACE_FUNC();
+    for (auto it = layers.crbegin(); it != layers.crend(); ++it) {
+        for (const BucketPlacementData& data : it->get().getPlacementData()) {
+            recordedBuckets.emplace_back(static_cast<const SymbolBucket&>(data.bucket.get()).bucketInstanceId,
+                                         data.tile.get().holdForFade());
+        }
+    }
+
+    // When the same buckets are placed in the same order and the camera only
+    // panned, every symbol moves by the same screen offset. A symbol then keeps
+    // its previous result unless it crosses the edge of the collision grid, or
+    // a feature it overlaps was placed differently.
+    const Placement* prev = getPrevPlacement();
+    if (!prev || !prev->recordSymbols || prev->recordedBuckets != recordedBuckets) {
+        return false;
+    }
+    const TransformState& state = collisionIndex.getTransformState();
+    const TransformState& prevState = prev->collisionIndex.getTransformState();
+    if (state.getSize() != prevState.getSize() || state.getZoom() != prevState.getZoom() ||
+        state.getBearing() != prevState.getBearing() || state.getPitch() != 0.0 || prevState.getPitch() != 0.0 ||
+        state.getNorthOrientation() != prevState.getNorthOrientation() ||
+        state.getViewportMode() != prevState.getViewportMode()) {
+        return false;
+    }
+
+    const LatLng center = prevState.getLatLng();
+    const ScreenCoordinate before = prevState.latLngToScreenCoordinate(center);
+    const ScreenCoordinate after = state.latLngToScreenCoordinate(center);
+    cameraShift = {static_cast<float>(after.x - before.x), static_cast<float>(after.y - before.y)};
+    // Beyond the padding, too many symbols cross the grid edge for reuse to pay off
+    const float padding = collisionIndex.getViewportPadding();
+    if (!(std::abs(cameraShift.x) < padding && std::abs(cameraShift.y) < padding)) {
+        return false;
+    }
+
+    changedRegions.emplace(static_cast<float>(state.getSize().width) + 2 * padding,
+                           static_cast<float>(state.getSize().height) + 2 * padding,
+                           25);
+
+    // Features of symbols that are not placed anymore, e.g. because they left an
+    // overscaled tile's viewport, leave free space behind
+    std::unordered_set<uint32_t> presentCrossTileIDs;
+    for (const RenderLayer& layer : layers) {
+        for (const BucketPlacementData& data : layer.getPlacementData()) {
+            if (data.tile.get().holdForFade()) continue;
+            for (const SymbolInstance& symbol : static_cast<const SymbolBucket&>(data.bucket.get()).symbolInstances) {
+                if (symbol.check(SYM_GUARD_LOC) && symbol.getCrossTileID() != SymbolInstance::invalidCrossTileID) {
+                    presentCrossTileIDs.insert(symbol.getCrossTileID());
+                }
+            }
+        }
+    }
+    for (const auto& [crossTileID, recorded] : prev->recordedSymbols) {
+        if ((recorded.placeText || recorded.placeIcon) && !presentCrossTileIDs.contains(crossTileID)) {
+            previousTextBoxes.clear();
+            prev->appendRecordedBoxes(recorded, false, cameraShift, previousTextBoxes);
+            prev->appendRecordedBoxes(recorded, true, cameraShift, previousTextBoxes);
+            markChangedRegion(previousTextBoxes);
+        }
+    }
+    return true;
+}
+
+std::optional<JointPlacement> Placement::reuseSymbolPlacement(const SymbolInstance& symbolInstance,
+                                                              const PlacementContext& ctx) {
+    const Placement* prev = getPrevPlacement();
+    const auto found = prev->recordedSymbols.find(symbolInstance.getCrossTileID());
+    if (found == prev->recordedSymbols.end() || !found->second.reusable || found->second.symbol != &symbolInstance) {
+        return std::nullopt;
+    }
+    const RecordedSymbol& recorded = found->second;
+
+    textBoxes.clear();
+    iconBoxes.clear();
+    prev->appendRecordedBoxes(recorded, false, cameraShift, textBoxes);
+    prev->appendRecordedBoxes(recorded, true, cameraShift, iconBoxes);
+    const Point<float> back{-cameraShift.x, -cameraShift.y};
+    if (collisionIndex.crossesGridEdge(textBoxes, back) || collisionIndex.crossesGridEdge(iconBoxes, back) ||
+        overlapsChangedRegion(textBoxes) || overlapsChangedRegion(iconBoxes)) {
+        return std::nullopt;
+    }
+
+    const SymbolBucket& bucket = ctx.getBucket();
+    if (recorded.placeText) {
+        collisionIndex.insertFeature(symbolInstance.getTextCollisionFeature(),
+                                     textBoxes,
+                                     ctx.getLayout().get<TextIgnorePlacement>(),
+                                     bucket.bucketInstanceId,
+                                     ctx.collisionGroup.first);
+    }
+    if (recorded.placeIcon) {
+        collisionIndex.insertFeature(symbolInstance.getIconCollisionFeature(),
+                                     iconBoxes,
+                                     ctx.getLayout().get<IconIgnorePlacement>(),
+                                     bucket.bucketInstanceId,
+                                     ctx.collisionGroup.first);
+    }
+    if (recorded.textFits) {
+        symbolStates.emplaceOrientation(symbolInstance.getCrossTileID(), style::TextWritingModeType::Horizontal);
+    }
+
+    bool offscreen = true;
+    if (recorded.hasText) {
+        offscreen &= recorded.textFits && collisionIndex.isOffscreen(textBoxes);
+    }
+    if (recorded.hasIcon) {
+        offscreen &= recorded.iconFits && collisionIndex.isOffscreen(iconBoxes);
+    }
+
+    JointPlacement result(recorded.placeText, recorded.placeIcon, offscreen || bucket.justReloaded);
+    symbolStates.setPlacement(symbolInstance.getCrossTileID(), result);
+    recordSymbol(symbolInstance.getCrossTileID(), recorded);
+    newSymbolPlaced(symbolInstance, ctx, result, ctx.placementType, textBoxes, iconBoxes);
+    ++reusedSymbolCount;
+    return result;
+}
+
+void Placement::recordSymbol(uint32_t crossTileID, RecordedSymbol recorded) {
+    recorded.firstBox = static_cast<uint32_t>(recordedBoxes.size());
+    recorded.textBoxCount = static_cast<uint32_t>(textBoxes.size());
+    recorded.iconBoxCount = static_cast<uint32_t>(iconBoxes.size());
+    recordedBoxes.insert(recordedBoxes.end(), textBoxes.begin(), textBoxes.end());
+    recordedBoxes.insert(recordedBoxes.end(), iconBoxes.begin(), iconBoxes.end());
+    recordedSymbols.insert_or_assign(crossTileID, recorded);
+}
+
+namespace {
+
+bool nearlyEqual(const ProjectedCollisionBox& a, const ProjectedCollisionBox& b) {
+    // Boxes moved by the camera shift differ from freshly projected ones by rounding
+    constexpr float epsilon = 0.01f;
+    const auto close = [](float x, float y) {
+        return std::abs(x - y) < epsilon;
+    };
+    if (a.isBox() && b.isBox()) {
+        return close(a.box().min.x, b.box().min.x) && close(a.box().min.y, b.box().min.y) &&
+               close(a.box().max.x, b.box().max.x) && close(a.box().max.y, b.box().max.y);
+    }
+    if (a.isCircle() && b.isCircle()) {
+        return close(a.circle().center.x, b.circle().center.x) && close(a.circle().center.y, b.circle().center.y) &&
+               close(a.circle().radius, b.circle().radius);
+    }
+    return !a.isBox() && !a.isCircle() && !b.isBox() && !b.isCircle();
+}
+
+bool nearlyEqual(const std::vector<ProjectedCollisionBox>& a, const std::vector<ProjectedCollisionBox>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const auto& lhs, const auto& rhs) {
+        return nearlyEqual(lhs, rhs);
+    });
+}
+
+} // namespace
+
+void Placement::markIfPlacedDifferently(uint32_t crossTileID, const RecordedSymbol& current) {
+    const Placement* prev = getPrevPlacement();
+    const auto found = prev->recordedSymbols.find(crossTileID);
+    const RecordedSymbol* previous = found != prev->recordedSymbols.end() ? &found->second : nullptr;
+    if (!(current.placeText || current.placeIcon) && !(previous && (previous->placeText || previous->placeIcon))) {
+        return;
+    }
+
+    previousTextBoxes.clear();
+    previousIconBoxes.clear();
+    if (previous) {
+        prev->appendRecordedBoxes(*previous, false, cameraShift, previousTextBoxes);
+        prev->appendRecordedBoxes(*previous, true, cameraShift, previousIconBoxes);
+        if (previous->symbol == current.symbol && previous->placeText == current.placeText &&
+            previous->placeIcon == current.placeIcon && nearlyEqual(previousTextBoxes, textBoxes) &&
+            nearlyEqual(previousIconBoxes, iconBoxes)) {
+            return;
+        }
+    }
+    markChangedRegion(previousTextBoxes);
+    markChangedRegion(previousIconBoxes);
+    markChangedRegion(textBoxes);
+    markChangedRegion(iconBoxes);
+}
+
+void Placement::appendRecordedBoxes(const RecordedSymbol& recorded,
+                                    bool icon,
+                                    Point<float> offset,
+                                    std::vector<ProjectedCollisionBox>& out) const {
+    const auto first = recordedBoxes.begin() + recorded.firstBox + (icon ? recorded.textBoxCount : 0);
+    const auto last = first + (icon ? recorded.iconBoxCount : recorded.textBoxCount);
+    for (auto it = first; it != last; ++it) {
+        out.push_back(it->translate(offset));
+    }
+}
+
+bool Placement::overlapsChangedRegion(const std::vector<ProjectedCollisionBox>& boxes) const {
+    if (changedRegions->empty()) {
+        return false;
+    }
+    return std::any_of(boxes.begin(), boxes.end(), [this](const ProjectedCollisionBox& box) {
+        return (box.isBox() && changedRegions->hitTest(box.box())) ||
+               (box.isCircle() && changedRegions->hitTest(box.circle()));
+    });
+}
+
+void Placement::markChangedRegion(const std::vector<ProjectedCollisionBox>& boxes) {
+    for (const auto& box : boxes) {
+        if (box.isBox()) {
+            changedRegions->insert(0u, box.box());
+        } else if (box.isCircle()) {
+            changedRegions->insert(0u, box.circle());
+        }
+    }
+}
+
 void Placement::placeLayer(const RenderLayer& layer, std::set<uint32_t>& seenCrossTileIDs) {
     for (const BucketPlacementData& data : layer.getPlacementData()) {
         Bucket& bucket = data.bucket;
@@ -276,6 +566,13 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
         // a parent tile that _should_ be placed.
         return kUnplaced;
     }
+    if (incremental) {
+        if (const auto reused = reuseSymbolPlacement(symbolInstance, ctx)) {
+            return *reused;
+        }
+    }
+    ++testedSymbolCount;
+
     const SymbolBucket& bucket = ctx.getBucket();
     const mat4& posMatrix = ctx.getRenderTile().matrix;
     const auto& collisionGroup = ctx.collisionGroup;
@@ -289,6 +586,7 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
     std::pair<bool, bool> placed{false, false};
     std::pair<bool, bool> placedVerticalText{false, false};
     std::pair<bool, bool> placedVerticalIcon{false, false};
+    std::pair<bool, bool> placedIcon{false, false};
     Point<float> shift{0.0f, 0.0f};
     std::optional<size_t> horizontalTextIndex = symbolInstance.getDefaultHorizontalPlacedTextIndex();
     if (horizontalTextIndex) {
@@ -297,9 +595,10 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
 
         const auto updatePreviousOrientationIfNotPlaced = [&](bool isPlaced) {
             if (bucket.allowVerticalPlacement && !isPlaced && getPrevPlacement()) {
-                auto prevOrientation = getPrevPlacement()->placedOrientations.find(symbolInstance.getCrossTileID());
-                if (prevOrientation != getPrevPlacement()->placedOrientations.end()) {
-                    placedOrientations[symbolInstance.getCrossTileID()] = prevOrientation->second;
+                const auto prevOrientation = getPrevPlacement()->symbolStates.getOrientation(
+                    symbolInstance.getCrossTileID());
+                if (prevOrientation) {
+                    symbolStates.setOrientation(symbolInstance.getCrossTileID(), *prevOrientation);
                 }
             }
         };
@@ -343,7 +642,7 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
                                                                  collisionGroup.second,
                                                                  textBoxes);
                 if (placedFeature.first) {
-                    placedOrientations.emplace(symbolInstance.getCrossTileID(), orientation);
+                    symbolStates.emplaceOrientation(symbolInstance.getCrossTileID(), orientation);
                 }
                 return placedFeature;
             };
@@ -371,9 +670,10 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
             // used anchor to the front of the anchor list, only if the previous
             // anchor is still in the anchor list.
             if (getPrevPlacement()) {
-                auto prevOffset = getPrevPlacement()->variableOffsets.find(symbolInstance.getCrossTileID());
-                if (prevOffset != getPrevPlacement()->variableOffsets.end()) {
-                    const auto prevAnchor = prevOffset->second.anchor;
+                const auto* prevOffset = getPrevPlacement()->symbolStates.getVariableOffset(
+                    symbolInstance.getCrossTileID());
+                if (prevOffset) {
+                    const auto prevAnchor = prevOffset->anchor;
                     auto found = std::find(variableTextAnchors.begin(), variableTextAnchors.end(), prevAnchor);
                     if (found != variableTextAnchors.begin() && found != variableTextAnchors.end()) {
                         std::vector<style::TextVariableAnchorType> filtered{prevAnchor};
@@ -465,25 +765,25 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
                         // placement, record the anchor position to allow us
                         // to animate the transition
                         if (getPrevPlacement()) {
-                            auto prevOffset = getPrevPlacement()->variableOffsets.find(symbolInstance.getCrossTileID());
-                            auto prevPlacements = getPrevPlacement()->placements.find(symbolInstance.getCrossTileID());
-                            if (prevOffset != getPrevPlacement()->variableOffsets.end() &&
-                                prevPlacements != getPrevPlacement()->placements.end() && prevPlacements->second.text) {
+                            const auto& prevStates = getPrevPlacement()->symbolStates;
+                            const auto* prevOffset = prevStates.getVariableOffset(symbolInstance.getCrossTileID());
+                            const auto prevJointPlacement = prevStates.getPlacement(symbolInstance.getCrossTileID());
+                            if (prevOffset && prevJointPlacement && prevJointPlacement->text) {
                                 // TODO: The prevAnchor seems to be unused, needs to be fixed.
-                                prevAnchor = prevOffset->second.anchor;
+                                prevAnchor = prevOffset->anchor;
                             }
                         }
 
-                        variableOffsets.insert(std::make_pair(symbolInstance.getCrossTileID(),
-                                                              VariableOffset{.offset = variableTextOffset,
-                                                                             .width = width,
-                                                                             .height = height,
-                                                                             .anchor = anchor,
-                                                                             .textBoxScale = textBoxScale,
-                                                                             .prevAnchor = prevAnchor}));
+                        symbolStates.emplaceVariableOffset(symbolInstance.getCrossTileID(),
+                                                           VariableOffset{.offset = variableTextOffset,
+                                                                          .width = width,
+                                                                          .height = height,
+                                                                          .anchor = anchor,
+                                                                          .textBoxScale = textBoxScale,
+                                                                          .prevAnchor = prevAnchor});
 
                         if (bucket.allowVerticalPlacement) {
-                            placedOrientations.emplace(symbolInstance.getCrossTileID(), orientation);
+                            symbolStates.emplaceOrientation(symbolInstance.getCrossTileID(), orientation);
                         }
                         break;
                     }
@@ -520,9 +820,10 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
             // If we didn't get placed, we still need to copy our position from
             // the last placement for fade animations
             if (!placeText && getPrevPlacement()) {
-                auto prevOffset = getPrevPlacement()->variableOffsets.find(symbolInstance.getCrossTileID());
-                if (prevOffset != getPrevPlacement()->variableOffsets.end()) {
-                    variableOffsets[symbolInstance.getCrossTileID()] = prevOffset->second;
+                const auto* prevOffset = getPrevPlacement()->symbolStates.getVariableOffset(
+                    symbolInstance.getCrossTileID());
+                if (prevOffset) {
+                    symbolStates.setVariableOffset(symbolInstance.getCrossTileID(), *prevOffset);
                 }
             }
         }
@@ -553,7 +854,6 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
                                                iconBoxes);
         };
 
-        std::pair<bool, bool> placedIcon;
         if (placedVerticalText.first && symbolInstance.getVerticalIconCollisionFeature()) {
             placedIcon = placedVerticalIcon = placeIconFeature(*symbolInstance.getVerticalIconCollisionFeature());
         } else {
@@ -621,23 +921,41 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
         return kUnplaced;
     }
 
-    if (symbolInstance.getCrossTileID() != 0) {
-        const auto hit = placements.find(symbolInstance.getCrossTileID());
-        if (hit != placements.end()) {
-            // If there's a previous placement with this ID, it comes from a tile that's fading out
-            // Erase it so that the placement result from the non-fading tile supersedes it
-            placements.erase(hit);
-        }
-    } else {
+    if (symbolInstance.getCrossTileID() == 0) {
         assert(false);
         // We skipped some setup, don't use this one or we might run into inconsistencies
         symbolInstance.forceFail();
         return kUnplaced;
     }
 
+    if (recordSymbols) {
+        const bool hasText = horizontalTextIndex.has_value();
+        const bool hasIcon = symbolInstance.getPlacedIconIndex().has_value();
+        // Symbols with alternative anchors or orientations may be placed differently even where nothing
+        // changed. Line labels that did not fit were not projected completely.
+        const bool reusable = variableTextAnchors.empty() && !bucket.allowVerticalPlacement && !ctx.alwaysShowText &&
+                              !ctx.alwaysShowIcon && !ctx.avoidEdges &&
+                              (!hasText || placed.first || !symbolInstance.getTextCollisionFeature().alongLine) &&
+                              (!hasIcon || placedIcon.first || !symbolInstance.getIconCollisionFeature().alongLine);
+        const RecordedSymbol recorded{.symbol = &symbolInstance,
+                                      .hasText = hasText,
+                                      .hasIcon = hasIcon,
+                                      .textFits = placed.first,
+                                      .iconFits = placedIcon.first,
+                                      .placeText = placeText,
+                                      .placeIcon = placeIcon,
+                                      .reusable = reusable};
+        if (incremental) {
+            markIfPlacedDifferently(symbolInstance.getCrossTileID(), recorded);
+        }
+        recordSymbol(symbolInstance.getCrossTileID(), recorded);
+    }
+
     JointPlacement result(
         placeText || ctx.alwaysShowText, placeIcon || ctx.alwaysShowIcon, offscreen || bucket.justReloaded);
-    placements.emplace(symbolInstance.getCrossTileID(), result);
+    // If there's a previous placement with this ID, it comes from a tile that's fading out
+    // Overwrite it so that the placement result from the non-fading tile supersedes it
+    symbolStates.setPlacement(symbolInstance.getCrossTileID(), result);
     newSymbolPlaced(symbolInstance, ctx, result, ctx.placementType, textBoxes, iconBoxes);
     return result;
 }
@@ -667,8 +985,8 @@ SymbolInstanceReferences Placement::getSortedSymbols(const BucketPlacementData&
         std::stable_sort(sortedSymbols.begin(),
                          sortedSymbols.end(),
                          [previousPlacement](const SymbolInstance& a, const SymbolInstance& b) noexcept {
-                             auto* aPlacement = previousPlacement->getSymbolPlacement(a);
-                             auto* bPlacement = previousPlacement->getSymbolPlacement(b);
+                             const auto aPlacement = previousPlacement->getSymbolPlacement(a);
+                             const auto bPlacement = previousPlacement->getSymbolPlacement(b);
                              if (!aPlacement) {
                                  // a < b, if 'a' is new and if 'b' was previously hidden.
                                  return bPlacement && !bPlacement->placed();
@@ -693,57 +1011,51 @@ void Placement::commit() {
     prevZoomAdjustment = getPrevPlacement()->zoomAdjustment(placementZoom);
     const float increment = getPrevPlacement()->symbolFadeChange(commitTime);
 
+    const auto& prevStates = getPrevPlacement()->symbolStates;
+
     // add the opacities from the current placement, and copy their current
     // values from the previous placement
-    for (auto& jointPlacement : placements) {
-        auto prevOpacity = getPrevPlacement()->opacities.find(jointPlacement.first);
-        if (prevOpacity != getPrevPlacement()->opacities.end()) {
-            opacities.emplace(
-                jointPlacement.first,
-                JointOpacityState(
-                    prevOpacity->second, increment, jointPlacement.second.text, jointPlacement.second.icon));
-            placementChanged = placementChanged || jointPlacement.second.icon != prevOpacity->second.icon.placed ||
-                               jointPlacement.second.text != prevOpacity->second.text.placed;
+    symbolStates.forEachPlacement([&](uint32_t crossTileID, const JointPlacement& jointPlacement) {
+        if (const auto prevOpacity = prevStates.getOpacity(crossTileID)) {
+            symbolStates.setOpacity(
+                crossTileID, JointOpacityState(*prevOpacity, increment, jointPlacement.text, jointPlacement.icon));
+            placementChanged = placementChanged || jointPlacement.icon != prevOpacity->icon.placed ||
+                               jointPlacement.text != prevOpacity->text.placed;
         } else {
-            opacities.emplace(
-                jointPlacement.first,
-                JointOpacityState(
-                    jointPlacement.second.text, jointPlacement.second.icon, jointPlacement.second.skipFade));
-            placementChanged = placementChanged || jointPlacement.second.icon || jointPlacement.second.text;
+            symbolStates.setOpacity(
+                crossTileID, JointOpacityState(jointPlacement.text, jointPlacement.icon, jointPlacement.skipFade));
+            placementChanged = placementChanged || jointPlacement.icon || jointPlacement.text;
         }
-    }
+    });
 
     // copy and update values from the previous placement that aren't in the
     // current placement but haven't finished fading
-    for (auto& prevOpacity : getPrevPlacement()->opacities) {
-        if (!opacities.contains(prevOpacity.first)) {
-            JointOpacityState jointOpacity(prevOpacity.second, increment, false, false);
+    prevStates.forEachOpacity([&](uint32_t crossTileID, const JointOpacityState& prevOpacity) {
+        if (!symbolStates.getOpacity(crossTileID)) {
+            JointOpacityState jointOpacity(prevOpacity, increment, false, false);
             if (!jointOpacity.isHidden()) {
-                opacities.emplace(prevOpacity.first, jointOpacity);
-                placementChanged = placementChanged || prevOpacity.second.icon.placed || prevOpacity.second.text.placed;
+                symbolStates.setOpacity(crossTileID, jointOpacity);
+                placementChanged = placementChanged || prevOpacity.icon.placed || prevOpacity.text.placed;
             }
         }
-    }
+    });
 
-    for (auto& prevOffset : getPrevPlacement()->variableOffsets) {
-        const uint32_t crossTileID = prevOffset.first;
-        auto foundOffset = variableOffsets.find(crossTileID);
-        auto foundOpacity = opacities.find(crossTileID);
-        if (foundOffset == variableOffsets.end() && foundOpacity != opacities.end() &&
-            !foundOpacity->second.isHidden()) {
-            variableOffsets[prevOffset.first] = prevOffset.second;
+    const auto isVisible = [&](uint32_t crossTileID) {
+        const auto opacity = symbolStates.getOpacity(crossTileID);
+        return opacity && !opacity->isHidden();
+    };
+
+    prevStates.forEachVariableOffset([&](uint32_t crossTileID, const VariableOffset& prevOffset) {
+        if (!symbolStates.getVariableOffset(crossTileID) && isVisible(crossTileID)) {
+            symbolStates.setVariableOffset(crossTileID, prevOffset);
         }
-    }
+    });
 
-    for (auto& prevOrientation : getPrevPlacement()->placedOrientations) {
-        const uint32_t crossTileID = prevOrientation.first;
-        auto foundOrientation = placedOrientations.find(crossTileID);
-        auto foundOpacity = opacities.find(crossTileID);
-        if (foundOrientation == placedOrientations.end() && foundOpacity != opacities.end() &&
-            !foundOpacity->second.isHidden()) {
-            placedOrientations[prevOrientation.first] = prevOrientation.second;
+    prevStates.forEachOrientation([&](uint32_t crossTileID, style::TextWritingModeType prevOrientation) {
+        if (!symbolStates.getOrientation(crossTileID) && isVisible(crossTileID)) {
+            symbolStates.setOrientation(crossTileID, prevOrientation);
         }
-    }
+    });
 
     fadeStartTime = placementChanged ? commitTime
                                      : (getPrevPlacement() ? getPrevPlacement()->fadeStartTime : TimePoint{});
@@ -848,10 +1160,9 @@ bool Placement::updateBucketDynamicVertices(SymbolBucket& bucket,
             std::optional<VariableOffset> variableOffset;
             const bool skipOrientation = bucket.allowVerticalPlacement && !symbol.placedOrientation;
             if (!symbol.hidden && symbol.crossTileID != 0u && !skipOrientation) {
-                auto it = variableOffsets.find(symbol.crossTileID);
-                if (it != variableOffsets.end()) {
+                if (const auto* found = symbolStates.getVariableOffset(symbol.crossTileID)) {
                     bucket.hasVariablePlacement = true;
-                    variableOffset = it->second;
+                    variableOffset = *found;
                 }
             }
 
@@ -997,12 +1308,11 @@ void Placement::updateBucketOpacities(SymbolBucket& bucket,
         if (!symbolInstance.check(SYM_GUARD_LOC)) continue;
         bool isDuplicate = seenCrossTileIDs.contains(symbolInstance.getCrossTileID());
 
-        auto it = opacities.find(symbolInstance.getCrossTileID());
         auto opacityState = defaultOpacityState;
         if (isDuplicate) {
             opacityState = duplicateOpacityState;
-        } else if (it != opacities.end()) {
-            opacityState = it->second;
+        } else if (const auto found = symbolStates.getOpacity(symbolInstance.getCrossTileID())) {
+            opacityState = *found;
         }
 
         seenCrossTileIDs.insert(symbolInstance.getCrossTileID());
@@ -1043,16 +1353,14 @@ void Placement::updateBucketOpacities(SymbolBucket& bucket,
 
             style::TextWritingModeType previousOrientation = style::TextWritingModeType::Horizontal;
             if (bucket.allowVerticalPlacement) {
-                auto prevOrientation = placedOrientations.find(symbolInstance.getCrossTileID());
-                if (prevOrientation != placedOrientations.end()) {
-                    previousOrientation = prevOrientation->second;
-                    markUsedOrientation(bucket, prevOrientation->second, symbolInstance);
+                if (const auto prevOrientation = symbolStates.getOrientation(symbolInstance.getCrossTileID())) {
+                    previousOrientation = *prevOrientation;
+                    markUsedOrientation(bucket, *prevOrientation, symbolInstance);
                 }
             }
 
-            auto prevOffset = variableOffsets.find(symbolInstance.getCrossTileID());
-            if (prevOffset != variableOffsets.end()) {
-                markUsedJustification(bucket, prevOffset->second.anchor, symbolInstance, previousOrientation);
+            if (const auto* prevOffset = symbolStates.getVariableOffset(symbolInstance.getCrossTileID())) {
+                markUsedJustification(bucket, prevOffset->anchor, symbolInstance, previousOrientation);
             }
         }
         if (symbolInstance.hasIcon()) {
@@ -1091,9 +1399,9 @@ void Placement::updateBucketOpacities(SymbolBucket& bucket,
                 }
                 bool used = true;
                 if (variablePlacement) {
-                    auto foundOffset = variableOffsets.find(symbolInstance.getCrossTileID());
-                    if (foundOffset != variableOffsets.end()) {
-                        const VariableOffset& variableOffset = foundOffset->second;
+                    const auto* foundOffset = symbolStates.getVariableOffset(symbolInstance.getCrossTileID());
+                    if (foundOffset) {
+                        const VariableOffset& variableOffset = *foundOffset;
                         // This will show either the currently placed position or
                         // the last successfully placed position (so you can
                         // visualize what collision just made the symbol disappear,
@@ -1293,10 +1601,9 @@ float Placement::zoomAdjustment(const float zoom) const {
     return std::max(0.0f, (placementZoom - zoom) / 1.5f);
 }
 
-const JointPlacement* Placement::getSymbolPlacement(const SymbolInstance& symbol) const {
+std::optional<JointPlacement> Placement::getSymbolPlacement(const SymbolInstance& symbol) const {
     assert(symbol.getCrossTileID() != 0);
-    const auto found = placements.find(symbol.getCrossTileID());
-    return (found != placements.end()) ? &found->second : nullptr;
+    return symbolStates.getPlacement(symbol.getCrossTileID());
 }
 
 Duration Placement::getUpdatePeriod(const float zoom) const {
@@ -1349,11 +1656,10 @@ protected:
 
 void StaticPlacement::commit() {
     fadeStartTime = commitTime;
-    for (auto& jointPlacement : placements) {
-        opacities.emplace(
-            jointPlacement.first,
-            JointOpacityState(jointPlacement.second.text, jointPlacement.second.icon, jointPlacement.second.skipFade));
-    }
+    symbolStates.forEachPlacement([&](uint32_t crossTileID, const JointPlacement& jointPlacement) {
+        symbolStates.setOpacity(
+            crossTileID, JointOpacityState(jointPlacement.text, jointPlacement.icon, jointPlacement.skipFade));
+    });
 }
 
 /// Placement for Tile map mode.
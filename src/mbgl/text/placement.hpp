@@ -4,7 +4,9 @@
 #include <mbgl/renderer/renderer.hpp>
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/text/collision_index.hpp>
+#include <mbgl/text/placement_state.hpp>
 #include <mbgl/util/chrono.hpp>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -17,52 +19,6 @@ using SymbolInstanceReferences = std::vector<std::reference_wrapper<const Symbol
 class UpdateParameters;
 enum class PlacedSymbolOrientation : bool;
 
-class OpacityState {
-public:
-    OpacityState(bool placed, bool skipFade);
-    OpacityState(const OpacityState& prevState, float increment, bool placed);
-    bool isHidden() const;
-    float opacity;
-    bool placed;
-};
-
-class JointOpacityState {
-public:
-    JointOpacityState(bool placedText, bool placedIcon, bool skipFade);
-    JointOpacityState(const JointOpacityState& prevOpacityState, float increment, bool placedText, bool placedIcon);
-    bool isHidden() const;
-    OpacityState icon;
-    OpacityState text;
-};
-
-class VariableOffset {
-public:
-    std::array<float, 2> offset;
-    float width;
-    float height;
-    style::TextVariableAnchorType anchor;
-    float textBoxScale;
-    std::optional<style::TextVariableAnchorType> prevAnchor;
-};
-
-class JointPlacement {
-public:
-    JointPlacement(bool text_, bool icon_, bool skipFade_)
-        : text(text_),
-          icon(icon_),
-          skipFade(skipFade_) {}
-
-    bool placed() const { return text || icon; }
-
-    const bool text;
-    const bool icon;
-    // skipFade = outside viewport, but within CollisionIndex::viewportPadding
-    // px of the edge Because these symbols aren't onscreen yet, we can skip the
-    // "fade in" animation, and if a subsequent viewport change brings them into
-    // view, they'll be fully visible right away.
-    const bool skipFade;
-};
-
 struct RetainedQueryData {
     uint32_t bucketInstanceId;
     std::shared_ptr<FeatureIndex> featureIndex;
@@ -134,10 +90,15 @@ public:
     Duration getUpdatePeriod(float zoom) const;
 
     float zoomAdjustment(float zoom) const;
-    const JointPlacement* getSymbolPlacement(const SymbolInstance&) const;
+    std::optional<JointPlacement> getSymbolPlacement(const SymbolInstance&) const;
 
     const RetainedQueryData& getQueryData(uint32_t bucketInstanceId) const;
 
+    /// Number of symbols whose result was carried over from the previous placement
+    std::size_t getReusedSymbolCount() const { return reusedSymbolCount; }
+    /// Number of symbols that were collision tested
+    std::size_t getTestedSymbolCount() const { return testedSymbolCount; }
+
     // Public constructors are required for makeMutable(), shall not be called directly.
     Placement();
     Placement(std::shared_ptr<const UpdateParameters>, std::optional<Immutable<Placement>> prevPlacement);
@@ -147,6 +108,8 @@ protected:
     virtual void placeSymbolBucket(const BucketPlacementData&, std::set<uint32_t>& seenCrossTileIDs);
     JointPlacement placeSymbol(const SymbolInstance& symbolInstance, const PlacementContext&);
     void placeLayer(const RenderLayer&, std::set<uint32_t>&);
+    // Returns `false` if there are fewer than two collision groups to place.
+    bool placeLayersByCollisionGroup(const RenderLayerReferences&);
     virtual void commit();
     virtual void newSymbolPlaced(const SymbolInstance&,
                                  const PlacementContext&,
@@ -181,6 +144,38 @@ protected:
     const Placement* getPrevPlacement() const { return prevPlacement ? prevPlacement->get() : nullptr; }
     bool isTiltedView() const;
 
+    // Outcome and projected boxes of a symbol, kept for the next placement
+    struct RecordedSymbol {
+        const SymbolInstance* symbol = nullptr;
+        // Text boxes start at `firstBox` in `recordedBoxes`, followed by the icon boxes
+        uint32_t firstBox = 0;
+        uint32_t textBoxCount = 0;
+        uint32_t iconBoxCount = 0;
+        bool hasText = false;
+        bool hasIcon = false;
+        // Whether text and icon fit on their own, before being combined
+        bool textFits = false;
+        bool iconFits = false;
+        // Whether text and icon were inserted into the collision index
+        bool placeText = false;
+        bool placeIcon = false;
+        // Whether the next placement may take over the outcome
+        bool reusable = false;
+    };
+
+    // Returns `true` if symbols may be reused from the previous placement.
+    bool prepareIncrementalPlacement(const RenderLayerReferences&);
+    std::optional<JointPlacement> reuseSymbolPlacement(const SymbolInstance&, const PlacementContext&);
+    // Records `textBoxes` and `iconBoxes` along with the outcome.
+    void recordSymbol(uint32_t crossTileID, RecordedSymbol);
+    void markIfPlacedDifferently(uint32_t crossTileID, const RecordedSymbol&);
+    void appendRecordedBoxes(const RecordedSymbol&,
+                             bool icon,
+                             Point<float> offset,
+                             std::vector<ProjectedCollisionBox>&) const;
+    bool overlapsChangedRegion(const std::vector<ProjectedCollisionBox>&) const;
+    void markChangedRegion(const std::vector<ProjectedCollisionBox>&);
+
     std::shared_ptr<const UpdateParameters> updateParameters;
     CollisionIndex collisionIndex;
 
@@ -191,10 +186,8 @@ protected:
     float placementZoom = 0.0f;
     float prevZoomAdjustment = 0.0f;
 
-    std::unordered_map<uint32_t, JointPlacement> placements;
-    std::unordered_map<uint32_t, JointOpacityState> opacities;
-    std::unordered_map<uint32_t, VariableOffset> variableOffsets;
-    std::unordered_map<uint32_t, style::TextWritingModeType> placedOrientations;
+    // Placements, opacities, variable offsets and orientations by crossTileID
+    PlacementStateTable symbolStates;
 
     std::unordered_map<uint32_t, RetainedQueryData> retainedQueryData;
     CollisionGroups collisionGroups;
@@ -206,6 +199,22 @@ protected:
     std::vector<ProjectedCollisionBox> iconBoxes;
     // Used for debug purposes.
     std::unordered_map<const CollisionFeature*, std::vector<ProjectedCollisionBox>> collisionCircles;
+
+    // Incremental placement
+    bool recordSymbols = false;
+    bool incremental = false;
+    std::unordered_map<uint32_t, RecordedSymbol> recordedSymbols;
+    std::vector<ProjectedCollisionBox> recordedBoxes;
+    // Buckets in placement order, with their tile's `holdForFade()`
+    std::vector<std::pair<uint32_t, bool>> recordedBuckets;
+    // Screen offset of the previous placement's symbols
+    Point<float> cameraShift;
+    // Areas where placed features differ from the previous placement
+    std::optional<GridIndex<uint32_t>> changedRegions;
+    std::vector<ProjectedCollisionBox> previousTextBoxes;
+    std::vector<ProjectedCollisionBox> previousIconBoxes;
+    std::size_t reusedSymbolCount = 0;
+    std::size_t testedSymbolCount = 0;
 };
 
 } // namespace mbgl
@@ -0,0 +1,246 @@
+#include <mbgl/text/placement_state.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <mutex>
+
+namespace mbgl {
+
+OpacityState::OpacityState(bool placed_, bool skipFade)
+    : opacity((skipFade && placed_) ? 1.0f : 0.0f),
+      placed(placed_) {}
+
+OpacityState::OpacityState(const OpacityState& prevState, float increment, bool placed_)
+    : opacity(std::fmax(0.0f, std::fmin(1.0f, prevState.opacity + (prevState.placed ? increment : -increment)))),
+      placed(placed_) {}
+
+bool OpacityState::isHidden() const {
+    return opacity == 0 && !placed;
+}
+
+JointOpacityState::JointOpacityState(bool placedText, bool placedIcon, bool skipFade)
+    : icon(OpacityState(placedIcon, skipFade)),
+      text(OpacityState(placedText, skipFade)) {}
+
+JointOpacityState::JointOpacityState(const JointOpacityState& prevOpacityState,
+                                     float increment,
+                                     bool placedText,
+                                     bool placedIcon)
+    : icon(OpacityState(prevOpacityState.icon, increment, placedIcon)),
+      text(OpacityState(prevOpacityState.text, increment, placedText)) {}
+
+bool JointOpacityState::isHidden() const {
+    return icon.isHidden() && text.isHidden();
+}
+
+namespace {
+
+// Two placements are alive at a time, this covers both on a label-heavy map
+constexpr std::size_t maxRecycledPages = 64;
+
+uint32_t nextGeneration() {
+    static std::atomic<uint32_t> counter{0};
+    uint32_t generation = ++counter;
+    // Zero is the stamp of pages that were never written
+    while (generation == 0) {
+        generation = ++counter;
+    }
+    return generation;
+}
+
+} // namespace
+
+struct PlacementStateTable::PagePool {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Page>> pages;
+};
+
+PlacementStateTable::PagePool& PlacementStateTable::pagePool() {
+    static PagePool pool;
+    return pool;
+}
+
+PlacementStateTable::PlacementStateTable()
+    : generation(nextGeneration()) {}
+
+PlacementStateTable::~PlacementStateTable() {
+    auto& pool = pagePool();
+    std::scoped_lock lock(pool.mutex);
+    for (auto& page : pages) {
+        if (pool.pages.size() >= maxRecycledPages) {
+            break;
+        }
+        pool.pages.push_back(std::move(page));
+    }
+}
+
+JointPlacement PlacementStateTable::placementAt(const Page& page, uint32_t i) {
+    const uint16_t flags = page.flags[i];
+    return {(flags & PlacedText) != 0, (flags & PlacedIcon) != 0, (flags & SkipFade) != 0};
+}
+
+JointOpacityState PlacementStateTable::opacityAt(const Page& page, uint32_t i) {
+    const uint16_t flags = page.flags[i];
+    JointOpacityState state(false, false, false);
+    state.text.opacity = page.textOpacities[i];
+    state.text.placed = (flags & OpacityPlacedText) != 0;
+    state.icon.opacity = page.iconOpacities[i];
+    state.icon.placed = (flags & OpacityPlacedIcon) != 0;
+    return state;
+}
+
+const PlacementStateTable::Page* PlacementStateTable::find(uint32_t crossTileID, uint16_t flag) const {
+    const std::size_t index = crossTileID / PageSize;
+    if (index >= directory.size() || !directory[index]) {
+        return nullptr;
+    }
+    const Page* page = directory[index];
+    return (flagsAt(*page, crossTileID % PageSize) & flag) ? page : nullptr;
+}
+
+PlacementStateTable::Page& PlacementStateTable::writable(uint32_t crossTileID) {
+    const std::size_t index = crossTileID / PageSize;
+    if (index >= directory.size()) {
+        directory.resize(index + 1, nullptr);
+    }
+
+    Page*& page = directory[index];
+    if (!page) {
+        auto& pool = pagePool();
+        std::unique_lock lock(pool.mutex);
+        if (pool.pages.empty()) {
+            lock.unlock();
+            pages.push_back(std::make_unique<Page>());
+        } else {
+            pages.push_back(std::move(pool.pages.back()));
+            pool.pages.pop_back();
+        }
+        page = pages.back().get();
+        page->firstID = static_cast<uint32_t>(index * PageSize);
+    }
+
+    const uint32_t i = crossTileID % PageSize;
+    if (page->generations[i] != generation) {
+        page->generations[i] = generation;
+        page->flags[i] = 0;
+    }
+    return *page;
+}
+
+std::optional<JointPlacement> PlacementStateTable::getPlacement(uint32_t crossTileID) const {
+    const Page* page = find(crossTileID, HasPlacement);
+    if (!page) {
+        return std::nullopt;
+    }
+    return placementAt(*page, crossTileID % PageSize);
+}
+
+void PlacementStateTable::setPlacement(uint32_t crossTileID, const JointPlacement& placement) {
+    Page& page = writable(crossTileID);
+    uint16_t& flags = page.flags[crossTileID % PageSize];
+    flags &= static_cast<uint16_t>(~PlacementFlags);
+    flags |= HasPlacement;
+    if (placement.text) flags |= PlacedText;
+    if (placement.icon) flags |= PlacedIcon;
+    if (placement.skipFade) flags |= SkipFade;
+}
+
+void PlacementStateTable::erasePlacement(uint32_t crossTileID) {
+    if (find(crossTileID, HasPlacement)) {
+        directory[crossTileID / PageSize]->flags[crossTileID % PageSize] &= static_cast<uint16_t>(~PlacementFlags);
+    }
+}
+
+std::optional<JointOpacityState> PlacementStateTable::getOpacity(uint32_t crossTileID) const {
+    const Page* page = find(crossTileID, HasOpacity);
+    if (!page) {
+        return std::nullopt;
+    }
+    return opacityAt(*page, crossTileID % PageSize);
+}
+
+void PlacementStateTable::setOpacity(uint32_t crossTileID, const JointOpacityState& opacity) {
+    Page& page = writable(crossTileID);
+    const uint32_t i = crossTileID % PageSize;
+    page.textOpacities[i] = opacity.text.opacity;
+    page.iconOpacities[i] = opacity.icon.opacity;
+    uint16_t& flags = page.flags[i];
+    flags &= static_cast<uint16_t>(~OpacityFlags);
+    flags |= HasOpacity;
+    if (opacity.text.placed) flags |= OpacityPlacedText;
+    if (opacity.icon.placed) flags |= OpacityPlacedIcon;
+}
+
+const VariableOffset* PlacementStateTable::getVariableOffset(uint32_t crossTileID) const {
+    const Page* page = find(crossTileID, HasVariableOffset);
+    return page ? &page->variableOffsets[crossTileID % PageSize] : nullptr;
+}
+
+void PlacementStateTable::setVariableOffset(uint32_t crossTileID, const VariableOffset& offset) {
+    Page& page = writable(crossTileID);
+    const uint32_t i = crossTileID % PageSize;
+    page.variableOffsets[i] = offset;
+    page.flags[i] |= HasVariableOffset;
+}
+
+bool PlacementStateTable::emplaceVariableOffset(uint32_t crossTileID, const VariableOffset& offset) {
+    if (find(crossTileID, HasVariableOffset)) {
+        return false;
+    }
+    setVariableOffset(crossTileID, offset);
+    return true;
+}
+
+std::optional<style::TextWritingModeType> PlacementStateTable::getOrientation(uint32_t crossTileID) const {
+    const Page* page = find(crossTileID, HasOrientation);
+    if (!page) {
+        return std::nullopt;
+    }
+    return page->orientations[crossTileID % PageSize];
+}
+
+void PlacementStateTable::setOrientation(uint32_t crossTileID, style::TextWritingModeType orientation) {
+    Page& page = writable(crossTileID);
+    const uint32_t i = crossTileID % PageSize;
+    page.orientations[i] = orientation;
+    page.flags[i] |= HasOrientation;
+}
+
+bool PlacementStateTable::emplaceOrientation(uint32_t crossTileID, style::TextWritingModeType orientation) {
+    if (find(crossTileID, HasOrientation)) {
+        return false;
+    }
+    setOrientation(crossTileID, orientation);
+    return true;
+}
+
+void PlacementStateTable::merge(const PlacementStateTable& other) {
+    other.forEach(PlacementFlags | OpacityFlags | HasVariableOffset | HasOrientation,
+                  [&](const Page& from, uint32_t i) {
+                      const uint16_t theirs = from.flags[i];
+                      Page& to = writable(from.firstID + i);
+                      uint16_t& ours = to.flags[i];
+                      if ((theirs & HasPlacement) && !(ours & HasPlacement)) {
+                          ours |= theirs & PlacementFlags;
+                      }
+                      if ((theirs & HasOpacity) && !(ours & HasOpacity)) {
+                          ours |= theirs & OpacityFlags;
+                          to.textOpacities[i] = from.textOpacities[i];
+                          to.iconOpacities[i] = from.iconOpacities[i];
+                      }
+                      if ((theirs & HasVariableOffset) && !(ours & HasVariableOffset)) {
+                          ours |= HasVariableOffset;
+                          to.variableOffsets[i] = from.variableOffsets[i];
+                      }
+                      if ((theirs & HasOrientation) && !(ours & HasOrientation)) {
+                          ours |= HasOrientation;
+                          to.orientations[i] = from.orientations[i];
+                      }
+                  });
+}
+
+void PlacementStateTable::clear() {
+    generation = nextGeneration();
+}
+
+} // namespace mbgl
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <mbgl/style/types.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace mbgl {
+
+class OpacityState {
+public:
+    OpacityState(bool placed, bool skipFade);
+    OpacityState(const OpacityState& prevState, float increment, bool placed);
+    bool isHidden() const;
+    float opacity;
+    bool placed;
+};
+
+class JointOpacityState {
+public:
+    JointOpacityState(bool placedText, bool placedIcon, bool skipFade);
+    JointOpacityState(const JointOpacityState& prevOpacityState, float increment, bool placedText, bool placedIcon);
+    bool isHidden() const;
+    OpacityState icon;
+    OpacityState text;
+};
+
+class VariableOffset {
+public:
+    std::array<float, 2> offset;
+    float width;
+    float height;
+    style::TextVariableAnchorType anchor;
+    float textBoxScale;
+    std::optional<style::TextVariableAnchorType> prevAnchor;
+};
+
+class JointPlacement {
+public:
+    JointPlacement(bool text_, bool icon_, bool skipFade_)
+        : text(text_),
+          icon(icon_),
+          skipFade(skipFade_) {}
+
+    bool placed() const { return text || icon; }
+
+    const bool text;
+    const bool icon;
+    // skipFade = outside viewport, but within CollisionIndex::viewportPadding
+    // px of the edge Because these symbols aren't onscreen yet, we can skip the
+    // "fade in" animation, and if a subsequent viewport change brings them into
+    // view, they'll be fully visible right away.
+    const bool skipFade;
+};
+
+/**
+ * @brief Per-symbol state of a placement, indexed by crossTileID.
+ *
+ * CrossTileIDs are handed out consecutively, so instead of hashing them the
+ * table addresses fixed size pages of columns directly. Each column only
+ * holds one kind of state, which keeps the per-frame scans over opacities
+ * and offsets within a few cache lines per page.
+ *
+ * Every slot is stamped with the generation of the table that wrote it.
+ * Pages of destroyed tables are recycled, and a slot stamped by an earlier
+ * owner reads as empty, so neither recycling nor `clear()` touches the pages.
+ */
+class PlacementStateTable {
+public:
+    PlacementStateTable();
+    ~PlacementStateTable();
+
+    PlacementStateTable(const PlacementStateTable&) = delete;
+    PlacementStateTable& operator=(const PlacementStateTable&) = delete;
+
+    std::optional<JointPlacement> getPlacement(uint32_t crossTileID) const;
+    void setPlacement(uint32_t crossTileID, const JointPlacement&);
+    void erasePlacement(uint32_t crossTileID);
+
+    std::optional<JointOpacityState> getOpacity(uint32_t crossTileID) const;
+    void setOpacity(uint32_t crossTileID, const JointOpacityState&);
+
+    const VariableOffset* getVariableOffset(uint32_t crossTileID) const;
+    void setVariableOffset(uint32_t crossTileID, const VariableOffset&);
+    /// Sets the offset unless one is already present, returns `true` if it was set.
+    bool emplaceVariableOffset(uint32_t crossTileID, const VariableOffset&);
+
+    std::optional<style::TextWritingModeType> getOrientation(uint32_t crossTileID) const;
+    void setOrientation(uint32_t crossTileID, style::TextWritingModeType);
+    /// Sets the orientation unless one is already present, returns `true` if it was set.
+    bool emplaceOrientation(uint32_t crossTileID, style::TextWritingModeType);
+
+    /// Copies the state `other` has and this table does not.
+    void merge(const PlacementStateTable& other);
+    /// Drops all state in constant time, the pages are kept.
+    void clear();
+
+    // The `forEach` functions visit slots page by page. `fn` may update the
+    // crossTileID it is called with, but must not add other IDs.
+
+    /// Calls `fn(crossTileID, const JointPlacement&)` for every placement.
+    template <typename Fn>
+    void forEachPlacement(Fn&& fn) const {
+        forEach(HasPlacement, [&](const Page& page, uint32_t i) { fn(page.firstID + i, placementAt(page, i)); });
+    }
+
+    /// Calls `fn(crossTileID, const JointOpacityState&)` for every opacity.
+    template <typename Fn>
+    void forEachOpacity(Fn&& fn) const {
+        forEach(HasOpacity, [&](const Page& page, uint32_t i) { fn(page.firstID + i, opacityAt(page, i)); });
+    }
+
+    /// Calls `fn(crossTileID, const VariableOffset&)` for every variable offset.
+    template <typename Fn>
+    void forEachVariableOffset(Fn&& fn) const {
+        forEach(HasVariableOffset,
+                [&](const Page& page, uint32_t i) { fn(page.firstID + i, page.variableOffsets[i]); });
+    }
+
+    /// Calls `fn(crossTileID, style::TextWritingModeType)` for every orientation.
+    template <typename Fn>
+    void forEachOrientation(Fn&& fn) const {
+        forEach(HasOrientation, [&](const Page& page, uint32_t i) { fn(page.firstID + i, page.orientations[i]); });
+    }
+
+private:
+    static constexpr uint32_t PageSize = 256;
+
+    struct Page {
+        uint32_t firstID = 0;
+        std::array<uint32_t, PageSize> generations{};
+        std::array<uint16_t, PageSize> flags{};
+        std::array<float, PageSize> textOpacities{};
+        std::array<float, PageSize> iconOpacities{};
+        std::array<style::TextWritingModeType, PageSize> orientations{};
+        std::array<VariableOffset, PageSize> variableOffsets{};
+    };
+
+    enum Flag : uint16_t {
+        HasPlacement = 1 << 0,
+        PlacedText = 1 << 1,
+        PlacedIcon = 1 << 2,
+        SkipFade = 1 << 3,
+        HasOpacity = 1 << 4,
+        OpacityPlacedText = 1 << 5,
+        OpacityPlacedIcon = 1 << 6,
+        HasVariableOffset = 1 << 7,
+        HasOrientation = 1 << 8,
+        PlacementFlags = HasPlacement | PlacedText | PlacedIcon | SkipFade,
+        OpacityFlags = HasOpacity | OpacityPlacedText | OpacityPlacedIcon,
+    };
+
+    // Returns the flags of a slot, zero if it is not stamped with the current generation.
+    uint16_t flagsAt(const Page& page, uint32_t i) const {
+        return page.generations[i] == generation ? page.flags[i] : 0;
+    }
+    static JointPlacement placementAt(const Page&, uint32_t i);
+    static JointOpacityState opacityAt(const Page&, uint32_t i);
+
+    // Pages released by destroyed tables, shared by all tables
+    struct PagePool;
+    static PagePool& pagePool();
+
+    const Page* find(uint32_t crossTileID, uint16_t flag) const;
+    // Returns the page holding `crossTileID`, with its slot stamped for the current generation.
+    Page& writable(uint32_t crossTileID);
+
+    template <typename Fn>
+    void forEach(uint16_t flag, Fn&& fn) const {
+        for (const auto& page : pages) {
+            for (uint32_t i = 0; i < PageSize; ++i) {
+                if (flagsAt(*page, i) & flag) {
+                    fn(*page, i);
+                }
+            }
+        }
+    }
+
+    uint32_t generation;
+    // Indexed by `crossTileID / PageSize`, null where nothing was written
+    std::vector<Page*> directory;
+    // Pages in the order they were first written
+    std::vector<std::unique_ptr<Page>> pages;
+};
+
+} // namespace mbgl
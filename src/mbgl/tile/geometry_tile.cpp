@@ -22,6 +22,7 @@
 #include <mbgl/util/thread_pool.hpp>
 #include <mbgl/gfx/upload_pass.hpp>
 
+#include <unordered_set>
 #include <utility>
 
 namespace mbgl {
@@ -204,7 +205,8 @@ GeometryTile::GeometryTile(const OverscaledTileID& id_,
              parameters.pixelRatio,
              parameters.debugOptions & MapDebugOptions::Collision,
              parameters.dynamicTextureAtlas,
-             parameters.glyphManager->getFontFaces()),
+             parameters.glyphManager->getFontFaces(),
+             parameters.abortedTileWork),
       fileSource(parameters.fileSource),
       glyphManager(parameters.glyphManager),
       imageManager(parameters.imageManager),
@@ -236,6 +238,30 @@ void GeometryTile::cancel() {
     markObsolete();
 }
 
+void GeometryTile::setPriority(Scheduler::Priority priority) {
+    worker.setPriority(priority);
+}
+
+std::size_t GeometryTile::getCPUMemoryUsage() const {
+    if (!layoutResult) {
+        return 0;
+    }
+
+    // Layers of the same layout group share a bucket, count each one once
+    std::unordered_set<const Bucket*> buckets;
+    std::size_t bytes = 0;
+    for (const auto& entry : layoutResult->layerRenderData) {
+        const Bucket* bucket = entry.second.bucket.get();
+        if (bucket && buckets.insert(bucket).second) {
+            bytes += bucket->getCPUMemoryUsage();
+        }
+    }
+    if (layoutResult->featureIndex) {
+        bytes += layoutResult->featureIndex->getCPUMemoryUsage();
+    }
+    return bytes;
+}
+
 void GeometryTile::markObsolete() {
     obsolete = true;
     mailbox->abandon();
@@ -65,6 +65,8 @@ public:
     float getQueryPadding(const std::unordered_map<std::string, const RenderLayer*>&) override;
 
     void cancel() override;
+    void setPriority(Scheduler::Priority) override;
+    std::size_t getCPUMemoryUsage() const override;
 
     class LayoutResult {
     public:
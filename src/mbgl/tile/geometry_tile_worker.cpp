@@ -39,7 +39,8 @@ GeometryTileWorker::GeometryTileWorker(OptionalActorRef<GeometryTileWorker> self
                                        const float pixelRatio_,
                                        const bool showCollisionBoxes_,
                                        gfx::DynamicTextureAtlasPtr dynamicTextureAtlas_,
-                                       std::shared_ptr<FontFaces> fontFaces_)
+                                       std::shared_ptr<FontFaces> fontFaces_,
+                                       std::shared_ptr<std::atomic<std::size_t>> abortedWork_)
     : self(std::move(self_)),
       parent(std::move(parent_)),
       scheduler(scheduler_),
@@ -50,7 +51,8 @@ GeometryTileWorker::GeometryTileWorker(OptionalActorRef<GeometryTileWorker> self
       pixelRatio(pixelRatio_),
       showCollisionBoxes(showCollisionBoxes_),
       dynamicTextureAtlas(dynamicTextureAtlas_),
-      fontFaces(fontFaces_) {}
+      fontFaces(fontFaces_),
+      abortedWork(std::move(abortedWork_)) {}
 
 GeometryTileWorker::~GeometryTileWorker() {
     MLN_TRACE_FUNC();
@@ -435,7 +437,7 @@ void GeometryTileWorker::parse() {
 
     for (auto& pair : groupMap) {
         const auto& group = pair.second;
-        if (obsolete) {
+        if (abortIfObsolete()) {
             return;
         }
 
@@ -444,8 +446,11 @@ void GeometryTileWorker::parse() {
         }
 
         const style::Layer::Impl& leaderImpl = *(group.at(0)->baseImpl);
-        BucketParameters parameters{
-            .tileID = id, .mode = mode, .pixelRatio = pixelRatio, .layerType = leaderImpl.getTypeInfo()};
+        BucketParameters parameters{.tileID = id,
+                                    .mode = mode,
+                                    .pixelRatio = pixelRatio,
+                                    .layerType = leaderImpl.getTypeInfo(),
+                                    .obsolete = &obsolete};
 
         auto geometryLayer = (*data)->getLayer(leaderImpl.sourceLayer);
         if (!geometryLayer) {
@@ -474,6 +479,10 @@ void GeometryTileWorker::parse() {
                                                                                 .availableImages = availableImages},
                                                                                std::move(geometryLayer),
                                                                                group);
+            // Layout construction evaluates every feature and may have stopped early
+            if (abortIfObsolete()) {
+                return;
+            }
             if (layout->hasDependencies()) {
                 layouts.push_back(std::move(layout));
             } else {
@@ -496,6 +505,10 @@ void GeometryTileWorker::parse() {
                 featureIndex->insert(geometries, i, sourceLayerID, leaderImpl.id);
             }
 
+            if (abortIfObsolete()) {
+                return;
+            }
+
             if (!bucket->hasData()) {
                 continue;
             }
@@ -530,6 +543,16 @@ bool GeometryTileWorker::hasPendingParseResult() const {
     return bool(featureIndex);
 }
 
+bool GeometryTileWorker::abortIfObsolete() {
+    if (!obsolete.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    if (abortedWork) {
+        abortedWork->fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
 void GeometryTileWorker::finalizeLayout() {
     MLN_TRACE_FUNC();
 
@@ -548,14 +571,23 @@ void GeometryTileWorker::finalizeLayout() {
             glyphAtlas = dynamicTextureAtlas->uploadGlyphs(glyphMap);
         }
 
-        for (auto& layout : layouts) {
-            if (obsolete) {
+        const auto abandon = [&] {
+            if (dynamicTextureAtlas) {
                 dynamicTextureAtlas->removeTextures(glyphAtlas.textureHandles, glyphAtlas.dynamicTexture);
                 dynamicTextureAtlas->removeTextures(imageAtlas.textureHandles, imageAtlas.dynamicTexture);
-                return;
+            }
+        };
+
+        for (auto& layout : layouts) {
+            if (abortIfObsolete()) {
+                return abandon();
             }
 
+            // Stops early once the tile is obsolete, leaving a partial layout behind
             layout->prepareSymbols(glyphMap, glyphAtlas.glyphPositions, iconMap, imageAtlas.iconPositions);
+            if (abortIfObsolete()) {
+                return abandon();
+            }
 
             if (!layout->hasSymbolInstances()) {
                 continue;
@@ -565,6 +597,10 @@ void GeometryTileWorker::finalizeLayout() {
             layout->createBucket(
                 imageAtlas.patternPositions, featureIndex, renderData, firstLoad, showCollisionBoxes, id.canonical);
         }
+
+        if (abortIfObsolete()) {
+            return abandon();
+        }
     }
 
     layouts.clear();
@@ -15,6 +15,7 @@
 #include <mbgl/util/containers.hpp>
 
 #include <atomic>
+#include <cstddef>
 #include <memory>
 
 namespace mbgl {
@@ -44,7 +45,8 @@ public:
                        float pixelRatio,
                        bool showCollisionBoxes_,
                        gfx::DynamicTextureAtlasPtr,
-                       std::shared_ptr<FontFaces> fontFaces);
+                       std::shared_ptr<FontFaces> fontFaces,
+                       std::shared_ptr<std::atomic<std::size_t>> abortedWork = nullptr);
     ~GeometryTileWorker();
 
     void setLayers(std::vector<Immutable<style::LayerProperties>>,
@@ -77,6 +79,10 @@ private:
     bool hasPendingDependencies() const;
     bool hasPendingParseResult() const;
 
+    /// Cancellation checkpoint, returns true (and counts the aborted pass) if
+    /// the tile was made obsolete and the current work should be dropped.
+    bool abortIfObsolete();
+
     void checkPatternLayout(std::unique_ptr<Layout> layout);
 
     OptionalActorRef<GeometryTileWorker> self;
@@ -123,6 +129,7 @@ private:
     gfx::DynamicTextureAtlasPtr dynamicTextureAtlas;
 
     std::shared_ptr<FontFaces> fontFaces;
+    std::shared_ptr<std::atomic<std::size_t>> abortedWork;
 };
 
 } // namespace mbgl
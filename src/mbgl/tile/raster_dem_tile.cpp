@@ -64,7 +64,7 @@ void RasterDEMTile::setMetadata(std::optional<Timestamp> modified_, std::optiona
     expires = std::move(expires_);
 }
 
-void RasterDEMTile::setData(const std::shared_ptr<const std::string>& data) {
+void RasterDEMTile::setData(const SharedBuffer& data) {
     if (!obsolete) {
         ++correlationID;
 
@@ -155,6 +155,14 @@ void RasterDEMTile::cancel() {
     markObsolete();
 }
 
+void RasterDEMTile::setPriority(Scheduler::Priority priority) {
+    worker.setPriority(priority);
+}
+
+std::size_t RasterDEMTile::getCPUMemoryUsage() const {
+    return bucket ? bucket->getCPUMemoryUsage() : 0;
+}
+
 void RasterDEMTile::markObsolete() {
     obsolete = true;
     if (pending) {
@@ -71,7 +71,7 @@ public:
 
     void setError(std::exception_ptr);
     void setMetadata(std::optional<Timestamp> modified, std::optional<Timestamp> expires);
-    void setData(const std::shared_ptr<const std::string>& data);
+    void setData(const SharedBuffer& data);
 
     bool layerPropertiesUpdated(const Immutable<style::LayerProperties>& layerProperties) override;
 
@@ -88,6 +88,8 @@ public:
     void onError(std::exception_ptr, uint64_t correlationID);
 
     void cancel() override;
+    void setPriority(Scheduler::Priority) override;
+    std::size_t getCPUMemoryUsage() const override;
 
 private:
     void markObsolete();
@@ -9,7 +9,7 @@ namespace mbgl {
 RasterDEMTileWorker::RasterDEMTileWorker(const ActorRef<RasterDEMTileWorker>&, ActorRef<RasterDEMTile> parent_)
     : parent(std::move(parent_)) {}
 
-void RasterDEMTileWorker::parse(const std::shared_ptr<const std::string>& data,
+void RasterDEMTileWorker::parse(const SharedBuffer& data,
                                 uint64_t correlationID,
                                 Tileset::RasterEncoding encoding) {
     if (!data) {
@@ -19,7 +19,7 @@ void RasterDEMTileWorker::parse(const std::shared_ptr<const std::string>& data,
     }
 
     try {
-        auto bucket = std::make_unique<HillshadeBucket>(decodeImage(*data), encoding);
+        auto bucket = std::make_unique<HillshadeBucket>(decodeImage(*data.string()), encoding);
         parent.invoke(&RasterDEMTile::onParsed, std::move(bucket), correlationID);
     } catch (...) {
         parent.invoke(&RasterDEMTile::onError, std::current_exception(), correlationID);
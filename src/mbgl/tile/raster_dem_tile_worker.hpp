@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/util/shared_buffer.hpp>
 #include <mbgl/util/tileset.hpp>
 
 #include <memory>
@@ -14,7 +15,7 @@ class RasterDEMTileWorker {
 public:
     RasterDEMTileWorker(const ActorRef<RasterDEMTileWorker>&, ActorRef<RasterDEMTile>);
 
-    void parse(const std::shared_ptr<const std::string>& data,
+    void parse(const SharedBuffer& data,
                uint64_t correlationID,
                Tileset::RasterEncoding encoding);
 
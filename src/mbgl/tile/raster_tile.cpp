@@ -53,7 +53,7 @@ void RasterTile::setMetadata(std::optional<Timestamp> modified_, std::optional<T
     expires = std::move(expires_);
 }
 
-void RasterTile::setData(const std::shared_ptr<const std::string>& data) {
+void RasterTile::setData(const SharedBuffer& data) {
     if (!obsolete) {
         ++correlationID;
 
@@ -110,6 +110,14 @@ void RasterTile::cancel() {
     markObsolete();
 }
 
+void RasterTile::setPriority(Scheduler::Priority priority) {
+    worker.setPriority(priority);
+}
+
+std::size_t RasterTile::getCPUMemoryUsage() const {
+    return bucket ? bucket->getCPUMemoryUsage() : 0;
+}
+
 void RasterTile::markObsolete() {
     obsolete = true;
     if (pending) {
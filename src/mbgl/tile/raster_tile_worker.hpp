@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/util/shared_buffer.hpp>
 
 #include <memory>
 #include <string>
@@ -13,7 +14,7 @@ class RasterTileWorker {
 public:
     RasterTileWorker(const ActorRef<RasterTileWorker>&, ActorRef<RasterTile>);
 
-    void parse(const std::shared_ptr<const std::string>& data, uint64_t correlationID);
+    void parse(const SharedBuffer& data, uint64_t correlationID);
 
 private:
     ActorRef<RasterTile> parent;
@@ -0,0 +1,208 @@
+#include <mbgl/tile/shared_geometry_tile_data.hpp>
+
+#include <mbgl/platform/settings.hpp>
+#include <mbgl/util/hash.hpp>
+
+#include <vector>
+
+namespace mbgl {
+
+namespace {
+
+/// The features of a layer with their geometries and properties decoded.
+struct SharedLayerData {
+    explicit SharedLayerData(std::unique_ptr<GeometryTileLayer> layer_)
+        : layer(std::move(layer_)),
+          name(layer->getName()) {
+        const auto count = layer->featureCount();
+        features.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto feature = layer->getFeature(i);
+            // Features decode lazily into mutable members, afterwards they are only read
+            feature->getGeometries();
+            feature->getProperties();
+            features.push_back(std::move(feature));
+        }
+    }
+
+    // Keeps alive the raw data the features refer to
+    const std::unique_ptr<GeometryTileLayer> layer;
+    const std::string name;
+    std::vector<std::unique_ptr<GeometryTileFeature>> features;
+};
+
+class SharedGeometryTileFeature final : public GeometryTileFeature {
+public:
+    SharedGeometryTileFeature(std::shared_ptr<const SharedLayerData> layer_, const GeometryTileFeature& feature_)
+        : layer(std::move(layer_)),
+          feature(feature_) {}
+
+    FeatureType getType() const override { return feature.getType(); }
+    std::optional<Value> getValue(const std::string& key) const override { return feature.getValue(key); }
+    const PropertyMap& getProperties() const override { return feature.getProperties(); }
+    FeatureIdentifier getID() const override { return feature.getID(); }
+    const GeometryCollection& getGeometries() const override { return feature.getGeometries(); }
+
+private:
+    const std::shared_ptr<const SharedLayerData> layer;
+    const GeometryTileFeature& feature;
+};
+
+class SharedGeometryTileLayer final : public GeometryTileLayer {
+public:
+    explicit SharedGeometryTileLayer(std::shared_ptr<const SharedLayerData> data_)
+        : data(std::move(data_)) {}
+
+    std::size_t featureCount() const override { return data->features.size(); }
+
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override {
+        return std::make_unique<SharedGeometryTileFeature>(data, *data->features[i]);
+    }
+
+    std::string getName() const override { return data->name; }
+
+private:
+    const std::shared_ptr<const SharedLayerData> data;
+};
+
+/// Tile data that decodes each layer once, features included, and is then shared by every
+/// copy made with `clone()`.
+class SharedGeometryTileData final : public GeometryTileData {
+public:
+    explicit SharedGeometryTileData(std::unique_ptr<GeometryTileData> data)
+        : state(std::make_shared<State>(std::move(data))) {}
+
+    std::unique_ptr<GeometryTileData> clone() const override {
+        return std::make_unique<SharedGeometryTileData>(*this);
+    }
+
+    std::unique_ptr<GeometryTileLayer> getLayer(const std::string& name) const override {
+        auto layer = state->getLayer(name);
+        return layer ? std::make_unique<SharedGeometryTileLayer>(std::move(layer)) : nullptr;
+    }
+
+private:
+    class State {
+    public:
+        explicit State(std::unique_ptr<GeometryTileData> data_)
+            : data(std::move(data_)) {}
+
+        std::shared_ptr<const SharedLayerData> getLayer(const std::string& name) {
+            // Whichever worker asks first decodes the layer, the others wait for it
+            std::scoped_lock lock(mutex);
+            auto it = layers.find(name);
+            if (it == layers.end()) {
+                auto layer = data->getLayer(name);
+                it = layers.emplace(name, layer ? std::make_shared<const SharedLayerData>(std::move(layer)) : nullptr)
+                         .first;
+            }
+            return it->second;
+        }
+
+    private:
+        const std::unique_ptr<GeometryTileData> data;
+        std::mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<const SharedLayerData>> layers;
+    };
+
+    std::shared_ptr<State> state;
+};
+
+} // namespace
+
+std::size_t SharedGeometryTileDataCache::KeyHash::operator()(const Key& key) const {
+    return util::hash(key.sourceKey, key.tileID);
+}
+
+SharedGeometryTileDataCache& SharedGeometryTileDataCache::getInstance() {
+    static SharedGeometryTileDataCache instance;
+    return instance;
+}
+
+std::unique_ptr<GeometryTileData> SharedGeometryTileDataCache::get(const std::string& sourceKey,
+                                                                   const OverscaledTileID& tileID,
+                                                                   const SharedBuffer& raw,
+                                                                   const Factory& create) {
+    const std::size_t limit = getMaxSize();
+    if (!limit || !raw) {
+        return create();
+    }
+
+    std::scoped_lock lock(mutex);
+
+    Key key{.sourceKey = sourceKey, .tileID = tileID};
+    auto it = entries.find(key);
+    // Comparing bytes is far cheaper than decoding and catches tiles that changed upstream
+    if (it != entries.end() && (it->second.raw == raw || *it->second.raw == *raw)) {
+        ++hits;
+        lru.touch(key);
+        return it->second.data->clone();
+    }
+
+    ++misses;
+    Entry entry{.raw = raw, .data = std::make_unique<SharedGeometryTileData>(create())};
+    auto result = entry.data->clone();
+    if (it != entries.end()) {
+        it->second = std::move(entry);
+    } else {
+        entries.emplace(key, std::move(entry));
+    }
+    lru.touch(std::move(key));
+    evict(limit);
+    return result;
+}
+
+void SharedGeometryTileDataCache::setMaxSize(std::size_t size) {
+    std::scoped_lock lock(mutex);
+    maxSize = size;
+    evict(size);
+}
+
+std::size_t SharedGeometryTileDataCache::getMaxSize() const {
+    {
+        std::scoped_lock lock(mutex);
+        if (maxSize) {
+            return *maxSize;
+        }
+    }
+
+    const auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_SHARED_TILE_DATA_CACHE_SIZE);
+    if (const auto* size = value.getUint()) {
+        return static_cast<std::size_t>(*size);
+    }
+    if (const auto* size = value.getInt(); size && *size > 0) {
+        return static_cast<std::size_t>(*size);
+    }
+    return 0;
+}
+
+std::size_t SharedGeometryTileDataCache::size() const {
+    std::scoped_lock lock(mutex);
+    return entries.size();
+}
+
+uint64_t SharedGeometryTileDataCache::getHits() const {
+    std::scoped_lock lock(mutex);
+    return hits;
+}
+
+uint64_t SharedGeometryTileDataCache::getMisses() const {
+    std::scoped_lock lock(mutex);
+    return misses;
+}
+
+void SharedGeometryTileDataCache::clear() {
+    std::scoped_lock lock(mutex);
+    entries.clear();
+    lru = {};
+    hits = 0;
+    misses = 0;
+}
+
+void SharedGeometryTileDataCache::evict(std::size_t limit) {
+    while (entries.size() > limit && !lru.empty()) {
+        entries.erase(lru.evict());
+    }
+}
+
+} // namespace mbgl
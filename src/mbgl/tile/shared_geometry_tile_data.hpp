@@ -0,0 +1,91 @@
+#pragma once
+
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/lru_cache.hpp>
+#include <mbgl/util/shared_buffer.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace mbgl {
+
+/**
+ * @brief Process-wide cache of decoded vector tile data.
+ *
+ * Tile data does not depend on the style, so maps that load the same tile from
+ * the same source can share one decoded copy instead of each decoding its own.
+ * Layers are decoded on first use, including the geometries and properties of
+ * their features, and kept for as long as any map uses the tile.
+ * The cache is disabled unless `platform::EXPERIMENTAL_SHARED_TILE_DATA_CACHE_SIZE`
+ * is set, in which case it keeps up to that many tiles. Evicting a tile does not
+ * affect maps already using it, later loads simply decode it again.
+ */
+class SharedGeometryTileDataCache {
+public:
+    using Factory = std::function<std::unique_ptr<GeometryTileData>()>;
+
+    static SharedGeometryTileDataCache& getInstance();
+
+    /**
+     * @brief Returns tile data for the given raw tile.
+     *
+     * If an entry with the same key and identical raw bytes exists, the result
+     * shares its decoded form. Otherwise `create` is called to make the data,
+     * which is cached when the cache is enabled.
+     *
+     * @param sourceKey Identifies the source, typically its tile URL templates.
+     * @param raw The raw tile as loaded from the network or the database.
+     * @param create Makes undecoded tile data from `raw`.
+     */
+    std::unique_ptr<GeometryTileData> get(const std::string& sourceKey,
+                                          const OverscaledTileID&,
+                                          const SharedBuffer& raw,
+                                          const Factory& create);
+
+    /// Overrides the size from the platform setting, zero disables the cache.
+    void setMaxSize(std::size_t);
+    std::size_t getMaxSize() const;
+
+    std::size_t size() const;
+    uint64_t getHits() const;
+    uint64_t getMisses() const;
+
+    void clear();
+
+private:
+    SharedGeometryTileDataCache() = default;
+
+    struct Key {
+        std::string sourceKey;
+        OverscaledTileID tileID;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key&) const;
+    };
+
+    struct Entry {
+        SharedBuffer raw;
+        // Handed out through `clone()`, which shares the decoded tile
+        std::unique_ptr<const GeometryTileData> data;
+    };
+
+    void evict(std::size_t limit);
+
+    mutable std::mutex mutex;
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    LRU<Key, KeyHash> lru;
+    std::optional<std::size_t> maxSize;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
+
+} // namespace mbgl
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/feature.hpp>
@@ -68,9 +69,15 @@ public:
 
     virtual void setUpdateParameters(const TileUpdateParameters&) {}
 
+    // Set the urgency of this tile's background work relative to other tiles, lower runs first.
+    virtual void setPriority(Scheduler::Priority) {}
+
     // Mark this tile as no longer needed and cancel any pending work.
     virtual void cancel() = 0;
 
+    // Approximate CPU memory held by the tile's render data, in bytes. GPU resources are not included.
+    virtual std::size_t getCPUMemoryUsage() const { return 0; }
+
     // Notifies this tile of the updated layer properties.
     //
     // Tile implementation should update the contained layer
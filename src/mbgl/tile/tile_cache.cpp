@@ -4,6 +4,7 @@
 #include <mbgl/util/instrumentation.hpp>
 
 #include <cassert>
+#include <iterator>
 
 namespace mbgl {
 
@@ -21,20 +22,35 @@ void TileCache::setSize(size_t size_) {
     MLN_TRACE_FUNC();
 
     size = size_;
+    evict();
 
-    while (orderedKeys.size() > size) {
-        const auto key = orderedKeys.front();
-        orderedKeys.remove(key);
+    assert(entries.size() <= size);
+}
+
+void TileCache::setMaxCPUBytes(size_t maxCPUBytes_) {
+    MLN_TRACE_FUNC();
+
+    maxCPUBytes = maxCPUBytes_;
+    evict();
+}
 
-        auto hit = tiles.find(key);
-        if (hit != tiles.end()) {
-            auto tile = std::move(hit->second);
-            tiles.erase(hit);
-            deferredRelease(std::move(tile));
-        }
+TileCacheStats TileCache::getStats() const {
+    return {.hits = hits, .misses = misses, .evictions = evictions, .tiles = entries.size(), .cpuBytes = cpuBytes};
+}
+
+void TileCache::evict() {
+    while (!entries.empty() && (entries.size() > size || (maxCPUBytes && cpuBytes > maxCPUBytes))) {
+        deferredRelease(extract(entries.begin()));
+        ++evictions;
     }
+}
 
-    assert(orderedKeys.size() <= size);
+std::unique_ptr<Tile> TileCache::extract(Entries::iterator it) {
+    auto tile = std::move(it->tile);
+    cpuBytes -= it->cpuBytes;
+    index.erase(it->key);
+    entries.erase(it);
+    return tile;
 }
 
 namespace {
@@ -107,61 +123,53 @@ void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile>&& tile) {
         return;
     }
 
-    const auto result = tiles.insert(std::make_pair(key, std::unique_ptr<Tile>{}));
-    if (result.second) {
-        // inserted
-        result.first->second = std::move(tile);
-    } else {
-        // already present
-        // remove existing tile key to move it to the end
-        orderedKeys.remove(key);
+    if (const auto it = index.find(key); it != index.end()) {
+        // already present, keep the existing tile but mark it as newest
+        entries.splice(entries.end(), entries, it->second);
         // release the newly-provided item
         deferredRelease(std::move(tile));
+    } else {
+        const size_t tileBytes = tile->getCPUMemoryUsage();
+        entries.push_back({.key = key, .tile = std::move(tile), .cpuBytes = tileBytes});
+        index.emplace(key, std::prev(entries.end()));
+        cpuBytes += tileBytes;
     }
 
-    // (re-)insert tile key as newest
-    orderedKeys.push_back(key);
+    // purge oldest tiles if necessary
+    evict();
 
-    // purge oldest key/tile if necessary
-    if (orderedKeys.size() > size) {
-        deferredRelease(pop(orderedKeys.front()));
-    }
-
-    assert(orderedKeys.size() <= size);
+    assert(entries.size() <= size);
 }
 
 Tile* TileCache::get(const OverscaledTileID& key) {
-    auto it = tiles.find(key);
-    if (it != tiles.end()) {
-        return it->second.get();
-    } else {
-        return nullptr;
-    }
+    const auto it = index.find(key);
+    return it != index.end() ? it->second->tile.get() : nullptr;
 }
 
 std::unique_ptr<Tile> TileCache::pop(const OverscaledTileID& key) {
-    std::unique_ptr<Tile> tile;
-
-    const auto it = tiles.find(key);
-    if (it != tiles.end()) {
-        tile = std::move(tiles.extract(it).mapped());
-        orderedKeys.remove(key);
-        assert(tile->isRenderable());
+    const auto it = index.find(key);
+    if (it == index.end()) {
+        ++misses;
+        return nullptr;
     }
 
+    ++hits;
+    auto tile = extract(it->second);
+    assert(tile->isRenderable());
     return tile;
 }
 
 bool TileCache::has(const OverscaledTileID& key) {
-    return tiles.find(key) != tiles.end();
+    return index.contains(key);
 }
 
 void TileCache::clear() {
-    for (auto& item : tiles) {
-        deferredRelease(std::move(item.second));
+    for (auto& entry : entries) {
+        deferredRelease(std::move(entry.tile));
     }
-    orderedKeys.clear();
-    tiles.clear();
+    entries.clear();
+    index.clear();
+    cpuBytes = 0;
 }
 
 } // namespace mbgl
@@ -1,12 +1,13 @@
 #pragma once
 
 #include <mbgl/actor/scheduler.hpp>
+#include <mbgl/renderer/tile_cache_stats.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/tile/tile.hpp>
 
 #include <list>
 #include <memory>
-#include <map>
+#include <unordered_map>
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
@@ -26,10 +27,21 @@ public:
     /// Get the maximum size
     size_t getMaxSize() const { return size; }
 
+    /// Change the maximum CPU memory held by cached tiles, as reported by `Tile::getCPUMemoryUsage`.
+    /// Zero disables the byte budget, leaving only the tile count limit.
+    void setMaxCPUBytes(size_t);
+
+    /// Get the maximum CPU memory budget
+    size_t getMaxCPUBytes() const { return maxCPUBytes; }
+
+    /// Hit, miss and eviction counters along with the current usage
+    TileCacheStats getStats() const;
+
     /// Add a new tile with the given ID.
     /// If a tile with the same ID is already present, it will be retained and the new one will be discarded.
     void add(const OverscaledTileID& key, std::unique_ptr<Tile>&& tile);
 
+    /// Remove and return the tile with the given ID, counted as a cache hit or miss.
     std::unique_ptr<Tile> pop(const OverscaledTileID& key);
     Tile* get(const OverscaledTileID& key);
     bool has(const OverscaledTileID& key);
@@ -42,8 +54,27 @@ public:
     void deferPendingReleases();
 
 private:
-    std::map<OverscaledTileID, std::unique_ptr<Tile>> tiles;
-    std::list<OverscaledTileID> orderedKeys;
+    struct Entry {
+        OverscaledTileID key;
+        std::unique_ptr<Tile> tile;
+        size_t cpuBytes;
+    };
+    using Entries = std::list<Entry>;
+
+    /// Drop the least recently used tiles until both limits are met
+    void evict();
+    std::unique_ptr<Tile> extract(Entries::iterator);
+
+    // Least recently used first
+    Entries entries;
+    std::unordered_map<OverscaledTileID, Entries::iterator> index;
+    size_t cpuBytes = 0;
+    size_t maxCPUBytes = 0;
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+
     TaggedScheduler threadPool;
     std::vector<std::unique_ptr<Tile>> pendingReleases;
     size_t deferredDeletionsPending{0};
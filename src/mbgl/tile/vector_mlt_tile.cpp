@@ -1,6 +1,7 @@
 #include <mbgl/tile/vector_mlt_tile.hpp>
 
 #include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/tile/shared_geometry_tile_data.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
 #include <mbgl/tile/vector_mlt_tile_data.hpp>
 
@@ -26,9 +27,14 @@ VectorMLTTile::~VectorMLTTile() {
     GeometryTile::cancel();
 }
 
-void VectorMLTTile::setData(const std::shared_ptr<const std::string>& data_) {
+void VectorMLTTile::setData(const SharedBuffer& data_) {
     if (!obsolete) {
-        GeometryTile::setData(data_ ? std::make_unique<VectorMLTTileData>(data_, fastPFOREnabled) : nullptr);
+        GeometryTile::setData(data_ ? SharedGeometryTileDataCache::getInstance().get(
+                                          dataCacheKey,
+                                          id,
+                                          data_,
+                                          [&] { return std::make_unique<VectorMLTTileData>(data_, fastPFOREnabled); })
+                                    : nullptr);
     }
 }
 
@@ -20,7 +20,7 @@ public:
 
     ~VectorMLTTile() override;
 
-    void setData(const std::shared_ptr<const std::string>& data) override;
+    void setData(const SharedBuffer& data) override;
 
 private:
     bool fastPFOREnabled;
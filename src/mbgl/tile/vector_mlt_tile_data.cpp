@@ -226,7 +226,7 @@ private:
 
 class VectorMLTTileData::Impl {
 public:
-    Impl(std::shared_ptr<const std::string> data_, bool fastPFOREnabled_)
+    Impl(SharedBuffer data_, bool fastPFOREnabled_)
         : data(std::move(data_)),
           fastPFOREnabled(fastPFOREnabled_) {}
 
@@ -243,7 +243,7 @@ public:
                 Log::Warning(Event::ParseTile, "MLT parse failed: " + std::string(ex.what()));
             }
             // We don't need the raw data anymore
-            data.reset();
+            data = nullptr;
         }
 
         if (tile) {
@@ -268,12 +268,12 @@ public:
     }
 
 private:
-    mutable std::shared_ptr<const std::string> data;
+    mutable SharedBuffer data;
     mutable std::shared_ptr<const MapLibreTile> tile;
     bool fastPFOREnabled;
 };
 
-VectorMLTTileData::VectorMLTTileData(std::shared_ptr<const std::string> data, bool fastPFOREnabled)
+VectorMLTTileData::VectorMLTTileData(SharedBuffer data, bool fastPFOREnabled)
     : impl(std::make_unique<Impl>(std::move(data), fastPFOREnabled)) {}
 
 VectorMLTTileData::VectorMLTTileData(const VectorMLTTileData& other)
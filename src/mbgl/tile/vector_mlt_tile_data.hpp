@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/shared_buffer.hpp>
 
 #include <memory>
 #include <string>
@@ -10,7 +11,7 @@ namespace mbgl {
 
 class VectorMLTTileData : public GeometryTileData {
 public:
-    VectorMLTTileData(std::shared_ptr<const std::string> data, bool fastPFOREnabled);
+    VectorMLTTileData(SharedBuffer data, bool fastPFOREnabled);
     VectorMLTTileData(const VectorMLTTileData&);
     VectorMLTTileData(VectorMLTTileData&&) noexcept;
     ~VectorMLTTileData() override;
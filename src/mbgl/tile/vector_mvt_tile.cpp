@@ -1,6 +1,7 @@
 #include <mbgl/tile/vector_mvt_tile.hpp>
 
 #include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/tile/shared_geometry_tile_data.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
 #include <mbgl/tile/vector_mvt_tile_data.hpp>
 
@@ -24,9 +25,14 @@ VectorMVTTile::~VectorMVTTile() {
     GeometryTile::cancel();
 }
 
-void VectorMVTTile::setData(const std::shared_ptr<const std::string>& data_) {
+void VectorMVTTile::setData(const SharedBuffer& data_) {
     if (!obsolete) {
-        GeometryTile::setData(data_ ? std::make_unique<VectorMVTTileData>(data_) : nullptr);
+        GeometryTile::setData(data_ ? SharedGeometryTileDataCache::getInstance().get(
+                                          dataCacheKey,
+                                          id,
+                                          data_,
+                                          [&] { return std::make_unique<VectorMVTTileData>(data_); })
+                                    : nullptr);
     }
 }
 
@@ -4,12 +4,43 @@
 #include <mbgl/util/instrumentation.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
 #if ANDROID
 #include <mlt/decoder.hpp>
 #endif
 
 namespace mbgl {
 
+namespace {
+
+// Indexes the layers like mapbox::vector_tile::buffer, which only accepts a
+// std::string and would need the tile copied out of a sliced buffer.
+std::map<std::string, const protozero::data_view> readLayers(std::string_view tile) {
+    constexpr protozero::pbf_tag_type tileLayers = 3;
+    constexpr protozero::pbf_tag_type layerName = 1;
+
+    std::map<std::string, const protozero::data_view> layers;
+    protozero::pbf_reader tileReader(tile.data(), tile.size());
+    while (tileReader.next(tileLayers)) {
+        const protozero::data_view layerView = tileReader.get_view();
+        protozero::pbf_reader layerReader(layerView);
+        std::optional<std::string> name;
+        while (layerReader.next(layerName)) {
+            name = layerReader.get_string();
+        }
+        if (!name) {
+            throw std::runtime_error("Layer missing name");
+        }
+        layers.emplace(std::move(*name), layerView);
+    }
+    return layers;
+}
+
+} // namespace
+
 VectorMVTTileFeature::VectorMVTTileFeature(const mapbox::vector_tile::layer& layer, const protozero::data_view& view)
     : feature(view, layer) {}
 
@@ -62,7 +93,7 @@ const GeometryCollection& VectorMVTTileFeature::getGeometries() const {
     return *lines;
 }
 
-VectorMVTTileLayer::VectorMVTTileLayer(std::shared_ptr<const std::string> data_, const protozero::data_view& view)
+VectorMVTTileLayer::VectorMVTTileLayer(SharedBuffer data_, const protozero::data_view& view)
     : data(std::move(data_)),
       layer(view) {}
 
@@ -78,7 +109,7 @@ std::string VectorMVTTileLayer::getName() const {
     return layer.getName();
 }
 
-VectorMVTTileData::VectorMVTTileData(std::shared_ptr<const std::string> data_)
+VectorMVTTileData::VectorMVTTileData(SharedBuffer data_)
     : data(std::move(data_)) {}
 
 std::unique_ptr<GeometryTileData> VectorMVTTileData::clone() const {
@@ -92,7 +123,7 @@ std::unique_ptr<GeometryTileLayer> VectorMVTTileData::getLayer(const std::string
         // We're parsing this lazily so that we can construct VectorTileData
         // objects on the main thread without incurring the overhead of parsing
         // immediately.
-        layers = mapbox::vector_tile::buffer(*data).getLayers();
+        layers = readLayers(*data);
         parsed = true;
     }
 
@@ -104,7 +135,11 @@ std::unique_ptr<GeometryTileLayer> VectorMVTTileData::getLayer(const std::string
 }
 
 std::vector<std::string> VectorMVTTileData::layerNames() const {
-    return mapbox::vector_tile::buffer(*data).layerNames();
+    std::vector<std::string> names;
+    for (const auto& layer : readLayers(*data)) {
+        names.push_back(layer.first);
+    }
+    return names;
 }
 
 } // namespace mbgl
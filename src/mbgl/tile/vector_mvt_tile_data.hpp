@@ -1,5 +1,6 @@
 #pragma once
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/shared_buffer.hpp>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -38,20 +39,20 @@ private:
 
 class VectorMVTTileLayer : public GeometryTileLayer {
 public:
-    VectorMVTTileLayer(std::shared_ptr<const std::string> data, const protozero::data_view&);
+    VectorMVTTileLayer(SharedBuffer data, const protozero::data_view&);
 
     std::size_t featureCount() const override;
     std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override;
     std::string getName() const override;
 
 private:
-    std::shared_ptr<const std::string> data;
+    SharedBuffer data;
     mapbox::vector_tile::layer layer;
 };
 
 class VectorMVTTileData : public GeometryTileData {
 public:
-    VectorMVTTileData(std::shared_ptr<const std::string> data);
+    VectorMVTTileData(SharedBuffer data);
 
     std::unique_ptr<GeometryTileData> clone() const override;
     std::unique_ptr<GeometryTileLayer> getLayer(const std::string& name) const override;
@@ -59,7 +60,7 @@ public:
     std::vector<std::string> layerNames() const;
 
 private:
-    std::shared_ptr<const std::string> data;
+    SharedBuffer data;
     mutable bool parsed = false;
     mutable std::map<std::string, const protozero::data_view> layers;
 };
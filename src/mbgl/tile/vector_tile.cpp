@@ -2,18 +2,35 @@
 
 #include <mbgl/renderer/tile_parameters.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
+#include <mbgl/util/tileset.hpp>
 
 #include <utility>
 
 namespace mbgl {
 
+namespace {
+
+std::string makeDataCacheKey(const Tileset& tileset) {
+    std::string key = tileset.vectorEncoding == Tileset::VectorEncoding::MLT ? "mlt" : "mvt";
+    // The same URL templates fetch a different tile for each ID under TMS
+    key += tileset.scheme == Tileset::Scheme::TMS ? "/tms" : "/xyz";
+    for (const auto& url : tileset.tiles) {
+        key += '\n';
+        key += url;
+    }
+    return key;
+}
+
+} // namespace
+
 VectorTile::VectorTile(const OverscaledTileID& id_,
                        std::string sourceID_,
                        const TileParameters& parameters_,
                        const Tileset& tileset,
                        TileObserver* observer_)
     : GeometryTile(id_, std::move(sourceID_), parameters_, observer_),
-      loader(std::make_unique<TileLoader<VectorTile>>(*this, id_, parameters_, tileset)) {}
+      loader(std::make_unique<TileLoader<VectorTile>>(*this, id_, parameters_, tileset)),
+      dataCacheKey(makeDataCacheKey(tileset)) {}
 
 VectorTile::~VectorTile() {}
 
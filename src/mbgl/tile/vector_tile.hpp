@@ -21,12 +21,15 @@ public:
     void setUpdateParameters(const TileUpdateParameters&) final;
     void setMetadata(std::optional<Timestamp> modified, std::optional<Timestamp> expires);
 
-    virtual void setData(const std::shared_ptr<const std::string>&) = 0;
+    virtual void setData(const SharedBuffer&) = 0;
 
 protected:
     // this needs to be explicitly deleted in the most-derived destructor
     // see `~VectorMVTTile`
     std::unique_ptr<TileLoader<VectorTile>> loader;
+
+    // Identifies the tile's data in the `SharedGeometryTileDataCache`
+    const std::string dataCacheKey;
 };
 
 } // namespace mbgl
@@ -6,6 +6,13 @@ class ClientOptions::Impl {
 public:
     std::string name;
     std::string version;
+    ThreadPoolSize ioThreadPoolSize;
+    bool httpMultiplexing = true;
+    bool http2PriorKnowledge = false;
+    std::size_t maxHostConnections = 0;
+    std::size_t maxTotalConnections = 0;
+    Seconds tcpKeepAliveIdle = Seconds::zero();
+    Seconds tcpKeepAliveInterval = Seconds(60);
 };
 
 // These requires the complete type of Impl.
@@ -46,4 +53,63 @@ const std::string& ClientOptions::version() const {
     return impl_->version;
 }
 
+ClientOptions& ClientOptions::withIOThreadPoolSize(ThreadPoolSize size) {
+    impl_->ioThreadPoolSize = size;
+    return *this;
+}
+
+const ThreadPoolSize& ClientOptions::ioThreadPoolSize() const {
+    return impl_->ioThreadPoolSize;
+}
+
+ClientOptions& ClientOptions::withHTTPMultiplexing(bool enabled) {
+    impl_->httpMultiplexing = enabled;
+    return *this;
+}
+
+bool ClientOptions::httpMultiplexing() const {
+    return impl_->httpMultiplexing;
+}
+
+ClientOptions& ClientOptions::withHTTP2PriorKnowledge(bool enabled) {
+    impl_->http2PriorKnowledge = enabled;
+    return *this;
+}
+
+bool ClientOptions::http2PriorKnowledge() const {
+    return impl_->http2PriorKnowledge;
+}
+
+ClientOptions& ClientOptions::withMaxHostConnections(std::size_t connections) {
+    impl_->maxHostConnections = connections;
+    return *this;
+}
+
+std::size_t ClientOptions::maxHostConnections() const {
+    return impl_->maxHostConnections;
+}
+
+ClientOptions& ClientOptions::withMaxTotalConnections(std::size_t connections) {
+    impl_->maxTotalConnections = connections;
+    return *this;
+}
+
+std::size_t ClientOptions::maxTotalConnections() const {
+    return impl_->maxTotalConnections;
+}
+
+ClientOptions& ClientOptions::withTCPKeepAlive(Seconds idle, Seconds interval) {
+    impl_->tcpKeepAliveIdle = idle;
+    impl_->tcpKeepAliveInterval = interval;
+    return *this;
+}
+
+Seconds ClientOptions::tcpKeepAliveIdle() const {
+    return impl_->tcpKeepAliveIdle;
+}
+
+Seconds ClientOptions::tcpKeepAliveInterval() const {
+    return impl_->tcpKeepAliveInterval;
+}
+
 } // namespace mbgl
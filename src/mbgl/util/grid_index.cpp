@@ -1,8 +1,100 @@
 #include <mbgl/util/grid_index.hpp>
 #include <mbgl/geometry/feature_index.hpp>
 
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace mbgl {
 
+namespace detail {
+
+static_assert(GridBoxBlock::size == 8, "the kernels test eight boxes at a time");
+
+uint32_t collidingBoxes(const GridBoxBlock& block, const mapbox::geometry::box<float>& bbox) {
+    // Same test as `first.min <= second.max && first.max >= second.min` per axis;
+    // comparisons with NaN are false, so unused lanes never collide.
+#if defined(__AVX__)
+    const __m256 hit = _mm256_and_ps(
+        _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(block.minX.data()), _mm256_set1_ps(bbox.max.x), _CMP_LE_OQ),
+                      _mm256_cmp_ps(_mm256_loadu_ps(block.minY.data()), _mm256_set1_ps(bbox.max.y), _CMP_LE_OQ)),
+        _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(block.maxX.data()), _mm256_set1_ps(bbox.min.x), _CMP_GE_OQ),
+                      _mm256_cmp_ps(_mm256_loadu_ps(block.maxY.data()), _mm256_set1_ps(bbox.min.y), _CMP_GE_OQ)));
+    return static_cast<uint32_t>(_mm256_movemask_ps(hit));
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128 queryMaxX = _mm_set1_ps(bbox.max.x);
+    const __m128 queryMaxY = _mm_set1_ps(bbox.max.y);
+    const __m128 queryMinX = _mm_set1_ps(bbox.min.x);
+    const __m128 queryMinY = _mm_set1_ps(bbox.min.y);
+    uint32_t mask = 0;
+    for (std::size_t i = 0; i < GridBoxBlock::size; i += 4) {
+        const __m128 hit = _mm_and_ps(_mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&block.minX[i]), queryMaxX),
+                                                 _mm_cmple_ps(_mm_loadu_ps(&block.minY[i]), queryMaxY)),
+                                      _mm_and_ps(_mm_cmpge_ps(_mm_loadu_ps(&block.maxX[i]), queryMinX),
+                                                 _mm_cmpge_ps(_mm_loadu_ps(&block.maxY[i]), queryMinY)));
+        mask |= static_cast<uint32_t>(_mm_movemask_ps(hit)) << i;
+    }
+    return mask;
+#elif defined(__ARM_NEON)
+    const float32x4_t queryMaxX = vdupq_n_f32(bbox.max.x);
+    const float32x4_t queryMaxY = vdupq_n_f32(bbox.max.y);
+    const float32x4_t queryMinX = vdupq_n_f32(bbox.min.x);
+    const float32x4_t queryMinY = vdupq_n_f32(bbox.min.y);
+    static const uint32_t laneBits[4] = {1, 2, 4, 8};
+    const uint32x4_t bits = vld1q_u32(laneBits);
+    uint32_t mask = 0;
+    for (std::size_t i = 0; i < GridBoxBlock::size; i += 4) {
+        const uint32x4_t hit = vandq_u32(vandq_u32(vcleq_f32(vld1q_f32(&block.minX[i]), queryMaxX),
+                                                   vcleq_f32(vld1q_f32(&block.minY[i]), queryMaxY)),
+                                         vandq_u32(vcgeq_f32(vld1q_f32(&block.maxX[i]), queryMinX),
+                                                   vcgeq_f32(vld1q_f32(&block.maxY[i]), queryMinY)));
+        const uint32x4_t laneMask = vandq_u32(hit, bits);
+#if defined(__aarch64__)
+        mask |= vaddvq_u32(laneMask) << i;
+#else
+        const uint32x2_t sum = vadd_u32(vget_low_u32(laneMask), vget_high_u32(laneMask));
+        mask |= vget_lane_u32(vpadd_u32(sum, sum), 0) << i;
+#endif
+    }
+    return mask;
+#else
+    uint32_t mask = 0;
+    for (std::size_t i = 0; i < GridBoxBlock::size; ++i) {
+        if (block.minX[i] <= bbox.max.x && block.minY[i] <= bbox.max.y && block.maxX[i] >= bbox.min.x &&
+            block.maxY[i] >= bbox.min.y) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+#endif
+}
+
+uint32_t GridQueryStamps::next(std::size_t boxCount, std::size_t circleCount) {
+    // Stamps left by other indexes are all older than the next one
+    if (boxes.size() < boxCount) {
+        boxes.resize(boxCount);
+    }
+    if (circles.size() < circleCount) {
+        circles.resize(circleCount);
+    }
+    if (++stamp == 0) {
+        // Wrapped around, stamps of earlier queries could match again
+        std::fill(boxes.begin(), boxes.end(), 0);
+        std::fill(circles.begin(), circles.end(), 0);
+        stamp = 1;
+    }
+    return stamp;
+}
+
+GridQueryStamps& gridQueryStamps() {
+    thread_local GridQueryStamps stamps;
+    return stamps;
+}
+
+} // namespace detail
+
 template class GridIndex<RefIndexedSubfeature>;
 
 } // namespace mbgl
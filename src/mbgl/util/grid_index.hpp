@@ -4,13 +4,15 @@
 #include <mapbox/geometry/box.hpp>
 #include <mbgl/math/minmax.hpp>
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
-#include <functional>
-#include <optional>
-#include <unordered_set>
+#include <iterator>
+#include <limits>
 #include <vector>
 
 namespace mbgl {
@@ -41,6 +43,103 @@ constexpr bool operator!=(circle<T> const& lhs, circle<T> const& rhs) {
 
 } // namespace geometry
 
+namespace detail {
+
+/// Bounding boxes of up to eight grid elements, one array per coordinate, so
+/// that a block is tested against a query box with a few vector instructions.
+/// Unused lanes hold NaN, which never collides.
+struct alignas(32) GridBoxBlock {
+    static constexpr std::size_t size = 8;
+
+    std::array<float, size> minX;
+    std::array<float, size> minY;
+    std::array<float, size> maxX;
+    std::array<float, size> maxY;
+};
+
+/// Returns a mask with bit `i` set if box `i` of the block intersects the
+/// given box. Uses AVX, SSE2 or NEON when the target supports them.
+uint32_t collidingBoxes(const GridBoxBlock&, const mapbox::geometry::box<float>&);
+
+/// Boxes that intersect one grid cell, in insertion order
+class GridBoxCell {
+public:
+    using BBox = mapbox::geometry::box<float>;
+
+    std::size_t size() const { return uids.size(); }
+    bool empty() const { return uids.empty(); }
+
+    uint32_t uid(std::size_t i) const { return uids[i]; }
+    BBox box(std::size_t i) const {
+        const auto& block = blocks[i / GridBoxBlock::size];
+        const auto lane = i % GridBoxBlock::size;
+        return {{block.minX[lane], block.minY[lane]}, {block.maxX[lane], block.maxY[lane]}};
+    }
+
+    void reserve(std::size_t count) {
+        uids.reserve(count);
+        blocks.reserve((count + GridBoxBlock::size - 1) / GridBoxBlock::size);
+    }
+
+    void push_back(uint32_t uid, const BBox& bbox) {
+        const auto lane = uids.size() % GridBoxBlock::size;
+        if (lane == 0) {
+            constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+            blocks.push_back({});
+            blocks.back().minX.fill(nan);
+            blocks.back().minY.fill(nan);
+            blocks.back().maxX.fill(nan);
+            blocks.back().maxY.fill(nan);
+        }
+        auto& block = blocks.back();
+        block.minX[lane] = bbox.min.x;
+        block.minY[lane] = bbox.min.y;
+        block.maxX[lane] = bbox.max.x;
+        block.maxY[lane] = bbox.max.y;
+        uids.push_back(uid);
+    }
+
+    /// Index of the first box at or after `begin` that intersects `bbox`, `size()` if there is none
+    std::size_t findColliding(const BBox& bbox, std::size_t begin = 0) const {
+        for (std::size_t b = begin / GridBoxBlock::size; b < blocks.size(); ++b) {
+            uint32_t mask = collidingBoxes(blocks[b], bbox);
+            if (b == begin / GridBoxBlock::size) {
+                mask &= ~0u << (begin % GridBoxBlock::size);
+            }
+            if (mask) {
+                return b * GridBoxBlock::size + std::countr_zero(mask);
+            }
+        }
+        return size();
+    }
+
+    std::size_t bytes() const {
+        return uids.capacity() * sizeof(uint32_t) + blocks.capacity() * sizeof(GridBoxBlock);
+    }
+
+private:
+    std::vector<uint32_t> uids;
+    std::vector<GridBoxBlock> blocks;
+};
+
+/// The query in which each element was last reported, so that queries spanning several cells report
+/// it once without clearing anything. There is one per thread, shared by all grid indexes, which keeps
+/// concurrent queries on the same index apart. A result callback must not query a grid index itself.
+struct GridQueryStamps {
+    std::vector<uint32_t> boxes;
+    std::vector<uint32_t> circles;
+    uint32_t stamp = 0;
+
+    /// Starts a query over the given numbers of elements
+    /// @return The stamp marking the elements reported by this query
+    uint32_t next(std::size_t boxCount, std::size_t circleCount);
+};
+
+/// The stamps of the calling thread
+GridQueryStamps& gridQueryStamps();
+
+} // namespace detail
+
 /*
  GridIndex is a data structure for testing the intersection of
  circles and rectangles in a 2d plane.
@@ -67,26 +166,41 @@ public:
     void insert(T&& t, const BBox&);
     void insert(T&& t, const BCircle&);
 
+    /// Append all elements of an index with the same dimensions, as if they had been inserted after the existing ones
+    void merge(GridIndex&&);
+
     std::vector<T> query(const BBox&) const;
     std::vector<std::pair<T, BBox>> queryWithBoxes(const BBox&) const;
 
-    bool hitTest(const BBox&, std::optional<std::function<bool(const T&)>> predicate = std::nullopt) const;
-    bool hitTest(const BCircle&, std::optional<std::function<bool(const T&)>> predicate = std::nullopt) const;
+    bool hitTest(const BBox&) const;
+    bool hitTest(const BCircle&) const;
+
+    /// Whether any element for which `predicate(const T&)` returns `true` intersects the geometry
+    template <typename Predicate>
+    bool hitTest(const BBox&, const Predicate& predicate) const;
+    template <typename Predicate>
+    bool hitTest(const BCircle&, const Predicate& predicate) const;
 
     bool empty() const;
 
+    /// Approximate heap memory held by the index, in bytes
+    std::size_t bytes() const;
+
 private:
     bool noIntersection(const BBox& queryBBox) const;
     bool completeIntersection(const BBox& queryBBox) const;
     BBox convertToBox(const BCircle& circle) const;
 
-    void query(const BBox&, std::function<bool(const T&, const BBox&)>) const;
-    void query(const BCircle&, std::function<bool(const T&, const BBox&)>) const;
+    // Calls `resultFn(const T&, const BBox&)` for each intersecting element until it returns `true`.
+    // Elements are reported once unless `unique` is false, which skips the bookkeeping.
+    template <typename ResultFn>
+    void query(const BBox&, ResultFn&& resultFn, bool unique = true) const;
+    template <typename ResultFn>
+    void query(const BCircle&, ResultFn&& resultFn) const;
 
     std::size_t convertToXCellCoord(float x) const;
     std::size_t convertToYCellCoord(float y) const;
 
-    bool boxesCollide(const BBox&, const BBox&) const;
     bool circlesCollide(const BCircle&, const BCircle&) const;
     bool circleAndBoxCollide(const BCircle&, const BBox&) const;
 
@@ -103,7 +217,7 @@ private:
     std::vector<std::pair<T, BBox>> boxElements;
     std::vector<std::pair<T, BCircle>> circleElements;
 
-    std::vector<std::vector<uint32_t>> boxCells;
+    std::vector<detail::GridBoxCell> boxCells;
     std::vector<std::vector<uint32_t>> circleCells;
 };
 
@@ -137,7 +251,7 @@ void GridIndex<T>::insert(T&& t, const BBox& bbox) {
             if (estimatedElementsPerCell && cell.empty()) {
                 cell.reserve(estimatedElementsPerCell);
             }
-            cell.push_back(uid);
+            cell.push_back(uid, bbox);
         }
     }
 
@@ -167,6 +281,32 @@ void GridIndex<T>::insert(T&& t, const BCircle& bcircle) {
     circleElements.emplace_back(std::move(t), bcircle);
 }
 
+template <class T>
+void GridIndex<T>::merge(GridIndex&& other) {
+    assert(xCellCount == other.xCellCount && yCellCount == other.yCellCount);
+    assert(boxElements.size() + other.boxElements.size() < std::numeric_limits<uint32_t>::max());
+    assert(circleElements.size() + other.circleElements.size() < std::numeric_limits<uint32_t>::max());
+    const auto boxOffset = static_cast<uint32_t>(boxElements.size());
+    const auto circleOffset = static_cast<uint32_t>(circleElements.size());
+
+    for (std::size_t i = 0; i < boxCells.size(); ++i) {
+        const auto& otherCell = other.boxCells[i];
+        for (std::size_t j = 0; j < otherCell.size(); ++j) {
+            boxCells[i].push_back(otherCell.uid(j) + boxOffset, otherCell.box(j));
+        }
+        for (auto uid : other.circleCells[i]) {
+            circleCells[i].push_back(uid + circleOffset);
+        }
+    }
+
+    boxElements.insert(boxElements.end(),
+                       std::make_move_iterator(other.boxElements.begin()),
+                       std::make_move_iterator(other.boxElements.end()));
+    circleElements.insert(circleElements.end(),
+                          std::make_move_iterator(other.circleElements.begin()),
+                          std::make_move_iterator(other.circleElements.end()));
+}
+
 template <class T>
 std::vector<T> GridIndex<T>::query(const BBox& queryBBox) const {
     std::vector<T> result;
@@ -188,29 +328,37 @@ std::vector<std::pair<T, typename GridIndex<T>::BBox>> GridIndex<T>::queryWithBo
 }
 
 template <class T>
-bool GridIndex<T>::hitTest(const BBox& queryBBox, std::optional<std::function<bool(const T&)>> predicate) const {
+bool GridIndex<T>::hitTest(const BBox& queryBBox) const {
+    return hitTest(queryBBox, [](const T&) { return true; });
+}
+
+template <class T>
+bool GridIndex<T>::hitTest(const BCircle& queryBCircle) const {
+    return hitTest(queryBCircle, [](const T&) { return true; });
+}
+
+template <class T>
+template <typename Predicate>
+bool GridIndex<T>::hitTest(const BBox& queryBBox, const Predicate& predicate) const {
     bool hit = false;
-    query(queryBBox, [&](const T& t, const BBox&) -> bool {
-        if (!predicate || (*predicate)(t)) {
-            hit = true;
-            return true;
-        } else {
-            return false;
-        }
-    });
+    // Testing an element twice gives the same answer, so duplicates need not be skipped
+    query(
+        queryBBox,
+        [&](const T& t, const BBox&) -> bool {
+            hit = predicate(t);
+            return hit;
+        },
+        false);
     return hit;
 }
 
 template <class T>
-bool GridIndex<T>::hitTest(const BCircle& queryBCircle, std::optional<std::function<bool(const T&)>> predicate) const {
+template <typename Predicate>
+bool GridIndex<T>::hitTest(const BCircle& queryBCircle, const Predicate& predicate) const {
     bool hit = false;
     query(queryBCircle, [&](const T& t, const BBox&) -> bool {
-        if (!predicate || (*predicate)(t)) {
-            hit = true;
-            return true;
-        } else {
-            return false;
-        }
+        hit = predicate(t);
+        return hit;
     });
     return hit;
 }
@@ -232,10 +380,8 @@ typename GridIndex<T>::BBox GridIndex<T>::convertToBox(const BCircle& circle) co
 }
 
 template <class T>
-void GridIndex<T>::query(const BBox& queryBBox, std::function<bool(const T&, const BBox&)> resultFn) const {
-    std::unordered_set<uint32_t> seenBoxes;
-    std::unordered_set<uint32_t> seenCircles;
-
+template <typename ResultFn>
+void GridIndex<T>::query(const BBox& queryBBox, ResultFn&& resultFn, bool unique) const {
     if (noIntersection(queryBBox)) {
         return;
     } else if (completeIntersection(queryBBox)) {
@@ -257,6 +403,15 @@ void GridIndex<T>::query(const BBox& queryBBox, std::function<bool(const T&, con
     auto cx2 = convertToXCellCoord(queryBBox.max.x);
     auto cy2 = convertToYCellCoord(queryBBox.max.y);
 
+    // Only elements spanning several of the queried cells can be found twice
+    unique = unique && (cx1 != cx2 || cy1 != cy2);
+    detail::GridQueryStamps* stamps = nullptr;
+    uint32_t stamp = 0;
+    if (unique) {
+        stamps = &detail::gridQueryStamps();
+        stamp = stamps->next(boxElements.size(), circleElements.size());
+    }
+
     std::size_t x;
     std::size_t y;
     std::size_t cellIndex;
@@ -264,31 +419,36 @@ void GridIndex<T>::query(const BBox& queryBBox, std::function<bool(const T&, con
         for (y = cy1; y <= cy2; ++y) {
             cellIndex = xCellCount * y + x;
             // Look up other boxes
-            for (auto uid : boxCells[cellIndex]) {
-                if (!seenBoxes.contains(uid)) {
-                    seenBoxes.insert(uid);
-
-                    auto& pair = boxElements.at(uid);
-                    auto& bbox = pair.second;
-                    if (boxesCollide(queryBBox, bbox)) {
-                        if (resultFn(pair.first, bbox)) {
-                            return;
-                        }
+            const auto& cell = boxCells[cellIndex];
+            for (auto i = cell.findColliding(queryBBox); i < cell.size(); i = cell.findColliding(queryBBox, i + 1)) {
+                const auto uid = cell.uid(i);
+                if (unique) {
+                    if (stamps->boxes[uid] == stamp) {
+                        continue;
                     }
+                    stamps->boxes[uid] = stamp;
+                }
+
+                auto& pair = boxElements[uid];
+                if (resultFn(pair.first, pair.second)) {
+                    return;
                 }
             }
 
             // Look up circles
             for (auto uid : circleCells[cellIndex]) {
-                if (!seenCircles.contains(uid)) {
-                    seenCircles.insert(uid);
-
-                    auto& pair = circleElements.at(uid);
-                    auto& bcircle = pair.second;
-                    if (circleAndBoxCollide(bcircle, queryBBox)) {
-                        if (resultFn(pair.first, convertToBox(bcircle))) {
-                            return;
-                        }
+                if (unique) {
+                    if (stamps->circles[uid] == stamp) {
+                        continue;
+                    }
+                    stamps->circles[uid] = stamp;
+                }
+
+                auto& pair = circleElements[uid];
+                auto& bcircle = pair.second;
+                if (circleAndBoxCollide(bcircle, queryBBox)) {
+                    if (resultFn(pair.first, convertToBox(bcircle))) {
+                        return;
                     }
                 }
             }
@@ -297,10 +457,9 @@ void GridIndex<T>::query(const BBox& queryBBox, std::function<bool(const T&, con
 }
 
 template <class T>
-void GridIndex<T>::query(const BCircle& queryBCircle, std::function<bool(const T&, const BBox&)> resultFn) const {
-    std::unordered_set<size_t> seenBoxes;
-    std::unordered_set<size_t> seenCircles;
-
+template <typename ResultFn>
+void GridIndex<T>::query(const BCircle& queryBCircle, ResultFn&& resultFn) const {
+    // Only used for hit tests, so elements found in several cells are not skipped
     BBox queryBBox = convertToBox(queryBCircle);
     if (noIntersection(queryBBox)) {
         return;
@@ -315,6 +474,7 @@ void GridIndex<T>::query(const BCircle& queryBCircle, std::function<bool(const T
                 return;
             }
         }
+        return;
     }
 
     auto cx1 = convertToXCellCoord(queryBCircle.center.x - queryBCircle.radius);
@@ -322,6 +482,11 @@ void GridIndex<T>::query(const BCircle& queryBCircle, std::function<bool(const T
     auto cx2 = convertToXCellCoord(queryBCircle.center.x + queryBCircle.radius);
     auto cy2 = convertToYCellCoord(queryBCircle.center.y + queryBCircle.radius);
 
+    // Boxes are preselected by the bounding box of the circle, grown by a pixel
+    // so that rounding can't reject a box the exact test would accept.
+    const BBox candidateBBox{{queryBBox.min.x - 1.0f, queryBBox.min.y - 1.0f},
+                             {queryBBox.max.x + 1.0f, queryBBox.max.y + 1.0f}};
+
     std::size_t x;
     std::size_t y;
     std::size_t cellIndex;
@@ -329,31 +494,24 @@ void GridIndex<T>::query(const BCircle& queryBCircle, std::function<bool(const T
         for (y = cy1; y <= cy2; ++y) {
             cellIndex = xCellCount * y + x;
             // Look up boxes
-            for (auto uid : boxCells[cellIndex]) {
-                if (!seenBoxes.contains(uid)) {
-                    seenBoxes.insert(uid);
-
-                    auto& pair = boxElements.at(uid);
-                    auto& bbox = pair.second;
-                    if (circleAndBoxCollide(queryBCircle, bbox)) {
-                        if (resultFn(pair.first, bbox)) {
-                            return;
-                        }
+            const auto& cell = boxCells[cellIndex];
+            for (auto i = cell.findColliding(candidateBBox); i < cell.size();
+                 i = cell.findColliding(candidateBBox, i + 1)) {
+                auto& pair = boxElements[cell.uid(i)];
+                if (circleAndBoxCollide(queryBCircle, pair.second)) {
+                    if (resultFn(pair.first, pair.second)) {
+                        return;
                     }
                 }
             }
 
             // Look up other circles
             for (auto uid : circleCells[cellIndex]) {
-                if (!seenCircles.contains(uid)) {
-                    seenCircles.insert(uid);
-
-                    auto& pair = circleElements.at(uid);
-                    auto& bcircle = pair.second;
-                    if (circlesCollide(queryBCircle, bcircle)) {
-                        if (resultFn(pair.first, convertToBox(bcircle))) {
-                            return;
-                        }
+                auto& pair = circleElements[uid];
+                auto& bcircle = pair.second;
+                if (circlesCollide(queryBCircle, bcircle)) {
+                    if (resultFn(pair.first, convertToBox(bcircle))) {
+                        return;
                     }
                 }
             }
@@ -371,12 +529,6 @@ std::size_t GridIndex<T>::convertToYCellCoord(const float y) const {
     return static_cast<size_t>(util::max(0.0, util::min(yCellCount - 1.0, std::floor(y * yScale))));
 }
 
-template <class T>
-bool GridIndex<T>::boxesCollide(const BBox& first, const BBox& second) const {
-    return first.min.x <= second.max.x && first.min.y <= second.max.y && first.max.x >= second.min.x &&
-           first.max.y >= second.min.y;
-}
-
 template <class T>
 bool GridIndex<T>::circlesCollide(const BCircle& first, const BCircle& second) const {
     auto dx = second.center.x - first.center.x;
@@ -413,4 +565,19 @@ bool GridIndex<T>::empty() const {
     return boxElements.empty() && circleElements.empty();
 }
 
+template <class T>
+std::size_t GridIndex<T>::bytes() const {
+    std::size_t result = boxElements.capacity() * sizeof(typename decltype(boxElements)::value_type) +
+                         circleElements.capacity() * sizeof(typename decltype(circleElements)::value_type) +
+                         boxCells.capacity() * sizeof(detail::GridBoxCell) +
+                         circleCells.capacity() * sizeof(std::vector<uint32_t>);
+    for (const auto& cell : boxCells) {
+        result += cell.bytes();
+    }
+    for (const auto& cell : circleCells) {
+        result += cell.capacity() * sizeof(uint32_t);
+    }
+    return result;
+}
+
 } // namespace mbgl
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+namespace mbgl {
+namespace util {
+
+/**
+ * @brief FIFO queue with a fixed number of priority levels and constant time removal.
+ *
+ * Items are popped from the lowest level that holds any, in insertion order
+ * within a level. Each item may be queued at most once, an index over all
+ * levels lets `remove` and `contains` run without scanning the queue.
+ */
+template <typename T, std::size_t Levels, typename Hash = std::hash<T>>
+class IndexedPriorityQueue {
+    static_assert(Levels > 0, "IndexedPriorityQueue needs at least one level");
+
+public:
+    /// Append an item to the given level. The item must not be queued already.
+    void push(T item, std::size_t level) {
+        assert(level < Levels);
+        assert(!contains(item));
+        auto& queue = levels[level];
+        queue.push_back(item);
+        index.emplace(std::move(item), Position{.level = level, .it = std::prev(queue.end())});
+    }
+
+    /// Remove an item from wherever it is queued.
+    /// @return Whether the item was queued.
+    bool remove(const T& item) {
+        auto it = index.find(item);
+        if (it == index.end()) {
+            return false;
+        }
+        levels[it->second.level].erase(it->second.it);
+        index.erase(it);
+        return true;
+    }
+
+    bool contains(const T& item) const { return index.contains(item); }
+
+    /// Remove the oldest item of the lowest non-empty level.
+    std::optional<T> pop() {
+        for (auto& queue : levels) {
+            if (!queue.empty()) {
+                T item = std::move(queue.front());
+                queue.pop_front();
+                index.erase(item);
+                return item;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::size_t size() const { return index.size(); }
+    bool empty() const { return index.empty(); }
+
+    void clear() {
+        for (auto& queue : levels) {
+            queue.clear();
+        }
+        index.clear();
+    }
+
+private:
+    struct Position {
+        std::size_t level;
+        typename std::list<T>::iterator it;
+    };
+
+    std::array<std::list<T>, Levels> levels;
+    std::unordered_map<T, Position, Hash> index;
+};
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,38 @@
+#include <mbgl/util/shared_buffer.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+
+SharedBuffer::SharedBuffer(std::shared_ptr<const std::string> string) {
+    if (string) {
+        bytes = *string;
+        owner = std::move(string);
+        wholeString = true;
+    }
+}
+
+SharedBuffer::SharedBuffer(const char* data, std::size_t size, std::shared_ptr<const void> owner_)
+    : bytes(data, size),
+      owner(std::move(owner_)) {}
+
+SharedBuffer SharedBuffer::slice(std::size_t offset, std::size_t length) const {
+    if (offset == 0 && length >= bytes.size()) {
+        return *this;
+    }
+    offset = std::min(offset, bytes.size());
+    length = std::min(length, bytes.size() - offset);
+    return {bytes.data() + offset, length, owner};
+}
+
+std::shared_ptr<const std::string> SharedBuffer::string() const {
+    if (!owner) {
+        return nullptr;
+    }
+    if (wholeString) {
+        return std::static_pointer_cast<const std::string>(owner);
+    }
+    return std::make_shared<const std::string>(bytes);
+}
+
+} // namespace mbgl
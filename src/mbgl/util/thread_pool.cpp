@@ -9,7 +9,30 @@
 
 namespace mbgl {
 
-ThreadedSchedulerBase::~ThreadedSchedulerBase() = default;
+namespace {
+// Index of the current worker within its owning scheduler
+thread_local std::size_t currentWorkerIndex = 0;
+} // namespace
+
+ThreadedSchedulerBase::ThreadedSchedulerBase(Mode mode_, std::size_t maxThreadCount)
+    : mode(mode_) {
+    if (mode == Mode::WorkStealing) {
+        workerDeques.reserve(maxThreadCount);
+        for (std::size_t i = 0; i < maxThreadCount; ++i) {
+            workerDeques.push_back(std::make_unique<WorkerDeque>());
+        }
+    }
+}
+
+ThreadedSchedulerBase::~ThreadedSchedulerBase() {
+    // Worker threads have been joined by now, release anything left behind
+    for (auto& deque : workerDeques) {
+        while (auto* task = deque->pop()) {
+            delete task;
+        }
+    }
+    injectionQueue.forEach([](StealableTask* task) { delete task; });
+}
 
 void ThreadedSchedulerBase::terminate() {
     {
@@ -33,6 +56,13 @@ std::thread ThreadedSchedulerBase::makeSchedulerThread(size_t index) {
         platform::attachThread();
 
         owningThreadPool.set(this);
+        currentWorkerIndex = index;
+
+        if (mode == Mode::WorkStealing) {
+            runStealingWorker(index);
+            platform::detachThread();
+            return;
+        }
 
         while (true) {
             std::unique_lock<std::mutex> conditionLock(workerMutex);
@@ -64,8 +94,7 @@ std::thread ThreadedSchedulerBase::makeSchedulerThread(size_t index) {
                     std::scoped_lock lock(q->lock);
                     if (q->queue.size()) {
                         q->runningCount++;
-                        tasklet = std::move(q->queue.front());
-                        q->queue.pop();
+                        tasklet = q->queue.pop();
                     }
                     if (!tasklet) continue;
                 }
@@ -110,30 +139,27 @@ void ThreadedSchedulerBase::schedule(std::function<void()>&& fn) {
 }
 
 void ThreadedSchedulerBase::schedule(const util::SimpleIdentity tag, std::function<void()>&& fn) {
+    scheduleWithPriority(tag, DefaultPriority, std::move(fn));
+}
+
+void ThreadedSchedulerBase::scheduleWithPriority(const std::optional<util::SimpleIdentity>& tag,
+                                                 Priority priority,
+                                                 std::function<void()>&& fn) {
     MLN_TRACE_FUNC();
     assert(fn);
     if (!fn) return;
 
-    std::shared_ptr<Queue> q;
-    {
-        MLN_TRACE_ZONE(queue);
-        std::scoped_lock lock(taggedQueueLock);
-
-        // find or insert
-        auto result = taggedQueue.insert(std::make_pair(tag, std::shared_ptr<Queue>{}));
-        if (result.second) {
-            // new entry inserted
-            result.first->second = std::make_shared<Queue>();
-        }
-        q = result.first->second;
+    std::shared_ptr<Queue> q = getQueue(tag ? *tag : uniqueID);
 
-        MLN_ZONE_VALUE(taggedQueue.size());
+    if (mode == Mode::WorkStealing) {
+        scheduleStealable(std::move(q), priority, std::move(fn));
+        return;
     }
 
     {
         MLN_TRACE_ZONE(push);
         std::scoped_lock lock(q->lock);
-        q->queue.push(std::move(fn));
+        q->queue.push(priority, std::move(fn));
         taskCount++;
     }
 
@@ -142,6 +168,21 @@ void ThreadedSchedulerBase::schedule(const util::SimpleIdentity tag, std::functi
     cvAvailable.notify_one();
 }
 
+std::shared_ptr<ThreadedSchedulerBase::Queue> ThreadedSchedulerBase::getQueue(const util::SimpleIdentity tag) {
+    MLN_TRACE_ZONE(queue);
+    std::scoped_lock lock(taggedQueueLock);
+
+    // find or insert
+    auto result = taggedQueue.insert(std::make_pair(tag, std::shared_ptr<Queue>{}));
+    if (result.second) {
+        // new entry inserted
+        result.first->second = std::make_shared<Queue>();
+    }
+
+    MLN_ZONE_VALUE(taggedQueue.size());
+    return result.first->second;
+}
+
 void ThreadedSchedulerBase::waitForEmpty(const util::SimpleIdentity tag) {
     // Must not be called from a thread in our pool, or we would deadlock
     assert(!thisThreadIsOwned());
@@ -159,7 +200,7 @@ void ThreadedSchedulerBase::waitForEmpty(const util::SimpleIdentity tag) {
         }
 
         std::unique_lock<std::mutex> queueLock(q->lock);
-        while (q->queue.size() + q->runningCount) {
+        while (q->queue.size() + q->stealableCount + q->runningCount) {
             q->cv.wait(queueLock);
         }
 
@@ -171,4 +212,123 @@ void ThreadedSchedulerBase::waitForEmpty(const util::SimpleIdentity tag) {
     }
 }
 
+void ThreadedSchedulerBase::scheduleStealable(std::shared_ptr<Queue>&& q,
+                                              Priority priority,
+                                              std::function<void()>&& fn) {
+    // Count the task before publishing it so that neither `waitForEmpty` nor the
+    // worker that picks it up can observe it as missing.
+    q->stealableCount++;
+    taskCount++;
+
+    auto* task = new StealableTask{std::move(fn), std::move(q)};
+    if (thisThreadIsOwned()) {
+        // Tasks spawned by a worker stay local, where their data is likely still in cache
+        workerDeques[currentWorkerIndex]->push(task);
+    } else {
+        MLN_TRACE_ZONE(inject);
+        std::scoped_lock lock(injectionLock);
+        injectionQueue.push(priority, std::move(task));
+    }
+
+    // Only wake a worker if one is actually sleeping. Workers register as idle before
+    // checking `taskCount`, so one of the two sides always sees the other's update.
+    if (idleCount > 0) {
+        std::scoped_lock workerLock(workerMutex);
+        cvAvailable.notify_one();
+    }
+}
+
+ThreadedSchedulerBase::StealableTask* ThreadedSchedulerBase::takeStealable(std::size_t index) {
+    if (auto* task = workerDeques[index]->pop()) {
+        return task;
+    }
+
+    {
+        std::scoped_lock lock(injectionLock);
+        if (!injectionQueue.empty()) {
+            return injectionQueue.pop();
+        }
+    }
+
+    // Start with the next worker so that thieves spread out over the victims
+    const auto count = workerDeques.size();
+    for (std::size_t i = 1; i < count; ++i) {
+        if (auto* task = workerDeques[(index + i) % count]->steal()) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void ThreadedSchedulerBase::runStealable(StealableTask* task_) {
+    std::unique_ptr<StealableTask> task(task_);
+    const auto q = std::move(task->queue);
+
+    assert(taskCount > 0);
+    taskCount--;
+
+    // Mark as running before it stops being pending, so `waitForEmpty` never sees zero in between
+    q->runningCount++;
+    q->stealableCount--;
+
+    try {
+        MLN_TRACE_ZONE(task);
+        task->fn();
+        task.reset(); // destroy the function and release its captures before unblocking `waitForEmpty`
+
+        if (!--q->runningCount) {
+            std::scoped_lock lock(q->lock);
+            if (q->queue.empty() && q->stealableCount == 0) {
+                q->cv.notify_all();
+            }
+        }
+    } catch (...) {
+        std::scoped_lock lock(q->lock);
+        if (handler) {
+            handler(std::current_exception());
+        }
+
+        task.reset();
+
+        if (!--q->runningCount && q->queue.empty() && q->stealableCount == 0) {
+            q->cv.notify_all();
+        }
+
+        if (handler) {
+            return;
+        }
+        throw;
+    }
+}
+
+void ThreadedSchedulerBase::runStealingWorker(std::size_t index) {
+    while (!terminated) {
+        if (auto* task = takeStealable(index)) {
+            runStealable(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> conditionLock(workerMutex);
+        idleCount++;
+        if (!terminated && taskCount == 0) {
+            cvAvailable.wait(conditionLock);
+        }
+        idleCount--;
+
+        if (taskCount > 0 && !terminated) {
+            // Another worker may be between taking a task and decrementing the count
+            conditionLock.unlock();
+            std::this_thread::yield();
+        }
+    }
+}
+
+ThreadedSchedulerBase::Mode ThreadPool::defaultMode() {
+    auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_WORKER_WORK_STEALING);
+    if (auto* enabled = value.getBool(); enabled && *enabled) {
+        return Mode::WorkStealing;
+    }
+    return Mode::Shared;
+}
+
 } // namespace mbgl
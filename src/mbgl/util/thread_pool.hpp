@@ -6,7 +6,10 @@
 #include <mbgl/util/containers.hpp>
 #include <mbgl/util/identity.hpp>
 #include <mbgl/util/instrumentation.hpp>
+#include <mbgl/util/thread_pool_size.hpp>
+#include <mbgl/util/work_stealing_deque.hpp>
 
+#include <algorithm>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
@@ -17,6 +20,17 @@ namespace mbgl {
 
 class ThreadedSchedulerBase : public Scheduler {
 public:
+    /// How scheduled tasks are distributed among the worker threads
+    enum class Mode : uint8_t {
+        /// Workers visit the per-tag queues in turn, all guarded by shared locks.
+        Shared,
+        /// Each worker owns a lock-free deque that it pushes to and pops from, idle workers
+        /// steal from the others. Tasks scheduled from outside the pool go through an
+        /// injection queue. Per-tag `waitForEmpty` is preserved, but tasks are no longer
+        /// visited round-robin by tag, and tasks scheduled by a worker run LIFO on that worker.
+        WorkStealing,
+    };
+
     /// @brief Schedule a generic task not assigned to any particular owner.
     /// The scheduler itself will own the task.
     /// @param fn Task to run
@@ -26,10 +40,18 @@ public:
     /// @param tag Identifier object to indicate ownership of `fn`
     /// @param fn Task to run
     void schedule(const util::SimpleIdentity tag, std::function<void()>&& fn) override;
+
+    /// @brief Schedule a task ahead of the owner's pending tasks with a higher `priority` value.
+    /// In work-stealing mode, priorities order the injection queue but not the per-worker deques.
+    void scheduleWithPriority(const std::optional<util::SimpleIdentity>& tag,
+                              Priority priority,
+                              std::function<void()>&& fn) override;
+
     const util::SimpleIdentity uniqueID;
 
 protected:
-    ThreadedSchedulerBase() = default;
+    /// @param maxThreadCount Number of worker deques to set up in work-stealing mode
+    ThreadedSchedulerBase(Mode mode = Mode::Shared, std::size_t maxThreadCount = 0);
     ~ThreadedSchedulerBase() override;
 
     void terminate();
@@ -50,16 +72,83 @@ protected:
     std::mutex taggedQueueLock;
     util::ThreadLocal<ThreadedSchedulerBase> owningThreadPool;
     std::atomic<size_t> taskCount{0};
-    bool terminated{false};
+    std::atomic<bool> terminated{false};
+
+    /// Pending items ordered by priority, then by submission order
+    template <typename T>
+    class PriorityQueue {
+    public:
+        void push(Priority priority, T&& item) {
+            heap.push_back({priority, nextSequence++, std::move(item)});
+            std::push_heap(heap.begin(), heap.end(), runsLater);
+        }
+
+        /// Removes and returns the most urgent item, the queue must not be empty
+        T pop() {
+            std::pop_heap(heap.begin(), heap.end(), runsLater);
+            T item = std::move(heap.back().item);
+            heap.pop_back();
+            return item;
+        }
+
+        std::size_t size() const { return heap.size(); }
+        bool empty() const { return heap.empty(); }
+
+        template <typename Fn>
+        void forEach(Fn&& fn) {
+            for (auto& entry : heap) {
+                fn(entry.item);
+            }
+        }
+
+    private:
+        struct Entry {
+            Priority priority;
+            uint64_t sequence;
+            T item;
+        };
+
+        static bool runsLater(const Entry& a, const Entry& b) {
+            return a.priority != b.priority ? a.priority > b.priority : a.sequence > b.sequence;
+        }
+
+        std::vector<Entry> heap;
+        uint64_t nextSequence = 0;
+    };
 
     // Task queues bucketed by tag address
     struct Queue {
-        std::atomic<std::size_t> runningCount;   /* running tasks */
-        std::condition_variable cv;              /* queue empty condition */
-        std::mutex lock;                         /* lock */
-        std::queue<std::function<void()>> queue; /* pending task queue */
+        std::atomic<std::size_t> runningCount;      /* running tasks */
+        std::atomic<std::size_t> stealableCount;    /* pending tasks held in worker deques */
+        std::condition_variable cv;                 /* queue empty condition */
+        std::mutex lock;                            /* lock */
+        PriorityQueue<std::function<void()>> queue; /* pending task queue */
     };
     mbgl::unordered_map<util::SimpleIdentity, std::shared_ptr<Queue>> taggedQueue;
+
+    const Mode mode;
+
+    /// Upper bound on the number of worker threads in work-stealing mode
+    std::size_t maxThreads() const { return workerDeques.size(); }
+
+private:
+    // Work-stealing mode
+    struct StealableTask {
+        std::function<void()> fn;
+        std::shared_ptr<Queue> queue;
+    };
+    using WorkerDeque = util::WorkStealingDeque<StealableTask*>;
+
+    std::shared_ptr<Queue> getQueue(const util::SimpleIdentity tag);
+    void scheduleStealable(std::shared_ptr<Queue>&&, Priority, std::function<void()>&&);
+    StealableTask* takeStealable(std::size_t index);
+    void runStealable(StealableTask*);
+    void runStealingWorker(std::size_t index);
+
+    std::vector<std::unique_ptr<WorkerDeque>> workerDeques;
+    std::mutex injectionLock;
+    PriorityQueue<StealableTask*> injectionQueue; /* tasks scheduled from outside the pool */
+    std::atomic<std::size_t> idleCount{0};     /* workers waiting on `cvAvailable` */
 };
 
 /**
@@ -72,8 +161,9 @@ protected:
  */
 class ThreadedScheduler : public ThreadedSchedulerBase {
 public:
-    ThreadedScheduler(std::size_t n)
-        : threads(n) {
+    ThreadedScheduler(std::size_t n, Mode mode_ = Mode::Shared)
+        : ThreadedSchedulerBase(mode_, std::max<std::size_t>(n, std::thread::hardware_concurrency())),
+          threads(n) {
         for (std::size_t i = 0u; i < threads.size(); ++i) {
             threads[i] = makeSchedulerThread(i);
         }
@@ -82,12 +172,30 @@ public:
     ~ThreadedScheduler() override {
         assert(!thisThreadIsOwned());
         terminate();
+        std::scoped_lock lock(threadsLock);
         for (auto& thread : threads) {
             assert(std::this_thread::get_id() != thread.get_id());
             thread.join();
         }
     }
 
+    /// @brief Grow the pool to at least `n` threads. Pools never shrink.
+    /// In work-stealing mode the pool is limited to `max(initial size, hardware concurrency)` threads.
+    void reserve(std::size_t n) {
+        std::scoped_lock lock(threadsLock);
+        if (mode == Mode::WorkStealing) {
+            n = std::min(n, maxThreads());
+        }
+        while (threads.size() < n) {
+            threads.push_back(makeSchedulerThread(threads.size()));
+        }
+    }
+
+    std::size_t threadCount() const {
+        std::scoped_lock lock(threadsLock);
+        return threads.size();
+    }
+
     void runOnRenderThread(const util::SimpleIdentity tag, std::function<void()>&& fn) override {
         std::shared_ptr<RenderQueue> queue;
         {
@@ -150,6 +258,7 @@ protected:
 
 private:
     std::vector<std::thread> threads;
+    mutable std::mutex threadsLock;
 
     struct RenderQueue {
         std::queue<std::function<void()>> queue;
@@ -171,16 +280,22 @@ public:
 
 class ParallelScheduler : public ThreadedScheduler {
 public:
-    ParallelScheduler(std::size_t extra)
-        : ThreadedScheduler(1 + extra) {}
+    ParallelScheduler(std::size_t extra, Mode mode_ = Mode::Shared)
+        : ThreadedScheduler(1 + extra, mode_) {}
     ~ParallelScheduler() override { invalidateWeakPtrsEarly(); }
 };
 
 class ThreadPool final : public ParallelScheduler {
 public:
     ThreadPool()
-        : ParallelScheduler(3) {}
+        : ThreadPool(ThreadPoolSize().threadCount()) {}
+    explicit ThreadPool(std::size_t threads)
+        : ParallelScheduler(std::max<std::size_t>(threads, 1) - 1, defaultMode()) {}
     ~ThreadPool() override { invalidateWeakPtrsEarly(); }
+
+private:
+    /// Honors `platform::EXPERIMENTAL_WORKER_WORK_STEALING`
+    static Mode defaultMode();
 };
 
 } // namespace mbgl
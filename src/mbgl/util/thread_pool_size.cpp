@@ -0,0 +1,118 @@
+#include <mbgl/util/thread_pool_size.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace mbgl {
+
+namespace {
+
+constexpr std::size_t defaultThreadCount = 4;
+
+std::size_t hardwareThreads() {
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+#if defined(__linux__)
+std::optional<std::size_t> affinityThreads() {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        if (const auto count = CPU_COUNT(&set); count > 0) {
+            return static_cast<std::size_t>(count);
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<std::size_t> cgroupThreads() {
+    // cgroup v2: "<quota> <period>", quota is "max" when unlimited
+    if (std::ifstream cpuMax("/sys/fs/cgroup/cpu.max"); cpuMax) {
+        std::string quota;
+        double period = 0;
+        if (cpuMax >> quota >> period && quota != "max" && period > 0) {
+            try {
+                return static_cast<std::size_t>(std::ceil(std::stod(quota) / period));
+            } catch (...) {
+            }
+        }
+        return std::nullopt;
+    }
+
+    // cgroup v1: quota is -1 when unlimited
+    std::ifstream quotaFile("/sys/fs/cgroup/cpu/cpu.cfs_quota_us");
+    std::ifstream periodFile("/sys/fs/cgroup/cpu/cpu.cfs_period_us");
+    double quota = 0;
+    double period = 0;
+    if (quotaFile >> quota && periodFile >> period && quota > 0 && period > 0) {
+        return static_cast<std::size_t>(std::ceil(quota / period));
+    }
+    return std::nullopt;
+}
+#endif
+
+std::size_t quotaThreads() {
+    std::size_t count = hardwareThreads();
+#if defined(__linux__)
+    if (const auto affinity = affinityThreads()) {
+        count = std::min(count, *affinity);
+    }
+    if (const auto quota = cgroupThreads()) {
+        count = std::min(count, *quota);
+    }
+#endif
+    return std::max<std::size_t>(1, count);
+}
+
+} // namespace
+
+ThreadPoolSize::ThreadPoolSize()
+    : ThreadPoolSize(Policy::Fixed, defaultThreadCount, 0, 0) {}
+
+ThreadPoolSize::ThreadPoolSize(Policy policy, std::size_t threads, std::size_t reserved, std::size_t maxThreads)
+    : policy_(policy),
+      threads_(threads),
+      reserved_(reserved),
+      maxThreads_(maxThreads) {}
+
+ThreadPoolSize ThreadPoolSize::fixed(std::size_t threads) {
+    return {Policy::Fixed, threads, 0, 0};
+}
+
+ThreadPoolSize ThreadPoolSize::hardwareConcurrency(std::size_t reserved, std::size_t maxThreads) {
+    return {Policy::HardwareConcurrency, 0, reserved, maxThreads};
+}
+
+ThreadPoolSize ThreadPoolSize::cpuQuota(std::size_t reserved, std::size_t maxThreads) {
+    return {Policy::CPUQuota, 0, reserved, maxThreads};
+}
+
+std::size_t ThreadPoolSize::threadCount() const {
+    std::size_t count = threads_;
+    switch (policy_) {
+        case Policy::Fixed:
+            break;
+        case Policy::HardwareConcurrency:
+            count = hardwareThreads();
+            break;
+        case Policy::CPUQuota:
+            count = quotaThreads();
+            break;
+    }
+
+    count = count > reserved_ ? count - reserved_ : 1;
+    if (maxThreads_ > 0) {
+        count = std::min(count, maxThreads_);
+    }
+    return std::max<std::size_t>(1, count);
+}
+
+} // namespace mbgl
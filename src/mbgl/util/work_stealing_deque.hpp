@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+/**
+ * @brief Lock-free single-producer, multi-consumer deque (Chase-Lev).
+ *
+ * The owning thread pushes and pops at the bottom end, any other thread may
+ * steal from the top end. Only pointers are stored; the deque does not take
+ * ownership of the pointees.
+ *
+ * Buffers replaced while growing are retained until the deque is destroyed,
+ * because a concurrent thief may still be reading from them.
+ */
+template <typename T>
+class WorkStealingDeque {
+    static_assert(std::is_pointer_v<T>, "WorkStealingDeque stores pointers only");
+
+public:
+    explicit WorkStealingDeque(std::size_t initialCapacity = 64) {
+        std::size_t capacity = 1;
+        while (capacity < initialCapacity) {
+            capacity <<= 1;
+        }
+        buffers.push_back(std::make_unique<Buffer>(static_cast<std::int64_t>(capacity)));
+        buffer.store(buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /// Add an item at the bottom. Must only be called from the owning thread.
+    void push(T item) {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = top.load(std::memory_order_acquire);
+        Buffer* buf = buffer.load(std::memory_order_relaxed);
+        if (b - t > buf->capacity - 1) {
+            buf = grow(buf, b, t);
+        }
+        buf->put(b, item);
+        bottom.store(b + 1, std::memory_order_release);
+    }
+
+    /// Remove the most recently pushed item. Must only be called from the owning thread.
+    /// @return The item, or `nullptr` if the deque is empty or the last item was stolen.
+    T pop() {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buf = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+
+        T item = nullptr;
+        if (t <= b) {
+            item = buf->get(b);
+            if (t == b) {
+                // Last item, race against thieves for it
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    item = nullptr;
+                }
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+        } else {
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    /// Remove the least recently pushed item. May be called from any thread.
+    /// @return The item, or `nullptr` if the deque is empty or another thread won the race.
+    T steal() {
+        std::int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t b = bottom.load(std::memory_order_acquire);
+
+        if (t < b) {
+            Buffer* buf = buffer.load(std::memory_order_acquire);
+            T item = buf->get(t);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            return item;
+        }
+        return nullptr;
+    }
+
+    /// Approximate number of items, may be stale by the time it returns.
+    std::size_t size() const {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<std::size_t>(b - t) : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+private:
+    struct Buffer {
+        explicit Buffer(std::int64_t capacity_)
+            : capacity(capacity_),
+              mask(capacity_ - 1),
+              items(std::make_unique<std::atomic<T>[]>(static_cast<std::size_t>(capacity_))) {}
+
+        T get(std::int64_t index) const { return items[index & mask].load(std::memory_order_relaxed); }
+        void put(std::int64_t index, T item) { items[index & mask].store(item, std::memory_order_relaxed); }
+
+        const std::int64_t capacity;
+        const std::int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> items;
+    };
+
+    Buffer* grow(Buffer* old, std::int64_t b, std::int64_t t) {
+        auto replacement = std::make_unique<Buffer>(old->capacity * 2);
+        for (std::int64_t i = t; i < b; ++i) {
+            replacement->put(i, old->get(i));
+        }
+        Buffer* result = replacement.get();
+        buffers.push_back(std::move(replacement));
+        buffer.store(result, std::memory_order_release);
+        return result;
+    }
+
+    alignas(64) std::atomic<std::int64_t> top{0};
+    alignas(64) std::atomic<std::int64_t> bottom{0};
+    std::atomic<Buffer*> buffer{nullptr};
+
+    // Owned by the producer thread; includes retired buffers
+    std::vector<std::unique_ptr<Buffer>> buffers;
+};
+
+} // namespace util
+} // namespace mbgl
@@ -24,7 +24,11 @@ namespace {
 
 class QueryTest {
 public:
-    QueryTest() {
+    explicit QueryTest(MapOptions options = MapOptions())
+        : map(frontend,
+              MapObserver::nullObserver(),
+              fileSource,
+              options.withMapMode(MapMode::Static).withSize(frontend.getSize())) {
         map.getStyle().loadJSON(util::read_file("test/fixtures/api/query_style.json"));
         map.getStyle().addImage(std::make_unique<style::Image>(
             "test-icon", decodeImage(util::read_file("test/fixtures/sprites/default_marker.png")), 1.0f));
@@ -35,10 +39,7 @@ public:
     util::RunLoop loop;
     std::shared_ptr<StubFileSource> fileSource = std::make_shared<StubFileSource>();
     HeadlessFrontend frontend{1};
-    MapAdapter map{frontend,
-                   MapObserver::nullObserver(),
-                   fileSource,
-                   MapOptions().withMapMode(MapMode::Static).withSize(frontend.getSize())};
+    MapAdapter map;
 };
 
 std::vector<Feature> getTopClusterFeature(QueryTest& test) {
@@ -95,6 +96,22 @@ TEST(Query, QueryRenderedFeatures) {
     EXPECT_EQ(features2.size(), 0u);
 }
 
+TEST(Query, QueryRenderedFeaturesParallelPlacement) {
+    // Without cross-source collisions every source is placed on its own, so
+    // placing them concurrently must not change what is rendered.
+    QueryTest serial(MapOptions().withCrossSourceCollisions(false));
+    QueryTest parallel(MapOptions().withCrossSourceCollisions(false).withParallelPlacement(true));
+
+    auto point = serial.map.pixelForLatLng({0, 0});
+    auto serialFeatures = serial.frontend.getRenderer()->queryRenderedFeatures(point);
+    auto parallelFeatures = parallel.frontend.getRenderer()->queryRenderedFeatures(point);
+    ASSERT_EQ(serialFeatures.size(), 4u);
+    ASSERT_EQ(serialFeatures.size(), parallelFeatures.size());
+    for (std::size_t i = 0; i < serialFeatures.size(); ++i) {
+        EXPECT_EQ(serialFeatures[i].source, parallelFeatures[i].source);
+    }
+}
+
 TEST(Query, QueryRenderedFeaturesFilterLayer) {
     QueryTest test;
 
@@ -0,0 +1,57 @@
+#if MLN_RENDER_BACKEND_OPENGL
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/map_options.hpp>
+#include <mbgl/renderer/renderer.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+using namespace mbgl;
+
+TEST(GPUTimer, Render) {
+    util::RunLoop loop;
+    HeadlessFrontend frontend{1};
+    Map map(frontend,
+            MapObserver::nullObserver(),
+            MapOptions().withMapMode(MapMode::Static).withSize(frontend.getSize()),
+            ResourceOptions().withCachePath(":memory:").withAssetPath("test/fixtures/api/assets"));
+    map.getStyle().loadJSON(util::read_file("test/fixtures/api/water.json"));
+
+    frontend.getRenderer()->setGPUTimingEnabled(true);
+    EXPECT_TRUE(frontend.getRenderer()->isGPUTimingEnabled());
+
+    // Timings are reported once the GPU has finished the frame, some frames later
+    gfx::RenderingStats stats;
+    for (int i = 0; i < 10 && stats.gpuLayerGroupTimes.empty(); ++i) {
+        stats = frontend.render(map).stats;
+    }
+    {
+        gfx::BackendScope scope{*frontend.getBackend()};
+        if (!frontend.getBackend()->getContext().isGPUTimingEnabled()) {
+            GTEST_SKIP() << "The driver doesn't support timestamp queries";
+        }
+    }
+
+    ASSERT_TRUE(stats.gpuLayerGroupTimes.contains("water"));
+    EXPECT_TRUE(stats.gpuRenderPassTimes.contains("opaque"));
+    EXPECT_TRUE(stats.gpuRenderPassTimes.contains("translucent"));
+    EXPECT_LE(stats.gpuLayerGroupTimes["water"], stats.gpuFrameTime);
+    for (const auto& [name, time] : stats.gpuRenderPassTimes) {
+        EXPECT_LE(0.0, time) << name;
+        EXPECT_LE(time, stats.gpuFrameTime) << name;
+    }
+
+    frontend.getRenderer()->setGPUTimingEnabled(false);
+    stats = frontend.render(map).stats;
+    EXPECT_EQ(0.0, stats.gpuFrameTime);
+    EXPECT_TRUE(stats.gpuRenderPassTimes.empty());
+    EXPECT_TRUE(stats.gpuLayerGroupTimes.empty());
+}
+
+#endif
@@ -0,0 +1,129 @@
+#if MLN_RENDER_BACKEND_OPENGL
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/program_binary_cache.hpp>
+#include <mbgl/gl/renderer_backend.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/map_options.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <cstring>
+#include <filesystem>
+
+using namespace mbgl;
+using namespace mbgl::gl;
+
+namespace {
+
+const std::string cacheDirectory = "test/fixtures/program_binary_cache";
+
+std::size_t countFiles(const std::string& directory) {
+    std::size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        count += entry.is_regular_file() ? 1 : 0;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(ProgramBinaryCache, StoreAndLoad) {
+    std::filesystem::remove_all(cacheDirectory);
+    ProgramBinaryCache cache(cacheDirectory, "driver");
+
+    const auto key = cache.makeKey({"#define A\n", "void main() {}"}, {"void main() {}"}, "a_pos");
+    EXPECT_FALSE(cache.load(key));
+
+    cache.store(key, {42, std::string("\0binary\0", 8)});
+    const auto binary = cache.load(key);
+    ASSERT_TRUE(binary);
+    EXPECT_EQ(42u, binary->format);
+    EXPECT_EQ(std::string("\0binary\0", 8), binary->data);
+    EXPECT_EQ(1u, countFiles(cacheDirectory));
+
+    // Another permutation, attribute binding or driver misses
+    EXPECT_FALSE(cache.load(cache.makeKey({"#define B\n", "void main() {}"}, {"void main() {}"}, "a_pos")));
+    EXPECT_FALSE(cache.load(cache.makeKey({"#define A\n", "void main() {}"}, {"void main() {}"}, "a_pos2")));
+    // Moving text between sources is a different program
+    EXPECT_FALSE(cache.load(cache.makeKey({"#define A\nvoid main() {}", ""}, {"void main() {}"}, "a_pos")));
+    ProgramBinaryCache other(cacheDirectory, "other driver");
+    EXPECT_FALSE(other.load(other.makeKey({"#define A\n", "void main() {}"}, {"void main() {}"}, "a_pos")));
+
+    cache.remove(key);
+    EXPECT_FALSE(cache.load(key));
+    EXPECT_EQ(0u, countFiles(cacheDirectory));
+
+    std::filesystem::remove_all(cacheDirectory);
+}
+
+TEST(ProgramBinaryCache, RejectsDamagedFiles) {
+    std::filesystem::remove_all(cacheDirectory);
+    ProgramBinaryCache cache(cacheDirectory, "driver");
+    const auto key = cache.makeKey({"void main() {}"}, {"void main() {}"}, "a_pos");
+    const std::string path = cacheDirectory + "/" + key.fileName();
+
+    cache.store(key, {1, "binary"});
+    const std::string file = util::read_file(path);
+
+    // Truncated
+    util::write_file(path, file.substr(0, file.size() - 1));
+    EXPECT_FALSE(cache.load(key));
+
+    // Corrupted
+    std::string corrupted = file;
+    corrupted.back() ^= 1;
+    util::write_file(path, corrupted);
+    EXPECT_FALSE(cache.load(key));
+
+    // Shorter than the header
+    util::write_file(path, "MLPB");
+    EXPECT_FALSE(cache.load(key));
+
+    util::write_file(path, file);
+    EXPECT_TRUE(cache.load(key));
+
+    std::filesystem::remove_all(cacheDirectory);
+}
+
+TEST(ProgramBinaryCache, Render) {
+    std::filesystem::remove_all(cacheDirectory);
+    util::RunLoop loop;
+
+    const auto render = [&] {
+        HeadlessFrontend frontend{1};
+        static_cast<gl::RendererBackend*>(frontend.getBackend())->setProgramBinaryCacheDirectory(cacheDirectory);
+        Map map(frontend,
+                MapObserver::nullObserver(),
+                MapOptions().withMapMode(MapMode::Static).withSize(frontend.getSize()),
+                ResourceOptions().withCachePath(":memory:").withAssetPath("test/fixtures/api/assets"));
+        map.getStyle().loadJSON(util::read_file("test/fixtures/api/water.json"));
+
+        auto image = frontend.render(map).image;
+        gfx::BackendScope scope{*frontend.getBackend()};
+        const bool cached = frontend.getBackend()->getContext<gl::Context>().getProgramBinaryCache() != nullptr;
+        return std::make_pair(std::move(image), cached);
+    };
+
+    const auto [cold, cached] = render();
+    if (!cached) {
+        GTEST_SKIP() << "The driver doesn't support program binaries";
+    }
+    const auto programs = countFiles(cacheDirectory);
+    EXPECT_LT(0u, programs);
+
+    // A new context links the same programs from the cache
+    const auto warm = render().first;
+    EXPECT_EQ(programs, countFiles(cacheDirectory));
+    EXPECT_EQ(cold.bytes(), warm.bytes());
+    EXPECT_EQ(0, std::memcmp(cold.data.get(), warm.data.get(), cold.bytes()));
+
+    std::filesystem::remove_all(cacheDirectory);
+}
+
+#endif
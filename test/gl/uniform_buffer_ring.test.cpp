@@ -0,0 +1,149 @@
+#if MLN_RENDER_BACKEND_OPENGL
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/uniform_buffer_gl.hpp>
+#include <mbgl/gl/uniform_buffer_ring.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/map_options.hpp>
+#include <mbgl/renderer/renderer.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(UniformBufferRing, Update) {
+    util::RunLoop loop;
+    HeadlessFrontend frontend{1};
+    gfx::BackendScope scope{*frontend.getBackend()};
+    auto& context = static_cast<gl::Context&>(frontend.getBackend()->getContext());
+    EXPECT_FALSE(context.isUniformBufferRingEnabled());
+    context.setUniformBufferRingEnabled(true);
+    if (!context.isUniformBufferRingEnabled()) {
+        GTEST_SKIP() << "The driver doesn't support buffer storage";
+    }
+    const auto& ring = *context.getUniformBufferRing();
+
+    std::array<float, 16> data{};
+    {
+        auto buffer = context.createUniformBuffer(data.data(), sizeof(data));
+        auto& bufferGL = static_cast<gl::UniformBufferGL&>(*buffer);
+
+        const auto stats = context.renderingStats();
+        data[0] = 1.0f;
+        buffer->update(data.data(), sizeof(data));
+        // Only the CPU copy is updated
+        EXPECT_EQ(stats.numUniformUpdates + 1, context.renderingStats().numUniformUpdates);
+        EXPECT_EQ(stats.bufferObjUpdates, context.renderingStats().bufferObjUpdates);
+        EXPECT_EQ(stats.bufferUpdates, context.renderingStats().bufferUpdates);
+
+        // Copied into the ring once per frame
+        bufferGL.bind(0);
+        bufferGL.bind(0);
+        EXPECT_EQ(ring.getBufferID(), bufferGL.getID());
+        EXPECT_EQ(stats.bufferUpdates + 1, context.renderingStats().bufferUpdates);
+
+        context.beginFrame();
+        bufferGL.bind(0);
+        EXPECT_EQ(stats.bufferUpdates + 2, context.renderingStats().bufferUpdates);
+        context.endFrame();
+    }
+
+    context.setUniformBufferRingEnabled(false);
+    EXPECT_FALSE(context.isUniformBufferRingEnabled());
+    auto buffer = context.createUniformBuffer(data.data(), sizeof(data));
+    EXPECT_NE(ring.getBufferID(), static_cast<gl::UniformBufferGL&>(*buffer).getID());
+}
+
+TEST(UniformBufferRing, Wrap) {
+    util::RunLoop loop;
+    HeadlessFrontend frontend{1};
+    gfx::BackendScope scope{*frontend.getBackend()};
+    auto& context = static_cast<gl::Context&>(frontend.getBackend()->getContext());
+    context.setUniformBufferRingEnabled(true);
+    if (!context.isUniformBufferRingEnabled()) {
+        GTEST_SKIP() << "The driver doesn't support buffer storage";
+    }
+    auto& ring = *context.getUniformBufferRing();
+    constexpr auto regionCount = gl::UniformBufferRing::regionCount;
+
+    std::array<float, 16> data{};
+    std::array<std::size_t, regionCount> offsets{};
+    const auto frame = [&](std::size_t i) {
+        context.beginFrame();
+        const auto offset = ring.write(data.data(), sizeof(data));
+        ASSERT_TRUE(offset);
+        if (i < regionCount) {
+            offsets[i] = *offset;
+        } else {
+            // Back in the region of the frame `regionCount` ago
+            EXPECT_EQ(offsets[i % regionCount], *offset);
+        }
+        context.endFrame();
+    };
+
+    // Each region is fenced after its first frame, every later frame waits for the GPU to release it
+    for (std::size_t i = 0; i < regionCount; ++i) {
+        frame(i);
+    }
+    const auto waits = ring.getFenceWaits();
+    for (std::size_t i = regionCount; i < 3 * regionCount; ++i) {
+        frame(i);
+    }
+    EXPECT_EQ(waits + 2 * regionCount, ring.getFenceWaits());
+
+    // Overflowing a frame grows the regions at the start of the next one, without waiting on the old ones
+    const auto size = ring.getRegionSize();
+    std::vector<std::byte> block(size);
+    context.beginFrame();
+    EXPECT_TRUE(ring.write(data.data(), sizeof(data)));
+    EXPECT_FALSE(ring.write(block.data(), block.size()));
+    context.endFrame();
+
+    const auto overflowWaits = ring.getFenceWaits();
+    context.beginFrame();
+    EXPECT_EQ(2 * size, ring.getRegionSize());
+    EXPECT_EQ(overflowWaits, ring.getFenceWaits());
+    EXPECT_TRUE(ring.write(block.data(), block.size()));
+    context.endFrame();
+}
+
+TEST(UniformBufferRing, Render) {
+    util::RunLoop loop;
+
+    bool supported = true;
+    const auto render = [&](bool enable) {
+        HeadlessFrontend frontend{1};
+        frontend.getRenderer()->setUniformBufferRingEnabled(enable);
+
+        Map map(frontend,
+                MapObserver::nullObserver(),
+                MapOptions().withMapMode(MapMode::Static).withSize(frontend.getSize()),
+                ResourceOptions().withCachePath(":memory:").withAssetPath("test/fixtures/api/assets"));
+        map.getStyle().loadJSON(util::read_file("test/fixtures/api/water.json"));
+        auto image = frontend.render(map).image;
+
+        gfx::BackendScope scope{*frontend.getBackend()};
+        supported = supported && (!enable || frontend.getBackend()->getContext().isUniformBufferRingEnabled());
+        return image;
+    };
+
+    const auto expected = render(false);
+    const auto actual = render(true);
+    if (!supported) {
+        GTEST_SKIP() << "The driver doesn't support buffer storage";
+    }
+
+    ASSERT_EQ(expected.bytes(), actual.bytes());
+    EXPECT_EQ(0, std::memcmp(expected.data.get(), actual.data.get(), expected.bytes()));
+}
+
+#endif
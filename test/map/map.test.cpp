@@ -2039,3 +2039,61 @@ TEST(Map, SetFrustumOffset) {
 
     test::checkImage("test/fixtures/map/setFrustumOffset/after", test.frontend.render(test.map).image, 0.0006, 0.1);
 }
+
+TEST(Map, IncrementalPlacement) {
+    // Places a few hundred colliding icons, pans by a few pixels and returns
+    // the features still shown along with the stats of the last frame.
+    const auto panAndQuery = [](bool incremental) {
+        MapTest<> test{MapOptions().withMapMode(MapMode::Continuous).withIncrementalPlacement(incremental)};
+
+        std::string features;
+        uint32_t seed = 1;
+        const auto random = [&seed](double min, double max) {
+            seed = seed * 1664525u + 1013904223u;
+            return min + (max - min) * (seed >> 8) / double(1u << 24);
+        };
+        for (int i = 0; i < 400; ++i) {
+            features += (i ? "," : "") + std::string(R"({"type":"Feature","id":)") + std::to_string(i) +
+                        R"(,"properties":{},"geometry":{"type":"Point","coordinates":[)" +
+                        std::to_string(random(-40, 40)) + "," + std::to_string(random(-30, 30)) + "]}}";
+        }
+        test.map.getStyle().loadJSON(R"({"version":8,"sources":{"points":{"type":"geojson","data":{
+            "type":"FeatureCollection","features":[)" +
+                                     features + R"(]}}},"layers":[{"id":"icons","type":"symbol","source":"points",
+            "layout":{"icon-image":"marker"}}]})");
+        test.map.getStyle().addImage(std::make_unique<style::Image>(
+            "marker", decodeImage(util::read_file("test/fixtures/sprites/default_marker.png")), 1.0f));
+        // Place on every frame
+        test.map.getStyle().setTransitionOptions(TransitionOptions{{}, {}, false});
+        test.map.jumpTo(CameraOptions().withCenter(LatLng{0, 0}).withZoom(0.5));
+
+        gfx::RenderingStats stats;
+        test.observer.didFinishRenderingFrameCallback = [&](MapObserver::RenderFrameStatus status) {
+            if (status.mode == MapObserver::RenderMode::Full) {
+                stats = status.renderingStats;
+                test.runLoop.stop();
+            }
+        };
+        test.runLoop.run();
+        test.map.moveBy({3, 2});
+        test.runLoop.run();
+
+        std::vector<FeatureIdentifier> ids;
+        const auto size = test.frontend.getSize();
+        for (const auto& feature : test.frontend.getRenderer()->queryRenderedFeatures(
+                 ScreenBox{{0, 0}, {double(size.width), double(size.height)}})) {
+            ids.push_back(feature.id);
+        }
+        return std::make_pair(ids, stats);
+    };
+
+    const auto [fullIds, fullStats] = panAndQuery(false);
+    const auto [incrementalIds, incrementalStats] = panAndQuery(true);
+
+    EXPECT_EQ(0u, fullStats.reusedSymbolPlacements);
+    EXPECT_GT(incrementalStats.reusedSymbolPlacements, 0u);
+
+    // Reusing results must not change which icons are shown
+    EXPECT_FALSE(fullIds.empty());
+    EXPECT_TRUE(fullIds == incrementalIds);
+}
@@ -0,0 +1,120 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/gfx/renderer_backend.hpp>
+#include <mbgl/gfx/shader_group.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/map_options.hpp>
+#include <mbgl/renderer/renderer.hpp>
+#include <mbgl/renderer/shader_warm_up.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+class StubShaderGroup final : public gfx::ShaderGroup {
+public:
+    gfx::ShaderPtr getOrCreateShader(gfx::Context&,
+                                     const StringIDSetsPair& propertiesAsUniforms,
+                                     std::string_view firstAttribName) override {
+        requests.emplace_back(propertiesAsUniforms, std::string(firstAttribName));
+        return {};
+    }
+
+    std::vector<std::pair<StringIDSetsPair, std::string>> requests;
+};
+
+} // namespace
+
+TEST(ShaderWarmUp, Queue) {
+    util::RunLoop loop;
+    HeadlessFrontend frontend{1};
+    gfx::BackendScope scope{*frontend.getBackend()};
+    auto& context = frontend.getBackend()->getContext();
+
+    const auto group = std::make_shared<StubShaderGroup>();
+    const StringIDSetsPair colorAsUniform{{"a_color"}, {1}};
+
+    ShaderWarmUp warmUp;
+    warmUp.enqueue({{group, {}}, {group, colorAsUniform}, {group, {}, "a_pos_normal"}, {nullptr, {}}});
+    // Already queued
+    warmUp.enqueue({{group, {}}, {group, colorAsUniform}});
+    EXPECT_EQ(3u, warmUp.size());
+
+    // Even without a budget, the queue makes progress
+    EXPECT_EQ(1u, warmUp.run(context, Duration::zero()));
+    ASSERT_EQ(1u, group->requests.size());
+    EXPECT_TRUE(group->requests[0].first.second.empty());
+    EXPECT_EQ("a_pos", group->requests[0].second);
+
+    EXPECT_EQ(2u, warmUp.run(context, std::chrono::hours(1)));
+    EXPECT_TRUE(warmUp.empty());
+    ASSERT_EQ(3u, group->requests.size());
+    EXPECT_EQ(colorAsUniform.second, group->requests[1].first.second);
+    EXPECT_EQ("a_pos_normal", group->requests[2].second);
+
+    EXPECT_EQ(0u, warmUp.run(context, std::chrono::hours(1)));
+
+    warmUp.enqueue({{group, {}}});
+    warmUp.clear();
+    EXPECT_TRUE(warmUp.empty());
+}
+
+TEST(ShaderWarmUp, Render) {
+    util::RunLoop loop;
+
+    // Fill in one, background, circle, heatmap and fill extrusion layers in the other
+    const std::string geojsonStyle = R"({
+        "version": 8,
+        "sources": {
+            "points": {
+                "type": "geojson",
+                "data": {"type": "Feature", "properties": {}, "geometry": {"type": "Point", "coordinates": [0, 0]}}
+            },
+            "polygon": {
+                "type": "geojson",
+                "data": {"type": "Feature", "properties": {"height": 10}, "geometry": {"type": "Polygon",
+                    "coordinates": [[[-10, -10], [10, -10], [10, 10], [-10, 10], [-10, -10]]]}}
+            }
+        },
+        "layers": [
+            {"id": "background", "type": "background", "paint": {"background-color": "#ccc"}},
+            {"id": "extrusion", "type": "fill-extrusion", "source": "polygon",
+                "paint": {"fill-extrusion-height": ["get", "height"], "fill-extrusion-color": "#f00"}},
+            {"id": "heatmap", "type": "heatmap", "source": "points", "paint": {"heatmap-radius": 20}},
+            {"id": "circle", "type": "circle", "source": "points", "paint": {"circle-radius": ["zoom"]}}
+        ]
+    })";
+
+    const auto render = [&](Duration budget, const std::string& styleJSON) {
+        HeadlessFrontend frontend{1};
+        frontend.getRenderer()->setShaderWarmUpBudget(budget);
+        EXPECT_EQ(budget, frontend.getRenderer()->getShaderWarmUpBudget());
+
+        Map map(frontend,
+                MapObserver::nullObserver(),
+                MapOptions().withMapMode(MapMode::Static).withSize(frontend.getSize()),
+                ResourceOptions().withCachePath(":memory:").withAssetPath("test/fixtures/api/assets"));
+        map.getStyle().loadJSON(styleJSON);
+
+        auto image = frontend.render(map).image;
+        EXPECT_EQ(0u, frontend.getRenderer()->getPendingShaderWarmUpCount());
+        return image;
+    };
+
+    for (const auto& styleJSON : {util::read_file("test/fixtures/api/water.json"), geojsonStyle}) {
+        const auto expected = render(Duration::zero(), styleJSON);
+        const auto actual = render(std::chrono::hours(1), styleJSON);
+        ASSERT_EQ(expected.bytes(), actual.bytes());
+        EXPECT_EQ(0, std::memcmp(expected.data.get(), actual.data.get(), expected.bytes()));
+    }
+}
@@ -37,7 +37,7 @@ TEST(AssetFileSource, Load) {
 
             requestCallback = [this, asset, endCallback](mbgl::Response res) {
                 EXPECT_EQ(nullptr, res.error);
-                ASSERT_TRUE(res.data.get());
+                ASSERT_TRUE(res.data);
                 EXPECT_EQ("content is here\n", *res.data);
 
                 if (!--numRequests) {
@@ -92,7 +92,7 @@ TEST(AssetFileSource, EmptyFile) {
     std::unique_ptr<AsyncRequest> req = fs.request({Resource::Unknown, "asset://empty"}, [&](Response res) {
         req.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("", *res.data);
         loop.stop();
     });
@@ -108,7 +108,7 @@ TEST(AssetFileSource, NonEmptyFile) {
     std::unique_ptr<AsyncRequest> req = fs.request({Resource::Unknown, "asset://nonempty"}, [&](Response res) {
         req.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("content is here\n", *res.data);
         loop.stop();
     });
@@ -125,7 +125,7 @@ TEST(AssetFileSource, NonExistentFile) {
         req.reset();
         ASSERT_NE(nullptr, res.error);
         EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
-        ASSERT_FALSE(res.data.get());
+        ASSERT_FALSE(res.data);
         // Do not assert on platform-specific error message.
         loop.stop();
     });
@@ -143,7 +143,7 @@ TEST(AssetFileSource, InvalidURL) {
         ASSERT_NE(nullptr, res.error);
         EXPECT_EQ(Response::Error::Reason::Other, res.error->reason);
         EXPECT_EQ("Invalid asset URL", res.error->message);
-        ASSERT_FALSE(res.data.get());
+        ASSERT_FALSE(res.data);
         loop.stop();
     });
 
@@ -159,7 +159,7 @@ TEST(AssetFileSource, ReadDirectory) {
         req.reset();
         ASSERT_NE(nullptr, res.error);
         EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
-        ASSERT_FALSE(res.data.get());
+        ASSERT_FALSE(res.data);
         // Do not assert on platform-specific error message.
         loop.stop();
     });
@@ -175,7 +175,7 @@ TEST(AssetFileSource, URLEncoding) {
     std::unique_ptr<AsyncRequest> req = fs.request({Resource::Unknown, "asset://%6eonempty"}, [&](Response res) {
         req.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("content is here\n", *res.data);
         loop.stop();
     });
@@ -194,7 +194,7 @@ TEST(AssetFileSource, RangeRequest) {
     std::unique_ptr<AsyncRequest> req = fs.request(resource, [&](Response res) {
         req.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("ent is he", *res.data);
         loop.stop();
     });
@@ -39,7 +39,7 @@ TEST(DatabaseFileSource, VolatileResource) {
     dbfs->forward(resource, response, [&] {
         req = dbfs->request(resource, [&](Response res1) {
             EXPECT_EQ(nullptr, res1.error);
-            ASSERT_TRUE(res1.data.get());
+            ASSERT_TRUE(res1.data);
             EXPECT_FALSE(res1.noContent);
             EXPECT_EQ("Cached value", *res1.data);
             resource.storagePolicy = Resource::StoragePolicy::Volatile;
@@ -7,6 +7,8 @@
 #include <mbgl/util/string.hpp>
 #include <mbgl/storage/resource_options.hpp>
 
+#include <vector>
+
 using namespace mbgl;
 
 TEST(HTTPFileSource, TEST_REQUIRES_SERVER(Cancel)) {
@@ -25,7 +27,7 @@ TEST(HTTPFileSource, TEST_REQUIRES_SERVER(HTTP200)) {
 
     auto req = fs.request({Resource::Unknown, "http://127.0.0.1:3000/test"}, [&](Response res) {
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("Hello World!", *res.data);
         EXPECT_FALSE(bool(res.expires));
         EXPECT_FALSE(res.mustRevalidate);
@@ -46,7 +48,7 @@ TEST(HTTPFileSource, TEST_REQUIRES_SERVER(HTTP206)) {
 
     auto req = fs.request(resource, [&](Response res) {
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("lo Wor", *res.data);
         EXPECT_FALSE(bool(res.expires));
         EXPECT_FALSE(res.mustRevalidate);
@@ -159,7 +161,7 @@ TEST(HTTPFileSource, TEST_REQUIRES_SERVER(ExpiresParsing)) {
                            "test?modified=1420794326&expires=1420797926&etag=foo"},
                           [&](Response res) {
                               EXPECT_EQ(nullptr, res.error);
-                              ASSERT_TRUE(res.data.get());
+                              ASSERT_TRUE(res.data);
                               EXPECT_EQ("Hello World!", *res.data);
                               EXPECT_TRUE(Timestamp{Seconds(1420797926)} == res.expires);
                               EXPECT_FALSE(res.mustRevalidate);
@@ -178,7 +180,7 @@ TEST(HTTPFileSource, TEST_REQUIRES_SERVER(CacheControlParsing)) {
     auto req = fs.request({Resource::Unknown, "http://127.0.0.1:3000/test?cachecontrol=max-age=120"},
                           [&](Response res) {
                               EXPECT_EQ(nullptr, res.error);
-                              ASSERT_TRUE(res.data.get());
+                              ASSERT_TRUE(res.data);
                               EXPECT_EQ("Hello World!", *res.data);
                               EXPECT_GT(Seconds(2), util::abs(*res.expires - util::now() - Seconds(120)))
                                   << "Expiration date isn't about 120 seconds in the future";
@@ -207,7 +209,7 @@ TEST(HTTPFileSource, TEST_REQUIRES_SERVER(Load)) {
                              [&, i, current](Response res) {
                                  reqs[i].reset();
                                  EXPECT_EQ(nullptr, res.error);
-                                 ASSERT_TRUE(res.data.get());
+                                 ASSERT_TRUE(res.data);
                                  EXPECT_EQ(std::string("Request ") + util::toString(current), *res.data);
                                  EXPECT_FALSE(bool(res.expires));
                                  EXPECT_FALSE(res.mustRevalidate);
@@ -228,3 +230,71 @@ TEST(HTTPFileSource, TEST_REQUIRES_SERVER(Load)) {
 
     loop.run();
 }
+
+TEST(HTTPFileSource, TEST_REQUIRES_SERVER(ConnectionLimits)) {
+    util::RunLoop loop;
+    HTTPFileSource fs(ResourceOptions::Default(),
+                      ClientOptions().withMaxHostConnections(4).withTCPKeepAlive(Seconds(30), Seconds(10)));
+
+    EXPECT_EQ(4u, fs.getClientOptions().maxHostConnections());
+    EXPECT_TRUE(fs.getClientOptions().httpMultiplexing());
+
+    // A burst of tile-sized requests is queued behind the connection limit
+    // and still completes.
+    const int max = 500;
+    int completed = 0;
+    std::vector<std::unique_ptr<AsyncRequest>> reqs;
+    for (int i = 1; i <= max; i++) {
+        reqs.push_back(fs.request({Resource::Unknown, std::string("http://127.0.0.1:3000/load/") + util::toString(i)},
+                                  [&, i](Response res) {
+                                      EXPECT_EQ(nullptr, res.error);
+                                      ASSERT_TRUE(res.data);
+                                      EXPECT_EQ(std::string("Request ") + util::toString(i), *res.data);
+                                      if (++completed == max) {
+                                          loop.stop();
+                                      }
+                                  }));
+    }
+
+    loop.run();
+    EXPECT_EQ(max, completed);
+}
+
+TEST(HTTPFileSource, TEST_REQUIRES_SERVER(HTTP2Multiplexing)) {
+    util::RunLoop loop;
+    HTTPFileSource fs(ResourceOptions::Default(), ClientOptions().withHTTP2PriorKnowledge(true));
+
+    // Concurrent requests to the cleartext HTTP/2 server share a single connection
+    const int max = 50;
+    int completed = 0;
+    bool supported = true;
+    std::vector<std::unique_ptr<AsyncRequest>> reqs;
+    for (int i = 1; i <= max; i++) {
+        reqs.push_back(fs.request({Resource::Unknown, std::string("http://127.0.0.1:3001/load/") + util::toString(i)},
+                                  [&, i](Response res) {
+                                      if (res.error) {
+                                          // The HTTP stack can't speak HTTP/2 without TLS
+                                          supported = false;
+                                      } else {
+                                          ASSERT_TRUE(res.data);
+                                          EXPECT_EQ(std::string("Request ") + util::toString(i), *res.data);
+                                      }
+                                      if (++completed == max) {
+                                          loop.stop();
+                                      }
+                                  }));
+    }
+    loop.run();
+    EXPECT_EQ(max, completed);
+    if (!supported) {
+        GTEST_SKIP() << "Cleartext HTTP/2 is not supported";
+    }
+
+    auto req = fs.request({Resource::Unknown, "http://127.0.0.1:3001/connections"}, [&](Response res) {
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data);
+        EXPECT_EQ("1", *res.data);
+        loop.stop();
+    });
+    loop.run();
+}
@@ -54,7 +54,7 @@ TEST(LocalFileSource, EmptyFile) {
     std::unique_ptr<AsyncRequest> req = fs.request({Resource::Unknown, toAbsoluteURL("empty")}, [&](Response res) {
         req.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("", *res.data);
         loop.stop();
     });
@@ -70,7 +70,7 @@ TEST(LocalFileSource, NonEmptyFile) {
     std::unique_ptr<AsyncRequest> req = fs.request({Resource::Unknown, toAbsoluteURL("nonempty")}, [&](Response res) {
         req.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("content is here\n", *res.data);
         loop.stop();
     });
@@ -89,7 +89,7 @@ TEST(LocalFileSource, PartialFile) {
     std::unique_ptr<AsyncRequest> req = fs.request(resource, [&](Response res) {
         req.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("ent is he", *res.data);
         loop.stop();
     });
@@ -107,7 +107,7 @@ TEST(LocalFileSource, NonExistentFile) {
                                                        req.reset();
                                                        ASSERT_NE(nullptr, res.error);
                                                        EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
-                                                       ASSERT_FALSE(res.data.get());
+                                                       ASSERT_FALSE(res.data);
                                                        // Do not assert on platform-specific error message.
                                                        loop.stop();
                                                    });
@@ -125,7 +125,7 @@ TEST(LocalFileSource, InvalidURL) {
         ASSERT_NE(nullptr, res.error);
         EXPECT_EQ(Response::Error::Reason::Other, res.error->reason);
         EXPECT_EQ("Invalid file URL", res.error->message);
-        ASSERT_FALSE(res.data.get());
+        ASSERT_FALSE(res.data);
         loop.stop();
     });
 
@@ -141,7 +141,7 @@ TEST(LocalFileSource, ReadDirectory) {
         req.reset();
         ASSERT_NE(nullptr, res.error);
         EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
-        ASSERT_FALSE(res.data.get());
+        ASSERT_FALSE(res.data);
         // Do not assert on platform-specific error message.
         loop.stop();
     });
@@ -157,7 +157,7 @@ TEST(LocalFileSource, URLEncoding) {
     std::unique_ptr<AsyncRequest> req = fs.request({Resource::Unknown, toAbsoluteURL("%6eonempty")}, [&](Response res) {
         req.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("content is here\n", *res.data);
         loop.stop();
     });
@@ -187,7 +187,7 @@ TEST(LocalFileSource, URLLimit) {
 #else
         EXPECT_EQ(Response::Error::Reason::Other, res.error->reason);
 #endif
-        ASSERT_FALSE(res.data.get());
+        ASSERT_FALSE(res.data);
         loop.stop();
     });
 
@@ -27,7 +27,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(CacheResponse)) {
     req1 = fs.request(resource, [&](Response res) {
         req1.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("Response 1", *res.data);
         EXPECT_TRUE(bool(res.expires));
         EXPECT_FALSE(res.mustRevalidate);
@@ -40,7 +40,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(CacheResponse)) {
         req2 = fs.request(resource, [&](Response res2) {
             req2.reset();
             EXPECT_EQ(response.error, res2.error);
-            ASSERT_TRUE(res2.data.get());
+            ASSERT_TRUE(res2.data);
             EXPECT_EQ(*response.data, *res2.data);
             EXPECT_TRUE(response.expires == res2.expires);
             EXPECT_EQ(response.mustRevalidate, res2.mustRevalidate);
@@ -65,7 +65,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(VolatileStoragePolicy)) {
     req = fs.request(resource, [&](Response res1) {
         EXPECT_EQ(nullptr, res1.error);
         ASSERT_TRUE(res1.data);
-        std::string firstData = *res1.data;
+        std::string firstData(*res1.data);
 
         // Volatile resources are not stored in cache,
         // so we always get new data from the server ("Response N+1").
@@ -96,7 +96,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(CacheRevalidateSame)) {
 
         EXPECT_EQ(nullptr, res.error);
         EXPECT_FALSE(res.notModified);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("Response", *res.data);
         EXPECT_FALSE(bool(res.expires));
         EXPECT_TRUE(res.mustRevalidate);
@@ -118,7 +118,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(CacheRevalidateSame)) {
                 gotResponse = true;
                 EXPECT_EQ(nullptr, res2.error);
                 EXPECT_FALSE(res2.notModified);
-                ASSERT_TRUE(res2.data.get());
+                ASSERT_TRUE(res2.data);
                 EXPECT_EQ("Response", *res2.data);
                 EXPECT_TRUE(bool(res2.expires));
                 EXPECT_TRUE(res2.mustRevalidate);
@@ -134,7 +134,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(CacheRevalidateSame)) {
                 req2.reset();
                 EXPECT_EQ(nullptr, res2.error);
                 EXPECT_TRUE(res2.notModified);
-                EXPECT_FALSE(res2.data.get());
+                EXPECT_FALSE(res2.data);
                 EXPECT_TRUE(bool(res2.expires));
                 EXPECT_TRUE(res2.mustRevalidate);
                 EXPECT_FALSE(bool(res2.modified));
@@ -162,7 +162,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(CacheRevalidateModified)) {
 
         EXPECT_EQ(nullptr, res.error);
         EXPECT_FALSE(res.notModified);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("Response", *res.data);
         EXPECT_FALSE(bool(res.expires));
         EXPECT_TRUE(res.mustRevalidate);
@@ -184,7 +184,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(CacheRevalidateModified)) {
                 gotResponse = true;
                 EXPECT_EQ(nullptr, res2.error);
                 EXPECT_FALSE(res2.notModified);
-                ASSERT_TRUE(res2.data.get());
+                ASSERT_TRUE(res2.data);
                 EXPECT_EQ("Response", *res2.data);
                 EXPECT_TRUE(bool(res2.expires));
                 EXPECT_TRUE(res2.mustRevalidate);
@@ -200,7 +200,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(CacheRevalidateModified)) {
                 req2.reset();
                 EXPECT_EQ(nullptr, res2.error);
                 EXPECT_TRUE(res2.notModified);
-                EXPECT_FALSE(res2.data.get());
+                EXPECT_FALSE(res2.data);
                 EXPECT_TRUE(bool(res2.expires));
                 EXPECT_TRUE(res2.mustRevalidate);
                 EXPECT_TRUE(Timestamp{Seconds(1420070400)} == *res2.modified);
@@ -226,7 +226,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(CacheRevalidateEtag)) {
         req1.reset();
 
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("Response 1", *res.data);
         EXPECT_FALSE(bool(res.expires));
         EXPECT_TRUE(res.mustRevalidate);
@@ -239,7 +239,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(CacheRevalidateEtag)) {
             req2.reset();
 
             EXPECT_EQ(nullptr, res2.error);
-            ASSERT_TRUE(res2.data.get());
+            ASSERT_TRUE(res2.data);
             EXPECT_NE(res.data, res2.data);
             EXPECT_EQ("Response 2", *res2.data);
             EXPECT_FALSE(bool(res2.expires));
@@ -276,7 +276,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(HTTPIssue1369)) {
     req = fs.request(resource, [&](Response res) {
         req.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("Hello World!", *res.data);
         EXPECT_FALSE(bool(res.expires));
         EXPECT_FALSE(res.mustRevalidate);
@@ -308,7 +308,7 @@ TEST(MainResourceLoader, OptionalNonExpired) {
         req = fs.request(optionalResource, [&](Response res) {
             req.reset();
             EXPECT_EQ(nullptr, res.error);
-            ASSERT_TRUE(res.data.get());
+            ASSERT_TRUE(res.data);
             EXPECT_EQ("Cached value", *res.data);
             ASSERT_TRUE(bool(res.expires));
             EXPECT_TRUE(*response.expires == *res.expires);
@@ -341,7 +341,7 @@ TEST(MainResourceLoader, OptionalExpired) {
         req = fs.request(optionalResource, [&](Response res) {
             req.reset();
             EXPECT_EQ(nullptr, res.error);
-            ASSERT_TRUE(res.data.get());
+            ASSERT_TRUE(res.data);
             EXPECT_EQ("Cached value", *res.data);
             ASSERT_TRUE(bool(res.expires));
             EXPECT_TRUE(*response.expires == *res.expires);
@@ -404,7 +404,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(NoCacheRefreshEtagNotModified)) {
             req.reset();
             EXPECT_EQ(nullptr, res.error);
             EXPECT_TRUE(res.notModified);
-            EXPECT_FALSE(res.data.get());
+            EXPECT_FALSE(res.data);
             ASSERT_TRUE(bool(res.expires));
             EXPECT_TRUE(util::now() < *res.expires);
             EXPECT_TRUE(res.mustRevalidate);
@@ -441,7 +441,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(NoCacheRefreshEtagModified)) {
             req.reset();
             EXPECT_EQ(nullptr, res.error);
             EXPECT_FALSE(res.notModified);
-            ASSERT_TRUE(res.data.get());
+            ASSERT_TRUE(res.data);
             EXPECT_EQ("Response", *res.data);
             EXPECT_FALSE(bool(res.expires));
             EXPECT_TRUE(res.mustRevalidate);
@@ -477,7 +477,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(NoCacheFull)) {
             req.reset();
             EXPECT_EQ(nullptr, res.error);
             EXPECT_FALSE(res.notModified);
-            ASSERT_TRUE(res.data.get());
+            ASSERT_TRUE(res.data);
             EXPECT_EQ("Response", *res.data);
             EXPECT_FALSE(bool(res.expires));
             EXPECT_TRUE(res.mustRevalidate);
@@ -515,7 +515,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(NoCacheRefreshModifiedNotModified)
             req.reset();
             EXPECT_EQ(nullptr, res.error);
             EXPECT_TRUE(res.notModified);
-            EXPECT_FALSE(res.data.get());
+            EXPECT_FALSE(res.data);
             ASSERT_TRUE(bool(res.expires));
             EXPECT_TRUE(util::now() < *res.expires);
             EXPECT_TRUE(res.mustRevalidate);
@@ -553,7 +553,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(NoCacheRefreshModifiedModified)) {
             req.reset();
             EXPECT_EQ(nullptr, res.error);
             EXPECT_FALSE(res.notModified);
-            ASSERT_TRUE(res.data.get());
+            ASSERT_TRUE(res.data);
             EXPECT_EQ("Response", *res.data);
             EXPECT_FALSE(bool(res.expires));
             EXPECT_TRUE(res.mustRevalidate);
@@ -593,7 +593,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(SetResourceTransform)) {
     req = resourceLoader.request(resource1, [&](Response res) {
         req.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("Hello World!", *res.data);
         EXPECT_FALSE(bool(res.expires));
         EXPECT_FALSE(res.mustRevalidate);
@@ -610,7 +610,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(SetResourceTransform)) {
     req = resourceLoader.request(resource2, [&](Response res) {
         req.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("Hello World!", *res.data);
         EXPECT_FALSE(bool(res.expires));
         EXPECT_FALSE(res.mustRevalidate);
@@ -659,7 +659,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(RespondToStaleMustRevalidate)) {
             EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
             EXPECT_EQ("Cached resource is unusable", res.error->message);
             EXPECT_FALSE(res.notModified);
-            ASSERT_TRUE(res.data.get());
+            ASSERT_TRUE(res.data);
             EXPECT_EQ("Cached value", *res.data);
             ASSERT_TRUE(res.expires);
             EXPECT_TRUE(Timestamp{Seconds(1417392000)} == *res.expires);
@@ -695,7 +695,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(RespondToStaleMustRevalidate)) {
         // setting notModified to false in the OnlineFileSource to ensure that
         // requestors know that this is the first time they're seeing this data.
         EXPECT_FALSE(res.notModified);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         // Ensure that it's the value that we manually inserted into the cache
         // rather than the value the server returns, since we should be
         // executing a revalidation request which doesn't return new data, only
@@ -826,7 +826,7 @@ TEST(MainResourceLoader, TEST_REQUIRES_SERVER(NoDoubleDispatch)) {
             EXPECT_TRUE(bool(res.etag));
             EXPECT_EQ("snowfall", *res.etag);
             if (!res.notModified) {
-                ASSERT_TRUE(res.data.get());
+                ASSERT_TRUE(res.data);
                 EXPECT_EQ("data", *res.data);
                 ++responseCount;
             }
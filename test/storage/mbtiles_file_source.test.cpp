@@ -40,7 +40,7 @@ TEST(MBTilesFileSource, AbsolutePath) {
             ASSERT_NE(nullptr, res.error);
             EXPECT_EQ(Response::Error::Reason::Other, res.error->reason);
             EXPECT_NE((res.error->message).find("absolute"), std::string::npos);
-            ASSERT_FALSE(res.data.get());
+            ASSERT_FALSE(res.data);
             loop.stop();
         });
 
@@ -59,7 +59,7 @@ TEST(MBTilesFileSource, NonExistentFile) {
             ASSERT_NE(nullptr, res.error);
             EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
             EXPECT_NE((res.error->message).find("path not found"), std::string::npos);
-            ASSERT_FALSE(res.data.get());
+            ASSERT_FALSE(res.data);
             loop.stop();
         });
 
@@ -76,7 +76,7 @@ TEST(MBTilesFileSource, TileJSON) {
         {Resource::Unknown, toAbsoluteURL("geography-class-png.mbtiles")}, [&](Response res) {
             req.reset();
             EXPECT_EQ(nullptr, res.error);
-            ASSERT_TRUE(res.data.get());
+            ASSERT_TRUE(res.data);
             // basic test that TileJSON included a tile URL
             EXPECT_NE((*res.data).find("geography-class-png.mbtiles?file={x}/{y}/{z}"), std::string::npos);
             loop.stop();
@@ -97,7 +97,7 @@ TEST(MBTilesFileSource, Tile) {
         [&](Response res) {
             req.reset();
             EXPECT_EQ(nullptr, res.error);
-            ASSERT_TRUE(res.data.get());
+            ASSERT_TRUE(res.data);
             ASSERT_EQ(res.noContent, false);
             loop.stop();
         });
@@ -117,7 +117,7 @@ TEST(MBTilesFileSource, NonExistentTile) {
         [&](Response res) {
             req.reset();
             EXPECT_EQ(nullptr, res.error);
-            ASSERT_FALSE(res.data.get());
+            ASSERT_FALSE(res.data);
             ASSERT_EQ(res.noContent, true);
             loop.stop();
         });
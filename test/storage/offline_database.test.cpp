@@ -5,6 +5,7 @@
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/string.hpp>
 
@@ -28,6 +29,7 @@ static void deleteDatabaseFiles() {
     // Delete leftover journaling files as well.
     util::deleteFile(filename);
     util::deleteFile(filename + "-wal"s);
+    util::deleteFile(filename + "-shm"s);
     util::deleteFile(filename + "-journal"s);
 }
 
@@ -236,7 +238,7 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(SchemaVersion)) {
         OfflineDatabase db(filename, fixture::tileServerOptions);
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
 
     OfflineDatabase db(filename, fixture::tileServerOptions);
     // Now try inserting and reading back to make sure we have a valid database.
@@ -424,7 +426,7 @@ TEST(OfflineDatabase, PutResourceNoContent) {
     auto res = db.get(resource);
     EXPECT_EQ(nullptr, res->error);
     EXPECT_TRUE(res->noContent);
-    EXPECT_FALSE(res->data.get());
+    EXPECT_FALSE(res->data);
 
     EXPECT_EQ(0u, log.uncheckedCount());
 }
@@ -443,7 +445,7 @@ TEST(OfflineDatabase, PutTileNotFound) {
     auto res = db.get(resource);
     EXPECT_EQ(nullptr, res->error);
     EXPECT_TRUE(res->noContent);
-    EXPECT_FALSE(res->data.get());
+    EXPECT_FALSE(res->data);
 
     EXPECT_EQ(0u, log.uncheckedCount());
 }
@@ -1341,6 +1343,130 @@ TEST(OfflineDatabase, HasRegionResourceTile) {
     EXPECT_EQ(0u, log.uncheckedCount());
 }
 
+TEST(OfflineDatabase, RegionTileCursor) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+
+    OfflineTilePyramidRegionDefinition definition{"", LatLngBounds::world(), 0, INFINITY, 1.0, false};
+    auto region = db.createRegion(definition, OfflineRegionMetadata());
+    ASSERT_TRUE(region);
+
+    const std::string xyz = "http://a/{z}/{x}/{y}";
+    const std::string alt = "http://b/{z}/{x}/{y}";
+    EXPECT_FALSE(db.getRegionTileCursor(region->getID(), xyz));
+
+    Response response;
+    response.data = std::make_shared<std::string>("tile");
+    for (int8_t z = 0; z <= 2; ++z) {
+        for (int32_t x = 0; x < (1 << z); ++x) {
+            for (int32_t y = 0; y < (1 << z); ++y) {
+                db.putRegionResource(region->getID(), Resource::tile(xyz, 1, x, y, z, Tileset::Scheme::XYZ), response);
+                db.putRegionResource(region->getID(), Resource::tile(alt, 1, x, y, z, Tileset::Scheme::XYZ), response);
+            }
+        }
+    }
+
+    db.setRegionTileCursor(region->getID(), {.urlTemplate = xyz, .pixelRatio = 1, .z = 2, .position = 6});
+    auto cursor = db.getRegionTileCursor(region->getID(), xyz);
+    ASSERT_TRUE(cursor);
+    EXPECT_EQ(xyz, cursor->urlTemplate);
+    EXPECT_EQ(1, cursor->pixelRatio);
+    EXPECT_EQ(2, cursor->z);
+    EXPECT_EQ(6u, cursor->position);
+    EXPECT_FALSE(db.getRegionTileCursor(region->getID(), alt));
+
+    // Only tiles of the tileset below the cursor's zoom level are counted
+    EXPECT_EQ((std::pair<int64_t, int64_t>{5, 20}), db.getRegionTileCountAndSize(region->getID(), *cursor));
+
+    // Cursors move forward by replacing the previous one
+    db.setRegionTileCursor(region->getID(), {.urlTemplate = xyz, .pixelRatio = 1, .z = 2, .position = 9});
+    EXPECT_EQ(9u, db.getRegionTileCursor(region->getID(), xyz)->position);
+
+    const int64_t regionID = region->getID();
+    db.deleteRegion(std::move(*region));
+    EXPECT_FALSE(db.getRegionTileCursor(regionID, xyz));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, HasRegionResources) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+
+    OfflineTilePyramidRegionDefinition definition{"", LatLngBounds::world(), 0, INFINITY, 1.0, false};
+    auto region = db.createRegion(definition, OfflineRegionMetadata());
+    ASSERT_TRUE(region);
+
+    auto tile = [](const std::string& urlTemplate, int32_t x, int32_t y, int8_t z) {
+        return Resource::tile(urlTemplate, 1, x, y, z, Tileset::Scheme::XYZ);
+    };
+
+    Response response;
+    response.data = std::make_shared<std::string>("first");
+    db.putRegionResource(region->getID(), tile("http://a/{z}/{x}/{y}", 0, 0, 1), response);
+    db.putRegionResource(region->getID(), tile("http://a/{z}/{x}/{y}", 1, 1, 1), response);
+    db.putRegionResource(region->getID(), tile("http://b/{z}/{x}/{y}", 0, 1, 1), response);
+    db.putRegionResource(region->getID(), Resource::style("http://a/style.json"), response);
+
+    Response noContent;
+    noContent.noContent = true;
+    db.putRegionResource(region->getID(), tile("http://a/{z}/{x}/{y}", 1, 0, 1), noContent);
+
+    const std::vector<Resource> resources{tile("http://a/{z}/{x}/{y}", 0, 0, 1),
+                                          tile("http://a/{z}/{x}/{y}", 0, 1, 1),
+                                          tile("http://a/{z}/{x}/{y}", 1, 0, 1),
+                                          tile("http://a/{z}/{x}/{y}", 1, 1, 1),
+                                          tile("http://a/{z}/{x}/{y}", 0, 0, 0),
+                                          tile("http://b/{z}/{x}/{y}", 0, 1, 1),
+                                          Resource::style("http://a/style.json"),
+                                          Resource::style("http://b/style.json")};
+
+    const auto sizes = db.hasRegionResources(resources);
+    ASSERT_EQ(resources.size(), sizes.size());
+    for (std::size_t i = 0; i < resources.size(); ++i) {
+        EXPECT_EQ(db.hasRegionResource(resources[i]), sizes[i]) << resources[i].url;
+    }
+    EXPECT_EQ(5, sizes[0]);
+    EXPECT_FALSE(sizes[1]);
+    EXPECT_FALSE(sizes[4]);
+    EXPECT_EQ(5, sizes[5]);
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, HasRegionResourcesManyTiles) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+
+    OfflineTilePyramidRegionDefinition definition{"", LatLngBounds::world(), 0, INFINITY, 1.0, false};
+    auto region = db.createRegion(definition, OfflineRegionMetadata());
+    ASSERT_TRUE(region);
+
+    Response response;
+    response.data = std::make_shared<std::string>("tile");
+
+    // More tiles than fit into one lookup, scattered along a diagonal, every third one stored
+    std::vector<Resource> resources;
+    for (int32_t i = 0; i < 150; ++i) {
+        resources.push_back(Resource::tile("http://a/{z}/{x}/{y}", 1, i * 100, i * 90, 14, Tileset::Scheme::XYZ));
+        if (i % 3 == 0) {
+            db.putRegionResource(region->getID(), resources.back(), response);
+        }
+    }
+
+    const auto sizes = db.hasRegionResources(resources);
+    ASSERT_EQ(resources.size(), sizes.size());
+    for (std::size_t i = 0; i < resources.size(); ++i) {
+        if (i % 3 == 0) {
+            EXPECT_EQ(4, sizes[i]) << resources[i].url;
+        } else {
+            EXPECT_FALSE(sizes[i]) << resources[i].url;
+        }
+    }
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, OfflineMapboxTileCount) {
     FixtureLog log;
     OfflineDatabase db(":memory:", fixture::tileServerOptions);
@@ -1481,7 +1607,7 @@ TEST(OfflineDatabase, MigrateFromV2Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
     EXPECT_LT(databasePageCount(filename), databasePageCount("test/fixtures/offline_database/v2.db"));
 
     EXPECT_EQ(0u, log.uncheckedCount());
@@ -1503,7 +1629,7 @@ TEST(OfflineDatabase, MigrateFromV3Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
 
     EXPECT_EQ(0u, log.uncheckedCount());
 }
@@ -1525,7 +1651,7 @@ TEST(OfflineDatabase, MigrateFromV4Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
 
     // Journal mode should be DELETE after migration to v5.
     EXPECT_EQ("delete", databaseJournalMode(filename));
@@ -1552,7 +1678,7 @@ TEST(OfflineDatabase, MigrateFromV5Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
 
     EXPECT_EQ((std::vector<std::string>{"id",
                                         "url_template",
@@ -1572,6 +1698,10 @@ TEST(OfflineDatabase, MigrateFromV5Schema) {
         (std::vector<std::string>{
             "id", "url", "kind", "expires", "modified", "etag", "data", "compressed", "accessed", "must_revalidate"}),
         databaseTableColumns(filename, "resources"));
+    EXPECT_EQ((std::vector<std::string>{"region_id", "url_template", "pixel_ratio", "z", "position"}),
+              databaseTableColumns(filename, "region_tile_cursors"));
+    EXPECT_EQ((std::vector<std::string>{"codec", "id", "dictionary"}),
+              databaseTableColumns(filename, "compression_dictionaries"));
 
     EXPECT_EQ(0u, log.uncheckedCount());
 }
@@ -1609,7 +1739,7 @@ TEST(OfflineDatabase, DowngradeSchema) {
         db.setMaximumAmbientCacheSize(0);
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(8, databaseUserVersion(filename));
 
     EXPECT_EQ((std::vector<std::string>{"id",
                                         "url_template",
@@ -1629,6 +1759,8 @@ TEST(OfflineDatabase, DowngradeSchema) {
         (std::vector<std::string>{
             "id", "url", "kind", "expires", "modified", "etag", "data", "compressed", "accessed", "must_revalidate"}),
         databaseTableColumns(filename, "resources"));
+    EXPECT_EQ((std::vector<std::string>{"region_id", "url_template", "pixel_ratio", "z", "position"}),
+              databaseTableColumns(filename, "region_tile_cursors"));
 
     EXPECT_EQ(
         1u,
@@ -2086,3 +2218,236 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(UpdateDatabaseReadOnlyMode)) {
 
     EXPECT_EQ(0u, log.uncheckedCount());
 }
+
+static int64_t databaseResourceCount(const std::string& path) {
+    mapbox::sqlite::Database db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly);
+    mapbox::sqlite::Statement stmt{db, "SELECT COUNT(*) FROM resources"};
+    mapbox::sqlite::Query query{stmt};
+    query.run();
+    return query.get<int64_t>(0);
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(WriteBatching)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    OfflineDatabase db(filename, fixture::tileServerOptions);
+    db.setWriteBatching(OfflineDatabase::WriteBatching{.maxPendingWrites = 3, .maxDelay = std::chrono::hours(1)});
+    EXPECT_EQ("wal", databaseJournalMode(filename));
+
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+
+    db.put(Resource::style("http://example.com/1"), response);
+    db.put(Resource::style("http://example.com/2"), response);
+    EXPECT_TRUE(db.hasPendingWrites());
+
+    // Pending writes are visible to this connection only.
+    EXPECT_EQ("data", *db.get(Resource::style("http://example.com/1"))->data);
+    EXPECT_EQ(0, databaseResourceCount(filename));
+
+    // Reaching the batch size commits.
+    db.put(Resource::style("http://example.com/3"), response);
+    EXPECT_FALSE(db.hasPendingWrites());
+    EXPECT_EQ(3, databaseResourceCount(filename));
+
+    db.put(Resource::style("http://example.com/4"), response);
+    db.flushPendingWrites();
+    EXPECT_FALSE(db.hasPendingWrites());
+    EXPECT_EQ(4, databaseResourceCount(filename));
+
+    db.setWriteBatching(std::nullopt);
+    EXPECT_EQ("delete", databaseJournalMode(filename));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(WriteBatchingCommitsBeforeRegionWrites)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    OfflineDatabase db(filename, fixture::tileServerOptions);
+    db.setWriteBatching(OfflineDatabase::WriteBatching{.maxPendingWrites = 100, .maxDelay = std::chrono::hours(1)});
+
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+    db.put(Resource::style("http://example.com/ambient"), response);
+    EXPECT_TRUE(db.hasPendingWrites());
+
+    OfflineTilePyramidRegionDefinition definition{"http://example.com/style", LatLngBounds::world(), 0, 0, 1.0, false};
+    auto region = db.createRegion(definition, OfflineRegionMetadata());
+    ASSERT_TRUE(region);
+    db.putRegionResource(region->getID(), Resource::style("http://example.com/region"), response);
+
+    EXPECT_FALSE(db.hasPendingWrites());
+    EXPECT_EQ(2, databaseResourceCount(filename));
+
+    // Batching survives reopening the database.
+    db.changePath(filename);
+    EXPECT_EQ("wal", databaseJournalMode(filename));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+#ifndef __QT__ // Qt doesn't expose the ability to register virtual file system handlers.
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(WriteBatchingKeepsRegionsOnFailedPut)) {
+    FixtureLog log;
+    test::SQLite3TestFS fs;
+    deleteDatabaseFiles();
+
+    OfflineDatabase db(filename_test_fs, fixture::tileServerOptions);
+    db.setWriteBatching(OfflineDatabase::WriteBatching{.maxPendingWrites = 100, .maxDelay = std::chrono::hours(1)});
+
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+    db.put(Resource::style("http://example.com/ambient"), response);
+    EXPECT_TRUE(db.hasPendingWrites());
+
+    OfflineTilePyramidRegionDefinition definition{"http://example.com/style", LatLngBounds::world(), 0, 0, 1.0, false};
+    auto region = db.createRegion(definition, OfflineRegionMetadata());
+    ASSERT_TRUE(region);
+
+    // A resource larger than the page cache has to be spilled to disk before
+    // the batch is committed, so the put itself fails and drops the batch.
+    Response large;
+    large.data = std::make_shared<std::string>(8 * 1024 * 1024, '\0');
+    fs.setWriteLimit(0);
+    EXPECT_EQ(std::make_pair(false, uint64_t(0)), db.put(Resource::style("http://example.com/large"), large));
+    EXPECT_EQ(1u, log.count(warning(ResultCode::Full, "Can't write resource: database or disk is full")));
+    EXPECT_FALSE(db.hasPendingWrites());
+    fs.setWriteLimit(-1);
+
+    auto regions = db.listRegions().value();
+    ASSERT_EQ(1u, regions.size());
+    EXPECT_EQ(region->getID(), regions[0].getID());
+    EXPECT_EQ(1, databaseResourceCount(filename));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(WriteBatchingReplaysBatchOnFailedPut)) {
+    FixtureLog log;
+    test::SQLite3TestFS fs;
+    deleteDatabaseFiles();
+
+    OfflineDatabase db(filename_test_fs, fixture::tileServerOptions);
+    db.setWriteBatching(OfflineDatabase::WriteBatching{.maxPendingWrites = 100, .maxDelay = std::chrono::hours(1)});
+
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+    db.put(Resource::style("http://example.com/1"), response);
+    db.put(Resource::style("http://example.com/2"), response);
+
+    Response large;
+    large.data = std::make_shared<std::string>(8 * 1024 * 1024, '\0');
+    fs.setWriteLimit(0);
+    EXPECT_EQ(std::make_pair(false, uint64_t(0)), db.put(Resource::style("http://example.com/large"), large));
+    EXPECT_EQ(1u, log.count(warning(ResultCode::Full, "Can't write resource: database or disk is full")));
+    fs.setWriteLimit(-1);
+
+    // The writes that succeeded before the failing one are still pending.
+    EXPECT_TRUE(db.hasPendingWrites());
+    EXPECT_EQ("data", *db.get(Resource::style("http://example.com/2"))->data);
+    EXPECT_FALSE(db.get(Resource::style("http://example.com/large")));
+
+    db.flushPendingWrites();
+    EXPECT_EQ(2, databaseResourceCount(filename));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+#endif // __QT__
+
+TEST(OfflineDatabase, Compression) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+
+    std::vector<std::string> samples;
+    for (int i = 0; i < 16; ++i) {
+        std::string sample;
+        for (int feature = 0; feature < 20; ++feature) {
+            sample += R"({"type":"Feature","properties":{"class":"primary","name":"Street )" +
+                      util::toString(i * 20 + feature) + R"("}})";
+        }
+        samples.push_back(std::move(sample));
+    }
+    const auto dictionary = std::make_shared<const std::string>(
+        util::trainDictionary(util::Codec::Zlib, samples, 16 * 1024));
+
+    Response response;
+    response.data = std::make_shared<std::string>(samples.front());
+
+    const Resource plain = Resource::style("http://example.com/plain");
+    const Resource primed = Resource::style("http://example.com/primed");
+    const Resource uncompressed = Resource::style("http://example.com/uncompressed");
+
+    const auto plainSize = db.put(plain, response).second;
+    EXPECT_EQ(nullptr, db.setCompression(util::Codec::Zlib, dictionary));
+    const auto primedSize = db.put(primed, response).second;
+    EXPECT_LT(primedSize, plainSize);
+
+    EXPECT_EQ(nullptr, db.setCompression(util::Codec::None));
+    EXPECT_EQ(response.data->size(), db.put(uncompressed, response).second);
+
+    // Every row records its own codec.
+    EXPECT_EQ(samples.front(), *db.get(plain)->data);
+    EXPECT_EQ(samples.front(), *db.get(primed)->data);
+    EXPECT_EQ(samples.front(), *db.get(uncompressed)->data);
+
+    if (!util::isAvailable(util::Codec::Zstd)) {
+        EXPECT_NE(nullptr, db.setCompression(util::Codec::Zstd));
+        EXPECT_EQ(1u,
+                  log.count({EventSeverity::Error,
+                             Event::Database,
+                             -1,
+                             "Can't set compression: Compression codec is not available in this build"}));
+    }
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(CompressionDictionaryPersisted)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    std::vector<std::string> samples;
+    for (int i = 0; i < 16; ++i) {
+        samples.push_back(R"({"name":"Street )" + util::toString(i) + R"(","class":"primary","oneway":false})");
+    }
+    const auto dictionary = std::make_shared<const std::string>(
+        util::trainDictionary(util::Codec::Zlib, samples, 16 * 1024));
+
+    Response response;
+    response.data = std::make_shared<std::string>(samples.front() + samples.back());
+    const Resource resource = Resource::style("http://example.com/");
+
+    {
+        OfflineDatabase db(filename, fixture::tileServerOptions);
+        EXPECT_EQ(nullptr, db.setCompression(util::Codec::Zlib, dictionary));
+        db.put(resource, response);
+    }
+
+    {
+        // The dictionary is loaded with the database.
+        OfflineDatabase db(filename, fixture::tileServerOptions);
+        EXPECT_EQ(*response.data, *db.get(resource)->data);
+    }
+
+    {
+        mapbox::sqlite::Database db = mapbox::sqlite::Database::open(filename, mapbox::sqlite::ReadWriteCreate);
+        db.exec("DELETE FROM compression_dictionaries");
+    }
+
+    OfflineDatabase db(filename, fixture::tileServerOptions);
+    EXPECT_FALSE(db.get(resource));
+    EXPECT_EQ(1u,
+              log.count({EventSeverity::Error,
+                         Event::Database,
+                         -1,
+                         "Can't read resource: missing zlib compression dictionary " +
+                             util::toString(util::dictionaryID(util::Codec::Zlib, *dictionary))}));
+
+    db.addCompressionDictionary(util::Codec::Zlib, dictionary);
+    EXPECT_EQ(*response.data, *db.get(resource)->data);
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
@@ -15,10 +15,13 @@
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/compression.hpp>
 #include <mbgl/util/string.hpp>
+#include <mbgl/util/tile_cover.hpp>
 
 #include <mbgl/storage/sqlite3.hpp>
 #include <gtest/gtest.h>
 
+#include <set>
+
 using namespace mbgl;
 using namespace std::literals::string_literals;
 using mapbox::sqlite::ResultCode;
@@ -674,6 +677,174 @@ TEST(OfflineDownload, WithPreviouslyExistingTile) {
     test.loop.run();
 }
 
+TEST(OfflineDownload, SkipsStoredTilesAcrossChunks) {
+    OfflineTest test;
+    auto region = test.createRegion();
+    ASSERT_TRUE(region);
+    OfflineDownload download(region->getID(),
+                             OfflineTilePyramidRegionDefinition(
+                                 "http://127.0.0.1:3000/style.json", LatLngBounds::world(), 0.0, 5.0, 1.0, false),
+                             test.db,
+                             test.fileSource);
+
+    test.fileSource.styleResponse = [&](const Resource&) {
+        return test.response("inline_source.style.json");
+    };
+
+    // Every tile on zoom level 4; more than one batch of tiles is checked before and after them.
+    for (int32_t x = 0; x < 16; ++x) {
+        for (int32_t y = 0; y < 16; ++y) {
+            test.db.put(
+                Resource::tile("http://127.0.0.1:3000/{z}-{x}-{y}.vector.pbf", 1, x, y, 4, Tileset::Scheme::XYZ),
+                test.response("0-0-0.vector.pbf"));
+        }
+    }
+
+    uint64_t tileRequests = 0;
+    test.fileSource.tileResponse = [&](const Resource& resource) {
+        EXPECT_NE(4, resource.tileData->z);
+        ++tileRequests;
+        return test.response("0-0-0.vector.pbf");
+    };
+
+    auto observer = std::make_unique<MockObserver>();
+    observer->statusChangedFn = [&](OfflineRegionStatus status) {
+        if (status.complete()) {
+            EXPECT_EQ(1365u, status.requiredTileCount);
+            EXPECT_EQ(1365u, status.completedTileCount);
+            EXPECT_EQ(1366u, status.completedResourceCount);
+            EXPECT_TRUE(status.requiredResourceCountIsPrecise);
+            test.loop.stop();
+        }
+    };
+
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+
+    test.loop.run();
+
+    EXPECT_EQ(1365u - 256u, tileRequests);
+}
+
+TEST(OfflineDownload, ResumesFromTileCursor) {
+    OfflineTest test;
+    auto region = test.createRegion();
+    ASSERT_TRUE(region);
+    const OfflineTilePyramidRegionDefinition definition(
+        "http://127.0.0.1:3000/style.json", LatLngBounds::world(), 0.0, 3.0, 1.0, false);
+
+    test.fileSource.styleResponse = [&](const Resource&) {
+        return test.response("inline_source.style.json");
+    };
+
+    uint64_t tileRequests = 0;
+    test.fileSource.tileResponse = [&](const Resource&) {
+        ++tileRequests;
+        return test.response("0-0-0.vector.pbf");
+    };
+
+    OfflineRegionStatus completed;
+    auto observer = std::make_unique<MockObserver>();
+    observer->statusChangedFn = [&](OfflineRegionStatus status) {
+        if (status.complete()) {
+            completed = status;
+            test.loop.stop();
+        }
+    };
+
+    OfflineDownload download(region->getID(), definition, test.db, test.fileSource);
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+    test.loop.run();
+
+    EXPECT_EQ(85u, tileRequests);
+    EXPECT_EQ(85u, completed.completedTileCount);
+
+    // The cursor is the last tile of the cover
+    auto cursor = test.db.getRegionTileCursor(region->getID(), "http://127.0.0.1:3000/{z}-{x}-{y}.vector.pbf");
+    ASSERT_TRUE(cursor);
+    EXPECT_EQ(3, cursor->z);
+    EXPECT_EQ(63u, cursor->position);
+
+    OfflineRegionStatus resumed;
+    observer = std::make_unique<MockObserver>();
+    observer->statusChangedFn = [&](OfflineRegionStatus status) {
+        if (status.complete()) {
+            resumed = status;
+            test.loop.stop();
+        }
+    };
+
+    OfflineDownload redownload(region->getID(), definition, test.db, test.fileSource);
+    redownload.setObserver(std::move(observer));
+    redownload.setState(OfflineRegionDownloadState::Active);
+    test.loop.run();
+
+    EXPECT_EQ(85u, tileRequests);
+    EXPECT_EQ(completed.requiredResourceCount, resumed.requiredResourceCount);
+    EXPECT_EQ(completed.completedResourceCount, resumed.completedResourceCount);
+    EXPECT_EQ(completed.completedTileCount, resumed.completedTileCount);
+    EXPECT_EQ(completed.completedTileSize, resumed.completedTileSize);
+}
+
+TEST(OfflineDownload, ResumesFromTileCursorAcrossAntimeridian) {
+    OfflineTest test;
+    auto region = test.createRegion();
+    ASSERT_TRUE(region);
+    const auto bounds = LatLngBounds::hull({-20.9615, -214.309}, {19.477, -155.830});
+    const OfflineTilePyramidRegionDefinition definition(
+        "http://127.0.0.1:3000/style.json", bounds, 4.0, 4.0, 1.0, false);
+    const std::string urlTemplate = "http://127.0.0.1:3000/{z}-{x}-{y}.vector.pbf";
+
+    // Rows of the cover run from x = 14 over the antimeridian to x = 1, so canonical
+    // coordinates don't follow cover order. Store the first two tiles of the cover.
+    std::vector<CanonicalTileID> cover;
+    util::TileCover tileCover(bounds, 4);
+    while (tileCover.hasNext()) {
+        cover.push_back(tileCover.next()->canonical);
+    }
+    ASSERT_EQ(8u, cover.size());
+
+    for (std::size_t i = 0; i < 2; ++i) {
+        const auto& tile = cover[i];
+        test.db.putRegionResource(
+            region->getID(),
+            Resource::tile(urlTemplate, 1.0, tile.x, tile.y, tile.z, Tileset::Scheme::XYZ),
+            test.response("0-0-0.vector.pbf"));
+    }
+    test.db.setRegionTileCursor(region->getID(), {.urlTemplate = urlTemplate, .pixelRatio = 1, .z = 4, .position = 1});
+
+    test.fileSource.styleResponse = [&](const Resource&) {
+        return test.response("inline_source.style.json");
+    };
+
+    std::set<CanonicalTileID> requested;
+    test.fileSource.tileResponse = [&](const Resource& resource) {
+        const auto& tile = *resource.tileData;
+        requested.emplace(tile.z, tile.x, tile.y);
+        return test.response("0-0-0.vector.pbf");
+    };
+
+    OfflineRegionStatus completed;
+    auto observer = std::make_unique<MockObserver>();
+    observer->statusChangedFn = [&](OfflineRegionStatus status) {
+        if (status.complete()) {
+            completed = status;
+            test.loop.stop();
+        }
+    };
+
+    OfflineDownload download(region->getID(), definition, test.db, test.fileSource);
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+    test.loop.run();
+
+    // Every tile after the cursor is fetched, including those west of the stored ones
+    EXPECT_EQ(std::set<CanonicalTileID>(cover.begin() + 2, cover.end()), requested);
+    EXPECT_EQ(8u, completed.completedTileCount);
+    EXPECT_EQ(7u, test.db.getRegionTileCursor(region->getID(), urlTemplate)->position);
+}
+
 TEST(OfflineDownload, ReactivatePreviouslyCompletedDownload) {
     OfflineTest test;
     auto region = test.createRegion();
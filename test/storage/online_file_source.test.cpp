@@ -41,7 +41,7 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(CancelMultiple)) {
     std::unique_ptr<AsyncRequest> req = fs->request(resource, [&](Response res) {
         req.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("Hello World!", *res.data);
         EXPECT_FALSE(bool(res.expires));
         EXPECT_FALSE(res.mustRevalidate);
@@ -80,7 +80,7 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(TemporaryError)) {
                 EXPECT_LT(0.99, duration) << "Backoff timer didn't wait 1 second";
                 EXPECT_GT(1.2, duration) << "Backoff timer fired too late";
                 EXPECT_EQ(nullptr, res.error);
-                ASSERT_TRUE(res.data.get());
+                ASSERT_TRUE(res.data);
                 EXPECT_EQ("Hello World!", *res.data);
                 EXPECT_FALSE(bool(res.expires));
                 EXPECT_FALSE(res.mustRevalidate);
@@ -108,7 +108,7 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(ConnectionError)) {
         EXPECT_GT(wait + 0.3, duration) << "Backoff timer fired too late";
         ASSERT_NE(nullptr, res.error);
         EXPECT_EQ(Response::Error::Reason::Connection, res.error->reason);
-        ASSERT_FALSE(res.data.get());
+        ASSERT_FALSE(res.data);
         EXPECT_FALSE(bool(res.expires));
         EXPECT_FALSE(res.mustRevalidate);
         EXPECT_FALSE(bool(res.modified));
@@ -135,7 +135,7 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(Timeout)) {
     std::unique_ptr<AsyncRequest> req = fs->request(resource, [&](Response res) {
         counter++;
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("Hello World!", *res.data);
         EXPECT_TRUE(bool(res.expires));
         EXPECT_FALSE(res.mustRevalidate);
@@ -259,7 +259,7 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(Load)) {
                               [&, i, current](Response res) {
                                   reqs[i].reset();
                                   EXPECT_EQ(nullptr, res.error);
-                                  ASSERT_TRUE(res.data.get());
+                                  ASSERT_TRUE(res.data);
                                   EXPECT_EQ(std::string("Request ") + util::toString(current), *res.data);
                                   EXPECT_FALSE(bool(res.expires));
                                   EXPECT_FALSE(res.mustRevalidate);
@@ -298,7 +298,7 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(NetworkStatusChange)) {
     std::unique_ptr<AsyncRequest> req = fs->request(resource, [&](Response res) {
         req.reset();
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
         EXPECT_EQ("Response", *res.data);
         EXPECT_FALSE(bool(res.expires));
         EXPECT_FALSE(res.mustRevalidate);
@@ -340,7 +340,7 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(NetworkStatusChangePreempt)) {
         }
         ASSERT_NE(nullptr, res.error);
         EXPECT_EQ(Response::Error::Reason::Connection, res.error->reason);
-        ASSERT_FALSE(res.data.get());
+        ASSERT_FALSE(res.data);
         EXPECT_FALSE(bool(res.expires));
         EXPECT_FALSE(res.mustRevalidate);
         EXPECT_FALSE(bool(res.modified));
@@ -381,7 +381,7 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(NetworkStatusOnlineOffline)) {
         req.reset();
 
         EXPECT_EQ(nullptr, res.error);
-        ASSERT_TRUE(res.data.get());
+        ASSERT_TRUE(res.data);
 
         EXPECT_EQ(NetworkStatus::Get(), NetworkStatus::Status::Online) << "Triggered before set back to Online";
 
@@ -630,3 +630,31 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(RequestSameUrlMultipleTimes)) {
 
     loop.run();
 }
+
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(CoalesceIdenticalRequests)) {
+    util::RunLoop loop;
+    std::unique_ptr<FileSource> fs = std::make_unique<OnlineFileSource>(ResourceOptions::Default(), ClientOptions());
+
+    // Queue all requests before the file source thread sees the first one
+    fs->pause();
+
+    int count = 0;
+    std::vector<std::unique_ptr<AsyncRequest>> requests;
+
+    for (int i = 0; i < 10; ++i) {
+        requests.emplace_back(fs->request({Resource::Unknown, "http://127.0.0.1:3000/test"}, [&](Response res) {
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(res.data);
+            EXPECT_EQ("Hello World!", *res.data);
+            if (++count == 10) {
+                loop.stop();
+            }
+        }));
+    }
+
+    fs->resume();
+    loop.run();
+
+    EXPECT_EQ(1u, *fs->getProperty(TRANSFER_COUNT_KEY).getUint());
+    EXPECT_EQ(9u, *fs->getProperty(COALESCED_REQUEST_COUNT_KEY).getUint());
+}
@@ -40,7 +40,7 @@ TEST(PMTilesFileSource, NonExistentFile) {
             ASSERT_NE(nullptr, res.error);
             EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
             EXPECT_NE((res.error->message).find("path not found"), std::string::npos);
-            ASSERT_FALSE(res.data.get());
+            ASSERT_FALSE(res.data);
             loop.stop();
         });
 
@@ -57,7 +57,7 @@ TEST(PMTilesFileSource, TileJSON) {
         {Resource::Unknown, toAbsoluteURL("geography-class-png.pmtiles")}, [&](Response res) {
             req.reset();
             EXPECT_EQ(nullptr, res.error);
-            ASSERT_TRUE(res.data.get());
+            ASSERT_TRUE(res.data);
             // basic test that TileJSON included a tile URL
             EXPECT_NE((*res.data).find("geography-class-png.pmtiles"), std::string::npos);
             loop.stop();
@@ -77,7 +77,7 @@ TEST(PMTilesFileSource, Tile) {
         [&](Response res) {
             req.reset();
             EXPECT_EQ(nullptr, res.error);
-            ASSERT_TRUE(res.data.get());
+            ASSERT_TRUE(res.data);
             ASSERT_EQ(res.noContent, false);
             loop.stop();
         });
@@ -96,7 +96,7 @@ TEST(PMTilesFileSource, NonExistentTile) {
         [&](Response res) {
             req.reset();
             EXPECT_EQ(nullptr, res.error);
-            ASSERT_FALSE(res.data.get());
+            ASSERT_FALSE(res.data);
             ASSERT_EQ(res.noContent, true);
             loop.stop();
         });
@@ -163,7 +163,7 @@ TEST(PMTilesFileSource, RepeatedTileRequest) {
         [&](Response res1) {
             req1.reset();
             ASSERT_EQ(nullptr, res1.error);
-            ASSERT_TRUE(res1.data.get());
+            ASSERT_TRUE(res1.data);
             const auto firstSize = res1.data->size();
 
             req2 = pmtiles.request(
@@ -171,7 +171,7 @@ TEST(PMTilesFileSource, RepeatedTileRequest) {
                 [&, firstSize](Response res2) {
                     req2.reset();
                     EXPECT_EQ(nullptr, res2.error);
-                    ASSERT_TRUE(res2.data.get());
+                    ASSERT_TRUE(res2.data);
                     EXPECT_EQ(firstSize, res2.data->size());
                     loop.stop();
                 });
@@ -180,6 +180,39 @@ TEST(PMTilesFileSource, RepeatedTileRequest) {
     loop.run();
 }
 
+// Uncompressed tiles of a local archive are slices of the memory mapping. A
+// buffer still in use keeps the archive open, so the next request of the same
+// tile gets the same bytes.
+TEST(PMTilesFileSource, LocalTileSharesMapping) {
+    util::RunLoop loop;
+
+    PMTilesFileSource pmtiles(ResourceOptions::Default(), ClientOptions());
+    const auto resource = Resource::tile(
+        toAbsoluteURL("geography-class-png.pmtiles"), 1.0, 0, 0, 0, Tileset::Scheme::XYZ);
+
+    SharedBuffer first;
+    std::unique_ptr<AsyncRequest> req1;
+    std::unique_ptr<AsyncRequest> req2;
+
+    req1 = pmtiles.request(resource, [&](Response res1) {
+        req1.reset();
+        ASSERT_EQ(nullptr, res1.error);
+        ASSERT_TRUE(res1.data);
+        first = res1.data;
+
+        req2 = pmtiles.request(resource, [&](Response res2) {
+            req2.reset();
+            EXPECT_EQ(nullptr, res2.error);
+            ASSERT_TRUE(res2.data);
+            EXPECT_EQ(first.data(), res2.data.data());
+            EXPECT_EQ(*first, *res2.data);
+            loop.stop();
+        });
+    });
+
+    loop.run();
+}
+
 // An archive whose header flags tile_compression=GZIP but whose individual tiles are stored
 // without compression must be served without error (uncompressed bytes passed through as-is).
 TEST(PMTilesFileSource, UncompressedTile) {
@@ -192,10 +225,71 @@ TEST(PMTilesFileSource, UncompressedTile) {
         [&](Response res) {
             req.reset();
             EXPECT_EQ(nullptr, res.error);
-            ASSERT_TRUE(res.data.get());
+            ASSERT_TRUE(res.data);
             ASSERT_EQ(res.noContent, false);
             loop.stop();
         });
 
     loop.run();
 }
+
+// Tiles from local archives are read on the I/O pool, several requests may be in flight at once
+TEST(PMTilesFileSource, ConcurrentTiles) {
+    util::RunLoop loop;
+
+    PMTilesFileSource pmtiles(ResourceOptions::Default(), ClientOptions());
+
+    std::vector<std::unique_ptr<AsyncRequest>> requests;
+    std::size_t pending = 0;
+    for (int32_t x = 0; x < 2; ++x) {
+        for (int32_t y = 0; y < 2; ++y) {
+            ++pending;
+            requests.push_back(pmtiles.request(
+                Resource::tile(toAbsoluteURL("geography-class-png.pmtiles"), 1.0, x, y, 1, Tileset::Scheme::XYZ),
+                [&](Response res) {
+                    EXPECT_EQ(nullptr, res.error);
+                    if (--pending == 0) {
+                        loop.stop();
+                    }
+                }));
+        }
+    }
+
+    loop.run();
+    EXPECT_EQ(0u, pending);
+}
+
+// Decoded directories are cached, a second lookup in the same archive does not decode them again
+TEST(PMTilesFileSource, DirectoryCache) {
+    util::RunLoop loop;
+
+    PMTilesFileSource pmtiles(ResourceOptions::Default(), ClientOptions());
+
+    std::unique_ptr<AsyncRequest> req;
+    auto requestTile = [&](std::function<void()> next) {
+        req = pmtiles.request(
+            Resource::tile(toAbsoluteURL("geography-class-png.pmtiles"), 1.0, 0, 0, 0, Tileset::Scheme::XYZ),
+            [&, next](Response res) {
+                req.reset();
+                EXPECT_EQ(nullptr, res.error);
+                next();
+            });
+    };
+
+    requestTile([&] {
+        const auto first = pmtiles.getDirectoryCacheStats();
+        EXPECT_EQ(0u, first.hits);
+        EXPECT_LT(0u, first.misses);
+        EXPECT_LT(0u, first.entries);
+        EXPECT_LT(0u, first.bytes);
+
+        requestTile([&, first] {
+            const auto second = pmtiles.getDirectoryCacheStats();
+            EXPECT_EQ(first.misses, second.misses);
+            EXPECT_EQ(first.misses, second.hits);
+            loop.stop();
+        });
+    });
+
+    loop.run();
+}
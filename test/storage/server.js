@@ -1,4 +1,5 @@
 import express from "express";
+import http2 from "node:http2";
 import path from "node:path";
 
 if (!import.meta.dirname) throw new Error("Could not get import.meta.dirname. Use Node.js 20.11 or newer.");
@@ -186,11 +187,39 @@ app.get('/online/*style', function(req, res) {
     // res.send('Request ' + req.params.style);
 });
 
-var server = app.listen(3000, function (error) {
-    if (error) {
-        process.stderr.write('Failed to start server: ' + error.message + '\n');
-        process.exit(1);
+// Cleartext HTTP/2 (h2c) server on port 3001, which counts the connections made to it.
+var http2Connections = 0;
+var http2Server = http2.createServer();
+http2Server.on('session', function() {
+    http2Connections++;
+});
+http2Server.on('stream', function(stream, headers) {
+    const requestPath = headers[':path'];
+    const load = /^\/load\/(\d+)$/.exec(requestPath);
+    if (requestPath === '/connections') {
+        stream.respond({ ':status': 200 });
+        stream.end(String(http2Connections));
+    } else if (load) {
+        stream.respond({ ':status': 200 });
+        stream.end('Request ' + load[1]);
+    } else {
+        stream.respond({ ':status': 404 });
+        stream.end();
     }
-    // Tell parent that we're now listening.
-    process.stdout.write("OK");
+});
+
+http2Server.on('error', function (error) {
+    process.stderr.write('Failed to start HTTP/2 server: ' + error.message + '\n');
+    process.exit(1);
+});
+
+http2Server.listen(3001, function () {
+    var server = app.listen(3000, function (error) {
+        if (error) {
+            process.stderr.write('Failed to start server: ' + error.message + '\n');
+            process.exit(1);
+        }
+        // Tell parent that we're now listening.
+        process.stdout.write("OK");
+    });
 });
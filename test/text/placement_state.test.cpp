@@ -0,0 +1,135 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/text/placement_state.hpp>
+
+#include <map>
+
+using namespace mbgl;
+
+TEST(PlacementStateTable, Placements) {
+    PlacementStateTable table;
+    EXPECT_FALSE(table.getPlacement(1));
+
+    table.setPlacement(1, JointPlacement(true, false, true));
+    table.setPlacement(100000, JointPlacement(false, true, false));
+
+    const auto placement = table.getPlacement(1);
+    ASSERT_TRUE(placement);
+    EXPECT_TRUE(placement->text);
+    EXPECT_FALSE(placement->icon);
+    EXPECT_TRUE(placement->skipFade);
+
+    // Overwriting replaces all flags
+    table.setPlacement(1, JointPlacement(false, false, false));
+    EXPECT_FALSE(table.getPlacement(1)->placed());
+    EXPECT_FALSE(table.getPlacement(1)->skipFade);
+
+    table.erasePlacement(1);
+    EXPECT_FALSE(table.getPlacement(1));
+    EXPECT_TRUE(table.getPlacement(100000));
+    // Neighbouring slots of the same page are empty
+    EXPECT_FALSE(table.getPlacement(2));
+    EXPECT_FALSE(table.getPlacement(99999));
+}
+
+TEST(PlacementStateTable, Columns) {
+    PlacementStateTable table;
+
+    JointOpacityState opacity(true, false, true);
+    opacity.icon.opacity = 0.5f;
+    table.setOpacity(7, opacity);
+    EXPECT_FALSE(table.getPlacement(7));
+    const auto found = table.getOpacity(7);
+    ASSERT_TRUE(found);
+    EXPECT_EQ(1.0f, found->text.opacity);
+    EXPECT_TRUE(found->text.placed);
+    EXPECT_EQ(0.5f, found->icon.opacity);
+    EXPECT_FALSE(found->icon.placed);
+
+    EXPECT_TRUE(table.emplaceOrientation(7, style::TextWritingModeType::Vertical));
+    EXPECT_FALSE(table.emplaceOrientation(7, style::TextWritingModeType::Horizontal));
+    EXPECT_EQ(style::TextWritingModeType::Vertical, table.getOrientation(7));
+    table.setOrientation(7, style::TextWritingModeType::Horizontal);
+    EXPECT_EQ(style::TextWritingModeType::Horizontal, table.getOrientation(7));
+
+    const VariableOffset offset{.offset = {{1.0f, 2.0f}},
+                                .width = 10.0f,
+                                .height = 5.0f,
+                                .anchor = style::SymbolAnchorType::Top,
+                                .textBoxScale = 1.0f,
+                                .prevAnchor = std::nullopt};
+    EXPECT_FALSE(table.getVariableOffset(7));
+    EXPECT_TRUE(table.emplaceVariableOffset(7, offset));
+    EXPECT_FALSE(table.emplaceVariableOffset(7, VariableOffset{offset}));
+    ASSERT_TRUE(table.getVariableOffset(7));
+    EXPECT_EQ(style::SymbolAnchorType::Top, table.getVariableOffset(7)->anchor);
+    EXPECT_EQ(10.0f, table.getVariableOffset(7)->width);
+}
+
+TEST(PlacementStateTable, ForEach) {
+    PlacementStateTable table;
+    for (uint32_t id = 1; id < 2000; id += 3) {
+        table.setPlacement(id, JointPlacement(id % 2 == 0, true, false));
+    }
+    table.erasePlacement(4);
+
+    std::map<uint32_t, bool> visited;
+    table.forEachPlacement([&](uint32_t id, const JointPlacement& placement) {
+        EXPECT_EQ(id % 2 == 0, placement.text);
+        EXPECT_TRUE(visited.emplace(id, placement.text).second);
+        // Updating the visited ID is allowed
+        table.setOpacity(id, JointOpacityState(placement.text, placement.icon, true));
+    });
+    EXPECT_EQ(666u, visited.size());
+    EXPECT_FALSE(visited.contains(4));
+
+    std::size_t opacities = 0;
+    table.forEachOpacity([&](uint32_t id, const JointOpacityState& opacity) {
+        EXPECT_TRUE(visited.contains(id));
+        EXPECT_EQ(1.0f, opacity.icon.opacity);
+        ++opacities;
+    });
+    EXPECT_EQ(visited.size(), opacities);
+}
+
+TEST(PlacementStateTable, Merge) {
+    PlacementStateTable table;
+    table.setPlacement(1, JointPlacement(true, true, false));
+
+    PlacementStateTable other;
+    other.setPlacement(1, JointPlacement(false, false, false));
+    other.setPlacement(2, JointPlacement(false, true, true));
+    other.setOrientation(1, style::TextWritingModeType::Vertical);
+
+    table.merge(other);
+    // Existing state wins
+    EXPECT_TRUE(table.getPlacement(1)->text);
+    EXPECT_EQ(style::TextWritingModeType::Vertical, table.getOrientation(1));
+    ASSERT_TRUE(table.getPlacement(2));
+    EXPECT_TRUE(table.getPlacement(2)->icon);
+    EXPECT_TRUE(table.getPlacement(2)->skipFade);
+}
+
+TEST(PlacementStateTable, Reuse) {
+    {
+        PlacementStateTable table;
+        table.setPlacement(5, JointPlacement(true, true, true));
+        table.setOpacity(5, JointOpacityState(true, true, true));
+
+        table.clear();
+        EXPECT_FALSE(table.getPlacement(5));
+        EXPECT_FALSE(table.getOpacity(5));
+        table.forEachOpacity([](uint32_t, const JointOpacityState&) { FAIL(); });
+
+        table.setPlacement(5, JointPlacement(false, true, false));
+        EXPECT_FALSE(table.getOpacity(5));
+        EXPECT_TRUE(table.getPlacement(5)->icon);
+    }
+
+    // The pages of the destroyed table are recycled, without its state
+    PlacementStateTable table;
+    EXPECT_FALSE(table.getPlacement(5));
+    table.setOrientation(6, style::TextWritingModeType::Horizontal);
+    EXPECT_FALSE(table.getPlacement(5));
+    EXPECT_FALSE(table.getOpacity(5));
+    table.forEachPlacement([](uint32_t, const JointPlacement&) { FAIL(); });
+}
@@ -16,6 +16,7 @@
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/gfx/dynamic_texture_atlas.hpp>
 
+#include <atomic>
 #include <memory>
 
 using namespace mbgl;
@@ -126,6 +127,29 @@ TEST(GeoJSONTile, Issue7648) {
     }
 }
 
+TEST(GeoJSONTile, CancelledParseIsCounted) {
+    GeoJSONTileTest test;
+
+    CircleLayer layer("circle", "source");
+
+    mapbox::feature::feature_collection<int16_t> features;
+    features.push_back(mapbox::feature::feature<int16_t>{mapbox::geometry::point<int16_t>(0, 0)});
+    auto data = std::make_shared<FakeGeoJSONData>(std::move(features));
+    TileParameters tileParameters = test.tileParameters;
+    tileParameters.isUpdateSynchronous = true;
+    tileParameters.abortedTileWork = std::make_shared<std::atomic<std::size_t>>(0);
+    GeoJSONTile tile(OverscaledTileID(0, 0, 0), "source", tileParameters, data);
+    Immutable<LayerProperties> layerProperties = makeMutable<CircleLayerProperties>(
+        staticImmutableCast<CircleLayer::Impl>(layer.baseImpl));
+
+    // Once the tile is no longer needed, parsing stops at the first checkpoint
+    tile.cancel();
+    std::vector<Immutable<LayerProperties>> layers{layerProperties};
+    tile.setLayers(layers);
+    EXPECT_FALSE(tile.isRenderable());
+    EXPECT_EQ(1u, tileParameters.abortedTileWork->load());
+}
+
 // Tests that tiles remain renderable if they have been renderable and then had
 // an error sent to them, e.g. when revalidating/refreshing the request.
 TEST(GeoJSONTile, Issue9927) {
@@ -0,0 +1,185 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/tile/shared_geometry_tile_data.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+
+using namespace mbgl;
+
+namespace {
+
+class StubFeature : public GeometryTileFeature {
+public:
+    explicit StubFeature(std::size_t& decodes_)
+        : decodes(decodes_) {}
+
+    FeatureType getType() const override { return FeatureType::Point; }
+    std::optional<Value> getValue(const std::string&) const override { return std::nullopt; }
+
+    const GeometryCollection& getGeometries() const override {
+        if (!geometries) {
+            ++decodes;
+            geometries = GeometryCollection{{{1, 2}}};
+        }
+        return *geometries;
+    }
+
+private:
+    std::size_t& decodes;
+    mutable std::optional<GeometryCollection> geometries;
+};
+
+class StubLayer : public GeometryTileLayer {
+public:
+    explicit StubLayer(std::size_t& decodes_)
+        : decodes(decodes_) {}
+
+    std::size_t featureCount() const override { return 2; }
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t) const override {
+        return std::make_unique<StubFeature>(decodes);
+    }
+    std::string getName() const override { return "features"; }
+
+private:
+    std::size_t& decodes;
+};
+
+class StubTileData : public GeometryTileData {
+public:
+    StubTileData(std::size_t& decodes_, std::size_t& featureDecodes_)
+        : decodes(decodes_),
+          featureDecodes(featureDecodes_) {}
+
+    std::unique_ptr<GeometryTileData> clone() const override {
+        return std::make_unique<StubTileData>(decodes, featureDecodes);
+    }
+
+    std::unique_ptr<GeometryTileLayer> getLayer(const std::string& name) const override {
+        if (!decoded) {
+            decoded = true;
+            ++decodes;
+        }
+        if (name == "features") {
+            return std::make_unique<StubLayer>(featureDecodes);
+        }
+        return nullptr;
+    }
+
+private:
+    std::size_t& decodes;
+    std::size_t& featureDecodes;
+    mutable bool decoded = false;
+};
+
+class SharedGeometryTileDataCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        cache.clear();
+        cache.setMaxSize(2);
+    }
+
+    void TearDown() override {
+        cache.clear();
+        cache.setMaxSize(0);
+    }
+
+    std::unique_ptr<GeometryTileData> get(const OverscaledTileID& id, const std::shared_ptr<const std::string>& raw) {
+        return cache.get("source", id, raw, [&] {
+            ++created;
+            return std::make_unique<StubTileData>(decodes, featureDecodes);
+        });
+    }
+
+    SharedGeometryTileDataCache& cache = SharedGeometryTileDataCache::getInstance();
+    std::size_t created = 0;
+    std::size_t decodes = 0;
+    std::size_t featureDecodes = 0;
+};
+
+} // namespace
+
+TEST_F(SharedGeometryTileDataCacheTest, Disabled) {
+    cache.setMaxSize(0);
+    const auto raw = std::make_shared<const std::string>("tile");
+
+    get({0, 0, 0}, raw);
+    get({0, 0, 0}, raw);
+
+    EXPECT_EQ(2u, created);
+    EXPECT_EQ(0u, cache.size());
+}
+
+TEST_F(SharedGeometryTileDataCacheTest, SharesDecodedData) {
+    const auto first = get({0, 0, 0}, std::make_shared<const std::string>("tile"));
+    // Equal bytes in a different buffer, as when two maps load the same tile
+    const auto second = get({0, 0, 0}, std::make_shared<const std::string>("tile"));
+
+    EXPECT_EQ(1u, created);
+    EXPECT_EQ(1u, cache.getHits());
+    EXPECT_EQ(1u, cache.getMisses());
+
+    first->getLayer("a");
+    second->getLayer("b");
+    second->clone()->getLayer("c");
+    EXPECT_EQ(1u, decodes);
+}
+
+TEST_F(SharedGeometryTileDataCacheTest, SharesDecodedFeatures) {
+    const auto first = get({0, 0, 0}, std::make_shared<const std::string>("tile"));
+    const auto second = get({0, 0, 0}, std::make_shared<const std::string>("tile"));
+
+    const auto layer = first->getLayer("features");
+    ASSERT_TRUE(layer);
+    EXPECT_EQ("features", layer->getName());
+    ASSERT_EQ(2u, layer->featureCount());
+    // Both features were decoded along with the layer
+    EXPECT_EQ(2u, featureDecodes);
+
+    const auto other = second->clone()->getLayer("features");
+    ASSERT_TRUE(other);
+    const auto& geometries = other->getFeature(1)->getGeometries();
+    EXPECT_EQ(&layer->getFeature(1)->getGeometries(), &geometries);
+    ASSERT_EQ(1u, geometries.size());
+    EXPECT_EQ((GeometryCoordinates{{1, 2}}), geometries[0]);
+    EXPECT_EQ(2u, featureDecodes);
+
+    EXPECT_FALSE(first->getLayer("missing"));
+}
+
+TEST_F(SharedGeometryTileDataCacheTest, ChangedData) {
+    get({0, 0, 0}, std::make_shared<const std::string>("tile"));
+    get({0, 0, 0}, std::make_shared<const std::string>("updated"));
+
+    EXPECT_EQ(2u, created);
+    EXPECT_EQ(0u, cache.getHits());
+    EXPECT_EQ(1u, cache.size());
+
+    get({0, 0, 0}, std::make_shared<const std::string>("updated"));
+    EXPECT_EQ(2u, created);
+}
+
+TEST_F(SharedGeometryTileDataCacheTest, EvictsLeastRecentlyUsed) {
+    const auto raw = std::make_shared<const std::string>("tile");
+
+    get({1, 0, 0}, raw);
+    get({1, 0, 1}, raw);
+    get({1, 0, 0}, raw);
+    get({1, 1, 0}, raw);
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_EQ(3u, created);
+
+    // 1/0/1 was the least recently used entry
+    get({1, 0, 0}, raw);
+    EXPECT_EQ(3u, created);
+    get({1, 0, 1}, raw);
+    EXPECT_EQ(4u, created);
+
+    // Evicted entries stay valid for existing users
+    const auto data = get({1, 1, 1}, raw);
+    cache.setMaxSize(0);
+    EXPECT_EQ(0u, cache.size());
+    data->getLayer("a");
+    EXPECT_EQ(1u, decodes);
+}
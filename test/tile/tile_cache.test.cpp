@@ -38,9 +38,12 @@ public:
         renderable = true;
     }
 
-    void setData(const std::shared_ptr<const std::string>&) override {}
+    void setData(const SharedBuffer&) override {}
+
+    std::size_t getCPUMemoryUsage() const override { return memoryUsage; }
 
     util::SimpleIdentity uniqueId;
+    std::size_t memoryUsage = 0;
 };
 
 } // namespace
@@ -96,3 +99,69 @@ TEST(TileCache, Issue15926) {
         EXPECT_FALSE(cache.has(id1));
     }
 }
+
+TEST(TileCache, CPUByteBudget) {
+    VectorTileTest test;
+    {
+        TileCache cache(test.threadPool, 10);
+        cache.setMaxCPUBytes(1000);
+
+        const auto makeTile = [&](const OverscaledTileID& id, std::size_t bytes) {
+            auto tile = std::make_unique<VectorTileMock>(id, "source", test.tileParameters, test.tileset);
+            tile->memoryUsage = bytes;
+            return tile;
+        };
+
+        const OverscaledTileID id0(1, 0, 0);
+        const OverscaledTileID id1(1, 1, 0);
+        const OverscaledTileID id2(1, 0, 1);
+        cache.add(id0, makeTile(id0, 400));
+        cache.add(id1, makeTile(id1, 400));
+        EXPECT_EQ(800u, cache.getStats().cpuBytes);
+
+        // Refresh id0 so that id1 becomes the least recently used tile
+        cache.add(id0, makeTile(id0, 400));
+        EXPECT_EQ(800u, cache.getStats().cpuBytes);
+
+        // Going over budget evicts the oldest tile even though the count limit allows more
+        cache.add(id2, makeTile(id2, 400));
+        EXPECT_TRUE(cache.has(id0));
+        EXPECT_FALSE(cache.has(id1));
+        EXPECT_TRUE(cache.has(id2));
+        EXPECT_EQ(800u, cache.getStats().cpuBytes);
+        EXPECT_EQ(1u, cache.getStats().evictions);
+
+        // Shrinking the budget evicts immediately
+        cache.setMaxCPUBytes(500);
+        EXPECT_FALSE(cache.has(id0));
+        EXPECT_TRUE(cache.has(id2));
+        EXPECT_EQ(400u, cache.getStats().cpuBytes);
+        EXPECT_EQ(2u, cache.getStats().evictions);
+
+        // A budget of zero only limits by count
+        cache.setMaxCPUBytes(0);
+        cache.add(id0, makeTile(id0, 4000));
+        EXPECT_TRUE(cache.has(id0));
+        EXPECT_EQ(4400u, cache.getStats().cpuBytes);
+    }
+}
+
+TEST(TileCache, Stats) {
+    VectorTileTest test;
+    {
+        TileCache cache(test.threadPool, 2);
+        const OverscaledTileID id0(0, 0, 0);
+        const OverscaledTileID id1(1, 0, 0);
+
+        cache.add(id0, std::make_unique<VectorTileMock>(id0, "source", test.tileParameters, test.tileset));
+        EXPECT_NE(nullptr, cache.pop(id0));
+        EXPECT_EQ(nullptr, cache.pop(id0));
+        EXPECT_EQ(nullptr, cache.pop(id1));
+
+        const auto stats = cache.getStats();
+        EXPECT_EQ(1u, stats.hits);
+        EXPECT_EQ(2u, stats.misses);
+        EXPECT_EQ(0u, stats.evictions);
+        EXPECT_EQ(0u, stats.tiles);
+    }
+}
@@ -0,0 +1,101 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/compression.hpp>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Small JSON-like documents that share keys but differ in values, like tiles of one tileset.
+std::vector<std::string> makeSamples(std::size_t count, unsigned seed) {
+    std::mt19937 random(seed);
+    std::vector<std::string> samples;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::string sample;
+        for (int feature = 0; feature < 20; ++feature) {
+            sample += R"({"type":"Feature","properties":{"class":"primary","name":"Street )" +
+                      std::to_string(random() % 1000) + R"(","oneway":)" + std::to_string(random() % 2) +
+                      R"(},"geometry":[)" + std::to_string(random()) + "]}";
+        }
+        samples.push_back(std::move(sample));
+    }
+    return samples;
+}
+
+} // namespace
+
+TEST(Compression, Codecs) {
+    const std::string raw = makeSamples(1, 0).front();
+
+    for (const auto codec : {util::Codec::None, util::Codec::Zlib, util::Codec::Zstd}) {
+        if (!util::isAvailable(codec)) {
+            EXPECT_THROW(util::compress(raw, codec), std::runtime_error);
+            continue;
+        }
+        const auto compressed = util::compress(raw, codec);
+        if (codec != util::Codec::None) {
+            EXPECT_LT(compressed.size(), raw.size());
+        }
+        EXPECT_EQ(raw, util::decompress(compressed, codec));
+    }
+}
+
+TEST(Compression, LegacyZlib) {
+    const std::string raw = makeSamples(1, 0).front();
+
+    // Data written by compress(raw, windowBits) is read as Codec::Zlib.
+    EXPECT_EQ(raw, util::decompress(util::compress(raw), util::Codec::Zlib));
+    EXPECT_EQ(raw, util::decompress(util::compress(raw, util::Codec::Zlib)));
+}
+
+TEST(Compression, Slice) {
+    const std::string raw = makeSamples(1, 0).front();
+
+    // Compressed data in the middle of a larger buffer, e.g. a tile in a mapped archive.
+    const std::string buffer = "header" + util::compress(raw, util::CompressionFormat::GZIP) + "trailer";
+    const std::string_view slice = std::string_view(buffer).substr(6, buffer.size() - 13);
+    EXPECT_TRUE(util::is_compressed(slice));
+    EXPECT_FALSE(util::is_compressed(std::string_view(buffer).substr(0, 6)));
+    EXPECT_EQ(raw, util::decompress(slice));
+}
+
+TEST(Compression, Dictionary) {
+    const auto samples = makeSamples(32, 1);
+    const std::string raw = makeSamples(1, 2).front();
+
+    for (const auto codec : {util::Codec::Zlib, util::Codec::Zstd}) {
+        if (!util::isAvailable(codec)) {
+            continue;
+        }
+
+        const auto dictionary = util::trainDictionary(codec, samples, 16 * 1024);
+        ASSERT_FALSE(dictionary.empty());
+        const auto id = util::dictionaryID(codec, dictionary);
+
+        const auto plain = util::compress(raw, codec);
+        const auto primed = util::compress(raw, codec, &dictionary);
+        EXPECT_LT(primed.size(), plain.size());
+
+        std::size_t lookups = 0;
+        EXPECT_EQ(raw, util::decompress(primed, codec, [&](util::Codec codec_, uint32_t id_) -> const std::string* {
+                      ++lookups;
+                      EXPECT_EQ(codec, codec_);
+                      EXPECT_EQ(id, id_);
+                      return &dictionary;
+                  }));
+        EXPECT_EQ(1u, lookups);
+
+        // Data compressed without a dictionary never asks for one.
+        EXPECT_EQ(raw, util::decompress(plain, codec, [&](util::Codec, uint32_t) -> const std::string* {
+                      ADD_FAILURE();
+                      return nullptr;
+                  }));
+
+        EXPECT_THROW(util::decompress(primed, codec), std::runtime_error);
+    }
+}
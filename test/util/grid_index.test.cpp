@@ -2,6 +2,11 @@
 
 #include <mbgl/test/util.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <vector>
+
 using namespace mbgl;
 
 TEST(GridIndex, IndexesFeatures) {
@@ -50,8 +55,169 @@ TEST(GridIndex, CircleBox) {
     EXPECT_EQ(grid.query({{0, 80}, {20, 100}}), (std::vector<int16_t>{2}));
 }
 
+TEST(GridIndex, Merge) {
+    GridIndex<int16_t> grid(100, 100, 10);
+    grid.insert(0, {{4, 10}, {6, 30}});
+    grid.insert(1, {{50, 50}, 10});
+
+    GridIndex<int16_t> other(100, 100, 10);
+    other.insert(2, {{4, 10}, {30, 12}});
+    other.insert(3, {{60, 60}, 15});
+
+    grid.merge(std::move(other));
+
+    EXPECT_EQ(grid.query({{4, 10}, {5, 11}}), (std::vector<int16_t>{0, 2}));
+    EXPECT_EQ(grid.query({{45, 45}, {55, 55}}), (std::vector<int16_t>{1, 3}));
+    EXPECT_EQ(grid.query({{-1000, -1000}, {1000, 1000}}), (std::vector<int16_t>{0, 2, 1, 3}));
+    EXPECT_TRUE(grid.hitTest({{80, 60}, 10}));
+}
+
 TEST(GridIndex, IndexesFeaturesOverflow) {
     GridIndex<int16_t> grid(5000, 5000, 25);
     grid.insert(0, {{4500, 4500}, {4900, 4900}});
     EXPECT_EQ(grid.query({{4000, 4000}, {5000, 5000}}), (std::vector<int16_t>{0}));
 }
+
+TEST(GridIndex, HitTestPredicate) {
+    GridIndex<int16_t> grid(100, 100, 10);
+    grid.insert(0, {{10, 10}, {30, 30}});
+    grid.insert(1, {{20, 20}, {40, 40}});
+    grid.insert(2, {{70, 70}, 5});
+
+    EXPECT_TRUE(grid.hitTest({{25, 25}, {26, 26}}, [](int16_t id) { return id == 1; }));
+    EXPECT_FALSE(grid.hitTest({{11, 11}, {12, 12}}, [](int16_t id) { return id == 1; }));
+    EXPECT_FALSE(grid.hitTest({{0, 0}, {100, 100}}, [](int16_t) { return false; }));
+    EXPECT_TRUE(grid.hitTest({{35, 35}, 2}, [](int16_t id) { return id == 1; }));
+    EXPECT_FALSE(grid.hitTest({{35, 35}, 2}, [](int16_t id) { return id == 0; }));
+    EXPECT_TRUE(grid.hitTest({{72, 72}, 1}, [](int16_t id) { return id == 2; }));
+}
+
+TEST(GridIndex, CollidingBoxes) {
+    using BBox = mapbox::geometry::box<float>;
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    uint32_t seed = 1;
+    const auto random = [&] {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1 << 24) * 100.0f;
+    };
+
+    for (int round = 0; round < 1000; ++round) {
+        detail::GridBoxBlock block;
+        for (std::size_t i = 0; i < detail::GridBoxBlock::size; ++i) {
+            block.minX[i] = random();
+            block.minY[i] = random();
+            block.maxX[i] = block.minX[i] + random() / 4;
+            block.maxY[i] = block.minY[i] + random() / 4;
+        }
+        // Unused lanes
+        if (round % 3 == 0) {
+            block.minX[7] = block.minY[7] = block.maxX[7] = block.maxY[7] = nan;
+        }
+
+        const float x = random();
+        const float y = random();
+        const BBox query{{x, y}, {x + random() / 2, y + random() / 2}};
+
+        uint32_t expected = 0;
+        for (std::size_t i = 0; i < detail::GridBoxBlock::size; ++i) {
+            if (query.min.x <= block.maxX[i] && query.min.y <= block.maxY[i] && query.max.x >= block.minX[i] &&
+                query.max.y >= block.minY[i]) {
+                expected |= 1u << i;
+            }
+        }
+        EXPECT_EQ(expected, detail::collidingBoxes(block, query));
+    }
+
+    // Touching edges collide
+    detail::GridBoxBlock block;
+    block.minX.fill(nan);
+    block.minY.fill(nan);
+    block.maxX.fill(nan);
+    block.maxY.fill(nan);
+    block.minX[3] = 10;
+    block.minY[3] = 10;
+    block.maxX[3] = 20;
+    block.maxY[3] = 20;
+    EXPECT_EQ(1u << 3, detail::collidingBoxes(block, {{20, 20}, {30, 30}}));
+    EXPECT_EQ(0u, detail::collidingBoxes(block, {{20.5f, 20}, {30, 30}}));
+}
+
+TEST(GridIndex, QueryMatchesBruteForce) {
+    using BBox = GridIndex<int16_t>::BBox;
+    uint32_t seed = 7;
+    const auto random = [&](float range) {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1 << 24) * range;
+    };
+
+    GridIndex<int16_t> grid(400, 300, 25);
+    std::vector<BBox> boxes;
+    for (int16_t i = 0; i < 500; ++i) {
+        const float x = random(420) - 10;
+        const float y = random(320) - 10;
+        boxes.push_back({{x, y}, {x + random(60), y + random(20)}});
+        grid.insert(int16_t(i), boxes.back());
+    }
+
+    for (int round = 0; round < 200; ++round) {
+        const float x = random(400);
+        const float y = random(300);
+        const BBox query{{x, y}, {x + random(100), y + random(100)}};
+
+        std::vector<int16_t> expected;
+        for (int16_t i = 0; i < static_cast<int16_t>(boxes.size()); ++i) {
+            const auto& box = boxes[i];
+            if (query.min.x <= box.max.x && query.min.y <= box.max.y && query.max.x >= box.min.x &&
+                query.max.y >= box.min.y) {
+                expected.push_back(i);
+            }
+        }
+
+        auto found = grid.query(query);
+        EXPECT_EQ(expected.size(), found.size());
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(expected, found);
+        EXPECT_EQ(!expected.empty(), grid.hitTest(query));
+    }
+}
+
+TEST(GridIndex, ConcurrentQueries) {
+    using BBox = GridIndex<int16_t>::BBox;
+    GridIndex<int16_t> grid(400, 400, 25);
+    for (int16_t i = 0; i < 400; ++i) {
+        const auto x = static_cast<float>(i % 20) * 20;
+        const auto y = static_cast<float>(i / 20) * 20;
+        // Every box spans several cells, so each query has to skip elements it already reported
+        grid.insert(int16_t(i), BBox{{x, y}, {x + 60, y + 60}});
+    }
+
+    const auto queryAll = [&] {
+        std::size_t found = 0;
+        for (float y = 0; y < 400; y += 10) {
+            for (float x = 0; x < 400; x += 10) {
+                found += grid.query({{x, y}, {x + 50, y + 50}}).size();
+            }
+        }
+        return found;
+    };
+    const auto expected = queryAll();
+
+    std::vector<std::size_t> results(4);
+    std::vector<std::thread> threads;
+    for (auto& result : results) {
+        threads.emplace_back([&] {
+            for (int round = 0; round < 20; ++round) {
+                result = queryAll();
+                if (result != expected) {
+                    return;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto result : results) {
+        EXPECT_EQ(expected, result);
+    }
+}
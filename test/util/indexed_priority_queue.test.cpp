@@ -0,0 +1,44 @@
+#include <mbgl/util/indexed_priority_queue.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace mbgl::util;
+
+TEST(IndexedPriorityQueue, LevelsThenFIFO) {
+    IndexedPriorityQueue<int, 3> queue;
+    queue.push(1, 2);
+    queue.push(2, 0);
+    queue.push(3, 1);
+    queue.push(4, 0);
+    EXPECT_EQ(4u, queue.size());
+
+    EXPECT_EQ(2, queue.pop());
+    EXPECT_EQ(4, queue.pop());
+    EXPECT_EQ(3, queue.pop());
+    EXPECT_EQ(1, queue.pop());
+    EXPECT_EQ(std::nullopt, queue.pop());
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(IndexedPriorityQueue, Remove) {
+    IndexedPriorityQueue<int, 2> queue;
+    for (int i = 0; i < 6; ++i) {
+        queue.push(i, i % 2);
+    }
+
+    EXPECT_TRUE(queue.contains(2));
+    EXPECT_TRUE(queue.remove(2));
+    EXPECT_FALSE(queue.contains(2));
+    EXPECT_FALSE(queue.remove(2));
+    EXPECT_TRUE(queue.remove(1));
+
+    EXPECT_EQ(0, queue.pop());
+    EXPECT_EQ(4, queue.pop());
+    EXPECT_EQ(3, queue.pop());
+    EXPECT_EQ(5, queue.pop());
+    EXPECT_TRUE(queue.empty());
+
+    // Removed items may be queued again
+    queue.push(2, 1);
+    EXPECT_EQ(2, queue.pop());
+}
@@ -0,0 +1,66 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/shared_buffer.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace mbgl;
+
+TEST(SharedBuffer, AdoptsString) {
+    SharedBuffer empty;
+    EXPECT_FALSE(empty);
+    EXPECT_EQ(nullptr, empty);
+    EXPECT_EQ(nullptr, empty.string());
+
+    const auto string = std::make_shared<const std::string>("0123456789");
+    SharedBuffer buffer = string;
+    ASSERT_TRUE(buffer);
+    EXPECT_EQ(string->data(), buffer.data());
+    EXPECT_EQ("0123456789", *buffer);
+    EXPECT_EQ(10u, buffer->size());
+
+    // A buffer spanning the whole string hands it back without copying.
+    EXPECT_EQ(string, buffer.string());
+    EXPECT_EQ(string, buffer.slice(0).string());
+}
+
+TEST(SharedBuffer, Slice) {
+    SharedBuffer buffer = std::make_shared<std::string>("0123456789");
+
+    const auto slice = buffer.slice(2, 3);
+    EXPECT_EQ("234", *slice);
+    EXPECT_EQ(buffer.data() + 2, slice.data());
+    EXPECT_NE(buffer, slice);
+    EXPECT_EQ("34", *slice.slice(1));
+
+    // Ranges are clamped to the end of the buffer.
+    EXPECT_EQ("89", *buffer.slice(8, 100));
+    EXPECT_TRUE(buffer.slice(20));
+    EXPECT_TRUE(buffer.slice(20).empty());
+
+    // A partial slice copies its bytes into a new string.
+    const auto string = slice.string();
+    EXPECT_EQ("234", *string);
+    EXPECT_NE(buffer.string(), string);
+}
+
+TEST(SharedBuffer, ExternalOwner) {
+    auto owner = std::make_shared<std::string>("external bytes");
+    std::weak_ptr<std::string> weakOwner = owner;
+
+    SharedBuffer slice;
+    {
+        const char* data = owner->data();
+        SharedBuffer buffer(data, 8, std::move(owner));
+        EXPECT_EQ("external", *buffer);
+        slice = buffer.slice(1, 3);
+    }
+
+    // The slice keeps the owner alive on its own.
+    EXPECT_FALSE(weakOwner.expired());
+    EXPECT_EQ("xte", *slice);
+
+    slice = nullptr;
+    EXPECT_TRUE(weakOwner.expired());
+}
@@ -5,10 +5,13 @@
 #include <mbgl/platform/settings.hpp>
 #include <mbgl/test/util.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/thread_pool.hpp>
 #include <mbgl/util/timer.hpp>
 
 #include <atomic>
+#include <future>
 #include <memory>
+#include <vector>
 
 using namespace mbgl;
 using namespace mbgl::util;
@@ -477,3 +480,74 @@ TEST(Thread, TaggedPools) {
     // Same for queue 2
     ASSERT_TRUE(totalRuns2 == runCount2);
 }
+
+TEST(Thread, WorkStealingTaggedPools) {
+    std::shared_ptr<Scheduler> pool = std::make_shared<ParallelScheduler>(3, ThreadedSchedulerBase::Mode::WorkStealing);
+    TaggedScheduler poolTag1{pool, {}};
+    TaggedScheduler poolTag2{pool, {}};
+
+    std::atomic<bool> stopTasks1{false};
+    std::atomic<bool> stopTasks2{false};
+    std::atomic<size_t> runCount1{0};
+    std::atomic<size_t> runCount2{0};
+
+    // Tasks reschedule themselves from worker threads, so they land in the per-worker deques
+    for (auto i = 0; i < 50; i++) {
+        poolTag1.schedule(makeCounterThread(poolTag1, &stopTasks1, &runCount1));
+        poolTag2.schedule(makeCounterThread(poolTag2, &stopTasks2, &runCount2));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    stopTasks1 = true;
+    poolTag1.waitForEmpty();
+    const auto totalRuns1 = runCount1.load();
+
+    stopTasks2 = true;
+    poolTag2.waitForEmpty();
+    const auto totalRuns2 = runCount2.load();
+
+    ASSERT_TRUE(totalRuns1 == runCount1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    ASSERT_TRUE(totalRuns2 == runCount2);
+}
+
+TEST(Thread, WorkStealingFanOut) {
+    std::shared_ptr<Scheduler> pool = std::make_shared<ParallelScheduler>(3, ThreadedSchedulerBase::Mode::WorkStealing);
+    const util::SimpleIdentity tag;
+
+    constexpr int parents = 200;
+    constexpr int children = 10;
+    std::atomic<int> executed{0};
+    for (int i = 0; i < parents; ++i) {
+        pool->schedule(tag, [&] {
+            executed++;
+            for (int j = 0; j < children; ++j) {
+                pool->schedule(tag, [&] { executed++; });
+            }
+        });
+    }
+
+    pool->waitForEmpty(tag);
+    EXPECT_EQ(parents * (children + 1), executed);
+}
+
+TEST(Thread, PriorityOrder) {
+    std::shared_ptr<Scheduler> pool = std::make_shared<SequencedScheduler>();
+    const util::SimpleIdentity tag;
+
+    // Hold the only worker so that the remaining tasks queue up behind it
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    pool->schedule(tag, [released] { released.wait(); });
+
+    std::vector<int> order;
+    pool->scheduleWithPriority(tag, 3, [&] { order.push_back(3); });
+    pool->scheduleWithPriority(tag, 1, [&] { order.push_back(1); });
+    pool->scheduleWithPriority(tag, 2, [&] { order.push_back(2); });
+    pool->scheduleWithPriority(tag, 1, [&] { order.push_back(11); });
+    pool->schedule(tag, [&] { order.push_back(0); });
+
+    release.set_value();
+    pool->waitForEmpty(tag);
+    EXPECT_EQ((std::vector<int>{0, 1, 11, 2, 3}), order);
+}
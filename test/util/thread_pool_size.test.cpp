@@ -0,0 +1,34 @@
+#include <mbgl/util/thread_pool_size.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace mbgl;
+
+TEST(ThreadPoolSize, Default) {
+    EXPECT_EQ(ThreadPoolSize::Policy::Fixed, ThreadPoolSize().policy());
+    EXPECT_EQ(4u, ThreadPoolSize().threadCount());
+}
+
+TEST(ThreadPoolSize, Fixed) {
+    EXPECT_EQ(7u, ThreadPoolSize::fixed(7).threadCount());
+    // Never resolves to an empty pool
+    EXPECT_EQ(1u, ThreadPoolSize::fixed(0).threadCount());
+}
+
+TEST(ThreadPoolSize, HardwareConcurrency) {
+    const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    EXPECT_EQ(hardware, ThreadPoolSize::hardwareConcurrency().threadCount());
+    EXPECT_EQ(hardware > 1 ? hardware - 1 : 1, ThreadPoolSize::hardwareConcurrency(1).threadCount());
+    EXPECT_EQ(1u, ThreadPoolSize::hardwareConcurrency(0, 1).threadCount());
+    EXPECT_EQ(1u, ThreadPoolSize::hardwareConcurrency(hardware + 10).threadCount());
+}
+
+TEST(ThreadPoolSize, CPUQuota) {
+    const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    const auto count = ThreadPoolSize::cpuQuota().threadCount();
+    EXPECT_GE(count, 1u);
+    EXPECT_LE(count, hardware);
+    EXPECT_EQ(1u, ThreadPoolSize::cpuQuota(0, 1).threadCount());
+}
@@ -0,0 +1,60 @@
+#include <mbgl/util/work_stealing_deque.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace mbgl::util;
+
+TEST(WorkStealingDeque, OwnerIsLIFOThiefIsFIFO) {
+    int values[4] = {0, 1, 2, 3};
+    WorkStealingDeque<int*> deque(2);
+
+    for (auto& value : values) {
+        deque.push(&value);
+    }
+    EXPECT_EQ(4u, deque.size());
+
+    EXPECT_EQ(&values[3], deque.pop());
+    EXPECT_EQ(&values[0], deque.steal());
+    EXPECT_EQ(&values[2], deque.pop());
+    EXPECT_EQ(&values[1], deque.steal());
+    EXPECT_EQ(nullptr, deque.pop());
+    EXPECT_EQ(nullptr, deque.steal());
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDeque, ConcurrentSteal) {
+    constexpr int count = 100000;
+    std::vector<int> values(count);
+    WorkStealingDeque<int*> deque(4);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> stolen{0};
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < 3; ++i) {
+        thieves.emplace_back([&] {
+            while (!done) {
+                if (deque.steal()) stolen++;
+            }
+            while (deque.steal()) stolen++;
+        });
+    }
+
+    int popped = 0;
+    for (int i = 0; i < count; ++i) {
+        deque.push(&values[i]);
+        if (i % 3 == 0 && deque.pop()) popped++;
+    }
+    while (deque.pop()) popped++;
+
+    done = true;
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    // Every item is handed out exactly once
+    EXPECT_EQ(count, popped + stolen);
+}